@@ -0,0 +1,23 @@
+// Replaces the global allocation functions of the benchmark binary to count heap allocations
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "bench_utils.hpp"
+
+namespace
+{
+std::atomic<uint64_t> allocation_count{0};
+} // namespace
+
+uint64_t copc::bench::AllocationCount() { return allocation_count.load(std::memory_order_relaxed); }
+
+void *operator new(std::size_t size)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void *ptr = std::malloc(size == 0 ? 1 : size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
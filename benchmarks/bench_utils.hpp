@@ -0,0 +1,110 @@
+#ifndef COPCLIB_BENCHMARKS_BENCH_UTILS_H_
+#define COPCLIB_BENCHMARKS_BENCH_UTILS_H_
+
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include <copc-lib/io/copc_reader.hpp>
+#include <copc-lib/io/copc_writer.hpp>
+#include <copc-lib/las/points.hpp>
+
+namespace copc::bench
+{
+
+// Size of the synthetic datasets' cube along each axis
+const double DATASET_SPAN = 1024;
+
+// Number of heap allocations made by the benchmark binary so far, see alloc_counter.cpp
+uint64_t AllocationCount();
+
+// Returns count random points within the bounds of the key's voxel
+inline las::Points RandomPoints(const las::LasHeader &header, const VoxelKey &key, int count, std::mt19937 &rng)
+{
+    Box box(key, header);
+    std::uniform_real_distribution<double> x(box.x_min, box.x_max), y(box.y_min, box.y_max), z(box.z_min, box.z_max);
+    std::uniform_int_distribution<int> classification(0, 10);
+    std::uniform_real_distribution<double> gps_time(0, 1e6);
+
+    las::Points points(header);
+    for (int i = 0; i < count; i++)
+    {
+        auto point = points.CreatePoint();
+        point->X(x(rng));
+        point->Y(y(rng));
+        point->Z(z(rng));
+        point->Classification(classification(rng));
+        point->GPSTime(gps_time(rng));
+        point->Intensity(static_cast<uint16_t>(i));
+        points.AddPoint(point);
+    }
+    return points;
+}
+
+inline CopcConfigWriter SyntheticConfig(int8_t point_format_id = 7)
+{
+    CopcConfigWriter cfg(point_format_id, {0.001, 0.001, 0.001}, {0, 0, 0});
+    cfg.LasHeader()->min = Vector3(0, 0, 0);
+    cfg.LasHeader()->max = Vector3(DATASET_SPAN, DATASET_SPAN, DATASET_SPAN);
+    cfg.CopcInfo()->center_x = DATASET_SPAN / 2;
+    cfg.CopcInfo()->center_y = DATASET_SPAN / 2;
+    cfg.CopcInfo()->center_z = DATASET_SPAN / 2;
+    cfg.CopcInfo()->halfsize = DATASET_SPAN / 2;
+    cfg.CopcInfo()->spacing = DATASET_SPAN / 64;
+    return cfg;
+}
+
+// Returns the bytes of a COPC file holding a full octree of max_depth + 1 levels, with points_per_node random points
+// in each node. Nodes deeper than the root are paged by their depth 1 ancestor.
+// Datasets are generated once per set of parameters.
+inline const std::string &SyntheticCopcData(int max_depth = 3, int points_per_node = 2000)
+{
+    static std::map<std::pair<int, int>, std::string> datasets;
+    auto &data = datasets[{max_depth, points_per_node}];
+    if (!data.empty())
+        return data;
+
+    std::mt19937 rng(max_depth * 100003 + points_per_node);
+    std::stringstream out_stream;
+    Writer writer(out_stream, SyntheticConfig());
+    auto header = *writer.CopcConfig()->LasHeader();
+    for (int d = 0; d <= max_depth; d++)
+    {
+        int32_t n = 1 << d;
+        for (int32_t x = 0; x < n; x++)
+            for (int32_t y = 0; y < n; y++)
+                for (int32_t z = 0; z < n; z++)
+                {
+                    VoxelKey key(d, x, y, z);
+                    auto page_key = d == 0 ? VoxelKey::RootKey() : key.GetParentAtDepth(1);
+                    writer.AddNode(key, RandomPoints(header, key, points_per_node, rng), page_key);
+                }
+    }
+    writer.Close();
+
+    data = out_stream.str();
+    return data;
+}
+
+// Writes the synthetic dataset to disk once and returns its path
+inline std::string SyntheticCopcPath(int max_depth = 3, int points_per_node = 2000)
+{
+    std::string path = "copc_bench_" + std::to_string(max_depth) + "_" + std::to_string(points_per_node) + ".copc.laz";
+    static std::map<std::string, bool> written;
+    if (!written[path])
+    {
+        const auto &data = SyntheticCopcData(max_depth, points_per_node);
+        std::ofstream out_stream(path, std::ios::out | std::ios::binary | std::ios::trunc);
+        out_stream.write(data.data(), static_cast<std::streamsize>(data.size()));
+        written[path] = true;
+    }
+    return path;
+}
+
+} // namespace copc::bench
+
+#endif // COPCLIB_BENCHMARKS_BENCH_UTILS_H_
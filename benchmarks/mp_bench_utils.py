@@ -0,0 +1,51 @@
+"""Helpers shared by the copclib.mp benchmark scripts."""
+import copclib as copc
+import numpy as np
+
+POINTS_PER_NODE = 100000
+
+
+def generate_file(file_path, num_points, skew=0.0):
+    """Writes a COPC file of `num_points` random points, split between the nodes of an octree.
+
+    Args:
+        file_path (str): The output path.
+        num_points (int): The total number of points.
+        skew (float, optional): The spread of the node sizes, as the sigma of a lognormal distribution. Real files
+            have node sizes that vary by orders of magnitude, which is approached with a skew of 2 or more.
+            Defaults to 0, which splits the points evenly.
+    """
+    cfg = copc.CopcConfigWriter(point_format_id=6, scale=(0.01, 0.01, 0.01))
+    cfg.las_header.min = copc.Vector3(0, 0, 0)
+    cfg.las_header.max = copc.Vector3(1000, 1000, 1000)
+    cfg.copc_info.spacing = 10
+    writer = copc.FileWriter(file_path, cfg)
+    header = writer.copc_config.las_header
+
+    rng = np.random.default_rng(42)
+    num_nodes = max(1, num_points // POINTS_PER_NODE)
+    keys = [copc.VoxelKey.RootKey()]
+    depth = 1
+    while len(keys) < num_nodes:
+        span = 2**depth
+        keys += [
+            copc.VoxelKey(depth, x, y, z)
+            for x in range(span)
+            for y in range(span)
+            for z in range(span)
+        ]
+        depth += 1
+
+    weights = rng.lognormal(0, skew, num_nodes)
+    node_sizes = np.maximum(1, (weights / weights.sum() * num_points).astype(int))
+    for key, node_points in zip(keys, node_sizes):
+        # Unpack zeroed point data to create the points at once, then fill in their dimensions
+        point_data = copc.VectorChar(bytes(node_points * header.point_record_length))
+        points = copc.Points.Unpack(point_data, header)
+        box = copc.Box(key, header)
+        points.x = rng.uniform(box.x_min, box.x_max, node_points)
+        points.y = rng.uniform(box.y_min, box.y_max, node_points)
+        points.z = rng.uniform(box.z_min, box.z_max, node_points)
+        points.classification = rng.integers(0, 10, node_points)
+        writer.AddNode(key, points)
+    writer.Close()
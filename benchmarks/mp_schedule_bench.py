@@ -0,0 +1,105 @@
+"""Compares the streaming scheduler of copclib.mp with chunk-by-chunk scheduling, on a file with skewed node sizes.
+
+Usage:
+    python benchmarks/mp_schedule_bench.py [--file FILE] [--points N] [--skew S] [--chunk-size C] [--max-workers W]
+
+"barrier" submits nodes in file order, `chunk_size` at a time, and waits for a whole chunk before submitting the next
+one, as copclib.mp did before. "stream" keeps `chunk_size` tasks in flight, largest nodes first, and "stream+group" also
+groups the nodes smaller than `--group-points`.
+The file defaults to the COPC_BENCH_FILE environment variable, as for the C++ benchmarks, so a real dataset can be
+used. If no file is given, a synthetic COPC file of N points (default 5 million) is generated in a temporary directory.
+"""
+import argparse
+import concurrent.futures
+import os
+import tempfile
+import time
+
+import copclib as copc
+from copclib.mp.read import _do_read_xyz, _read_node, init_mp, read_multithreaded
+from copclib.mp.utils import chunks, make_executor
+from mp_bench_utils import generate_file
+
+
+def read_barrier(reader, chunk_size, max_workers):
+    point_count = 0
+    with make_executor("process", max_workers, init_mp, (reader.path,)) as executor:
+        for chunk in chunks(reader.GetAllNodes(), chunk_size):
+            futures = [
+                executor.submit(_read_node, _do_read_xyz, {}, node) for node in chunk
+            ]
+            for fut in concurrent.futures.as_completed(futures):
+                _, return_vals = fut.result()
+                point_count += len(return_vals["xyz"])
+    return point_count
+
+
+def read_stream(reader, chunk_size, max_workers, group_points=0):
+    point_count = 0
+
+    def callback(xyz, **kwargs):
+        nonlocal point_count
+        point_count += len(xyz)
+
+    read_multithreaded(
+        reader,
+        _do_read_xyz,
+        completed_callback=callback,
+        chunk_size=chunk_size,
+        max_workers=max_workers,
+        group_points=group_points,
+    )
+    return point_count
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument(
+        "--file",
+        default=os.environ.get("COPC_BENCH_FILE"),
+        help="COPC file to read, defaults to $COPC_BENCH_FILE, generated if neither is given",
+    )
+    parser.add_argument("--points", type=int, default=5000000)
+    parser.add_argument("--skew", type=float, default=2.0)
+    parser.add_argument("--chunk-size", type=int, default=os.cpu_count())
+    parser.add_argument("--group-points", type=int, default=20000)
+    parser.add_argument("--repeat", type=int, default=3)
+    parser.add_argument("--max-workers", type=int, default=None)
+    args = parser.parse_args()
+
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        file_path = args.file
+        if file_path is None:
+            file_path = os.path.join(tmp_dir, "bench.copc.laz")
+            generate_file(file_path, args.points, args.skew)
+
+        reader = copc.FileReader(file_path)
+        point_counts = [node.point_count for node in reader.GetAllNodes()]
+        print(
+            f"{file_path}: {sum(point_counts)} points, {len(point_counts)} nodes "
+            f"of {min(point_counts)} to {max(point_counts)} points"
+        )
+        schedulers = {
+            "barrier": lambda: read_barrier(reader, args.chunk_size, args.max_workers),
+            "stream": lambda: read_stream(reader, args.chunk_size, args.max_workers),
+            "stream+group": lambda: read_stream(
+                reader, args.chunk_size, args.max_workers, args.group_points
+            ),
+        }
+        baseline = None
+        for name, scheduler in schedulers.items():
+            timings = []
+            for _ in range(args.repeat):
+                start = time.perf_counter()
+                point_count = scheduler()
+                timings.append(time.perf_counter() - start)
+            best = min(timings)
+            baseline = baseline or best
+            print(
+                f"{name:>14}: best {best:.3f}s over {args.repeat} runs, "
+                f"{point_count / best / 1e6:.2f} Mpoints/s, speedup {baseline / best:.2f}x"
+            )
+
+
+if __name__ == "__main__":
+    main()
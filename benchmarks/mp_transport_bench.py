@@ -0,0 +1,58 @@
+"""Compares the "pickle" and "shared_memory" transports of copclib.mp on a large file.
+
+Usage:
+    python benchmarks/mp_transport_bench.py [--file FILE] [--points N] [--repeat R] [--max-workers W]
+
+The file defaults to the COPC_BENCH_FILE environment variable, as for the C++ benchmarks, so a real dataset can be
+used. If no file is given, a synthetic COPC file of N points (default 5 million) is generated in a temporary directory.
+"""
+import argparse
+import os
+import tempfile
+import time
+
+import copclib as copc
+from copclib.mp.read import read_concat_xyz_class_limit
+from mp_bench_utils import generate_file
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument(
+        "--file",
+        default=os.environ.get("COPC_BENCH_FILE"),
+        help="COPC file to read, defaults to $COPC_BENCH_FILE, generated if neither is given",
+    )
+    parser.add_argument("--points", type=int, default=5000000)
+    parser.add_argument("--repeat", type=int, default=3)
+    parser.add_argument("--max-workers", type=int, default=None)
+    args = parser.parse_args()
+
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        file_path = args.file
+        if file_path is None:
+            file_path = os.path.join(tmp_dir, "bench.copc.laz")
+            generate_file(file_path, args.points)
+
+        reader = copc.FileReader(file_path)
+        print(
+            f"{file_path}: {reader.copc_config.las_header.point_count} points, "
+            f"{len(reader.GetAllNodes())} nodes"
+        )
+        for transport in ["pickle", "shared_memory"]:
+            timings = []
+            for _ in range(args.repeat):
+                start = time.perf_counter()
+                xyz = read_concat_xyz_class_limit(
+                    reader, transport=transport, max_workers=args.max_workers
+                )
+                timings.append(time.perf_counter() - start)
+            best = min(timings)
+            print(
+                f"{transport:>14}: best {best:.3f}s over {args.repeat} runs, "
+                f"{len(xyz) / best / 1e6:.2f} Mpoints/s"
+            )
+
+
+if __name__ == "__main__":
+    main()
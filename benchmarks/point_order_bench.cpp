@@ -0,0 +1,150 @@
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <copc-lib/io/copc_reader.hpp>
+#include <copc-lib/las/point_order.hpp>
+#include <copc-lib/laz/compressor.hpp>
+#include <copc-lib/laz/decompressor.hpp>
+
+#include "bench_utils.hpp"
+
+using namespace copc;
+
+namespace
+{
+// Uncompressed point data of the nodes of a file, in the order they were written
+struct NodeSet
+{
+    las::LasHeader header;
+    std::vector<std::vector<char>> nodes;
+    int64_t point_count{0};
+    int64_t byte_size{0};
+    std::string source;
+};
+
+// Loads up to 64 nodes of the file given by the COPC_BENCH_FILE environment variable, such as a real dataset, or
+// of the synthetic dataset if it isn't set. Nodes are loaded once.
+const NodeSet &BenchNodes()
+{
+    static NodeSet node_set;
+    if (!node_set.nodes.empty())
+        return node_set;
+
+    const char *env_path = std::getenv("COPC_BENCH_FILE");
+    std::string path = env_path != nullptr ? env_path : bench::SyntheticCopcPath(2, 20000);
+    FileReader reader(path);
+    node_set.header = reader.CopcConfig().LasHeader();
+    node_set.source = env_path != nullptr ? path : "synthetic";
+    for (const auto &node : reader.GetAllNodes())
+    {
+        if (node_set.nodes.size() == 64)
+            break;
+        node_set.nodes.push_back(reader.GetPointData(node));
+        node_set.point_count += node.point_count;
+        node_set.byte_size += static_cast<int64_t>(node_set.nodes.back().size());
+    }
+    return node_set;
+}
+
+const char *OrderName(int64_t order)
+{
+    switch (static_cast<las::PointOrder>(order))
+    {
+    case las::PointOrder::Morton:
+        return "morton";
+    case las::PointOrder::GpsTime:
+        return "gps_time";
+    default:
+        return "unchanged";
+    }
+}
+
+std::vector<std::vector<char>> SortedNodes(const NodeSet &node_set, las::PointOrder order)
+{
+    auto nodes = node_set.nodes;
+    for (auto &node : nodes)
+        las::SortPointData(node, node_set.header, order);
+    return nodes;
+}
+} // namespace
+
+// Sorts the nodes' point records in the order range(0), a las::PointOrder
+static void BM_SortPointData(benchmark::State &state)
+{
+    const auto &node_set = BenchNodes();
+    auto order = static_cast<las::PointOrder>(state.range(0));
+    state.SetLabel(std::string(OrderName(state.range(0))) + "/" + node_set.source);
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto nodes = node_set.nodes;
+        state.ResumeTiming();
+
+        for (auto &node : nodes)
+            las::SortPointData(node, node_set.header, order);
+        benchmark::DoNotOptimize(nodes.data());
+    }
+    state.SetItemsProcessed(state.iterations() * node_set.point_count);
+    state.SetBytesProcessed(state.iterations() * node_set.byte_size);
+}
+BENCHMARK(BM_SortPointData)->DenseRange(0, 2)->Unit(benchmark::kMillisecond);
+
+// Sorts the nodes in the order range(0) then compresses them, as Writer::AddNode does with SetPointOrder. The ratio
+// counter is the uncompressed over the compressed size.
+static void BM_PointOrderCompress(benchmark::State &state)
+{
+    const auto &node_set = BenchNodes();
+    auto order = static_cast<las::PointOrder>(state.range(0));
+    state.SetLabel(std::string(OrderName(state.range(0))) + "/" + node_set.source);
+
+    int64_t compressed_bytes = 0;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto nodes = node_set.nodes;
+        state.ResumeTiming();
+
+        compressed_bytes = 0;
+        for (auto &node : nodes)
+        {
+            las::SortPointData(node, node_set.header, order);
+            compressed_bytes += static_cast<int64_t>(laz::Compressor::CompressBytes(node, node_set.header).size());
+        }
+    }
+    state.counters["ratio"] = static_cast<double>(node_set.byte_size) / static_cast<double>(compressed_bytes);
+    state.SetItemsProcessed(state.iterations() * node_set.point_count);
+    state.SetBytesProcessed(state.iterations() * node_set.byte_size);
+}
+BENCHMARK(BM_PointOrderCompress)->DenseRange(0, 2)->Unit(benchmark::kMillisecond);
+
+// Decompresses the nodes compressed in the order range(0)
+static void BM_PointOrderDecompress(benchmark::State &state)
+{
+    const auto &node_set = BenchNodes();
+    auto order = static_cast<las::PointOrder>(state.range(0));
+    state.SetLabel(std::string(OrderName(state.range(0))) + "/" + node_set.source);
+
+    std::vector<std::vector<char>> compressed_nodes;
+    std::vector<int> point_counts;
+    for (auto &node : SortedNodes(node_set, order))
+    {
+        point_counts.push_back(static_cast<int>(node.size() / node_set.header.PointRecordLength()));
+        compressed_nodes.push_back(laz::Compressor::CompressBytes(node, node_set.header));
+    }
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < compressed_nodes.size(); i++)
+        {
+            auto point_data = laz::Decompressor::DecompressBytes(compressed_nodes[i], node_set.header, point_counts[i]);
+            benchmark::DoNotOptimize(point_data.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * node_set.point_count);
+    state.SetBytesProcessed(state.iterations() * node_set.byte_size);
+}
+BENCHMARK(BM_PointOrderDecompress)->DenseRange(0, 2)->Unit(benchmark::kMillisecond);
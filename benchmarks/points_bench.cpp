@@ -0,0 +1,167 @@
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include <copc-lib/las/extra_bytes_schema.hpp>
+#include <copc-lib/las/points.hpp>
+
+#include "bench_utils.hpp"
+
+using namespace copc;
+
+// Number of points in each benchmarked Points object
+static const int NUM_POINTS = 50000;
+
+// Reports the number of point fields processed per second
+static void SetFieldsProcessed(benchmark::State &state, int8_t point_format_id)
+{
+    state.counters["fields_per_second"] =
+        benchmark::Counter(static_cast<double>(state.iterations() * NUM_POINTS) *
+                               las::PointBaseNumberDimensions(point_format_id),
+                           benchmark::Counter::kIsRate);
+}
+
+// Points::Pack for each point format
+static void BM_PointsPack(benchmark::State &state)
+{
+    auto cfg = bench::SyntheticConfig(static_cast<int8_t>(state.range(0)));
+    std::mt19937 rng(42);
+    auto points = bench::RandomPoints(*cfg.LasHeader(), VoxelKey::RootKey(), NUM_POINTS, rng);
+
+    int64_t bytes = 0;
+    for (auto _ : state)
+    {
+        auto point_data = points.Pack(*cfg.LasHeader());
+        bytes += static_cast<int64_t>(point_data.size());
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_POINTS);
+    state.SetBytesProcessed(bytes);
+    SetFieldsProcessed(state, cfg.LasHeader()->PointFormatId());
+}
+BENCHMARK(BM_PointsPack)->DenseRange(6, 8)->Unit(benchmark::kMillisecond);
+
+// Points::Unpack for each point format
+static void BM_PointsUnpack(benchmark::State &state)
+{
+    auto cfg = bench::SyntheticConfig(static_cast<int8_t>(state.range(0)));
+    std::mt19937 rng(42);
+    auto point_data =
+        bench::RandomPoints(*cfg.LasHeader(), VoxelKey::RootKey(), NUM_POINTS, rng).Pack(*cfg.LasHeader());
+
+    for (auto _ : state)
+    {
+        auto points = las::Points::Unpack(point_data, *cfg.LasHeader());
+        benchmark::DoNotOptimize(points);
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_POINTS);
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(point_data.size()));
+    SetFieldsProcessed(state, cfg.LasHeader()->PointFormatId());
+}
+BENCHMARK(BM_PointsUnpack)->DenseRange(6, 8)->Unit(benchmark::kMillisecond);
+
+// Merges many small Points objects into one, as when collecting node results:
+// 0 copies each part, 1 moves each part, 2 concatenates all parts at once
+static void BM_PointsMerge(benchmark::State &state)
+{
+    const int num_parts = 1000;
+    auto cfg = bench::SyntheticConfig(6);
+    std::mt19937 rng(42);
+    auto part = bench::RandomPoints(*cfg.LasHeader(), VoxelKey::RootKey(), NUM_POINTS / num_parts, rng);
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        std::vector<las::Points> parts(num_parts, part);
+        state.ResumeTiming();
+
+        las::Points out(*cfg.LasHeader());
+        if (state.range(0) == 0)
+        {
+            for (const auto &points : parts)
+                out.AddPoints(points);
+        }
+        else if (state.range(0) == 1)
+        {
+            for (auto &points : parts)
+                out.AddPoints(std::move(points));
+        }
+        else
+        {
+            out.AddPoints(std::move(parts));
+        }
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_POINTS);
+}
+BENCHMARK(BM_PointsMerge)->DenseRange(0, 2)->Unit(benchmark::kMicrosecond);
+
+// An extra bytes VLR of 8 scaled int16 fields
+static las::EbVlr ExtraBytesVlr()
+{
+    las::EbVlr eb_vlr;
+    for (int f = 0; f < 8; f++)
+    {
+        auto field = lazperf::eb_vlr::ebfield();
+        field.name = "field_" + std::to_string(f);
+        field.data_type = 4;
+        field.options = 0x8;
+        field.scale[0] = 0.01;
+        eb_vlr.addField(field);
+    }
+    return eb_vlr;
+}
+
+static std::vector<char> ExtraBytesPointData(const las::EbVlr &eb_vlr)
+{
+    auto eb_byte_size = static_cast<uint16_t>(las::NumBytesFromExtraBytes(eb_vlr.items));
+    las::Points points(6, eb_byte_size);
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> value(-1000, 1000);
+    for (int i = 0; i < NUM_POINTS; i++)
+    {
+        auto point = points.CreatePoint();
+        for (const auto &item : eb_vlr.items)
+            point->SetExtraBytesField<int16_t>(eb_vlr, item.name, static_cast<int16_t>(value(rng)));
+        points.AddPoint(point);
+    }
+    return points.Pack({1, 1, 1}, {0, 0, 0});
+}
+
+// Reads every extra bytes field of a node through Points::GetExtraBytesField
+static void BM_ExtraBytesPoints(benchmark::State &state)
+{
+    auto eb_vlr = ExtraBytesVlr();
+    auto point_data = ExtraBytesPointData(eb_vlr);
+    auto eb_byte_size = static_cast<uint16_t>(las::NumBytesFromExtraBytes(eb_vlr.items));
+
+    for (auto _ : state)
+    {
+        auto points = las::Points::Unpack(point_data, 6, eb_byte_size, {1, 1, 1}, {0, 0, 0});
+        for (const auto &item : eb_vlr.items)
+        {
+            auto values = points.GetExtraBytesField<int16_t>(eb_vlr, item.name);
+            benchmark::DoNotOptimize(values);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_POINTS * eb_vlr.items.size());
+}
+BENCHMARK(BM_ExtraBytesPoints)->Unit(benchmark::kMillisecond);
+
+// Reads every extra bytes field of a node, scaled, with an ExtraBytesSchema
+static void BM_ExtraBytesSchema(benchmark::State &state)
+{
+    auto eb_vlr = ExtraBytesVlr();
+    auto point_data = ExtraBytesPointData(eb_vlr);
+    las::ExtraBytesSchema schema(eb_vlr, 6);
+    std::vector<std::string> names;
+    for (const auto &item : eb_vlr.items)
+        names.push_back(item.name);
+
+    for (auto _ : state)
+    {
+        auto columns = schema.ExtractScaled(point_data, names);
+        benchmark::DoNotOptimize(columns);
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_POINTS * eb_vlr.items.size());
+}
+BENCHMARK(BM_ExtraBytesSchema)->Unit(benchmark::kMillisecond);
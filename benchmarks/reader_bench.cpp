@@ -0,0 +1,214 @@
+#include <cmath>
+
+#include <benchmark/benchmark.h>
+
+#include <copc-lib/io/copc_reader.hpp>
+#include <copc-lib/io/internal/memory_stream.hpp>
+
+#include "bench_utils.hpp"
+
+using namespace copc;
+
+// Opens a reader over a file that's already in memory, measuring header/VLR parsing only
+static void BM_ReaderOpen(benchmark::State &state)
+{
+    const auto &data = bench::SyntheticCopcData();
+    for (auto _ : state)
+    {
+        Internal::MemoryIStream in_stream(data.data(), data.size());
+        Reader reader(&in_stream);
+        benchmark::DoNotOptimize(reader.CopcConfig());
+    }
+    // Reported as opens per second
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ReaderOpen);
+
+static void BM_FileReaderOpen(benchmark::State &state)
+{
+    auto path = bench::SyntheticCopcPath();
+    for (auto _ : state)
+    {
+        FileReader reader(path);
+        benchmark::DoNotOptimize(reader.CopcConfig());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FileReaderOpen);
+
+// Opens a reader and loads the whole hierarchy, for octrees of increasing depth
+static void BM_HierarchyLoad(benchmark::State &state)
+{
+    const auto &data = bench::SyntheticCopcData(static_cast<int>(state.range(0)), 10);
+    size_t node_count = 0;
+    for (auto _ : state)
+    {
+        Internal::MemoryIStream in_stream(data.data(), data.size());
+        Reader reader(&in_stream);
+        node_count = reader.GetAllNodes().size();
+    }
+    state.counters["nodes"] = static_cast<double>(node_count);
+    state.SetItemsProcessed(state.iterations() * node_count);
+}
+BENCHMARK(BM_HierarchyLoad)->DenseRange(2, 4);
+
+// Decompresses every node of the file
+static void BM_GetPointData(benchmark::State &state)
+{
+    const auto &data = bench::SyntheticCopcData();
+    Internal::MemoryIStream in_stream(data.data(), data.size());
+    Reader reader(&in_stream);
+    auto nodes = reader.GetAllNodes();
+
+    int64_t points = 0, bytes = 0;
+    for (auto _ : state)
+    {
+        for (const auto &node : nodes)
+        {
+            auto point_data = reader.GetPointData(node);
+            points += node.point_count;
+            bytes += static_cast<int64_t>(point_data.size());
+        }
+    }
+    state.SetItemsProcessed(points);
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_GetPointData)->Unit(benchmark::kMillisecond);
+
+// Decompresses and unpacks every node of the file
+static void BM_GetPoints(benchmark::State &state)
+{
+    const auto &data = bench::SyntheticCopcData();
+    Internal::MemoryIStream in_stream(data.data(), data.size());
+    Reader reader(&in_stream);
+    auto nodes = reader.GetAllNodes();
+    auto point_size = reader.CopcConfig().LasHeader().PointRecordLength();
+
+    int64_t points = 0;
+    for (auto _ : state)
+    {
+        for (const auto &node : nodes)
+        {
+            auto node_points = reader.GetPoints(node);
+            points += static_cast<int64_t>(node_points.Size());
+        }
+    }
+    state.SetItemsProcessed(points);
+    state.SetBytesProcessed(points * point_size);
+}
+BENCHMARK(BM_GetPoints)->Unit(benchmark::kMillisecond);
+
+// Heap allocations made while reading every node into Points:
+// 0 decompresses into a vector and unpacks it, 1 uses GetPoints, whose buffers come from a thread-local arena,
+// 2 also allocates the points from an arena that is released after each node
+static void BM_GetPointsAllocations(benchmark::State &state)
+{
+    const auto &data = bench::SyntheticCopcData();
+    Internal::MemoryIStream in_stream(data.data(), data.size());
+    Reader reader(&in_stream);
+    auto nodes = reader.GetAllNodes();
+    const auto &header = reader.CopcConfig().LasHeader();
+    Arena arena;
+
+    int64_t points = 0;
+    uint64_t allocations = 0;
+    for (auto _ : state)
+    {
+        for (const auto &node : nodes)
+        {
+            uint64_t start = bench::AllocationCount();
+            if (state.range(0) == 0)
+            {
+                auto node_points = las::Points::Unpack(reader.GetPointData(node), header);
+                points += static_cast<int64_t>(node_points.Size());
+            }
+            else if (state.range(0) == 1)
+            {
+                auto node_points = reader.GetPoints(node);
+                points += static_cast<int64_t>(node_points.Size());
+            }
+            else
+            {
+                auto node_points = reader.GetPoints(node, arena);
+                points += static_cast<int64_t>(node_points.Size());
+            }
+            arena.Release();
+            allocations += bench::AllocationCount() - start;
+        }
+    }
+    state.counters["allocs_per_node"] =
+        static_cast<double>(allocations) / static_cast<double>(state.iterations() * nodes.size());
+    state.counters["allocs_per_point"] = static_cast<double>(allocations) / static_cast<double>(points);
+    state.SetItemsProcessed(points);
+}
+BENCHMARK(BM_GetPointsAllocations)->DenseRange(0, 2)->Unit(benchmark::kMillisecond);
+
+// Decompresses every node of the file into XYZ columns
+static void BM_GetPointsArray(benchmark::State &state)
+{
+    const auto &data = bench::SyntheticCopcData();
+    Internal::MemoryIStream in_stream(data.data(), data.size());
+    Reader reader(&in_stream);
+    auto nodes = reader.GetAllNodes();
+
+    int64_t points = 0;
+    for (auto _ : state)
+    {
+        for (const auto &node : nodes)
+        {
+            auto array = reader.GetPointsArray(node, {"x", "y", "z"});
+            points += static_cast<int64_t>(array.Size());
+        }
+    }
+    state.SetItemsProcessed(points);
+    state.SetBytesProcessed(points * 3 * sizeof(double));
+}
+BENCHMARK(BM_GetPointsArray)->Unit(benchmark::kMillisecond);
+
+// Query box covering range(0)% of the dataset's extent along X and Y, centered in the dataset
+static Box QueryBox(int64_t percent)
+{
+    double half_size = bench::DATASET_SPAN * static_cast<double>(percent) / 200;
+    double center = bench::DATASET_SPAN / 2;
+    return Box(center - half_size, center - half_size, center + half_size, center + half_size);
+}
+
+// Query resolution, range(1) levels of detail above the deepest level (0 for full resolution)
+static double QueryResolution(Reader &reader, int64_t levels_up)
+{
+    if (levels_up == 0)
+        return 0;
+    return reader.CopcConfig().CopcInfo().spacing / std::pow(2, reader.GetMaxDepth() - levels_up);
+}
+
+static void BM_GetNodesIntersectBox(benchmark::State &state)
+{
+    const auto &data = bench::SyntheticCopcData();
+    Internal::MemoryIStream in_stream(data.data(), data.size());
+    Reader reader(&in_stream);
+    reader.GetAllNodes();
+    auto box = QueryBox(state.range(0));
+    auto resolution = QueryResolution(reader, state.range(1));
+
+    size_t node_count = 0;
+    for (auto _ : state)
+        node_count = reader.GetNodesIntersectBox(box, resolution).size();
+    state.counters["nodes"] = static_cast<double>(node_count);
+}
+BENCHMARK(BM_GetNodesIntersectBox)->ArgsProduct({{1, 10, 50, 100}, {0, 1, 2}});
+
+static void BM_GetPointsWithinBox(benchmark::State &state)
+{
+    const auto &data = bench::SyntheticCopcData();
+    Internal::MemoryIStream in_stream(data.data(), data.size());
+    Reader reader(&in_stream);
+    reader.GetAllNodes();
+    auto box = QueryBox(state.range(0));
+    auto resolution = QueryResolution(reader, state.range(1));
+
+    int64_t points = 0;
+    for (auto _ : state)
+        points += static_cast<int64_t>(reader.GetPointsWithinBox(box, resolution).Size());
+    state.SetItemsProcessed(points);
+}
+BENCHMARK(BM_GetPointsWithinBox)->ArgsProduct({{1, 10, 50, 100}, {0, 1, 2}})->Unit(benchmark::kMillisecond);
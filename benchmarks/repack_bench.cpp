@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <copc-lib/io/copc_reader.hpp>
+#include <copc-lib/io/copc_repack.hpp>
+#include <copc-lib/io/copc_writer.hpp>
+#include <copc-lib/io/internal/memory_stream.hpp>
+#include <copc-lib/io/io_stats.hpp>
+
+#include "bench_utils.hpp"
+
+using namespace copc;
+
+// Layouts of the repack benchmarks: 0 is the synthetic dataset with its nodes written in random order, 1 and 2 are
+// that file repacked in breadth-first and Hilbert order
+static const char *LayoutName(int64_t layout)
+{
+    switch (layout)
+    {
+    case 1:
+        return "breadth_first";
+    case 2:
+        return "hilbert";
+    default:
+        return "scattered";
+    }
+}
+
+// Writes the file of the given layout to disk once and returns its path
+static std::string LayoutPath(int64_t layout)
+{
+    static std::map<int64_t, std::string> paths;
+    auto &path = paths[layout];
+    if (!path.empty())
+        return path;
+
+    // Re-add the synthetic dataset's nodes in random order, with a page per depth 1 subtree
+    const auto &data = bench::SyntheticCopcData(4, 500);
+    Internal::MemoryIStream in_stream(data.data(), data.size());
+    Reader reader(&in_stream);
+    auto nodes = reader.GetAllNodes();
+    std::mt19937 rng(42);
+    std::shuffle(nodes.begin(), nodes.end(), rng);
+
+    std::stringstream scattered_stream;
+    {
+        Writer writer(scattered_stream, reader.CopcConfig());
+        for (const auto &node : nodes)
+        {
+            auto page_key = node.key.d == 0 ? VoxelKey::RootKey() : node.key.GetParentAtDepth(1);
+            writer.AddNodeCompressed(node.key, reader.GetPointDataCompressed(node), node.point_count, page_key);
+        }
+        writer.Close();
+    }
+
+    std::stringstream out_stream;
+    if (layout == 0)
+    {
+        out_stream << scattered_stream.rdbuf();
+    }
+    else
+    {
+        Reader scattered(&scattered_stream);
+        Writer writer(out_stream, scattered.CopcConfig());
+        RepackCopc(scattered, writer, layout == 1 ? RepackOrder::BreadthFirst : RepackOrder::Hilbert, 512);
+        writer.Close();
+    }
+
+    path = std::string("copc_bench_repack_") + LayoutName(layout) + ".copc.laz";
+    std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    auto out_data = out_stream.str();
+    file.write(out_data.data(), static_cast<std::streamsize>(out_data.size()));
+    return path;
+}
+
+// Opens a file of range(0)'s layout and reads the node data of a query box covering range(1)% of the dataset's extent
+// along X and Y, at range(2) levels of detail above the deepest level. Nodes are read in file order; read_runs counts
+// the contiguous byte ranges they form, that is the reads left once adjacent ones are coalesced, and span_bytes the
+// distance from the first to the end of the last.
+static void BM_RepackedQuery(benchmark::State &state)
+{
+    auto path = LayoutPath(state.range(0));
+    state.SetLabel(LayoutName(state.range(0)));
+    double half_size = bench::DATASET_SPAN * static_cast<double>(state.range(1)) / 200;
+    double center = bench::DATASET_SPAN / 2;
+    Box box(center - half_size, center - half_size, center + half_size, center + half_size);
+
+    int64_t bytes = 0;
+    uint64_t runs = 0, span = 0, pages = 0;
+    for (auto _ : state)
+    {
+        FileReader reader(path);
+        auto stats = std::make_shared<IOStats>();
+        reader.SetStats(stats);
+        double resolution = 0;
+        if (state.range(2) > 0)
+            resolution = reader.CopcConfig().CopcInfo().spacing / std::pow(2, reader.GetMaxDepth() - state.range(2));
+        auto nodes = reader.GetNodesIntersectBox(box, resolution);
+        std::sort(nodes.begin(), nodes.end(), [](const Node &a, const Node &b) { return a.offset < b.offset; });
+
+        runs = 0;
+        for (size_t i = 0; i < nodes.size(); i++)
+        {
+            if (i == 0 || nodes[i].offset != nodes[i - 1].offset + nodes[i - 1].byte_size)
+                runs++;
+            bytes += static_cast<int64_t>(reader.GetPointDataCompressed(nodes[i]).size());
+        }
+        span = nodes.empty() ? 0 : nodes.back().offset + nodes.back().byte_size - nodes.front().offset;
+        pages = stats->GetSnapshot().Get(IOStats::Counter::PagesLoaded);
+    }
+    state.counters["read_runs"] = static_cast<double>(runs);
+    state.counters["span_bytes"] = static_cast<double>(span);
+    state.counters["pages_loaded"] = static_cast<double>(pages);
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_RepackedQuery)->ArgsProduct({{0, 1, 2}, {10, 50}, {0, 2}})->Unit(benchmark::kMillisecond);
@@ -0,0 +1,111 @@
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <copc-lib/io/copc_writer.hpp>
+#include <copc-lib/laz/compressor.hpp>
+
+#include "bench_utils.hpp"
+
+using namespace copc;
+
+// Compresses a node's worth of points, for node sizes from 1k to 100k points
+static void BM_CompressBytes(benchmark::State &state)
+{
+    auto cfg = bench::SyntheticConfig();
+    std::mt19937 rng(42);
+    auto point_count = static_cast<int>(state.range(0));
+    auto point_data =
+        bench::RandomPoints(*cfg.LasHeader(), VoxelKey::RootKey(), point_count, rng).Pack(*cfg.LasHeader());
+
+    int64_t compressed_bytes = 0;
+    for (auto _ : state)
+    {
+        auto compressed = laz::Compressor::CompressBytes(point_data, *cfg.LasHeader());
+        compressed_bytes += static_cast<int64_t>(compressed.size());
+    }
+    state.SetItemsProcessed(state.iterations() * point_count);
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(point_data.size()));
+    state.counters["ratio"] =
+        static_cast<double>(state.iterations() * point_data.size()) / static_cast<double>(compressed_bytes);
+}
+BENCHMARK(BM_CompressBytes)->RangeMultiplier(10)->Range(1000, 100000)->Unit(benchmark::kMillisecond);
+
+// Nodes of a full octree down to the given depth
+static std::vector<VoxelKey> OctreeKeys(int max_depth)
+{
+    std::vector<VoxelKey> keys;
+    for (int d = 0; d <= max_depth; d++)
+    {
+        int32_t n = 1 << d;
+        for (int32_t x = 0; x < n; x++)
+            for (int32_t y = 0; y < n; y++)
+                for (int32_t z = 0; z < n; z++)
+                    keys.emplace_back(d, x, y, z);
+    }
+    return keys;
+}
+
+// Adds (compresses and writes) every node of a depth 2 octree
+static void BM_WriterAddNode(benchmark::State &state)
+{
+    auto cfg = bench::SyntheticConfig();
+    std::mt19937 rng(42);
+    auto keys = OctreeKeys(2);
+    std::vector<las::Points> node_points;
+    for (const auto &key : keys)
+        node_points.push_back(bench::RandomPoints(*cfg.LasHeader(), key, 2000, rng));
+
+    int64_t points = 0;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        std::stringstream out_stream;
+        auto writer = std::make_unique<Writer>(out_stream, cfg);
+        state.ResumeTiming();
+
+        for (size_t i = 0; i < keys.size(); i++)
+        {
+            writer->AddNode(keys[i], node_points[i]);
+            points += static_cast<int64_t>(node_points[i].Size());
+        }
+
+        state.PauseTiming();
+        writer.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(points);
+}
+BENCHMARK(BM_WriterAddNode)->Unit(benchmark::kMillisecond);
+
+// Closes a writer holding a hierarchy of the given depth, which writes the hierarchy and the header
+static void BM_WriterClose(benchmark::State &state)
+{
+    auto cfg = bench::SyntheticConfig();
+    std::mt19937 rng(42);
+    auto keys = OctreeKeys(static_cast<int>(state.range(0)));
+    auto points = bench::RandomPoints(*cfg.LasHeader(), VoxelKey::RootKey(), 10, rng);
+    auto point_data = points.Pack(*cfg.LasHeader());
+    auto compressed = laz::Compressor::CompressBytes(point_data, *cfg.LasHeader());
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        std::stringstream out_stream;
+        Writer writer(out_stream, cfg);
+        for (const auto &key : keys)
+        {
+            // Page the nodes by their depth 1 ancestor, to write several hierarchy pages
+            auto page_key = key.d == 0 ? VoxelKey::RootKey() : key.GetParentAtDepth(1);
+            writer.AddNodeCompressed(key, compressed, static_cast<int32_t>(points.Size()), page_key);
+        }
+        state.ResumeTiming();
+
+        writer.Close();
+    }
+    state.counters["nodes"] = static_cast<double>(keys.size());
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK(BM_WriterClose)->DenseRange(2, 6)->Unit(benchmark::kMillisecond);
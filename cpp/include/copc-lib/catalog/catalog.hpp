@@ -0,0 +1,115 @@
+#ifndef COPCLIB_CATALOG_CATALOG_H_
+#define COPCLIB_CATALOG_CATALOG_H_
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "copc-lib/catalog/internal/rtree.hpp"
+#include "copc-lib/geometry/box.hpp"
+#include "copc-lib/io/copc_reader.hpp"
+
+namespace copc
+{
+
+// Summary of a COPC file indexed by a Catalog
+class CatalogFile
+{
+  public:
+    CatalogFile() = default;
+    CatalogFile(const std::string &path, const CopcConfig &config);
+
+    std::string ToString() const;
+    friend std::ostream &operator<<(std::ostream &os, CatalogFile const &value)
+    {
+        os << value.ToString();
+        return os;
+    }
+
+    std::string path;
+    // Bounds of the points, from the LAS header
+    Box bounds;
+    // Octree cube, from the COPC Info VLR
+    Box cube;
+    double spacing{};
+    uint64_t point_count{};
+};
+
+// Keeps at most max_open_readers FileReaders open, closing the least recently used one when the cap is reached.
+// A reader handed out stays valid after being evicted, until the caller releases it.
+class ReaderPool
+{
+  public:
+    ReaderPool(size_t max_open_readers = 64);
+
+    // Returns an open reader for the file, opening it if needed
+    std::shared_ptr<FileReader> Get(const std::string &path);
+
+    size_t Size();
+    size_t MaxOpenReaders() const { return max_open_readers_; }
+    void Clear();
+
+  private:
+    size_t max_open_readers_;
+    std::mutex mutex_;
+    // Most recently used first
+    std::list<std::pair<std::string, std::shared_ptr<FileReader>>> readers_;
+    std::unordered_map<std::string, decltype(readers_)::iterator> reader_map_;
+};
+
+// Collection of COPC files with a spatial index over their bounds, answering queries across all files.
+// Queries fan out to the relevant files in parallel, with at most num_threads files being read at once.
+// A Catalog shouldn't be queried from several threads at the same time.
+class Catalog
+{
+  public:
+    static const uint32_t VERSION = 1;
+
+    // num_threads = 0 uses the number of hardware threads
+    Catalog(size_t max_open_readers = 64, unsigned int num_threads = 0);
+
+    // Indexes the files, opening them in parallel. Files already in the catalog are skipped.
+    void AddFiles(const std::vector<std::string> &paths);
+    void AddFile(const std::string &path) { AddFiles({path}); }
+
+    std::vector<CatalogFile> Files() const { return files_; }
+    size_t Size() const { return files_.size(); }
+
+    // File level spatial queries, only using the index
+    std::vector<CatalogFile> GetFilesIntersectBox(const Box &box);
+    std::vector<CatalogFile> GetFilesWithinBox(const Box &box);
+
+    // Node and point queries across files, keyed by file path. Files without results are omitted.
+    std::map<std::string, std::vector<Node>> GetNodesIntersectBox(const Box &box, double resolution = 0);
+    std::map<std::string, std::vector<Node>> GetNodesWithinBox(const Box &box, double resolution = 0);
+    std::map<std::string, std::vector<Node>> GetNodesWithinResolution(double resolution);
+    std::map<std::string, las::Points> GetPointsWithinBox(const Box &box, double resolution = 0);
+
+    // Writes the file summaries to disk, so that a catalog can be rebuilt without opening every file
+    void Save(const std::string &path) const;
+    // Adds the file summaries stored by Save to this catalog, without opening the files
+    void Load(const std::string &path);
+
+    ReaderPool &Readers() { return reader_pool_; }
+
+  private:
+    std::vector<CatalogFile> files_;
+    std::unordered_map<std::string, size_t> file_ids_;
+    Internal::RTree index_;
+    bool index_dirty_{false};
+    unsigned int num_threads_;
+    ReaderPool reader_pool_;
+
+    void AddFileSummary(const CatalogFile &file);
+    const Internal::RTree &Index();
+
+    template <typename Result, typename Query>
+    std::map<std::string, Result> FanOut(const std::vector<size_t> &file_ids, Query query);
+};
+
+} // namespace copc
+#endif // COPCLIB_CATALOG_CATALOG_H_
@@ -0,0 +1,46 @@
+#ifndef COPCLIB_CATALOG_RTREE_H_
+#define COPCLIB_CATALOG_RTREE_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "copc-lib/geometry/box.hpp"
+
+namespace copc::Internal
+{
+// Static 3D R-tree, bulk loaded with the Sort-Tile-Recursive algorithm.
+// Items are identified by their index in the vector of boxes the tree was built from.
+class RTree
+{
+  public:
+    static const size_t NODE_CAPACITY = 16;
+
+    RTree() = default;
+    RTree(const std::vector<Box> &boxes);
+
+    // Returns the indices of all items whose box intersects the query box, in ascending order
+    std::vector<size_t> Intersects(const Box &box) const;
+    // Returns the indices of all items whose box is within the query box, in ascending order
+    std::vector<size_t> Within(const Box &box) const;
+
+    size_t Size() const { return boxes_.size(); }
+
+  private:
+    struct TreeNode
+    {
+        Box bounds;
+        bool leaf;
+        // Item indices if the node is a leaf, otherwise indices into nodes_
+        std::vector<size_t> children;
+    };
+
+    std::vector<Box> boxes_;
+    std::vector<TreeNode> nodes_;
+    size_t root_{};
+
+    template <typename Predicate> std::vector<size_t> Query(const Box &box, Predicate item_matches) const;
+};
+
+} // namespace copc::Internal
+
+#endif // COPCLIB_CATALOG_RTREE_H_
@@ -1,6 +1,7 @@
 #ifndef COPCLIB_HIERARCHY_ENTRY_H_
 #define COPCLIB_HIERARCHY_ENTRY_H_
 
+#include <cstring>
 #include <ostream>
 #include <vector>
 
@@ -36,16 +37,24 @@ class Entry
         return os;
     }
 
-    void Pack(std::ostream &out_stream)
+    void Pack(std::ostream &out_stream) const
     {
-        out_stream.write(reinterpret_cast<char *>(&key.d), sizeof(key.d));
-        out_stream.write(reinterpret_cast<char *>(&key.x), sizeof(key.x));
-        out_stream.write(reinterpret_cast<char *>(&key.y), sizeof(key.y));
-        out_stream.write(reinterpret_cast<char *>(&key.z), sizeof(key.z));
-
-        out_stream.write(reinterpret_cast<char *>(&offset), sizeof(offset));
-        out_stream.write(reinterpret_cast<char *>(&byte_size), sizeof(byte_size));
-        out_stream.write(reinterpret_cast<char *>(&point_count), sizeof(point_count));
+        char data[ENTRY_SIZE];
+        Pack(data);
+        out_stream.write(data, ENTRY_SIZE);
+    }
+
+    // Packs the entry into the ENTRY_SIZE bytes at out
+    void Pack(char *out) const
+    {
+        std::memcpy(out, &key.d, sizeof(key.d));
+        std::memcpy(out + 4, &key.x, sizeof(key.x));
+        std::memcpy(out + 8, &key.y, sizeof(key.y));
+        std::memcpy(out + 12, &key.z, sizeof(key.z));
+
+        std::memcpy(out + 16, &offset, sizeof(offset));
+        std::memcpy(out + 24, &byte_size, sizeof(byte_size));
+        std::memcpy(out + 28, &point_count, sizeof(point_count));
     }
 
     static Entry Unpack(std::istream &in_stream)
@@ -0,0 +1,51 @@
+#ifndef COPCLIB_HIERARCHY_HIERARCHY_CACHE_H_
+#define COPCLIB_HIERARCHY_HIERARCHY_CACHE_H_
+
+#include <memory>
+#include <string>
+
+#include "copc-lib/copc/info.hpp"
+#include "copc-lib/hierarchy/internal/hierarchy.hpp"
+
+namespace copc::Internal
+{
+// Identifies the exact version of a COPC file a hierarchy cache was built from
+struct HierarchyCacheIdentity
+{
+    uint64_t file_size{};
+    int64_t modified_time{};
+    uint64_t root_hier_offset{};
+    uint64_t root_hier_size{};
+
+    bool operator==(const HierarchyCacheIdentity &rhs) const
+    {
+        return file_size == rhs.file_size && modified_time == rhs.modified_time &&
+               root_hier_offset == rhs.root_hier_offset && root_hier_size == rhs.root_hier_size;
+    }
+};
+
+// Sidecar file holding a fully loaded hierarchy, so that it doesn't have to be read and parsed again on reopen.
+// The file is a fixed 64 byte header followed by a flat table of fixed size records (one per page and node,
+// pages always before their children), all in native byte order so that it can be memory mapped.
+class HierarchyCache
+{
+  public:
+    static const int HEADER_SIZE = 64;
+    // An Entry followed by the key of the page it belongs to
+    static const int RECORD_SIZE = Entry::ENTRY_SIZE + 16;
+    static const uint32_t VERSION = 1;
+
+    // Returns the identity of the COPC file at file_path, throws if the file can't be accessed
+    static HierarchyCacheIdentity Identify(const std::string &file_path, const CopcInfo &copc_info);
+
+    // Returns the hierarchy stored in the cache, or nullptr if it is missing, invalid or doesn't match the identity
+    static std::shared_ptr<Hierarchy> Read(const std::string &cache_path, const HierarchyCacheIdentity &identity);
+
+    // Writes a fully loaded hierarchy to the cache, returns false if it couldn't be written
+    static bool Write(const std::string &cache_path, const HierarchyCacheIdentity &identity,
+                      const Hierarchy &hierarchy);
+};
+
+} // namespace copc::Internal
+
+#endif // COPCLIB_HIERARCHY_HIERARCHY_CACHE_H_
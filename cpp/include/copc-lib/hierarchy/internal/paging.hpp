@@ -0,0 +1,22 @@
+#ifndef COPCLIB_HIERARCHY_PAGING_H_
+#define COPCLIB_HIERARCHY_PAGING_H_
+
+#include <unordered_map>
+#include <vector>
+
+#include "copc-lib/hierarchy/key.hpp"
+
+namespace copc::Internal
+{
+// Returns the page key of each node key, so that pages hold whole subtrees of up to roughly max_page_nodes nodes.
+// A key roots a page when its subtree fits within max_page_nodes but its parent's doesn't, and isn't too small to be
+// worth a page of its own. Nodes of larger subtrees stay in their ancestors' page, down to the root page. All nodes
+// are in the root page if max_page_nodes is 0.
+std::unordered_map<VoxelKey, VoxelKey> AssignPages(const std::vector<VoxelKey> &keys, size_t max_page_nodes);
+
+// Returns the page key of each node key, with pages rooted at every depth_step levels: a node is in the page of its
+// ancestor at the closest multiple of depth_step at or above its depth.
+std::unordered_map<VoxelKey, VoxelKey> AssignPagesByDepth(const std::vector<VoxelKey> &keys, int32_t depth_step);
+
+} // namespace copc::Internal
+#endif // COPCLIB_HIERARCHY_PAGING_H_
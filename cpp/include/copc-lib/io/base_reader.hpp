@@ -6,10 +6,14 @@
 #include <istream>
 #include <limits>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include "copc-lib/copc/copc_config.hpp"
 #include "copc-lib/hierarchy/key.hpp"
+#include "copc-lib/io/io_stats.hpp"
 #include "copc-lib/las/points.hpp"
 #include "copc-lib/las/vlr.hpp"
 
@@ -20,20 +24,44 @@ class BaseReader
   public:
     BaseReader(std::istream *in_stream) : in_stream_(in_stream) { InitReader(); }
 
+    // Statistics are only collected while a stats object is set, which should be done before reading
+    void SetStats(const std::shared_ptr<IOStats> &stats) { stats_ = stats; }
+    std::shared_ptr<IOStats> Stats() const { return stats_; }
+
   protected:
+    // The LAS header and VLRs are read in one go, assuming they fit in this many bytes
+    static const uint64_t HEADER_READ_SIZE_BYTES = 16384;
+    // The EVLR block is read in one go if it's smaller than this, otherwise EVLRs are read as needed
+    static const uint64_t MAX_EVLR_READ_SIZE_BYTES = 1048576;
+
     BaseReader() = default;
 
     las::LazConfig las_config_;
     std::map<uint64_t, las::VlrHeader> vlrs_; // maps from absolute offsets to VLR entries
 
     std::istream *in_stream_;
+    // Guards in_stream_, which may be read from a background thread when prefetching
+    std::mutex stream_mutex_;
+
+    // Bytes [0, point_offset) of the file, holding the LAS header and all VLRs
+    std::vector<char> vlr_block_;
+    // Bytes [evlr_offset, EOF) of the file, if they were small enough to be read at once
+    std::vector<char> evlr_block_;
+    uint64_t evlr_block_offset_{};
+    // Size of the LAS header as given by the file, where the VLRs start
+    uint64_t header_size_{las::LasHeader::HEADER_SIZE_BYTES};
 
-    std::unique_ptr<lazperf::reader::generic_file> reader_;
+    std::shared_ptr<IOStats> stats_;
 
     // Constructor helper function, initializes the file and hierarchy
     void InitReader();
     // Reads file VLRs and EVLRs into vlrs_
-    std::map<uint64_t, las::VlrHeader> ReadVlrHeaders(); // TODO: Allow user to create/reader arbitrary VLRs
+    // TODO: Allow user to create/reader arbitrary VLRs
+    std::map<uint64_t, las::VlrHeader> ReadVlrHeaders(const las::LasHeader &header);
+    // Returns the bytes at the given absolute offset, from the blocks read at initialization when possible
+    std::vector<char> ReadBytes(uint64_t offset, uint64_t size);
+    // Returns the payload of the VLR or EVLR whose header is at the given absolute offset
+    std::vector<char> ReadVlrData(uint64_t offset);
     // Fetchs the map key for a query vlr user and record IDs
     static uint64_t FetchVlr(const std::map<uint64_t, las::VlrHeader> &vlrs, const std::string &user_id,
                              uint16_t record_id);
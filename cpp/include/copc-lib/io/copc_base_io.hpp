@@ -1,6 +1,8 @@
 #ifndef COPCLIB_IO_COPC_BASE_IO_H_
 #define COPCLIB_IO_COPC_BASE_IO_H_
 
+#include <mutex>
+
 #include "copc-lib/copc/copc_config.hpp"
 #include "copc-lib/copc/info.hpp"
 #include "copc-lib/hierarchy/node.hpp"
@@ -26,6 +28,9 @@ class BaseIO
 
   protected:
     std::shared_ptr<Internal::Hierarchy> hierarchy_;
+    // Guards lazy loading of the hierarchy, so that nodes can be looked up from several threads.
+    // Recursive because FindNode and LoadPageHierarchy call themselves
+    std::recursive_mutex hierarchy_mutex_;
     virtual std::vector<Entry> ReadPage(std::shared_ptr<Internal::PageInternal> page) = 0;
     void ReadAndParsePage(const std::shared_ptr<Internal::PageInternal> &page);
     // Recursively reads all subpages and nodes given a root and returns all the nodes that were loaded
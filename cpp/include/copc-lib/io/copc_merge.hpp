@@ -0,0 +1,49 @@
+#ifndef COPCLIB_IO_COPC_MERGE_H_
+#define COPCLIB_IO_COPC_MERGE_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "copc-lib/io/copc_reader.hpp"
+#include "copc-lib/io/copc_writer.hpp"
+
+namespace copc
+{
+
+struct MergeResult
+{
+    // Nodes found in a single input, copied without decompressing them
+    uint64_t nodes_copied{0};
+    // Nodes found in several inputs, decompressed, merged and compressed again
+    uint64_t nodes_merged{0};
+    // Nodes without points kept as the parents of written nodes
+    uint64_t nodes_empty{0};
+    uint64_t point_count{0};
+    // Points left out of merged nodes by subsampling, 0 unless it was requested
+    uint64_t points_dropped{0};
+
+    std::string ToString() const;
+};
+
+// Merges the nodes of several COPC files into the writer. The inputs must share their octree, that is the minimum
+// and span of their header bounds, and have the point format, scale and offset of the writer, such as one created from
+// the CopcConfig of the first reader.
+//
+// A key found in a single input has its compressed data copied verbatim. Keys found in several inputs are decoded,
+// concatenated and re-encoded, from up to num_threads threads (0 meaning the number of hardware threads), by bounded
+// batches. By default no point is lost. Subsampling is an opt-in, lossy reduction: if subsample is set, a merged node
+// that has children keeps at most as many points as the largest of its inputs, evenly picked across them, so that
+// coarse levels don't grow with the number of inputs, and the points left out are dropped. Leaves keep all their
+// points.
+//
+// Nodes without points in every input are kept if they have written descendants, so that the octree has no holes.
+// Nodes are written breadth-first, and paged by subtrees of up to roughly max_page_nodes nodes (a single page if 0),
+// which replaces the writer's paging policy.
+// The header's bounds and GPS time range are the union of the inputs'. Its points_by_return are the sum of the inputs',
+// less the returns of the dropped points.
+MergeResult MergeCopc(const std::vector<Reader *> &readers, Writer &writer, bool subsample = false,
+                      size_t max_page_nodes = 4096, unsigned int num_threads = 0);
+
+} // namespace copc
+#endif // COPCLIB_IO_COPC_MERGE_H_
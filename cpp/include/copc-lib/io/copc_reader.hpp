@@ -1,17 +1,26 @@
 #ifndef COPCLIB_IO_COPC_READER_H_
 #define COPCLIB_IO_COPC_READER_H_
 
+#include <atomic>
+#include <future>
 #include <istream>
 #include <limits>
 #include <map>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "copc-lib/copc/copc_config.hpp"
 #include "copc-lib/hierarchy/key.hpp"
 #include "copc-lib/io/base_reader.hpp"
 #include "copc-lib/io/copc_base_io.hpp"
+#include "copc-lib/las/dimension_stats.hpp"
+#include "copc-lib/las/point_array.hpp"
 #include "copc-lib/las/points.hpp"
 #include "copc-lib/las/vlr.hpp"
+#include "copc-lib/utils/arena.hpp"
 
 namespace copc
 {
@@ -20,23 +29,48 @@ namespace Internal
 class PageInternal;
 } // namespace Internal
 
+// Reading points and querying the hierarchy are safe to do from several threads at once with the same reader
 class Reader : public BaseIO, public BaseReader
 {
   public:
+    // Prefetched data held in memory at most by default
+    static const uint64_t DEFAULT_MAX_PREFETCH_BYTES = 256 * 1024 * 1024;
+
     Reader(std::istream *in_stream) : BaseReader(in_stream) { InitCopcReader(); }
+    ~Reader() { WaitForPrefetch(); }
 
     // Reads the node's data into an uncompressed byte array
     // Node needs to be valid for this function, it will error
     std::vector<char> GetPointData(Node const &node);
     // VoxelKey can be invalid, function will return empty arr
     std::vector<char> GetPointData(VoxelKey const &key);
-    // Reads the node's data into Point objects
+    // Reads the node's data into Point objects. The compressed and uncompressed buffers are allocated from an arena
+    // of the calling thread, which is released once the points are created.
     las::Points GetPoints(Node const &node);
     las::Points GetPoints(VoxelKey const &key);
+    // Allocates the Point objects from the arena too, so they must not be used after it is released
+    las::Points GetPoints(Node const &node, Arena &arena);
+    // Reads the node's data into columns of the requested dimensions (all of them if empty), without creating Point
+    // objects
+    las::PointArray GetPointsArray(Node const &node, const std::vector<std::string> &dimensions = {});
+    las::PointArray GetPointsArray(VoxelKey const &key, const std::vector<std::string> &dimensions = {});
     // Reads node data without decompressing
     std::vector<char> GetPointDataCompressed(Node const &node);
     std::vector<char> GetPointDataCompressed(VoxelKey const &key);
 
+    // Hints that the nodes will be read soon, so that their data is fetched ahead of time and later reads of them
+    // don't block on I/O. Nodes are read in the background into a cache that is emptied as the nodes get read.
+    virtual void Prefetch(const std::vector<Node> &nodes);
+    // Blocks until the background prefetches, if any, are done
+    void WaitForPrefetch();
+    // Number of bytes of node data prefetched so far
+    uint64_t PrefetchedBytes() const { return prefetched_bytes_; }
+    // Number of node reads that were served by a prefetch
+    uint64_t PrefetchesUsed() const { return prefetches_used_; }
+    // Bounds the prefetched data held in memory: nodes that don't fit aren't prefetched, and are read when needed
+    void SetMaxPrefetchBytes(uint64_t max_bytes) { max_prefetch_bytes_ = max_bytes; }
+    uint64_t GetMaxPrefetchBytes() const { return max_prefetch_bytes_; }
+
     // Return all children of a page with a given key
     // (or the node itself, if it exists, if there isn't a page with that key)
     std::vector<Node> GetAllChildrenOfPage(const VoxelKey &key);
@@ -65,22 +99,56 @@ class Reader : public BaseIO, public BaseReader
     las::Points GetPointsWithinBox(const Box &box, double resolution = 0);
     bool ValidateSpatialBounds(bool verbose = false);
     copc::CopcConfig CopcConfig() { return config_; }
+    // Statistics of the file's dimensions, if the writer stored them, read when the file is opened
+    std::optional<las::DimensionStats> GetDimensionStats() const { return dimension_stats_; }
 
   protected:
     Reader() = default;
     void InitCopcReader();
     copc::CopcConfig config_;
+    std::optional<las::DimensionStats> dimension_stats_;
 
     // Finds and loads the COPC vlr
     CopcInfo ReadCopcInfoVlr(std::map<uint64_t, las::VlrHeader> &vlrs);
 
     std::vector<Entry> ReadPage(std::shared_ptr<Internal::PageInternal> page) override;
+
+    // Compressed data of prefetched nodes, and keys of nodes that were prefetched without being cached here
+    std::unordered_map<VoxelKey, std::vector<char>> prefetch_cache_;
+    std::unordered_set<VoxelKey> prefetch_hinted_;
+    // Keys of nodes queued for a background prefetch that nobody has read yet
+    std::unordered_set<VoxelKey> prefetch_pending_;
+    std::mutex prefetch_mutex_;
+    // Size of the data in prefetch_cache_, guarded by prefetch_mutex_
+    uint64_t prefetch_cache_bytes_{0};
+    std::atomic<uint64_t> max_prefetch_bytes_{DEFAULT_MAX_PREFETCH_BYTES};
+    // Last queued background prefetch, which waits for the previous ones
+    std::mutex prefetch_task_mutex_;
+    std::shared_future<void> prefetch_task_;
+    std::atomic<uint64_t> prefetched_bytes_{0};
+    std::atomic<uint64_t> prefetches_used_{0};
+
+    // Reads the node's compressed data, from the prefetch cache if possible
+    std::vector<char> ReadNodeData(const Node &node);
+    // Moves the node's compressed data out of the prefetch cache, returns false if it isn't cached
+    bool TakePrefetchedNodeData(const Node &node, std::vector<char> &data);
+    // Reads the node's compressed data from the stream into out, which must hold node.byte_size bytes
+    void ReadNodeDataFromStream(const Node &node, char *out);
+    // Decompresses the node's data into the arena and returns it
+    const char *DecompressNodeData(const Node &node, Arena &arena);
+    // Stats helpers, which do nothing if no stats object is set
+    void RecordNodeRead(const Node &node);
+    void RecordQuery(size_t node_count);
+    // Body of the background prefetch, reads the nodes that are still pending into the cache
+    void ReadPrefetchedNodes(const std::vector<Node> &nodes);
 };
 
 class FileReader : public Reader
 {
   public:
-    FileReader(const std::string &file_path) : is_open_(true)
+    // If a hierarchy_cache_path is given, the hierarchy is loaded from that sidecar file when it matches the COPC
+    // file, otherwise the whole hierarchy is loaded from the COPC file and the sidecar is (re)written
+    FileReader(const std::string &file_path, const std::string &hierarchy_cache_path = "") : is_open_(true)
     {
         auto f_stream = new std::fstream;
         this->file_path_ = file_path;
@@ -91,12 +159,16 @@ class FileReader : public Reader
 
         InitReader();
         InitCopcReader();
+        if (!hierarchy_cache_path.empty())
+            LoadHierarchyCache(hierarchy_cache_path);
     }
 
     void Close()
     {
         if (is_open_)
         {
+            WaitForPrefetch();
+            ClosePrefetchHandle();
             dynamic_cast<std::fstream *>(in_stream_)->close();
             delete in_stream_;
             is_open_ = false;
@@ -104,12 +176,24 @@ class FileReader : public Reader
     }
 
     std::string FilePath() { return file_path_; }
+    // Whether the hierarchy was loaded from the sidecar cache when opening the file
+    bool HierarchyCacheHit() const { return hierarchy_cache_hit_; }
+
+    // Where the OS supports it, asks it to read the nodes into the page cache with posix_fadvise rather than
+    // keeping a copy of their data in the reader
+    void Prefetch(const std::vector<Node> &nodes) override;
 
     ~FileReader() { Close(); }
 
   private:
     bool is_open_;
     std::string file_path_;
+    bool hierarchy_cache_hit_{false};
+    // Separate file descriptor used to give read-ahead hints to the OS
+    int prefetch_fd_{-1};
+
+    void LoadHierarchyCache(const std::string &hierarchy_cache_path);
+    void ClosePrefetchHandle();
 };
 
 } // namespace copc
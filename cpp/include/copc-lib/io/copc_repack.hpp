@@ -0,0 +1,51 @@
+#ifndef COPCLIB_IO_COPC_REPACK_H_
+#define COPCLIB_IO_COPC_REPACK_H_
+
+#include <cstdint>
+#include <string>
+
+#include "copc-lib/hierarchy/key.hpp"
+#include "copc-lib/io/copc_reader.hpp"
+#include "copc-lib/io/copc_writer.hpp"
+
+namespace copc
+{
+
+// Order in which a repacked file lays out its nodes
+enum class RepackOrder
+{
+    // By depth, then by key: each level of detail is contiguous, for streaming coarse to fine
+    BreadthFirst,
+    // By depth, then along a Hilbert curve within each depth: nodes close in space are close in the file, for spatial
+    // queries
+    Hilbert
+};
+
+struct RepackResult
+{
+    uint64_t node_count{0};
+    // Nodes without points kept as the parents of written nodes
+    uint64_t empty_node_count{0};
+    uint64_t point_count{0};
+    uint64_t page_count{0};
+
+    std::string ToString() const;
+};
+
+// Rewrites every node of the reader into the writer in the given order, copying their compressed data without
+// decoding it, with a hierarchy regenerated by subtrees of up to roughly max_page_nodes nodes (a single page if 0),
+// which replaces the writer's paging policy. Nodes are read ahead in the background while they are written.
+//
+// Nodes without points are kept if they have descendants with points, so that the octree has no holes, and dropped
+// otherwise.
+// The writer must have been created from the reader's CopcConfig, since nodes keep their point format, scale, offset
+// and octree. The header keeps the reader's bounds and points_by_return.
+RepackResult RepackCopc(Reader &reader, Writer &writer, RepackOrder order = RepackOrder::Hilbert,
+                        size_t max_page_nodes = 4096);
+
+// Position of the key's voxel along a 3D Hilbert curve over the voxels of its depth. Depths beyond 21 are ordered
+// by their depth 21 ancestor.
+uint64_t HilbertIndex(const VoxelKey &key);
+
+} // namespace copc
+#endif // COPCLIB_IO_COPC_REPACK_H_
@@ -0,0 +1,45 @@
+#ifndef COPCLIB_IO_COPC_SUBSET_H_
+#define COPCLIB_IO_COPC_SUBSET_H_
+
+#include <cstdint>
+#include <string>
+
+#include "copc-lib/geometry/box.hpp"
+#include "copc-lib/io/copc_reader.hpp"
+#include "copc-lib/io/copc_writer.hpp"
+
+namespace copc
+{
+
+struct SubsetResult
+{
+    // Nodes fully within the box, copied without decompressing them
+    uint64_t nodes_copied{0};
+    // Nodes crossing the box, decompressed, filtered and compressed again
+    uint64_t nodes_filtered{0};
+    // Nodes without points kept as the parents of written nodes
+    uint64_t nodes_empty{0};
+    uint64_t point_count{0};
+    // Bounds of the written points: exact for the filtered nodes, and the node cubes within the file's bounds for the
+    // copied ones, which aren't decoded. Left at 0 if no point is written.
+    Vector3 min;
+    Vector3 max;
+
+    std::string ToString() const;
+};
+
+// Copies the points of the reader that are within the box, down to the depth of the given resolution (all depths if
+// 0), into the writer. Nodes fully within the box have their compressed data copied verbatim, only the nodes crossing
+// the box are decoded, filtered and re-encoded, from up to num_threads threads (0 meaning the number of hardware
+// threads). Nodes keep their key and page. Nodes left without points are kept as empty nodes when they are the
+// parents of written nodes, so that the hierarchy stays connected.
+//
+// The writer must have been created from the reader's CopcConfig, since copied nodes keep their point format, scale,
+// offset and octree. The header's point count follows the written points and its points_by_return are cleared, since
+// they aren't known without decompressing every node. The header's min and max define the cubes of the node keys, so
+// they are kept, and the bounds of the subset are returned in the result.
+SubsetResult ExtractSubset(Reader &reader, Writer &writer, const Box &box, double resolution = 0,
+                           unsigned int num_threads = 0);
+
+} // namespace copc
+#endif // COPCLIB_IO_COPC_SUBSET_H_
@@ -2,16 +2,22 @@
 #define COPCLIB_IO_COPC_WRITER_H_
 
 #include <array>
+#include <memory>
 #include <optional>
 #include <ostream>
 #include <stdexcept>
 #include <string>
+#include <utility>
 
 #include "copc-lib/copc/copc_config.hpp"
 #include "copc-lib/geometry/box.hpp"
 #include "copc-lib/io/copc_base_io.hpp"
 #include "copc-lib/io/laz_base_writer.hpp"
+#include "copc-lib/io/output_sink.hpp"
+#include "copc-lib/las/dimension_stats.hpp"
 #include "copc-lib/las/header.hpp"
+#include "copc-lib/las/header_stats.hpp"
+#include "copc-lib/las/point_order.hpp"
 #include "copc-lib/las/points.hpp"
 #include "copc-lib/las/utils.hpp"
 
@@ -22,6 +28,18 @@ namespace Internal
 class WriterInternal;
 }
 
+// Automatic paging of the hierarchy, applied when the file is closed to the nodes that are still in the root page.
+// It is off by default. Nodes added to or moved to another page keep it, and nodes that would be paged into a page
+// that already exists, such as one created by AddNode or ChangeNodePage, stay in the root page rather than being mixed
+// into it.
+struct PagingPolicy
+{
+    // Pages hold whole subtrees of up to roughly this many nodes, 0 to keep every node in the root page
+    size_t max_page_nodes{0};
+    // If above 0, pages are instead rooted at every depth_step levels, e.g. 3 for pages at depths 0, 3, 6...
+    int32_t depth_step{0};
+};
+
 // Provides the public interface for writing COPC files
 class Writer : public BaseIO
 {
@@ -31,7 +49,16 @@ class Writer : public BaseIO
            const std::optional<Vector3> &offset = {}, const std::optional<std::string> &wkt = {},
            const std::optional<las::EbVlr> &extra_bytes_vlr = {}, const std::optional<bool> &has_extended_stats = {})
     {
-        InitWriter(out_stream, copc_config_writer, point_format_id, scale, offset, wkt, extra_bytes_vlr,
+        InitWriter(std::make_shared<StreamSink>(out_stream), copc_config_writer, point_format_id, scale, offset, wkt,
+                   extra_bytes_vlr, has_extended_stats);
+    }
+    // Writes to a custom destination, such as a MemorySink or a FileSink with direct I/O
+    Writer(std::shared_ptr<OutputSink> sink, const CopcConfigWriter &copc_config_writer,
+           const std::optional<int8_t> &point_format_id = {}, const std::optional<Vector3> &scale = {},
+           const std::optional<Vector3> &offset = {}, const std::optional<std::string> &wkt = {},
+           const std::optional<las::EbVlr> &extra_bytes_vlr = {}, const std::optional<bool> &has_extended_stats = {})
+    {
+        InitWriter(std::move(sink), copc_config_writer, point_format_id, scale, offset, wkt, extra_bytes_vlr,
                    has_extended_stats);
     }
 
@@ -44,9 +71,46 @@ class Writer : public BaseIO
                            const VoxelKey &page_key = VoxelKey::RootKey());
     Node AddNode(const VoxelKey &key, std::vector<char> const &uncompressed_data,
                  const VoxelKey &page_key = VoxelKey::RootKey());
+    // Sorts the given data in place if a point order is set, rather than a copy of it
+    Node AddNode(const VoxelKey &key, std::vector<char> &&uncompressed_data,
+                 const VoxelKey &page_key = VoxelKey::RootKey());
+    // Adds a node without points or data, such as the parent of nodes whose own points were all filtered out, so
+    // that the hierarchy stays connected
+    Node AddEmptyNode(const VoxelKey &key, const VoxelKey &page_key = VoxelKey::RootKey());
 
     void ChangeNodePage(const VoxelKey &node_key, const VoxelKey &new_page_key);
 
+    // Sets how Close() pages the nodes left in the root page, which it doesn't by default
+    void SetPagingPolicy(const PagingPolicy &paging_policy);
+    PagingPolicy GetPagingPolicy() const;
+
+    // Sets the order the points of uncompressed nodes are sorted in before they are compressed, unchanged by default.
+    // Points close in space or in time compress better and faster, and Morton order keeps the points of a region of
+    // the node together for filtering. Compressed nodes are written as given.
+    void SetPointOrder(las::PointOrder point_order);
+    las::PointOrder GetPointOrder() const;
+
+    // Statistics are only collected while a stats object is set
+    void SetStats(const std::shared_ptr<IOStats> &stats);
+    std::shared_ptr<IOStats> Stats() const;
+
+    // While enabled, the points of uncompressed nodes are summarized and Close() sets the header's points by return,
+    // and the COPC info's GPS time range, from them. The header's bounds are kept, since they define the octree cube
+    // of the node keys: the bounds of the points are available from GetHeaderStats. Compressed nodes aren't decoded:
+    // the statistics of their points can be merged with AddHeaderStats.
+    void SetAccumulateHeaderStats(bool accumulate);
+    bool GetAccumulateHeaderStats() const;
+    las::HeaderStats GetHeaderStats() const;
+    void AddHeaderStats(const las::HeaderStats &header_stats);
+
+    // While enabled, the points of uncompressed nodes are summarized by dimension, and Close() writes the statistics
+    // in an EVLR that Reader::GetDimensionStats returns. The statistics of compressed nodes can be merged with
+    // AddDimensionStats.
+    void SetAccumulateDimensionStats(bool accumulate);
+    bool GetAccumulateDimensionStats() const;
+    las::DimensionStats GetDimensionStats() const;
+    void AddDimensionStats(const las::DimensionStats &dimension_stats);
+
     std::shared_ptr<CopcConfigWriter> CopcConfig() { return config_; }
 
     ~Writer() { Close(); }
@@ -62,13 +126,15 @@ class Writer : public BaseIO
 
     Node DoAddNode(const VoxelKey &key, const std::vector<char> &in, int32_t point_count, bool compressed_data,
                    const VoxelKey &page_key);
+    // Checks that uncompressed data is a whole, non-zero number of point records
+    void CheckPointData(const std::vector<char> &uncompressed_data) const;
     std::vector<Entry> ReadPage(std::shared_ptr<Internal::PageInternal> page) override
     {
         throw std::runtime_error("No pages should be unloaded!");
     };
 
     // Constructor helper function, initializes the file and hierarchy
-    void InitWriter(std::ostream &out_stream, const CopcConfigWriter &copc_file_writer,
+    void InitWriter(std::shared_ptr<OutputSink> sink, const CopcConfigWriter &copc_file_writer,
                     const std::optional<int8_t> &point_format_id, const std::optional<Vector3> &scale,
                     const std::optional<Vector3> &offset, const std::optional<std::string> &wkt,
                     const std::optional<las::EbVlr> &extra_bytes_vlr, const std::optional<bool> &has_extended_stats);
@@ -81,10 +147,11 @@ class FileWriter : public Writer, laz::BaseFileWriter
                const std::optional<int8_t> &point_format_id = {}, const std::optional<Vector3> &scale = {},
                const std::optional<Vector3> &offset = {}, const std::optional<std::string> &wkt = {},
                const std::optional<las::EbVlr> &extra_bytes_vlr = {},
-               const std::optional<bool> &has_extended_stats = {})
-        : BaseFileWriter(file_path)
+               const std::optional<bool> &has_extended_stats = {},
+               const FileSinkOptions &sink_options = {})
+        : BaseFileWriter(file_path, sink_options)
     {
-        InitWriter(f_stream_, copc_config_writer, point_format_id, scale, offset, wkt, extra_bytes_vlr,
+        InitWriter(file_sink_, copc_config_writer, point_format_id, scale, offset, wkt, extra_bytes_vlr,
                    has_extended_stats);
     }
 
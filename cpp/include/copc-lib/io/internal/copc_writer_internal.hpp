@@ -1,12 +1,18 @@
 #ifndef COPCLIB_IO_COPC_WRITER_INTERNAL_H_
 #define COPCLIB_IO_COPC_WRITER_INTERNAL_H_
 
-#include <ostream>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #include "copc-lib/copc/copc_config.hpp"
 #include "copc-lib/io/copc_base_io.hpp"
+#include "copc-lib/io/copc_writer.hpp"
 #include "copc-lib/io/laz_base_writer.hpp"
+#include "copc-lib/las/dimension_stats.hpp"
 #include "copc-lib/las/header.hpp"
+#include "copc-lib/las/point_order.hpp"
 
 namespace copc::Internal
 {
@@ -14,7 +20,7 @@ namespace copc::Internal
 class WriterInternal : laz::BaseWriter
 {
   public:
-    WriterInternal(std::ostream &out_stream, const std::shared_ptr<CopcConfigWriter> &copc_config,
+    WriterInternal(std::shared_ptr<OutputSink> sink, const std::shared_ptr<CopcConfigWriter> &copc_config,
                    std::shared_ptr<Hierarchy> hierarchy);
 
     // Writes the header and COPC vlrs
@@ -22,11 +28,38 @@ class WriterInternal : laz::BaseWriter
     // Call close on destructor if needed
     ~WriterInternal() { Close(); }
 
+    using laz::BaseWriter::SetStats;
+    using laz::BaseWriter::Stats;
+
+    using laz::BaseWriter::AddHeaderStats;
+    using laz::BaseWriter::GetAccumulateHeaderStats;
+    using laz::BaseWriter::GetHeaderStats;
+    using laz::BaseWriter::SetAccumulateHeaderStats;
+
+    void SetAccumulateDimensionStats(bool accumulate);
+    bool GetAccumulateDimensionStats() const { return accumulate_dimension_stats_; }
+    las::DimensionStats GetDimensionStats() const;
+    void AddDimensionStats(const las::DimensionStats &dimension_stats);
+
+    void SetPagingPolicy(const PagingPolicy &paging_policy) { paging_policy_ = paging_policy; }
+    PagingPolicy GetPagingPolicy() const { return paging_policy_; }
+
+    void SetPointOrder(las::PointOrder point_order) { point_order_ = point_order; }
+    las::PointOrder GetPointOrder() const { return point_order_; }
+
     // Writes a chunk to the laz file
     Entry WriteNode(const std::vector<char> &in, int32_t point_count, bool compressed);
 
   private:
     std::shared_ptr<Hierarchy> hierarchy_;
+    PagingPolicy paging_policy_;
+    las::PointOrder point_order_{las::PointOrder::Unchanged};
+    // Read by WriteNode without the lock
+    std::atomic<bool> accumulate_dimension_stats_{false};
+    mutable std::mutex dimension_stats_mutex_;
+    las::DimensionStats dimension_stats_;
+    // Empty statistics with the resolved dimensions, copied for each node. Set once, before accumulation is enabled.
+    las::DimensionStats dimension_stats_prototype_;
 
     std::shared_ptr<CopcConfigWriter> GetConfig() const
     {
@@ -35,13 +68,18 @@ class WriterInternal : laz::BaseWriter
 
     size_t OffsetToPointData() const override;
     void WriteHeader() override;
+    void ApplyHeaderStats() override;
+
+    void WritePage(const std::shared_ptr<PageInternal> &page, std::vector<char> &hierarchy_data);
+    void WriteDimensionStats();
 
-    void WritePage(const std::shared_ptr<PageInternal> &page);
+    // Moves the nodes of the root page to the pages given by the paging policy
+    void ApplyPagingPolicy();
 
     void ComputePageHierarchy();
 
-    // Iterates through a given page in a postorder traversal and writes the pages
-    void WritePageTree(const std::shared_ptr<PageInternal> &current);
+    // Iterates through a given page in a postorder traversal and serializes the pages
+    void WritePageTree(const std::shared_ptr<PageInternal> &current, std::vector<char> &hierarchy_data);
 };
 } // namespace copc::Internal
 #endif // COPCLIB_IO_COPC_WRITER_INTERNAL_H_
@@ -0,0 +1,90 @@
+#ifndef COPCLIB_IO_MEMORY_STREAM_H_
+#define COPCLIB_IO_MEMORY_STREAM_H_
+
+#include <istream>
+#include <ostream>
+#include <streambuf>
+#include <vector>
+
+namespace copc::Internal
+{
+// Read-only streambuf over a byte range owned by the caller, so that data which has already
+// been read into memory can be parsed by stream-based functions without copying it again
+class MemoryStreamBuf : public std::streambuf
+{
+  public:
+    MemoryStreamBuf(const char *data, std::size_t size)
+    {
+        auto begin = const_cast<char *>(data);
+        setg(begin, begin, begin + size);
+    }
+
+  protected:
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override
+    {
+        char *pos;
+        if (dir == std::ios_base::beg)
+            pos = eback() + off;
+        else if (dir == std::ios_base::cur)
+            pos = gptr() + off;
+        else
+            pos = egptr() + off;
+
+        if (pos < eback() || pos > egptr())
+            return pos_type(off_type(-1));
+
+        setg(eback(), pos, egptr());
+        return pos_type(pos - eback());
+    }
+
+    pos_type seekpos(pos_type pos, std::ios_base::openmode which) override
+    {
+        return seekoff(off_type(pos), std::ios_base::beg, which);
+    }
+};
+
+class MemoryIStream : public std::istream
+{
+  public:
+    MemoryIStream(const char *data, std::size_t size) : std::istream(&buf_), buf_(data, size) {}
+
+  private:
+    MemoryStreamBuf buf_;
+};
+
+// Write-only streambuf appending to a vector owned by the caller, so that a reused buffer receives the output of
+// stream-based functions without the copies of an std::ostringstream and its str()
+class VectorStreamBuf : public std::streambuf
+{
+  public:
+    VectorStreamBuf(std::vector<char> &data) : data_(data) {}
+
+  protected:
+    int_type overflow(int_type ch) override
+    {
+        if (!traits_type::eq_int_type(ch, traits_type::eof()))
+            data_.push_back(traits_type::to_char_type(ch));
+        return traits_type::not_eof(ch);
+    }
+
+    std::streamsize xsputn(const char *s, std::streamsize count) override
+    {
+        data_.insert(data_.end(), s, s + count);
+        return count;
+    }
+
+  private:
+    std::vector<char> &data_;
+};
+
+class VectorOStream : public std::ostream
+{
+  public:
+    VectorOStream(std::vector<char> &data) : std::ostream(&buf_), buf_(data) {}
+
+  private:
+    VectorStreamBuf buf_;
+};
+
+} // namespace copc::Internal
+#endif // COPCLIB_IO_MEMORY_STREAM_H_
@@ -0,0 +1,67 @@
+#ifndef COPCLIB_IO_PARALLEL_H_
+#define COPCLIB_IO_PARALLEL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace copc::Internal
+{
+// Returns the number of threads to use, 0 meaning the number of hardware threads
+inline unsigned int ResolveNumThreads(unsigned int num_threads)
+{
+    if (num_threads == 0)
+        num_threads = std::thread::hardware_concurrency();
+    return std::max(1u, num_threads);
+}
+
+// Calls func(i) for i in [0, count) from up to num_threads threads, each thread picking the next index as it goes.
+// The first exception thrown by func is rethrown once all threads are done, the remaining indices are skipped.
+template <typename Func> void ParallelFor(size_t count, unsigned int num_threads, Func func)
+{
+    num_threads = static_cast<unsigned int>(std::min<size_t>(ResolveNumThreads(num_threads), count));
+    if (num_threads <= 1)
+    {
+        for (size_t i = 0; i < count; i++)
+            func(i);
+        return;
+    }
+
+    std::atomic<size_t> next{0};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    auto worker = [&]()
+    {
+        size_t i;
+        while ((i = next++) < count)
+        {
+            try
+            {
+                func(i);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error)
+                    error = std::current_exception();
+                next = count;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned int t = 0; t < num_threads; t++)
+        threads.emplace_back(worker);
+    for (auto &thread : threads)
+        thread.join();
+
+    if (error)
+        std::rethrow_exception(error);
+}
+
+} // namespace copc::Internal
+
+#endif // COPCLIB_IO_PARALLEL_H_
@@ -0,0 +1,128 @@
+#ifndef COPCLIB_IO_IO_STATS_H_
+#define COPCLIB_IO_IO_STATS_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace copc
+{
+// The IOStats class collects counters and per-phase latency histograms of readers and writers. Statistics are
+// opt-in: a Reader, Writer or LazWriter only records them once a stats object is set on it. A stats object can be
+// shared by several readers or writers, and updated from several threads at once.
+class IOStats
+{
+  public:
+    enum class Counter
+    {
+        PagesLoaded,
+        NodesRead,
+        PointsRead,
+        BytesRead,
+        Seeks,
+        NodesWritten,
+        PointsWritten,
+        BytesWritten,
+        Queries,
+        QueryNodes
+    };
+    static const size_t COUNTER_COUNT = 10;
+
+    enum class Phase
+    {
+        PageRead,
+        NodeRead,
+        Decompress,
+        Unpack,
+        Pack,
+        // Compression into memory, writing the compressed bytes out is timed as Write
+        Compress,
+        Write
+    };
+    static const size_t PHASE_COUNT = 7;
+
+    // Latencies are bucketed by powers of two, bucket i holds latencies in [2^i, 2^(i+1)) nanoseconds
+    static const size_t BUCKET_COUNT = 40;
+
+    struct PhaseSnapshot
+    {
+        uint64_t count{0};
+        uint64_t total_ns{0};
+        uint64_t max_ns{0};
+        std::array<uint64_t, BUCKET_COUNT> buckets{};
+
+        double MeanNs() const { return count == 0 ? 0 : static_cast<double>(total_ns) / count; }
+        // Upper bound of the bucket holding the given quantile, in [0, 1]
+        uint64_t PercentileNs(double quantile) const;
+    };
+
+    struct Snapshot
+    {
+        std::array<uint64_t, COUNTER_COUNT> counters{};
+        std::array<PhaseSnapshot, PHASE_COUNT> phases{};
+
+        uint64_t Get(Counter counter) const { return counters[static_cast<size_t>(counter)]; }
+        const PhaseSnapshot &Get(Phase phase) const { return phases[static_cast<size_t>(phase)]; }
+        std::string ToString() const;
+    };
+
+    // Measures the lifetime of a scope into a phase, does nothing if stats is null
+    class Timer
+    {
+      public:
+        Timer(IOStats *stats, Phase phase) : stats_(stats), phase_(phase)
+        {
+            if (stats_)
+                start_ = std::chrono::steady_clock::now();
+        }
+        ~Timer()
+        {
+            if (stats_)
+                stats_->Record(phase_, std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                           std::chrono::steady_clock::now() - start_)
+                                           .count());
+        }
+        Timer(const Timer &) = delete;
+        Timer &operator=(const Timer &) = delete;
+
+      private:
+        IOStats *stats_;
+        Phase phase_;
+        std::chrono::steady_clock::time_point start_;
+    };
+
+    IOStats() = default;
+    IOStats(const IOStats &) = delete;
+    IOStats &operator=(const IOStats &) = delete;
+
+    void Add(Counter counter, uint64_t value = 1)
+    {
+        counters_[static_cast<size_t>(counter)].fetch_add(value, std::memory_order_relaxed);
+    }
+    void Record(Phase phase, int64_t duration_ns);
+
+    // Copies the current values. Counters are read one by one, so a snapshot taken while other threads are updating
+    // the stats may mix values from slightly different times.
+    Snapshot GetSnapshot() const;
+    void Reset();
+
+    static std::string CounterName(Counter counter);
+    static std::string PhaseName(Phase phase);
+
+  private:
+    struct PhaseHistogram
+    {
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> total_ns{0};
+        std::atomic<uint64_t> max_ns{0};
+        std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets{};
+    };
+
+    std::array<std::atomic<uint64_t>, COUNTER_COUNT> counters_{};
+    std::array<PhaseHistogram, PHASE_COUNT> phases_{};
+};
+
+} // namespace copc
+#endif // COPCLIB_IO_IO_STATS_H_
@@ -2,7 +2,8 @@
 #define COPCLIB_IO_LAZ_BASE_WRITER_H_
 
 #include <array>
-#include <iterator>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <ostream>
 #include <stdexcept>
@@ -11,7 +12,10 @@
 
 #include "copc-lib/copc/copc_config.hpp"
 #include "copc-lib/geometry/vector3.hpp"
+#include "copc-lib/io/io_stats.hpp"
+#include "copc-lib/io/output_sink.hpp"
 #include "copc-lib/las/header.hpp"
+#include "copc-lib/las/header_stats.hpp"
 #include "copc-lib/las/laz_config.hpp"
 #include "copc-lib/las/points.hpp"
 #include "copc-lib/las/utils.hpp"
@@ -23,18 +27,30 @@ namespace copc::laz
 class BaseWriter
 {
   public:
-    BaseWriter(std::ostream &out_stream, std::shared_ptr<las::LazConfig> laz_config)
-        : out_stream_(out_stream), config_(std::move(laz_config)), open_(true)
+    BaseWriter(std::shared_ptr<OutputSink> sink, std::shared_ptr<las::LazConfig> laz_config)
+        : sink_(std::move(sink)), config_(std::move(laz_config)), open_(true)
     {
     }
 
+    // Statistics are only collected while a stats object is set
+    void SetStats(const std::shared_ptr<IOStats> &stats) { stats_ = stats; }
+    std::shared_ptr<IOStats> Stats() const { return stats_; }
+
+    // While enabled, the points of uncompressed chunks are summarized and the header's bounds, points by return
+    // and GPS time range are set from them on close. Compressed chunks aren't decoded, see AddHeaderStats.
+    void SetAccumulateHeaderStats(bool accumulate) { accumulate_header_stats_ = accumulate; }
+    bool GetAccumulateHeaderStats() const { return accumulate_header_stats_; }
+    las::HeaderStats GetHeaderStats() const;
+    // Merges the statistics of points written by other means, such as compressed chunks
+    void AddHeaderStats(const las::HeaderStats &header_stats);
+
     int32_t WriteChunk(const std::vector<char> &in, int32_t point_count = 0, bool compressed = false,
                        uint64_t *offset = nullptr, int32_t *byte_size = nullptr);
 
     // 8 bytes for the chunk table offset
     uint64_t FirstChunkOffset() const { return OffsetToPointData() + sizeof(uint64_t); };
-    void WriteLasHeader();
-    void WriteLazAndEbVlrs();
+    void WriteLasHeader(std::ostream &out_stream);
+    void WriteLazAndEbVlrs(std::ostream &out_stream);
     void WriteChunkTable();
     void WriteWKT();
     virtual size_t OffsetToPointData() const;
@@ -46,23 +62,32 @@ class BaseWriter
   protected:
     static const uint32_t VARIABLE_CHUNK_SIZE = std::numeric_limits<uint32_t>::max();
 
+    // Sets the header fields from the accumulated statistics
+    virtual void ApplyHeaderStats() {}
+
     bool open_{};
-    std::ostream &out_stream_;
+    std::shared_ptr<OutputSink> sink_;
     std::vector<lazperf::chunk> chunks_;
     uint64_t point_count_{};
     uint64_t evlr_offset_{};
     uint32_t evlr_count_{};
     std::shared_ptr<las::LazConfig> config_;
+    std::shared_ptr<IOStats> stats_;
+    // Compressed data of the chunk being written
+    std::vector<char> compress_buffer_;
+    bool accumulate_header_stats_{false};
+    mutable std::mutex header_stats_mutex_;
+    las::HeaderStats header_stats_;
 };
 
 class BaseFileWriter
 {
   public:
-    BaseFileWriter(const std::string &file_path);
+    BaseFileWriter(const std::string &file_path, const FileSinkOptions &sink_options = {});
     virtual void Close();
 
   protected:
-    std::fstream f_stream_;
+    std::shared_ptr<FileSink> file_sink_;
     std::string file_path_;
 };
 
@@ -0,0 +1,39 @@
+#ifndef COPCLIB_IO_LAZ_EXPORT_H_
+#define COPCLIB_IO_LAZ_EXPORT_H_
+
+#include <cstdint>
+#include <string>
+
+#include "copc-lib/geometry/box.hpp"
+#include "copc-lib/io/copc_reader.hpp"
+#include "copc-lib/io/laz_writer.hpp"
+
+namespace copc
+{
+
+struct LazExportResult
+{
+    uint64_t node_count{0};
+    uint64_t point_count{0};
+
+    std::string ToString() const;
+};
+
+// Writes the nodes of the reader that intersect the box, down to the depth of the given resolution (all depths if 0),
+// to the LAZ writer. COPC nodes are valid LAZ chunks, so each node's compressed data is written as is as one chunk,
+// without decoding any point. Nodes are read in file order, and read ahead in the background while they are written.
+// Filtering is done at node granularity: nodes crossing the box are written whole.
+//
+// The writer must have the point format, scale and offset of the reader, such as one created from
+// las::LazConfigWriter(reader.CopcConfig()). The header's point count and chunk table follow the written nodes. When
+// every node is written, the bounds and points_by_return are the reader's. Otherwise they aren't known without
+// decoding the points:
+// - By default nothing is decoded, and the header of a partial export is loose: its bounds are the written node
+//   cubes clipped to the reader's bounds, and its points_by_return are all 0, which doesn't mean there are no returns.
+// - If the writer accumulates header stats (SetAccumulateHeaderStats(true)), the written nodes are also decoded, and
+//   the writer sets the exact bounds, points_by_return and GPS time range on close.
+LazExportResult ExportToLaz(Reader &reader, laz::LazWriter &writer, const Box &box = Box::MaxBox(),
+                            double resolution = 0);
+
+} // namespace copc
+#endif // COPCLIB_IO_LAZ_EXPORT_H_
@@ -24,6 +24,7 @@ class LazWriter : public BaseWriter
 
   public:
     LazWriter(std::ostream &out_stream, const las::LazConfigWriter &las_config_writer);
+    LazWriter(std::shared_ptr<OutputSink> sink, const las::LazConfigWriter &las_config_writer);
 
     // Write a group of points as a chunk
     void WritePoints(const las::Points &points);
@@ -36,14 +37,20 @@ class LazWriter : public BaseWriter
 
     uint64_t PointCount() { return point_count_; }
     uint64_t ChunkCount() { return chunks_.size(); }
+
+    ~LazWriter() { Close(); }
+
+  protected:
+    void ApplyHeaderStats() override;
 };
 
 class LazFileWriter : BaseFileWriter, public LazWriter
 {
 
   public:
-    LazFileWriter(const std::string &file_path, const las::LazConfigWriter &laz_config_writer)
-        : BaseFileWriter(file_path), LazWriter(f_stream_, laz_config_writer)
+    LazFileWriter(const std::string &file_path, const las::LazConfigWriter &laz_config_writer,
+                  const FileSinkOptions &sink_options = {})
+        : BaseFileWriter(file_path, sink_options), LazWriter(file_sink_, laz_config_writer)
     {
     }
     void Close()
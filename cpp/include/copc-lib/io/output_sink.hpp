@@ -0,0 +1,117 @@
+#ifndef COPCLIB_IO_OUTPUT_SINK_H_
+#define COPCLIB_IO_OUTPUT_SINK_H_
+
+#include <cstdint>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace copc
+{
+
+// Destination of the bytes of a Writer or LazWriter. Writes are positional: the writers append chunks at Size() and
+// write the header and chunk table offset back in place when closing, without relying on a stream position.
+class OutputSink
+{
+  public:
+    virtual ~OutputSink() = default;
+
+    // Writes size bytes at the given offset, which can't be past Size()
+    virtual void WriteAt(uint64_t offset, const char *data, size_t size) = 0;
+    // Number of bytes written so far, including buffered ones
+    virtual uint64_t Size() const = 0;
+    // Writes out any buffered data
+    virtual void Flush() {}
+
+    void Append(const char *data, size_t size) { WriteAt(Size(), data, size); }
+};
+
+// Keeps the written bytes in memory
+class MemorySink : public OutputSink
+{
+  public:
+    void WriteAt(uint64_t offset, const char *data, size_t size) override;
+    uint64_t Size() const override { return data_.size(); }
+
+    const std::vector<char> &Data() const { return data_; }
+
+  private:
+    std::vector<char> data_;
+};
+
+// Writes to a stream, seeking only when a write isn't at the current stream position. Writers constructed with a
+// std::ostream write through one.
+class StreamSink : public OutputSink
+{
+  public:
+    StreamSink(std::ostream &out_stream);
+
+    void WriteAt(uint64_t offset, const char *data, size_t size) override;
+    uint64_t Size() const override { return size_; }
+    void Flush() override { out_stream_.flush(); }
+
+  private:
+    std::ostream &out_stream_;
+    uint64_t position_{0};
+    uint64_t size_{0};
+};
+
+struct FileSinkOptions
+{
+    // Size of the staging buffer, rounded up to a multiple of FileSink::BLOCK_SIZE
+    size_t buffer_size{8 * 1024 * 1024};
+    // Bypass the page cache with O_DIRECT
+    bool direct{false};
+};
+
+// Writes to a file through a large staging buffer, with positional writes (pwrite) where the OS supports them.
+// With the direct option, full blocks of the buffer are written with O_DIRECT, bypassing the page cache, while writes
+// before the buffer and the unaligned tail of the file go through a regular file descriptor. Direct I/O falls back to
+// regular writes where it isn't supported, see IsDirect().
+class FileSink : public OutputSink
+{
+  public:
+    // Alignment of the staging buffer and of its direct writes
+    static const size_t BLOCK_SIZE = 4096;
+
+    FileSink(const std::string &file_path, const FileSinkOptions &options = {});
+    FileSink(const FileSink &) = delete;
+    FileSink &operator=(const FileSink &) = delete;
+    ~FileSink() override;
+
+    void WriteAt(uint64_t offset, const char *data, size_t size) override;
+    uint64_t Size() const override { return size_; }
+    // Writes out the buffer. With direct I/O, its unaligned tail is also kept staged, so that it's written again once
+    // its block is complete.
+    void Flush() override;
+    void Close();
+
+    // Whether full blocks are written with O_DIRECT
+    bool IsDirect() const { return direct_fd_ >= 0; }
+    std::string FilePath() const { return file_path_; }
+
+  private:
+    std::string file_path_;
+    int fd_{-1};
+    int direct_fd_{-1};
+    // Used where positional writes aren't available
+    std::fstream f_stream_;
+    bool open_{false};
+
+    std::vector<char> buffer_storage_;
+    // Start of buffer_storage_, aligned to BLOCK_SIZE
+    char *buffer_{nullptr};
+    size_t capacity_{0};
+    // File offset of the start of the buffer, and number of bytes staged from there
+    uint64_t buffer_offset_{0};
+    size_t buffered_{0};
+    uint64_t size_{0};
+
+    // Writes the full blocks of the buffer out and moves the rest to its start
+    void FlushBlocks();
+    void WriteFile(uint64_t offset, const char *data, size_t size, bool direct);
+};
+
+} // namespace copc
+#endif // COPCLIB_IO_OUTPUT_SINK_H_
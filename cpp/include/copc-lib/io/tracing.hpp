@@ -0,0 +1,118 @@
+#ifndef COPCLIB_IO_TRACING_H_
+#define COPCLIB_IO_TRACING_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "copc-lib/hierarchy/key.hpp"
+
+namespace copc
+{
+// Begin or end of an operation. Operations of one thread are properly nested.
+struct TraceEvent
+{
+    enum class Type
+    {
+        Begin,
+        End
+    };
+
+    Type type;
+    // Static string naming the operation, such as "Reader::ReadPage"
+    const char *name;
+    // Node or page the operation works on, invalid if there is none
+    VoxelKey key;
+    // Bytes read, written or produced by the operation, only known at the end for some operations
+    uint64_t bytes;
+    std::thread::id thread_id;
+    std::chrono::steady_clock::time_point time;
+};
+
+// Receives the events of all readers and writers once registered with SetTracer. OnEvent is called from the threads
+// doing the work, so it must be thread safe, and it should be fast since it runs inline.
+class Tracer
+{
+  public:
+    virtual ~Tracer() = default;
+    virtual void OnEvent(const TraceEvent &event) = 0;
+};
+
+// Tracer forwarding the events to a callback
+class CallbackTracer : public Tracer
+{
+  public:
+    CallbackTracer(std::function<void(const TraceEvent &)> callback) : callback_(std::move(callback)) {}
+    void OnEvent(const TraceEvent &event) override { callback_(event); }
+
+  private:
+    std::function<void(const TraceEvent &)> callback_;
+};
+
+// Tracer recording the events in memory, to be written in the Chrome trace event format, which can be loaded in
+// chrome://tracing or Perfetto
+class ChromeTraceExporter : public Tracer
+{
+  public:
+    void OnEvent(const TraceEvent &event) override;
+
+    size_t EventCount() const;
+    void Clear();
+    void Write(std::ostream &out_stream) const;
+    void Save(const std::string &file_path) const;
+
+  private:
+    mutable std::mutex mutex_;
+    std::vector<TraceEvent> events_;
+};
+
+// Registers the tracer of the process, or unregisters it if null. Operations that are in flight when the tracer
+// changes still report their end to the tracer that saw them begin.
+void SetTracer(const std::shared_ptr<Tracer> &tracer);
+std::shared_ptr<Tracer> GetTracer();
+
+namespace Internal
+{
+// Set while a tracer is registered, so that spans cost a single branch otherwise
+extern std::atomic<bool> tracing_enabled;
+
+// Emits the begin event of an operation on construction and its end event on destruction
+class TraceSpan
+{
+  public:
+    TraceSpan(const char *name, const VoxelKey &key = VoxelKey::InvalidKey(), uint64_t bytes = 0)
+    {
+        if (tracing_enabled.load(std::memory_order_relaxed))
+            Begin(name, key, bytes);
+    }
+    ~TraceSpan()
+    {
+        if (tracer_)
+            End();
+    }
+    TraceSpan(const TraceSpan &) = delete;
+    TraceSpan &operator=(const TraceSpan &) = delete;
+
+    // Byte count reported with the end event
+    void SetBytes(uint64_t bytes) { bytes_ = bytes; }
+
+  private:
+    void Begin(const char *name, const VoxelKey &key, uint64_t bytes);
+    void End();
+
+    std::shared_ptr<Tracer> tracer_;
+    const char *name_{nullptr};
+    VoxelKey key_;
+    uint64_t bytes_{0};
+};
+} // namespace Internal
+
+} // namespace copc
+#endif // COPCLIB_IO_TRACING_H_
@@ -0,0 +1,90 @@
+#ifndef COPCLIB_LAS_DIMENSION_STATS_H_
+#define COPCLIB_LAS_DIMENSION_STATS_H_
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "copc-lib/las/extra_bytes_schema.hpp"
+#include "copc-lib/las/header.hpp"
+#include "copc-lib/las/vlr.hpp"
+
+namespace copc::las
+{
+// The DimensionStats class accumulates the minimum, maximum, mean and variance of each dimension of packed point
+// records, point formats 6-8 and their documented extra bytes fields, along with a histogram of the classifications.
+// Each dimension of a buffer is gathered into a column and reduced in passes that the compiler can vectorize, and
+// accumulators of separate buffers or threads can be merged. Writers store it in the statistics EVLR.
+class DimensionStats
+{
+  public:
+    // Identifiers of the statistics EVLR
+    static constexpr const char *USER_ID = "copc-lib";
+    static constexpr uint16_t RECORD_ID = 1;
+    // Names are stored in 32 bytes, like the names of extra bytes fields
+    static const size_t NAME_SIZE = 32;
+
+    struct Dimension
+    {
+        std::string name;
+        // Number of values, which excludes the no-data values of extra bytes fields
+        uint64_t count{0};
+        double minimum{0};
+        double maximum{0};
+        double mean{0};
+        // Population variance
+        double variance{0};
+    };
+
+    DimensionStats() = default;
+    // Dimensions are those of the header's point format, then the extra bytes fields, with array fields split into
+    // one dimension per element ("name[0]", "name[1]"...)
+    DimensionStats(const LasHeader &header, const EbVlr &extra_bytes_vlr = EbVlr());
+
+    // Adds point_count consecutive packed records
+    void Add(const char *data, size_t point_count);
+    // The data must be a whole number of point records
+    void Add(const std::vector<char> &data);
+    // Both accumulators must have the same dimensions
+    void Merge(const DimensionStats &other);
+
+    uint64_t PointCount() const { return point_count_; }
+    const std::vector<Dimension> &Dimensions() const { return dimensions_; }
+    bool HasDimension(const std::string &name) const;
+    const Dimension &GetDimension(const std::string &name) const;
+    const std::array<uint64_t, 256> &ClassificationHistogram() const { return classification_histogram_; }
+
+    // Payload of the statistics EVLR
+    std::vector<char> Pack() const;
+    // Statistics read from an EVLR can be merged into, but can't accumulate records
+    static DimensionStats Unpack(const std::vector<char> &data);
+
+    std::string ToString() const;
+
+  private:
+    // Where a dimension's values are in a point record, and how to turn them into values
+    struct Column
+    {
+        ExtraBytesSchema::Element element;
+        // For the bit fields of a byte
+        uint8_t shift;
+        uint8_t mask;
+    };
+
+    uint32_t point_record_length_{0};
+    size_t classification_offset_{0};
+    std::vector<Column> columns_;
+
+    uint64_t point_count_{0};
+    std::vector<Dimension> dimensions_;
+    // Sums of squared differences from the mean, the variance times the count
+    std::vector<double> m2_;
+    std::array<uint64_t, 256> classification_histogram_{};
+
+    void AddDimension(const std::string &name, const Column &column);
+    // Merges the statistics of count values into a dimension
+    void MergeDimension(size_t index, uint64_t count, double minimum, double maximum, double mean, double m2);
+};
+} // namespace copc::las
+#endif // COPCLIB_LAS_DIMENSION_STATS_H_
@@ -0,0 +1,135 @@
+#ifndef COPCLIB_LAS_EXTRA_BYTES_SCHEMA_H_
+#define COPCLIB_LAS_EXTRA_BYTES_SCHEMA_H_
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "copc-lib/las/header.hpp"
+#include "copc-lib/las/vlr.hpp"
+
+namespace copc::las
+{
+// The ExtraBytesSchema class resolves the fields of an extra bytes VLR once (offsets, types, scale, offset and
+// no-data values), and then reads or writes them directly in packed point data, one strided pass per node.
+class ExtraBytesSchema
+{
+  public:
+    enum class FieldType
+    {
+        UInt8,
+        Int8,
+        UInt16,
+        Int16,
+        UInt32,
+        Int32,
+        UInt64,
+        Int64,
+        Float,
+        Double
+    };
+
+    // One element of a field, resolved for scaled access: a raw value v stands for v * scale + offset
+    struct Element
+    {
+        size_t record_offset;
+        FieldType type;
+        double scale;
+        double offset;
+        bool has_no_data;
+        double no_data;
+    };
+
+    struct Field
+    {
+        std::string name;
+        FieldType type;
+        // Number of elements, 1 except for the deprecated array types and undocumented bytes
+        uint8_t count;
+        // Offset of the field from the start of the point record
+        size_t record_offset;
+        bool has_no_data;
+        bool has_scale;
+        bool has_offset;
+        double no_data[3];
+        double scale[3];
+        double offset[3];
+
+        size_t ElementSize() const { return ExtraBytesSchema::ElementSize(type); }
+        size_t ByteSize() const { return count * ElementSize(); }
+        Element GetElement(uint8_t element) const
+        {
+            return {record_offset + element * ElementSize(), type, has_scale ? scale[element] : 1.0,
+                    has_offset ? offset[element] : 0.0, has_no_data, no_data[element]};
+        }
+    };
+
+    ExtraBytesSchema(const EbVlr &eb_vlr, const int8_t &point_format_id);
+    // Also checks that the header's point record length matches the VLR
+    ExtraBytesSchema(const EbVlr &eb_vlr, const LasHeader &header);
+
+    static size_t ElementSize(FieldType type);
+
+    uint32_t PointRecordLength() const { return point_record_length_; }
+    const std::vector<Field> &Fields() const { return fields_; }
+    bool HasField(const std::string &name) const;
+    const Field &GetField(const std::string &name) const;
+    // Elements of several fields, in order
+    std::vector<Element> ResolveElements(const std::vector<std::string> &names) const;
+    // Number of points in packed point data
+    size_t PointCount(const std::vector<char> &point_data) const;
+
+    // Raw values of one element of a field, T must have the size of the field's type
+    template <typename T>
+    std::vector<T> Extract(const std::vector<char> &point_data, const std::string &name, uint8_t element = 0) const
+    {
+        const auto &field = GetTypedField<T>(name, element);
+        size_t point_count = PointCount(point_data);
+        std::vector<T> out(point_count);
+        const char *src = point_data.data() + field.record_offset + element * sizeof(T);
+        for (size_t i = 0; i < point_count; i++)
+            std::memcpy(&out[i], src + i * point_record_length_, sizeof(T));
+        return out;
+    }
+    template <typename T>
+    void Inject(std::vector<char> &point_data, const std::string &name, const std::vector<T> &values,
+                uint8_t element = 0) const
+    {
+        const auto &field = GetTypedField<T>(name, element);
+        if (values.size() != PointCount(point_data))
+            throw std::runtime_error("ExtraBytesSchema::Inject: Number of values does not match number of points.");
+        char *dst = point_data.data() + field.record_offset + element * sizeof(T);
+        for (size_t i = 0; i < values.size(); i++)
+            std::memcpy(dst + i * point_record_length_, &values[i], sizeof(T));
+    }
+
+    // Values of several fields, with the fields' scale and offset applied and no-data values set to NaN.
+    // Returns one column per element of each field, in order.
+    std::vector<std::vector<double>> ExtractScaled(const std::vector<char> &point_data,
+                                                   const std::vector<std::string> &names) const;
+    std::vector<double> ExtractScaled(const std::vector<char> &point_data, const std::string &name) const;
+    // Writes the columns of several fields, laid out as returned by ExtractScaled, removing the fields' scale and
+    // offset. NaN values are written as the field's no-data value.
+    void InjectScaled(std::vector<char> &point_data, const std::vector<std::string> &names,
+                      const std::vector<std::vector<double>> &columns) const;
+    void InjectScaled(std::vector<char> &point_data, const std::string &name, const std::vector<double> &values) const;
+
+  private:
+    template <typename T> const Field &GetTypedField(const std::string &name, uint8_t element) const
+    {
+        const auto &field = GetField(name);
+        if (sizeof(T) != field.ElementSize())
+            throw std::runtime_error("ExtraBytesSchema: Type size does not match field " + name + ".");
+        if (element >= field.count)
+            throw std::runtime_error("ExtraBytesSchema: Field " + name + " has no element " +
+                                     std::to_string(element) + ".");
+        return field;
+    }
+
+    uint32_t point_record_length_;
+    std::vector<Field> fields_;
+};
+} // namespace copc::las
+#endif // COPCLIB_LAS_EXTRA_BYTES_SCHEMA_H_
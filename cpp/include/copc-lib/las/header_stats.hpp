@@ -0,0 +1,55 @@
+#ifndef COPCLIB_LAS_HEADER_STATS_H_
+#define COPCLIB_LAS_HEADER_STATS_H_
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "copc-lib/geometry/vector3.hpp"
+#include "copc-lib/las/header.hpp"
+
+namespace copc::las
+{
+// The HeaderStats class accumulates the header fields that summarize the point records: the XYZ bounds, the number of
+// points by return and the GPS time range. Records of point formats 6-8 are read in their packed form, one pass per
+// buffer, and accumulators of separate buffers or threads can be merged.
+class HeaderStats
+{
+  public:
+    // Adds point_count consecutive packed records
+    void Add(const char *data, size_t point_count, uint16_t point_record_length);
+    // The data must be a whole number of the header's point records
+    void Add(const std::vector<char> &data, const LasHeader &header);
+    void Merge(const HeaderStats &other);
+
+    uint64_t PointCount() const { return point_count_; }
+    bool Empty() const { return point_count_ == 0; }
+
+    // Bounds of the integer coordinates, before scaling
+    std::array<int32_t, 3> MinInt() const { return min_; }
+    std::array<int32_t, 3> MaxInt() const { return max_; }
+    // Bounds of the coordinates, scaled by the header
+    Vector3 Min(const LasHeader &header) const;
+    Vector3 Max(const LasHeader &header) const;
+    // Number of points of return numbers 1-15, points with a return number of 0 aren't counted
+    std::array<uint64_t, 15> PointsByReturn() const;
+    double GpsTimeMin() const { return gps_time_min_; }
+    double GpsTimeMax() const { return gps_time_max_; }
+
+    // Sets the header's min, max and points_by_return, unless no point was added
+    void Apply(LasHeader &header) const;
+
+    std::string ToString() const;
+
+  private:
+    uint64_t point_count_{0};
+    std::array<int32_t, 3> min_{};
+    std::array<int32_t, 3> max_{};
+    // Indexed by the 4-bit return number
+    std::array<uint64_t, 16> returns_{};
+    double gps_time_min_{0};
+    double gps_time_max_{0};
+};
+} // namespace copc::las
+#endif // COPCLIB_LAS_HEADER_STATS_H_
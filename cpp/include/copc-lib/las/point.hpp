@@ -10,6 +10,7 @@
 
 namespace copc::las
 {
+class PointCodec;
 class Point
 {
   public:
@@ -281,6 +282,8 @@ class Point
     std::vector<uint8_t> extra_bytes_;
 
   private:
+    friend class PointCodec;
+
     uint32_t point_record_length_;
     int8_t point_format_id_;
 };
@@ -0,0 +1,82 @@
+#ifndef COPCLIB_LAS_POINT_ARRAY_H_
+#define COPCLIB_LAS_POINT_ARRAY_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "copc-lib/las/header.hpp"
+#include "copc-lib/las/points.hpp"
+
+namespace copc::las
+{
+// The PointArray class stores a set of point dimensions in columnar form, with each dimension's values contiguous
+// in memory. It can be filled directly from packed point data without creating Point objects, and its columns can be
+// wrapped by other libraries (e.g. NumPy) without copying.
+class PointArray
+{
+  public:
+    enum class DimensionType
+    {
+        Bool,
+        UInt8,
+        Int16,
+        UInt16,
+        Float64
+    };
+
+    // A single dimension's values
+    struct Column
+    {
+        std::string name;
+        DimensionType type;
+        std::vector<char> data;
+
+        size_t ItemSize() const { return PointArray::ItemSize(type); }
+        const void *Data() const { return data.data(); }
+        void *Data() { return data.data(); }
+    };
+
+    PointArray() = default;
+
+    // Decodes the requested dimensions (all of the format's dimensions if empty) from packed point data
+    static PointArray Unpack(const std::vector<char> &point_data, const LasHeader &header,
+                             const std::vector<std::string> &dimensions = {});
+    static PointArray Unpack(const std::vector<char> &point_data, const int8_t &point_format_id,
+                             const uint16_t &eb_byte_size, const Vector3 &scale, const Vector3 &offset,
+                             const std::vector<std::string> &dimensions = {});
+    static PointArray Unpack(const char *point_data, const size_t &size, const LasHeader &header,
+                             const std::vector<std::string> &dimensions = {});
+    // Copies the requested dimensions (all of the format's dimensions if empty) from Point objects
+    static PointArray FromPoints(const Points &points, const std::vector<std::string> &dimensions = {});
+
+    // Names of the dimensions available for a point format, in record order
+    static std::vector<std::string> AvailableDimensions(const int8_t &point_format_id);
+    static size_t ItemSize(DimensionType type);
+
+    size_t Size() const { return size_; }
+    const std::vector<Column> &Columns() const { return columns_; }
+    std::vector<Column> &Columns() { return columns_; }
+    bool HasDimension(const std::string &name) const;
+    const Column &GetColumn(const std::string &name) const;
+
+    // Typed access to a column's values, the type must match the column's DimensionType
+    template <typename T> const T *Data(const std::string &name) const
+    {
+        const auto &column = GetColumn(name);
+        if (sizeof(T) != column.ItemSize())
+            throw std::runtime_error("PointArray::Data: Type size does not match dimension " + name + ".");
+        return reinterpret_cast<const T *>(column.Data());
+    }
+
+  private:
+    PointArray(const int8_t &point_format_id, size_t size, const std::vector<std::string> &dimensions);
+    static PointArray Unpack(const char *point_data, const size_t &size, const int8_t &point_format_id,
+                             const uint16_t &eb_byte_size, const Vector3 &scale, const Vector3 &offset,
+                             const std::vector<std::string> &dimensions);
+
+    size_t size_{0};
+    std::vector<Column> columns_;
+};
+} // namespace copc::las
+#endif // COPCLIB_LAS_POINT_ARRAY_H_
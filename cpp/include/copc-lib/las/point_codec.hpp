@@ -0,0 +1,102 @@
+#ifndef COPCLIB_LAS_POINT_CODEC_H_
+#define COPCLIB_LAS_POINT_CODEC_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "copc-lib/las/header.hpp"
+#include "copc-lib/las/point.hpp"
+#include "copc-lib/utils/arena.hpp"
+
+namespace copc::las
+{
+// The PointCodec class packs and unpacks point records of one point format (6-8) and extra bytes size.
+// Each codec is compiled for its point format and, for up to MAX_SPECIALIZED_EB_BYTE_SIZE bytes, its extra bytes size,
+// so records are read and written with fixed offsets and no per-point branches. Codecs are looked up once per
+// buffer of points in a dispatch table.
+class PointCodec
+{
+  public:
+    // Extra bytes sizes above this are copied with a runtime size
+    static const uint16_t MAX_SPECIALIZED_EB_BYTE_SIZE = 8;
+
+    static const PointCodec &Get(const int8_t &point_format_id, const uint16_t &eb_byte_size);
+    static const PointCodec &Get(const LasHeader &header) { return Get(header.PointFormatId(), header.EbByteSize()); }
+
+    int8_t PointFormatId() const { return point_format_id_; }
+    uint16_t EbByteSize() const { return eb_byte_size_; }
+    uint32_t PointRecordLength() const { return point_record_length_; }
+
+    // Single records, `data` must hold PointRecordLength() bytes
+    std::shared_ptr<Point> UnpackPoint(const char *data, const Vector3 &scale, const Vector3 &offset) const
+    {
+        return unpack_point_(data, scale, offset, eb_byte_size_);
+    }
+    void PackPoint(const Point &point, char *data, const Vector3 &scale, const Vector3 &offset) const
+    {
+        pack_point_(point, data, scale, offset, eb_byte_size_);
+    }
+
+    // Consecutive records, `data` must hold count * PointRecordLength() bytes
+    std::vector<std::shared_ptr<Point>> UnpackPoints(const char *data, size_t count, const Vector3 &scale,
+                                                     const Vector3 &offset) const
+    {
+        return unpack_points_(data, count, scale, offset, eb_byte_size_, nullptr);
+    }
+    // Allocates the points from the arena, so they must not be used after it is released
+    std::vector<std::shared_ptr<Point>> UnpackPoints(const char *data, size_t count, const Vector3 &scale,
+                                                     const Vector3 &offset, Arena &arena) const
+    {
+        return unpack_points_(data, count, scale, offset, eb_byte_size_, &arena);
+    }
+    void PackPoints(const std::vector<std::shared_ptr<Point>> &points, char *data, const Vector3 &scale,
+                    const Vector3 &offset) const
+    {
+        pack_points_(points, data, scale, offset, eb_byte_size_);
+    }
+
+  private:
+    using UnpackPointFunction = std::shared_ptr<Point> (*)(const char *, const Vector3 &, const Vector3 &, uint16_t);
+    using PackPointFunction = void (*)(const Point &, char *, const Vector3 &, const Vector3 &, uint16_t);
+    using UnpackPointsFunction = std::vector<std::shared_ptr<Point>> (*)(const char *, size_t, const Vector3 &,
+                                                                          const Vector3 &, uint16_t, Arena *);
+    using PackPointsFunction = void (*)(const std::vector<std::shared_ptr<Point>> &, char *, const Vector3 &,
+                                        const Vector3 &, uint16_t);
+
+    PointCodec(int8_t point_format_id, uint16_t eb_byte_size, UnpackPointFunction unpack_point,
+               PackPointFunction pack_point, UnpackPointsFunction unpack_points, PackPointsFunction pack_points);
+
+    // Implementations for a point format, and an extra bytes size or -1 for a runtime size
+    template <int8_t PointFormatId, int EbSize>
+    static void UnpackRecord(const char *data, Point &point, const Vector3 &scale, const Vector3 &offset,
+                             uint16_t eb_byte_size);
+    template <int8_t PointFormatId, int EbSize>
+    static void PackRecord(const Point &point, char *data, const Vector3 &scale, const Vector3 &offset,
+                           uint16_t eb_byte_size);
+    template <int8_t PointFormatId, int EbSize>
+    static std::shared_ptr<Point> UnpackPointImpl(const char *data, const Vector3 &scale, const Vector3 &offset,
+                                                  uint16_t eb_byte_size);
+    template <int8_t PointFormatId, int EbSize>
+    static void PackPointImpl(const Point &point, char *data, const Vector3 &scale, const Vector3 &offset,
+                              uint16_t eb_byte_size);
+    template <int8_t PointFormatId, int EbSize>
+    static std::vector<std::shared_ptr<Point>> UnpackPointsImpl(const char *data, size_t count, const Vector3 &scale,
+                                                                const Vector3 &offset, uint16_t eb_byte_size,
+                                                                Arena *arena);
+    template <int8_t PointFormatId, int EbSize>
+    static void PackPointsImpl(const std::vector<std::shared_ptr<Point>> &points, char *data, const Vector3 &scale,
+                               const Vector3 &offset, uint16_t eb_byte_size);
+    template <int8_t PointFormatId, int EbSize> static PointCodec Make(uint16_t eb_byte_size);
+    template <int8_t PointFormatId> static const PointCodec &GetForFormat(uint16_t eb_byte_size);
+
+    int8_t point_format_id_;
+    uint16_t eb_byte_size_;
+    uint32_t point_record_length_;
+    UnpackPointFunction unpack_point_;
+    PackPointFunction pack_point_;
+    UnpackPointsFunction unpack_points_;
+    PackPointsFunction pack_points_;
+};
+} // namespace copc::las
+#endif // COPCLIB_LAS_POINT_CODEC_H_
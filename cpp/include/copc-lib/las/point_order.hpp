@@ -0,0 +1,33 @@
+#ifndef COPCLIB_LAS_POINT_ORDER_H_
+#define COPCLIB_LAS_POINT_ORDER_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "copc-lib/las/header.hpp"
+
+namespace copc::las
+{
+
+// Order of the point records within a node
+enum class PointOrder
+{
+    // As given
+    Unchanged,
+    // Along a Morton (Z-order) curve of the integer XYZ coordinates, so that consecutive points are close in space
+    Morton,
+    // By GPS time, the acquisition order
+    GpsTime
+};
+
+// Sorts packed records of point formats 6-8 in place. The sort is a stable LSD radix sort on 64 bit keys, which skips
+// the key bytes that all the records share, so equal keys keep their order and sorted data is sorted again cheaply.
+void SortPointData(char *data, size_t point_count, uint16_t point_record_length, PointOrder order);
+// The data must be a whole number of the header's point records
+void SortPointData(std::vector<char> &data, const LasHeader &header, PointOrder order);
+
+// Interleaves the low 21 bits of each coordinate, x in the lowest bit
+uint64_t MortonCode(uint32_t x, uint32_t y, uint32_t z);
+
+} // namespace copc::las
+#endif // COPCLIB_LAS_POINT_ORDER_H_
@@ -9,6 +9,7 @@
 #include "copc-lib/las/header.hpp"
 #include "copc-lib/las/point.hpp"
 #include "copc-lib/las/utils.hpp"
+#include "copc-lib/utils/arena.hpp"
 
 namespace copc::las
 {
@@ -22,6 +23,7 @@ class Points
     Points(const LasHeader &header);
     // Will create Points object given a points vector
     Points(const std::vector<std::shared_ptr<Point>> &points);
+    Points(std::vector<std::shared_ptr<Point>> &&points);
 
     // Getters
     int8_t PointFormatId() const { return point_format_id_; }
@@ -30,6 +32,8 @@ class Points
 
     // Vector functions
     std::vector<std::shared_ptr<Point>> Get() { return points_; }
+    // Read-only access to the points, without copying the vector
+    const std::vector<std::shared_ptr<Point>> &View() const { return points_; }
     size_t Size() const { return points_.size(); }
     void Reserve(const size_t &num) { points_.reserve(num); }
 
@@ -42,8 +46,12 @@ class Points
 
     // Add points functions
     void AddPoint(const std::shared_ptr<Point> &point);
-    void AddPoints(Points points);
+    void AddPoints(const Points &points);
+    // Moves the points out of an rvalue, instead of copying them
+    void AddPoints(Points &&points);
     void AddPoints(std::vector<std::shared_ptr<Point>> points);
+    // Concatenates several Points objects, allocating the final size once
+    void AddPoints(std::vector<Points> &&points_list);
 
     // Point functions
     std::shared_ptr<Point> CreatePoint() { return std::make_shared<Point>(point_format_id_, EbByteSize()); }
@@ -57,6 +65,10 @@ class Points
     static Points Unpack(const std::vector<char> &point_data, const int8_t &point_format_id,
                          const uint16_t &eb_byte_size, const Vector3 &scale, const Vector3 &offset);
     static Points Unpack(const std::vector<char> &point_data, const LasHeader &header);
+    static Points Unpack(const char *point_data, const size_t &size, const LasHeader &header);
+    // Allocates the points from the arena, so they must not be used after it is released. The extra bytes of each
+    // point are still held in a heap-allocated vector.
+    static Points Unpack(const char *point_data, const size_t &size, const LasHeader &header, Arena &arena);
 
     std::string ToString() const;
     friend std::ostream &operator<<(std::ostream &os, Points const &value)
@@ -214,7 +226,7 @@ class Points
     }
 
     // Return sub-set of points that fall within the box
-    std::vector<std::shared_ptr<Point>> GetWithin(const Box &box)
+    std::vector<std::shared_ptr<Point>> GetWithin(const Box &box) const
     {
         std::vector<std::shared_ptr<Point>> points;
 
@@ -259,6 +271,9 @@ class Points
     }
 
   private:
+    static Points Unpack(const char *point_data, const size_t &size, const int8_t &point_format_id,
+                         const uint16_t &eb_byte_size, const Vector3 &scale, const Vector3 &offset, Arena *arena);
+
     std::vector<std::shared_ptr<Point>> points_;
     int8_t point_format_id_;
     uint32_t point_record_length_;
@@ -2,11 +2,17 @@
 #define COPCLIB_LAS_UTILS_H_
 
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <iostream>
 
 namespace copc::las
 {
+// Offsets of the fields common to point formats 6-8 in a point record, and the base size of point format 6
+const size_t RETURNS_OFFSET = 14;
+const size_t GPS_TIME_OFFSET = 22;
+const size_t MIN_RECORD_LENGTH = 30;
+
 uint8_t PointBaseByteSize(const int8_t &point_format_id);
 uint8_t PointBaseNumberDimensions(const int8_t &point_format_id);
 uint16_t EbByteSize(const int8_t &point_format_id, const uint32_t &point_record_length);
@@ -8,6 +8,7 @@
 #include <lazperf/filestream.hpp>
 
 #include "copc-lib/io/copc_writer.hpp"
+#include "copc-lib/io/tracing.hpp"
 #include "copc-lib/las/utils.hpp"
 
 using namespace lazperf;
@@ -22,6 +23,7 @@ class Compressor
     static int32_t CompressBytes(std::ostream &out_stream, const int8_t &point_format_id, const uint16_t &eb_byte_size,
                                  const std::vector<char> &in)
     {
+        copc::Internal::TraceSpan span("Compressor::CompressBytes", copc::VoxelKey::InvalidKey(), in.size());
         OutFileStream stream(out_stream);
 
         las_compressor::ptr compressor = build_las_compressor(stream.cb(), point_format_id, eb_byte_size);
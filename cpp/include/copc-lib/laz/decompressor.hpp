@@ -1,6 +1,8 @@
 #ifndef COPCLIB_LAZ_DECOMPRESS_H_
 #define COPCLIB_LAZ_DECOMPRESS_H_
 
+#include "copc-lib/io/internal/memory_stream.hpp"
+#include "copc-lib/io/tracing.hpp"
 #include "copc-lib/las/header.hpp"
 
 #include <lazperf/filestream.hpp>
@@ -18,24 +20,37 @@ namespace copc::laz
 class Decompressor
 {
   public:
-    // Decompresses bytes from the instream and returns them
-    static std::vector<char> DecompressBytes(std::istream &in_stream, const int8_t &point_format_id,
-                                             const uint16_t &eb_byte_size, const int &point_count)
+    // Decompresses bytes from the instream into out, which must hold point_count * PointByteSize bytes
+    static void DecompressBytes(std::istream &in_stream, const int8_t &point_format_id, const uint16_t &eb_byte_size,
+                                const int &point_count, char *out)
     {
-        std::vector<char> out;
+        int point_size = copc::las::PointByteSize(point_format_id, eb_byte_size);
+        copc::Internal::TraceSpan span("Decompressor::DecompressBytes", copc::VoxelKey::InvalidKey(),
+                                       static_cast<uint64_t>(point_count) * point_size);
 
         InFileStream stre(in_stream);
         las_decompressor::ptr decompressor = build_las_decompressor(stre.cb(), point_format_id, eb_byte_size);
 
-        int point_size = copc::las::PointByteSize(point_format_id, eb_byte_size);
-        char buff[255];
         for (int i = 0; i < point_count; i++)
-        {
-            decompressor->decompress(buff);
-            out.insert(out.end(), buff, buff + point_size);
-        }
+            decompressor->decompress(out + static_cast<size_t>(i) * point_size);
         // clear the EOF flag, since lazperf may read too large of a buffer
         in_stream.clear();
+    }
+
+    static void DecompressBytes(const char *compressed_data, const size_t &size, const las::LasHeader &header,
+                                const int &point_count, char *out)
+    {
+        copc::Internal::MemoryIStream in_stream(compressed_data, size);
+        DecompressBytes(in_stream, header.PointFormatId(), header.EbByteSize(), point_count, out);
+    }
+
+    // Decompresses bytes from the instream and returns them
+    static std::vector<char> DecompressBytes(std::istream &in_stream, const int8_t &point_format_id,
+                                             const uint16_t &eb_byte_size, const int &point_count)
+    {
+        std::vector<char> out(static_cast<size_t>(point_count) *
+                              copc::las::PointByteSize(point_format_id, eb_byte_size));
+        DecompressBytes(in_stream, point_format_id, eb_byte_size, point_count, out.data());
         return out;
     }
 
@@ -48,7 +63,7 @@ class Decompressor
     static std::vector<char> DecompressBytes(const std::vector<char> &compressed_data, const int8_t &point_format_id,
                                              const uint16_t &eb_byte_size, const int &point_count)
     {
-        std::istringstream in_stream(std::string(compressed_data.begin(), compressed_data.end()));
+        copc::Internal::MemoryIStream in_stream(compressed_data.data(), compressed_data.size());
         return DecompressBytes(in_stream, point_format_id, eb_byte_size, point_count);
     }
 
@@ -0,0 +1,87 @@
+#ifndef COPCLIB_UTILS_ARENA_H_
+#define COPCLIB_UTILS_ARENA_H_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace copc
+{
+// The Arena class is a monotonic allocator: allocations are carved out of large blocks and are never freed one by one,
+// instead Release frees all of them at once. It is meant for short-lived data, such as the buffers and points of a
+// node that is processed and then dropped. An Arena must only be used from one thread at a time.
+class Arena
+{
+  public:
+    static const size_t DEFAULT_BLOCK_SIZE = 1 << 20;
+    static const size_t DEFAULT_MAX_RETAINED_BYTES = 64 << 20;
+
+    // Release keeps up to max_retained_bytes for reuse, so that a long-lived arena, like the thread-local ones of the
+    // readers, doesn't hold on to the memory of the largest node it has seen
+    Arena(size_t block_size = DEFAULT_BLOCK_SIZE, size_t max_retained_bytes = DEFAULT_MAX_RETAINED_BYTES)
+        : block_size_(block_size), max_retained_bytes_(max_retained_bytes)
+    {
+    }
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    // Alignments above alignof(std::max_align_t) aren't supported
+    void *Allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+    template <typename T> T *Allocate(size_t count)
+    {
+        return static_cast<T *>(Allocate(count * sizeof(T), alignof(T)));
+    }
+
+    // Invalidates everything allocated so far. The memory is kept, merged into a single block, so that processing
+    // another node of the same size doesn't allocate, unless it exceeds max_retained_bytes, in which case it is freed
+    // down to a single block of block_size bytes.
+    void Release();
+
+    // Bytes handed out since the last Release
+    size_t BytesUsed() const { return bytes_used_; }
+    // Bytes held in blocks
+    size_t Capacity() const;
+    // Number of blocks allocated from the heap over the arena's lifetime
+    size_t BlockAllocations() const { return block_allocations_; }
+
+  private:
+    struct Block
+    {
+        std::unique_ptr<char[]> data;
+        size_t size;
+    };
+
+    void AddBlock(size_t size);
+
+    size_t block_size_;
+    size_t max_retained_bytes_;
+    std::vector<Block> blocks_;
+    // Offset of the free space in the last block
+    size_t offset_{0};
+    size_t bytes_used_{0};
+    size_t block_allocations_{0};
+};
+
+// STL allocator over an Arena, for containers and std::allocate_shared. Deallocation is a no-op, the memory is
+// reclaimed by Arena::Release, so the arena must outlive everything allocated with it.
+template <typename T> class ArenaAllocator
+{
+  public:
+    using value_type = T;
+
+    ArenaAllocator(Arena &arena) : arena_(&arena) {}
+    template <typename U> ArenaAllocator(const ArenaAllocator<U> &other) : arena_(other.arena_) {}
+
+    T *allocate(size_t n) { return arena_->Allocate<T>(n); }
+    void deallocate(T *, size_t) {}
+
+    template <typename U> bool operator==(const ArenaAllocator<U> &other) const { return arena_ == other.arena_; }
+    template <typename U> bool operator!=(const ArenaAllocator<U> &other) const { return arena_ != other.arena_; }
+
+  private:
+    template <typename U> friend class ArenaAllocator;
+    Arena *arena_;
+};
+
+} // namespace copc
+#endif // COPCLIB_UTILS_ARENA_H_
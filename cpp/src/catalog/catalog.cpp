@@ -0,0 +1,306 @@
+#include "copc-lib/catalog/catalog.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include "copc-lib/io/internal/parallel.hpp"
+
+namespace copc
+{
+
+CatalogFile::CatalogFile(const std::string &path, const CopcConfig &config) : path(path)
+{
+    auto header = config.LasHeader();
+    auto copc_info = config.CopcInfo();
+
+    bounds = header.Bounds();
+    cube = Box(copc_info.center_x - copc_info.halfsize, copc_info.center_y - copc_info.halfsize,
+               copc_info.center_z - copc_info.halfsize, copc_info.center_x + copc_info.halfsize,
+               copc_info.center_y + copc_info.halfsize, copc_info.center_z + copc_info.halfsize);
+    spacing = copc_info.spacing;
+    point_count = header.PointCount();
+}
+
+std::string CatalogFile::ToString() const
+{
+    std::stringstream ss;
+    ss << "CatalogFile " << path << ":" << std::endl;
+    ss << "\tbounds: " << bounds.ToString() << std::endl;
+    ss << "\tcube: " << cube.ToString() << std::endl;
+    ss << "\tspacing: " << spacing << std::endl;
+    ss << "\tpoint_count: " << point_count << std::endl;
+    return ss.str();
+}
+
+ReaderPool::ReaderPool(size_t max_open_readers) : max_open_readers_(max_open_readers)
+{
+    if (max_open_readers_ == 0)
+        throw std::runtime_error("ReaderPool: max_open_readers must be at least 1.");
+}
+
+std::shared_ptr<FileReader> ReaderPool::Get(const std::string &path)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = reader_map_.find(path);
+        if (it != reader_map_.end())
+        {
+            // Move the reader to the front of the LRU list
+            readers_.splice(readers_.begin(), readers_, it->second);
+            return it->second->second;
+        }
+    }
+
+    // Open the file outside of the lock, so that several files can be opened at once
+    auto reader = std::make_shared<FileReader>(path);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = reader_map_.find(path);
+    if (it != reader_map_.end())
+    {
+        // Another thread opened the same file in the meantime
+        readers_.splice(readers_.begin(), readers_, it->second);
+        return it->second->second;
+    }
+
+    readers_.emplace_front(path, reader);
+    reader_map_[path] = readers_.begin();
+    while (readers_.size() > max_open_readers_)
+    {
+        reader_map_.erase(readers_.back().first);
+        readers_.pop_back();
+    }
+    return reader;
+}
+
+size_t ReaderPool::Size()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return readers_.size();
+}
+
+void ReaderPool::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    reader_map_.clear();
+    readers_.clear();
+}
+
+Catalog::Catalog(size_t max_open_readers, unsigned int num_threads)
+    : num_threads_(Internal::ResolveNumThreads(num_threads)), reader_pool_(max_open_readers)
+{
+}
+
+void Catalog::AddFileSummary(const CatalogFile &file)
+{
+    if (file_ids_.find(file.path) != file_ids_.end())
+        return;
+
+    file_ids_[file.path] = files_.size();
+    files_.push_back(file);
+    index_dirty_ = true;
+}
+
+void Catalog::AddFiles(const std::vector<std::string> &paths)
+{
+    std::vector<CatalogFile> new_files(paths.size());
+    Internal::ParallelFor(paths.size(), num_threads_,
+                          [&](size_t i)
+                          {
+                              if (file_ids_.find(paths[i]) == file_ids_.end())
+                                  new_files[i] = CatalogFile(paths[i], reader_pool_.Get(paths[i])->CopcConfig());
+                          });
+
+    for (size_t i = 0; i < paths.size(); i++)
+    {
+        if (!new_files[i].path.empty())
+            AddFileSummary(new_files[i]);
+    }
+}
+
+const Internal::RTree &Catalog::Index()
+{
+    // The index is bulk loaded, so it's only rebuilt when queried after files were added
+    if (index_dirty_)
+    {
+        std::vector<Box> boxes;
+        boxes.reserve(files_.size());
+        for (const auto &file : files_)
+            boxes.push_back(file.bounds);
+        index_ = Internal::RTree(boxes);
+        index_dirty_ = false;
+    }
+    return index_;
+}
+
+std::vector<CatalogFile> Catalog::GetFilesIntersectBox(const Box &box)
+{
+    std::vector<CatalogFile> out;
+    for (auto id : Index().Intersects(box))
+        out.push_back(files_[id]);
+    return out;
+}
+
+std::vector<CatalogFile> Catalog::GetFilesWithinBox(const Box &box)
+{
+    std::vector<CatalogFile> out;
+    for (auto id : Index().Within(box))
+        out.push_back(files_[id]);
+    return out;
+}
+
+template <typename Result, typename Query>
+std::map<std::string, Result> Catalog::FanOut(const std::vector<size_t> &file_ids, Query query)
+{
+    std::vector<Result> results(file_ids.size());
+    Internal::ParallelFor(file_ids.size(), num_threads_,
+                          [&](size_t i)
+                          {
+                              auto reader = reader_pool_.Get(files_[file_ids[i]].path);
+                              results[i] = query(*reader);
+                          });
+
+    std::map<std::string, Result> out;
+    for (size_t i = 0; i < file_ids.size(); i++)
+    {
+        if (results[i].size() > 0)
+            out.emplace(files_[file_ids[i]].path, std::move(results[i]));
+    }
+    return out;
+}
+
+std::map<std::string, std::vector<Node>> Catalog::GetNodesIntersectBox(const Box &box, double resolution)
+{
+    return FanOut<std::vector<Node>>(Index().Intersects(box), [&](FileReader &reader)
+                                     { return reader.GetNodesIntersectBox(box, resolution); });
+}
+
+std::map<std::string, std::vector<Node>> Catalog::GetNodesWithinBox(const Box &box, double resolution)
+{
+    return FanOut<std::vector<Node>>(Index().Intersects(box), [&](FileReader &reader)
+                                     { return reader.GetNodesWithinBox(box, resolution); });
+}
+
+std::map<std::string, std::vector<Node>> Catalog::GetNodesWithinResolution(double resolution)
+{
+    std::vector<size_t> file_ids(files_.size());
+    for (size_t i = 0; i < file_ids.size(); i++)
+        file_ids[i] = i;
+    return FanOut<std::vector<Node>>(file_ids, [&](FileReader &reader)
+                                     { return reader.GetNodesWithinResolution(resolution); });
+}
+
+std::map<std::string, las::Points> Catalog::GetPointsWithinBox(const Box &box, double resolution)
+{
+    std::vector<size_t> file_ids = Index().Intersects(box);
+    std::vector<std::shared_ptr<las::Points>> results(file_ids.size());
+    Internal::ParallelFor(file_ids.size(), num_threads_,
+                          [&](size_t i)
+                          {
+                              auto reader = reader_pool_.Get(files_[file_ids[i]].path);
+                              results[i] = std::make_shared<las::Points>(reader->GetPointsWithinBox(box, resolution));
+                          });
+
+    std::map<std::string, las::Points> out;
+    for (size_t i = 0; i < file_ids.size(); i++)
+    {
+        if (results[i]->Size() > 0)
+            out.emplace(files_[file_ids[i]].path, *results[i]);
+    }
+    return out;
+}
+
+namespace
+{
+const char CATALOG_MAGIC[8] = {'C', 'O', 'P', 'C', 'C', 'T', 'L', 'G'};
+
+template <typename T> void WriteValue(std::ostream &out_stream, const T &value)
+{
+    out_stream.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T> T ReadValue(std::istream &in_stream)
+{
+    T value;
+    in_stream.read(reinterpret_cast<char *>(&value), sizeof(T));
+    return value;
+}
+
+void WriteBox(std::ostream &out_stream, const Box &box)
+{
+    for (double v : {box.x_min, box.y_min, box.z_min, box.x_max, box.y_max, box.z_max})
+        WriteValue(out_stream, v);
+}
+
+Box ReadBox(std::istream &in_stream)
+{
+    Box box;
+    box.x_min = ReadValue<double>(in_stream);
+    box.y_min = ReadValue<double>(in_stream);
+    box.z_min = ReadValue<double>(in_stream);
+    box.x_max = ReadValue<double>(in_stream);
+    box.y_max = ReadValue<double>(in_stream);
+    box.z_max = ReadValue<double>(in_stream);
+    return box;
+}
+} // namespace
+
+void Catalog::Save(const std::string &path) const
+{
+    std::ofstream out_stream(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!out_stream.good())
+        throw std::runtime_error("Catalog::Save: Error while opening file path.");
+
+    out_stream.write(CATALOG_MAGIC, sizeof(CATALOG_MAGIC));
+    WriteValue(out_stream, static_cast<uint32_t>(VERSION));
+    WriteValue(out_stream, static_cast<uint64_t>(files_.size()));
+    for (const auto &file : files_)
+    {
+        WriteValue(out_stream, static_cast<uint32_t>(file.path.size()));
+        out_stream.write(file.path.data(), static_cast<std::streamsize>(file.path.size()));
+        WriteBox(out_stream, file.bounds);
+        WriteBox(out_stream, file.cube);
+        WriteValue(out_stream, file.spacing);
+        WriteValue(out_stream, file.point_count);
+    }
+
+    if (!out_stream.good())
+        throw std::runtime_error("Catalog::Save: Error while writing file.");
+}
+
+void Catalog::Load(const std::string &path)
+{
+    std::ifstream in_stream(path, std::ios::in | std::ios::binary);
+    if (!in_stream.good())
+        throw std::runtime_error("Catalog::Load: Error while opening file path.");
+
+    char magic[sizeof(CATALOG_MAGIC)];
+    in_stream.read(magic, sizeof(magic));
+    if (!in_stream.good() || std::memcmp(magic, CATALOG_MAGIC, sizeof(CATALOG_MAGIC)) != 0)
+        throw std::runtime_error("Catalog::Load: File is not a catalog.");
+    if (ReadValue<uint32_t>(in_stream) != VERSION)
+        throw std::runtime_error("Catalog::Load: Unsupported catalog version.");
+
+    auto num_files = ReadValue<uint64_t>(in_stream);
+    std::vector<CatalogFile> files;
+    for (uint64_t i = 0; i < num_files && in_stream.good(); i++)
+    {
+        CatalogFile file;
+        file.path.resize(ReadValue<uint32_t>(in_stream));
+        in_stream.read(&file.path[0], static_cast<std::streamsize>(file.path.size()));
+        file.bounds = ReadBox(in_stream);
+        file.cube = ReadBox(in_stream);
+        file.spacing = ReadValue<double>(in_stream);
+        file.point_count = ReadValue<uint64_t>(in_stream);
+        files.push_back(file);
+    }
+    if (!in_stream.good())
+        throw std::runtime_error("Catalog::Load: Unexpected end of file.");
+
+    for (const auto &file : files)
+        AddFileSummary(file);
+}
+
+} // namespace copc
@@ -0,0 +1,148 @@
+#include "copc-lib/catalog/internal/rtree.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace copc::Internal
+{
+
+namespace
+{
+Box Union(const Box &a, const Box &b)
+{
+    Box out;
+    out.x_min = std::min(a.x_min, b.x_min);
+    out.y_min = std::min(a.y_min, b.y_min);
+    out.z_min = std::min(a.z_min, b.z_min);
+    out.x_max = std::max(a.x_max, b.x_max);
+    out.y_max = std::max(a.y_max, b.y_max);
+    out.z_max = std::max(a.z_max, b.z_max);
+    return out;
+}
+
+// Halved to avoid overflowing with unbounded boxes
+double CenterX(const Box &box) { return box.x_min / 2 + box.x_max / 2; }
+double CenterY(const Box &box) { return box.y_min / 2 + box.y_max / 2; }
+double CenterZ(const Box &box) { return box.z_min / 2 + box.z_max / 2; }
+
+// Sorts the [begin, end) range of ids by the center of their boxes along one axis and cuts it into slices, which are
+// tiled the same way along the next axes until groups of at most capacity ids are formed
+void SortTile(std::vector<size_t>::iterator begin, std::vector<size_t>::iterator end, const std::vector<Box> &boxes,
+              int axis, size_t capacity, std::vector<std::vector<size_t>> &groups)
+{
+    auto count = static_cast<size_t>(end - begin);
+    if (axis == 3 || count <= capacity)
+    {
+        for (auto it = begin; it < end; it += std::min(capacity, static_cast<size_t>(end - it)))
+            groups.emplace_back(it, it + std::min(capacity, static_cast<size_t>(end - it)));
+        return;
+    }
+
+    double (*center)(const Box &) = axis == 0 ? CenterX : (axis == 1 ? CenterY : CenterZ);
+    std::sort(begin, end, [&](size_t a, size_t b) { return center(boxes[a]) < center(boxes[b]); });
+
+    // Number of slices along the remaining axes so that each final group is roughly full
+    auto num_groups = static_cast<double>((count + capacity - 1) / capacity);
+    auto num_slices = static_cast<size_t>(std::ceil(std::pow(num_groups, 1.0 / (3 - axis))));
+    auto slice_size = capacity * static_cast<size_t>(std::ceil(num_groups / num_slices));
+
+    for (auto it = begin; it < end; it += std::min(slice_size, static_cast<size_t>(end - it)))
+        SortTile(it, it + std::min(slice_size, static_cast<size_t>(end - it)), boxes, axis + 1, capacity, groups);
+}
+} // namespace
+
+RTree::RTree(const std::vector<Box> &boxes) : boxes_(boxes)
+{
+    if (boxes_.empty())
+        return;
+
+    // Pack the items into leaves
+    std::vector<size_t> ids(boxes_.size());
+    for (size_t i = 0; i < ids.size(); i++)
+        ids[i] = i;
+    std::vector<std::vector<size_t>> groups;
+    SortTile(ids.begin(), ids.end(), boxes_, 0, NODE_CAPACITY, groups);
+
+    bool leaf = true;
+    size_t child_offset = 0;
+    const std::vector<Box> *child_boxes = &boxes_;
+    std::vector<Box> level_boxes;
+    while (true)
+    {
+        // Create one node per group at this level
+        std::vector<size_t> level_ids;
+        std::vector<Box> next_level_boxes;
+        for (auto &group : groups)
+        {
+            TreeNode node{(*child_boxes)[group[0]], leaf, std::move(group)};
+            for (auto child : node.children)
+                node.bounds = Union(node.bounds, (*child_boxes)[child]);
+            if (!leaf)
+            {
+                // Children ids were relative to the previous level, convert them to nodes_ indices
+                for (auto &child : node.children)
+                    child += child_offset;
+            }
+            next_level_boxes.push_back(node.bounds);
+            level_ids.push_back(nodes_.size());
+            nodes_.push_back(std::move(node));
+        }
+
+        if (level_ids.size() == 1)
+        {
+            root_ = level_ids[0];
+            return;
+        }
+
+        // Pack this level's nodes into the parent level
+        child_offset = level_ids[0];
+        level_boxes = std::move(next_level_boxes);
+        child_boxes = &level_boxes;
+        leaf = false;
+
+        std::vector<size_t> node_ids(level_boxes.size());
+        for (size_t i = 0; i < node_ids.size(); i++)
+            node_ids[i] = i;
+        groups.clear();
+        SortTile(node_ids.begin(), node_ids.end(), level_boxes, 0, NODE_CAPACITY, groups);
+    }
+}
+
+template <typename Predicate> std::vector<size_t> RTree::Query(const Box &box, Predicate item_matches) const
+{
+    std::vector<size_t> out;
+    if (nodes_.empty())
+        return out;
+
+    std::vector<size_t> stack{root_};
+    while (!stack.empty())
+    {
+        const auto &node = nodes_[stack.back()];
+        stack.pop_back();
+        if (!node.bounds.Intersects(box))
+            continue;
+
+        for (auto child : node.children)
+        {
+            if (!node.leaf)
+                stack.push_back(child);
+            else if (item_matches(boxes_[child]))
+                out.push_back(child);
+        }
+    }
+
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+std::vector<size_t> RTree::Intersects(const Box &box) const
+{
+    return Query(box, [&box](const Box &item) { return item.Intersects(box); });
+}
+
+std::vector<size_t> RTree::Within(const Box &box) const
+{
+    return Query(box, [&box](const Box &item) { return item.Within(box); });
+}
+
+} // namespace copc::Internal
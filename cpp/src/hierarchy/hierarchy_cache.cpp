@@ -0,0 +1,217 @@
+#include "copc-lib/hierarchy/internal/hierarchy_cache.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "copc-lib/io/internal/memory_stream.hpp"
+
+namespace copc::Internal
+{
+
+namespace
+{
+const char CACHE_MAGIC[8] = {'C', 'O', 'P', 'C', 'H', 'I', 'E', 'R'};
+
+void PackKey(std::ostream &out_stream, const VoxelKey &key)
+{
+    out_stream.write(reinterpret_cast<const char *>(&key.d), sizeof(key.d));
+    out_stream.write(reinterpret_cast<const char *>(&key.x), sizeof(key.x));
+    out_stream.write(reinterpret_cast<const char *>(&key.y), sizeof(key.y));
+    out_stream.write(reinterpret_cast<const char *>(&key.z), sizeof(key.z));
+}
+
+// Path of a temporary file next to path, unique to this call so that concurrent writers don't share it
+std::string UniqueTempPath(const std::string &path)
+{
+    std::random_device random;
+    uint64_t suffix = (static_cast<uint64_t>(random()) << 32) ^ random();
+    std::stringstream ss;
+    ss << path << ".tmp." << std::hex << std::setw(16) << std::setfill('0') << suffix;
+    return ss.str();
+}
+
+VoxelKey UnpackKey(std::istream &in_stream)
+{
+    VoxelKey key;
+    in_stream.read(reinterpret_cast<char *>(&key.d), sizeof(key.d));
+    in_stream.read(reinterpret_cast<char *>(&key.x), sizeof(key.x));
+    in_stream.read(reinterpret_cast<char *>(&key.y), sizeof(key.y));
+    in_stream.read(reinterpret_cast<char *>(&key.z), sizeof(key.z));
+    return key;
+}
+
+// Writes the records of a page's nodes and subpages, recursing into the subpages after they've been written
+// Returns false if a page of the hierarchy hasn't been loaded
+bool PackPage(std::ostream &out_stream, const PageInternal &page, uint64_t &record_count)
+{
+    if (!page.loaded)
+        return false;
+
+    for (const auto &node : page.nodes)
+    {
+        Entry entry = *node.second;
+        entry.Pack(out_stream);
+        PackKey(out_stream, page.key);
+        record_count++;
+    }
+    for (const auto &sub_page : page.sub_pages)
+    {
+        Entry entry(sub_page->key, sub_page->offset, sub_page->byte_size, -1);
+        entry.Pack(out_stream);
+        PackKey(out_stream, page.key);
+        record_count++;
+    }
+    for (const auto &sub_page : page.sub_pages)
+    {
+        if (!PackPage(out_stream, *sub_page, record_count))
+            return false;
+    }
+    return true;
+}
+} // namespace
+
+HierarchyCacheIdentity HierarchyCache::Identify(const std::string &file_path, const CopcInfo &copc_info)
+{
+    HierarchyCacheIdentity identity;
+    try
+    {
+        identity.file_size = std::filesystem::file_size(file_path);
+        identity.modified_time = std::filesystem::last_write_time(file_path).time_since_epoch().count();
+    }
+    catch (const std::filesystem::filesystem_error &e)
+    {
+        throw std::runtime_error("HierarchyCache::Identify: Cannot access " + file_path + ": " + e.what());
+    }
+    identity.root_hier_offset = copc_info.root_hier_offset;
+    identity.root_hier_size = copc_info.root_hier_size;
+    return identity;
+}
+
+std::shared_ptr<Hierarchy> HierarchyCache::Read(const std::string &cache_path, const HierarchyCacheIdentity &identity)
+{
+    std::ifstream in_stream(cache_path, std::ios::in | std::ios::binary | std::ios::ate);
+    if (!in_stream.good())
+        return nullptr;
+
+    // Read the whole cache in one go
+    auto size = static_cast<uint64_t>(in_stream.tellg());
+    if (size < HEADER_SIZE)
+        return nullptr;
+    std::vector<char> data(size);
+    in_stream.seekg(0);
+    in_stream.read(data.data(), static_cast<std::streamsize>(size));
+    if (static_cast<uint64_t>(in_stream.gcount()) != size)
+        return nullptr;
+
+    MemoryIStream cache_stream(data.data(), data.size());
+    char magic[sizeof(CACHE_MAGIC)];
+    uint32_t version, record_size;
+    HierarchyCacheIdentity cache_identity;
+    uint64_t record_count;
+    cache_stream.read(magic, sizeof(magic));
+    cache_stream.read(reinterpret_cast<char *>(&version), sizeof(version));
+    cache_stream.read(reinterpret_cast<char *>(&record_size), sizeof(record_size));
+    cache_stream.read(reinterpret_cast<char *>(&cache_identity.file_size), sizeof(cache_identity.file_size));
+    cache_stream.read(reinterpret_cast<char *>(&cache_identity.modified_time), sizeof(cache_identity.modified_time));
+    cache_stream.read(reinterpret_cast<char *>(&cache_identity.root_hier_offset),
+                      sizeof(cache_identity.root_hier_offset));
+    cache_stream.read(reinterpret_cast<char *>(&cache_identity.root_hier_size), sizeof(cache_identity.root_hier_size));
+    cache_stream.read(reinterpret_cast<char *>(&record_count), sizeof(record_count));
+    cache_stream.seekg(HEADER_SIZE);
+
+    // Any mismatch means the cache is stale or was written by an incompatible version
+    if (std::memcmp(magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 || version != VERSION ||
+        record_size != RECORD_SIZE || !(cache_identity == identity) ||
+        size != HEADER_SIZE + record_count * RECORD_SIZE)
+        return nullptr;
+
+    auto hierarchy = std::make_shared<Hierarchy>(identity.root_hier_offset, identity.root_hier_size);
+    hierarchy->seen_pages_[VoxelKey::RootKey()]->loaded = true;
+    for (uint64_t i = 0; i < record_count; i++)
+    {
+        Entry entry = Entry::Unpack(cache_stream);
+        VoxelKey page_key = UnpackKey(cache_stream);
+
+        auto page = hierarchy->seen_pages_.find(page_key);
+        if (!entry.IsValid() || page == hierarchy->seen_pages_.end())
+            return nullptr;
+
+        if (entry.IsPage())
+        {
+            auto sub_page = std::make_shared<PageInternal>(entry);
+            sub_page->loaded = true;
+            hierarchy->seen_pages_[entry.key] = sub_page;
+            page->second->sub_pages.insert(sub_page);
+        }
+        else
+        {
+            auto node = std::make_shared<Node>(entry, page_key);
+            hierarchy->loaded_nodes_[entry.key] = node;
+            page->second->nodes[entry.key] = node;
+        }
+    }
+    return hierarchy;
+}
+
+bool HierarchyCache::Write(const std::string &cache_path, const HierarchyCacheIdentity &identity,
+                           const Hierarchy &hierarchy)
+{
+    auto root_page = hierarchy.seen_pages_.find(VoxelKey::RootKey());
+    if (root_page == hierarchy.seen_pages_.end())
+        return false;
+
+    // Serialize in memory first, so that nothing is written if the hierarchy isn't fully loaded
+    std::stringstream records;
+    uint64_t record_count = 0;
+    if (!PackPage(records, *root_page->second, record_count))
+        return false;
+
+    // Write to a temporary file and move it in place, so that concurrent readers never see a partial cache. Each
+    // writer has its own temporary file, the last rename wins.
+    std::string tmp_path = UniqueTempPath(cache_path);
+    {
+        std::ofstream out_stream(tmp_path, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!out_stream.good())
+            return false;
+
+        uint32_t version = VERSION;
+        uint32_t record_size = RECORD_SIZE;
+        char reserved[HEADER_SIZE - 8 - 2 * sizeof(uint32_t) - 5 * sizeof(uint64_t)] = {};
+        out_stream.write(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+        out_stream.write(reinterpret_cast<const char *>(&version), sizeof(version));
+        out_stream.write(reinterpret_cast<const char *>(&record_size), sizeof(record_size));
+        out_stream.write(reinterpret_cast<const char *>(&identity.file_size), sizeof(identity.file_size));
+        out_stream.write(reinterpret_cast<const char *>(&identity.modified_time), sizeof(identity.modified_time));
+        out_stream.write(reinterpret_cast<const char *>(&identity.root_hier_offset),
+                         sizeof(identity.root_hier_offset));
+        out_stream.write(reinterpret_cast<const char *>(&identity.root_hier_size), sizeof(identity.root_hier_size));
+        out_stream.write(reinterpret_cast<const char *>(&record_count), sizeof(record_count));
+        out_stream.write(reserved, sizeof(reserved));
+        if (record_count > 0)
+            out_stream << records.rdbuf();
+        if (!out_stream.good())
+        {
+            out_stream.close();
+            std::remove(tmp_path.c_str());
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmp_path, cache_path, ec);
+    if (ec)
+    {
+        std::remove(tmp_path.c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace copc::Internal
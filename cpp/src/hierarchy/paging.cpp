@@ -0,0 +1,73 @@
+#include "copc-lib/hierarchy/internal/paging.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace copc::Internal
+{
+
+namespace
+{
+// Subtrees smaller than this fraction of a page are kept in their parent's page
+const size_t MIN_PAGE_FILL_DIVISOR = 8;
+} // namespace
+
+std::unordered_map<VoxelKey, VoxelKey> AssignPages(const std::vector<VoxelKey> &keys, size_t max_page_nodes)
+{
+    std::unordered_map<VoxelKey, VoxelKey> pages;
+    if (max_page_nodes == 0)
+    {
+        for (const auto &key : keys)
+            pages[key] = VoxelKey::RootKey();
+        return pages;
+    }
+
+    // Number of nodes within the subtree of each node and of each of their ancestors, nodes or not
+    std::unordered_map<VoxelKey, size_t> subtree_sizes;
+    for (const auto &key : keys)
+    {
+        for (const auto &parent : key.GetParents(true))
+            subtree_sizes[parent]++;
+    }
+
+    // Visit parents before their children, so that the page of a key's parent is known
+    std::vector<VoxelKey> tree_keys;
+    tree_keys.reserve(subtree_sizes.size());
+    for (const auto &entry : subtree_sizes)
+        tree_keys.push_back(entry.first);
+    std::sort(tree_keys.begin(), tree_keys.end(), [](const VoxelKey &a, const VoxelKey &b) { return a.d < b.d; });
+
+    const size_t min_page_nodes = std::max<size_t>(1, max_page_nodes / MIN_PAGE_FILL_DIVISOR);
+    std::unordered_map<VoxelKey, VoxelKey> tree_pages;
+    for (const auto &key : tree_keys)
+    {
+        if (key == VoxelKey::RootKey())
+        {
+            tree_pages[key] = key;
+            continue;
+        }
+        auto parent = key.GetParent();
+        auto size = subtree_sizes[key];
+        if (size <= max_page_nodes && subtree_sizes[parent] > max_page_nodes && size >= min_page_nodes)
+            tree_pages[key] = key;
+        else
+            tree_pages[key] = tree_pages[parent];
+    }
+
+    for (const auto &key : keys)
+        pages[key] = tree_pages[key];
+    return pages;
+}
+
+std::unordered_map<VoxelKey, VoxelKey> AssignPagesByDepth(const std::vector<VoxelKey> &keys, int32_t depth_step)
+{
+    if (depth_step <= 0)
+        throw std::runtime_error("AssignPagesByDepth: The depth step must be positive.");
+
+    std::unordered_map<VoxelKey, VoxelKey> pages;
+    for (const auto &key : keys)
+        pages[key] = key.GetParentAtDepth(key.d - key.d % depth_step);
+    return pages;
+}
+
+} // namespace copc::Internal
@@ -1,14 +1,17 @@
 #include "copc-lib/io/base_reader.hpp"
 
+#include <algorithm>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
 #include <stdexcept>
 
 #include "copc-lib/copc/copc_config.hpp"
+#include "copc-lib/io/internal/memory_stream.hpp"
 #include "copc-lib/las/header.hpp"
 #include "copc-lib/las/vlr.hpp"
 
-#include <lazperf/readers.hpp>
+#include <lazperf/header.hpp>
 #include <lazperf/vlr.hpp>
 
 namespace copc
@@ -18,57 +21,129 @@ void BaseReader::InitReader()
     if (!in_stream_->good())
         throw std::runtime_error("Invalid input stream!");
 
-    reader_ = std::make_unique<lazperf::reader::generic_file>(*in_stream_);
+    in_stream_->seekg(0, std::ios::end);
+    auto file_size = static_cast<uint64_t>(in_stream_->tellg());
+    if (file_size < las::LasHeader::HEADER_SIZE_BYTES)
+        throw std::runtime_error("BaseReader::InitReader: Input is too small to be a LAS file.");
+
+    // Read the LAS header and, in most cases, the whole VLR block following it in a single read
+    vlr_block_ = ReadBytes(0, std::min(file_size, HEADER_READ_SIZE_BYTES));
+    if (std::memcmp(vlr_block_.data(), "LASF", 4) != 0)
+        throw std::runtime_error("BaseReader::InitReader: Invalid LAS file signature.");
+
+    Internal::MemoryIStream header_stream(vlr_block_.data(), vlr_block_.size());
+    auto lazperf_header = lazperf::header14::create(header_stream);
+    if (!(lazperf_header.point_format_id & 0x80))
+        throw std::runtime_error("BaseReader::InitReader: Point data must be LAZ compressed.");
+    // Clear the compression bits
+    lazperf_header.point_format_id &= 0x3F;
+    header_size_ = lazperf_header.header_size;
+
+    auto header = las::LasHeader::FromLazPerf(lazperf_header);
+    if (header.PointOffset() > file_size)
+        throw std::runtime_error("BaseReader::InitReader: Offset to point data is past the end of the file.");
+
+    // Only keep the bytes up to the point data, reading the rest of the VLRs if they didn't fit
+    if (header.PointOffset() > vlr_block_.size())
+    {
+        auto rest = ReadBytes(vlr_block_.size(), header.PointOffset() - vlr_block_.size());
+        vlr_block_.insert(vlr_block_.end(), rest.begin(), rest.end());
+    }
+    vlr_block_.resize(header.PointOffset());
 
-    auto header = las::LasHeader::FromLazPerf(reader_->header());
+    // Read the EVLR block in a single read as well, unless it's too large to hold on to
+    if (header.EvlrCount() > 0 && header.EvlrOffset() < file_size &&
+        file_size - header.EvlrOffset() <= MAX_EVLR_READ_SIZE_BYTES)
+    {
+        evlr_block_ = ReadBytes(header.EvlrOffset(), file_size - header.EvlrOffset());
+        evlr_block_offset_ = header.EvlrOffset();
+    }
 
     // Load vlrs and evlrs
-    vlrs_ = ReadVlrHeaders();
+    vlrs_ = ReadVlrHeaders(header);
+    if (FetchVlr(vlrs_, "laszip encoded", 22204) == 0)
+        throw std::runtime_error("BaseReader::InitReader: No LAZ VLR found in file.");
+
     auto wkt = ReadWktVlr(vlrs_);
     auto eb = ReadExtraBytesVlr(vlrs_);
 
     las_config_ = las::LazConfig(header, wkt.wkt, eb);
 }
 
-std::map<uint64_t, las::VlrHeader> BaseReader::ReadVlrHeaders()
+std::map<uint64_t, las::VlrHeader> BaseReader::ReadVlrHeaders(const las::LasHeader &header)
 {
     std::map<uint64_t, las::VlrHeader> out;
 
-    // Move stream to beginning of VLRs
-    in_stream_->seekg(reader_->header().header_size);
-
     // Iterate through all vlr's and add them to the `vlrs` list
-    for (int i = 0; i < reader_->header().vlr_count; i++)
+    uint64_t cur_pos = header_size_;
+    for (uint32_t i = 0; i < header.VlrCount(); i++)
     {
-        uint64_t cur_pos = in_stream_->tellg();
-        auto h = las::VlrHeader(lazperf::vlr_header::create(*in_stream_));
+        if (cur_pos + las::VLR_HEADER_SIZE > vlr_block_.size())
+            throw std::runtime_error("BaseReader::ReadVlrHeaders: VLRs overlap the point data.");
+
+        Internal::MemoryIStream vlr_stream(vlr_block_.data() + cur_pos, las::VLR_HEADER_SIZE);
+        auto h = las::VlrHeader(lazperf::vlr_header::create(vlr_stream));
         out.insert({cur_pos, h});
 
-        in_stream_->seekg(h.data_length, std::ios::cur); // jump foward
+        cur_pos += las::VLR_HEADER_SIZE + h.data_length; // jump foward
     }
 
-    // Move stream to beginning of EVLRs
-    in_stream_->seekg(reader_->header().evlr_offset);
-
-    // Iterate through all vlr's and add them to the `vlrs` list
-    for (int i = 0; i < reader_->header().evlr_count; i++)
+    // Iterate through all evlr's and add them to the `vlrs` list
+    cur_pos = header.EvlrOffset();
+    for (uint32_t i = 0; i < header.EvlrCount(); i++)
     {
-        uint64_t cur_pos = in_stream_->tellg();
-        auto h = las::VlrHeader(lazperf::evlr_header::create(*in_stream_));
+        auto header_data = ReadBytes(cur_pos, las::EVLR_HEADER_SIZE);
+        Internal::MemoryIStream evlr_stream(header_data.data(), header_data.size());
+        auto h = las::VlrHeader(lazperf::evlr_header::create(evlr_stream));
         out.insert({cur_pos, h});
 
-        in_stream_->seekg(h.data_length, std::ios::cur); // jump foward
+        cur_pos += las::EVLR_HEADER_SIZE + h.data_length; // jump foward
+    }
+
+    return out;
+}
+
+std::vector<char> BaseReader::ReadBytes(uint64_t offset, uint64_t size)
+{
+    if (offset + size <= vlr_block_.size())
+        return {vlr_block_.begin() + offset, vlr_block_.begin() + offset + size};
+    if (!evlr_block_.empty() && offset >= evlr_block_offset_ &&
+        offset + size <= evlr_block_offset_ + evlr_block_.size())
+    {
+        auto begin = evlr_block_.begin() + (offset - evlr_block_offset_);
+        return {begin, begin + size};
     }
 
+    if (stats_)
+    {
+        stats_->Add(IOStats::Counter::Seeks);
+        stats_->Add(IOStats::Counter::BytesRead, size);
+    }
+    std::vector<char> out(size);
+    std::lock_guard<std::mutex> lock(stream_mutex_);
+    in_stream_->clear();
+    in_stream_->seekg(offset);
+    in_stream_->read(out.data(), static_cast<std::streamsize>(size));
+    if (static_cast<uint64_t>(in_stream_->gcount()) != size)
+        throw std::runtime_error("BaseReader::ReadBytes: Unexpected end of stream.");
     return out;
 }
+
+std::vector<char> BaseReader::ReadVlrData(uint64_t offset)
+{
+    const auto &vlr_header = vlrs_.at(offset);
+    return ReadBytes(offset + (vlr_header.evlr_flag ? las::EVLR_HEADER_SIZE : las::VLR_HEADER_SIZE),
+                     vlr_header.data_length);
+}
+
 las::WktVlr BaseReader::ReadWktVlr(std::map<uint64_t, las::VlrHeader> &vlrs)
 {
     auto offset = FetchVlr(vlrs, "LASF_Projection", 2112);
     if (offset != 0)
     {
-        in_stream_->seekg(offset + (vlrs[offset].evlr_flag ? las::EVLR_HEADER_SIZE : las::VLR_HEADER_SIZE));
-        return las::WktVlr::create(*in_stream_, static_cast<int>(vlrs[offset].data_length));
+        auto data = ReadVlrData(offset);
+        Internal::MemoryIStream vlr_stream(data.data(), data.size());
+        return las::WktVlr::create(vlr_stream, static_cast<int>(vlrs[offset].data_length));
     }
     return las::WktVlr();
 }
@@ -78,8 +153,9 @@ las::EbVlr BaseReader::ReadExtraBytesVlr(std::map<uint64_t, las::VlrHeader> &vlr
     auto offset = FetchVlr(vlrs, "LASF_Spec", 4);
     if (offset != 0)
     {
-        in_stream_->seekg(offset + las::VLR_HEADER_SIZE);
-        return las::EbVlr::create(*in_stream_, static_cast<int>(vlrs[offset].data_length));
+        auto data = ReadVlrData(offset);
+        Internal::MemoryIStream vlr_stream(data.data(), data.size());
+        return las::EbVlr::create(vlr_stream, static_cast<int>(vlrs[offset].data_length));
     }
     return las::EbVlr();
 }
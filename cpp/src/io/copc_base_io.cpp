@@ -8,6 +8,8 @@ namespace copc
 // Find a node object given a key
 Node BaseIO::FindNode(VoxelKey key)
 {
+    std::lock_guard<std::recursive_mutex> lock(hierarchy_mutex_);
+
     // Check if the entry has already been loaded
     if (hierarchy_->loaded_nodes_.find(key) != hierarchy_->loaded_nodes_.end())
     {
@@ -33,6 +35,8 @@ Node BaseIO::FindNode(VoxelKey key)
 
 void BaseIO::LoadPageHierarchy(const std::shared_ptr<Internal::PageInternal> &page, std::vector<Node> &loaded_nodes)
 {
+    std::lock_guard<std::recursive_mutex> lock(hierarchy_mutex_);
+
     if (!page->IsValid())
         return;
 
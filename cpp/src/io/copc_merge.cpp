@@ -0,0 +1,236 @@
+#include "copc-lib/io/copc_merge.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include "copc-lib/hierarchy/internal/paging.hpp"
+#include "copc-lib/io/internal/parallel.hpp"
+#include "copc-lib/las/header_stats.hpp"
+#include "copc-lib/laz/compressor.hpp"
+
+namespace copc
+{
+
+std::string MergeResult::ToString() const
+{
+    std::stringstream ss;
+    ss << "MergeResult:" << std::endl;
+    ss << "\tnodes_copied: " << nodes_copied << std::endl;
+    ss << "\tnodes_merged: " << nodes_merged << std::endl;
+    ss << "\tnodes_empty: " << nodes_empty << std::endl;
+    ss << "\tpoint_count: " << point_count << std::endl;
+    ss << "\tpoints_dropped: " << points_dropped << std::endl;
+    return ss.str();
+}
+
+namespace
+{
+// A node of one of the inputs
+struct MergeSource
+{
+    size_t reader_index;
+    Node node;
+};
+
+struct MergeNode
+{
+    std::vector<char> compressed_data;
+    int32_t point_count{0};
+    uint64_t points_dropped{0};
+    // Statistics of the dropped points
+    las::HeaderStats dropped_stats;
+    bool copied{false};
+};
+
+void CheckCompatibleInputs(const std::vector<Reader *> &readers, const las::LasHeader &writer_header)
+{
+    if (readers.empty())
+        throw std::runtime_error("MergeCopc: At least one reader is required.");
+    const auto first_header = readers[0]->CopcConfig().LasHeader();
+    for (auto *reader : readers)
+    {
+        const auto header = reader->CopcConfig().LasHeader();
+        if (header.PointFormatId() != writer_header.PointFormatId() ||
+            header.PointRecordLength() != writer_header.PointRecordLength())
+            throw std::runtime_error("MergeCopc: The readers must have the point format and size of the writer.");
+        if (!(header.Scale() == writer_header.Scale()) || !(header.Offset() == writer_header.Offset()))
+            throw std::runtime_error("MergeCopc: The readers must have the scale and offset of the writer.");
+        if (!(header.min == first_header.min) || header.Span() != first_header.Span())
+            throw std::runtime_error("MergeCopc: The readers must share their octree cube.");
+    }
+}
+
+// Keeps limit of the records of point_data, evenly picked across it, and adds the others to dropped_stats
+std::vector<char> Subsample(const std::vector<char> &point_data, size_t record_length, size_t limit,
+                            las::HeaderStats &dropped_stats)
+{
+    const size_t count = point_data.size() / record_length;
+    std::vector<char> out(limit * record_length);
+    std::vector<bool> kept(count, false);
+    for (size_t i = 0; i < limit; i++)
+    {
+        size_t index = i * count / limit;
+        kept[index] = true;
+        std::memcpy(out.data() + i * record_length, point_data.data() + index * record_length, record_length);
+    }
+    for (size_t index = 0; index < count; index++)
+    {
+        if (!kept[index])
+            dropped_stats.Add(point_data.data() + index * record_length, 1, static_cast<uint16_t>(record_length));
+    }
+    return out;
+}
+} // namespace
+
+MergeResult MergeCopc(const std::vector<Reader *> &readers, Writer &writer, bool subsample, size_t max_page_nodes,
+                      unsigned int num_threads)
+{
+    auto writer_config = writer.CopcConfig();
+    auto writer_header = writer_config->LasHeader();
+    CheckCompatibleInputs(readers, *writer_header);
+
+    // Group the nodes of every input by key
+    std::unordered_map<VoxelKey, std::vector<MergeSource>> sources;
+    std::unordered_set<VoxelKey> empty_keys;
+    for (size_t i = 0; i < readers.size(); i++)
+    {
+        for (const auto &node : readers[i]->GetAllNodes())
+        {
+            if (node.point_count > 0)
+                sources[node.key].push_back({i, node});
+            else
+                empty_keys.insert(node.key);
+        }
+    }
+
+    // Write the nodes breadth-first, so that coarse levels are together at the start of the file
+    std::vector<VoxelKey> keys;
+    keys.reserve(sources.size());
+    for (const auto &entry : sources)
+        keys.push_back(entry.first);
+    std::sort(keys.begin(), keys.end(),
+              [](const VoxelKey &a, const VoxelKey &b)
+              { return std::make_tuple(a.d, a.x, a.y, a.z) < std::make_tuple(b.d, b.x, b.y, b.z); });
+    // Leaves keep all their points when subsampling
+    std::unordered_set<VoxelKey> parent_keys;
+    for (const auto &key : keys)
+    {
+        auto parent = key.GetParent();
+        while (parent.IsValid() && parent_keys.insert(parent).second)
+            parent = parent.GetParent();
+    }
+    // Keep the nodes without points whose descendants are written, the octree can't have holes
+    std::vector<VoxelKey> page_keys = keys;
+    std::vector<VoxelKey> empty_parent_keys;
+    for (const auto &key : empty_keys)
+    {
+        if (sources.find(key) == sources.end() && parent_keys.find(key) != parent_keys.end())
+            empty_parent_keys.push_back(key);
+    }
+    page_keys.insert(page_keys.end(), empty_parent_keys.begin(), empty_parent_keys.end());
+    // Pages are assigned here, so that the writer doesn't page the nodes left in the root page again on close
+    auto pages = Internal::AssignPages(page_keys, max_page_nodes);
+    writer.SetPagingPolicy(PagingPolicy{0, 0});
+
+    const auto header = *writer_header;
+    const size_t record_length = header.PointRecordLength();
+
+    // Nodes are processed in parallel by batches, and each batch is written in order since the writer isn't thread
+    // safe. Batches bound the amount of node data held in memory.
+    num_threads = Internal::ResolveNumThreads(num_threads);
+    const size_t batch_size = static_cast<size_t>(num_threads) * 4;
+
+    MergeResult result;
+    las::HeaderStats dropped_stats;
+    std::vector<MergeNode> batch;
+    for (size_t batch_start = 0; batch_start < keys.size(); batch_start += batch_size)
+    {
+        size_t batch_count = std::min(batch_size, keys.size() - batch_start);
+        batch.assign(batch_count, MergeNode());
+
+        Internal::ParallelFor(batch_count, num_threads,
+                              [&](size_t i)
+                              {
+                                  const auto &node_sources = sources.at(keys[batch_start + i]);
+                                  auto &out = batch[i];
+                                  if (node_sources.size() == 1)
+                                  {
+                                      const auto &source = node_sources[0];
+                                      out.compressed_data =
+                                          readers[source.reader_index]->GetPointDataCompressed(source.node);
+                                      out.point_count = source.node.point_count;
+                                      out.copied = true;
+                                      return;
+                                  }
+
+                                  std::vector<char> point_data;
+                                  size_t limit = 0;
+                                  for (const auto &source : node_sources)
+                                  {
+                                      auto data = readers[source.reader_index]->GetPointData(source.node);
+                                      point_data.insert(point_data.end(), data.begin(), data.end());
+                                      limit = std::max(limit, static_cast<size_t>(source.node.point_count));
+                                  }
+                                  size_t count = point_data.size() / record_length;
+                                  if (subsample && count > limit && parent_keys.count(keys[batch_start + i]) > 0)
+                                  {
+                                      point_data = Subsample(point_data, record_length, limit, out.dropped_stats);
+                                      out.points_dropped = count - limit;
+                                      count = limit;
+                                  }
+                                  if (count > static_cast<size_t>((std::numeric_limits<int32_t>::max)()))
+                                      throw std::runtime_error("MergeCopc: Merged node is too large!");
+                                  out.compressed_data = laz::Compressor::CompressBytes(point_data, header);
+                                  out.point_count = static_cast<int32_t>(count);
+                              });
+
+        for (size_t i = 0; i < batch_count; i++)
+        {
+            auto &out = batch[i];
+            const auto &key = keys[batch_start + i];
+            writer.AddNodeCompressed(key, out.compressed_data, out.point_count, pages.at(key));
+            (out.copied ? result.nodes_copied : result.nodes_merged)++;
+            result.point_count += out.point_count;
+            result.points_dropped += out.points_dropped;
+            dropped_stats.Merge(out.dropped_stats);
+        }
+    }
+    for (const auto &key : empty_parent_keys)
+    {
+        writer.AddEmptyNode(key, pages.at(key));
+        result.nodes_empty++;
+    }
+
+    // The inputs share the cube's origin and span, so the union of their bounds keeps the cube
+    writer_header->min = readers[0]->CopcConfig().LasHeader().min;
+    writer_header->max = readers[0]->CopcConfig().LasHeader().max;
+    writer_header->points_by_return = {};
+    auto copc_info = writer_config->CopcInfo();
+    copc_info->gpstime_minimum = readers[0]->CopcConfig().CopcInfo().gpstime_minimum;
+    copc_info->gpstime_maximum = readers[0]->CopcConfig().CopcInfo().gpstime_maximum;
+    for (auto *reader : readers)
+    {
+        const auto reader_header = reader->CopcConfig().LasHeader();
+        writer_header->max.x = std::max(writer_header->max.x, reader_header.max.x);
+        writer_header->max.y = std::max(writer_header->max.y, reader_header.max.y);
+        writer_header->max.z = std::max(writer_header->max.z, reader_header.max.z);
+        const auto info = reader->CopcConfig().CopcInfo();
+        copc_info->gpstime_minimum = std::min(copc_info->gpstime_minimum, info.gpstime_minimum);
+        copc_info->gpstime_maximum = std::max(copc_info->gpstime_maximum, info.gpstime_maximum);
+        for (size_t i = 0; i < reader_header.points_by_return.size(); i++)
+            writer_header->points_by_return[i] += reader_header.points_by_return[i];
+    }
+    auto dropped_by_return = dropped_stats.PointsByReturn();
+    for (size_t i = 0; i < dropped_by_return.size(); i++)
+        writer_header->points_by_return[i] -= std::min(writer_header->points_by_return[i], dropped_by_return[i]);
+    return result;
+}
+
+} // namespace copc
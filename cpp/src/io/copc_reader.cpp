@@ -1,17 +1,49 @@
+#include <algorithm>
 #include <cmath>
 #include <iomanip>
 #include <iostream>
 #include <stdexcept>
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#if defined(POSIX_FADV_WILLNEED)
+#define COPCLIB_HAS_FADVISE
+#endif
+#endif
+
 #include "copc-lib/copc/copc_config.hpp"
 #include "copc-lib/hierarchy/internal/hierarchy.hpp"
+#include "copc-lib/hierarchy/internal/hierarchy_cache.hpp"
 #include "copc-lib/io/copc_reader.hpp"
+#include "copc-lib/io/internal/memory_stream.hpp"
+#include "copc-lib/io/tracing.hpp"
 #include "copc-lib/laz/decompressor.hpp"
 
 #include <lazperf/vlr.hpp>
 
 namespace copc
 {
+namespace
+{
+// Arena for the transient buffers of the nodes decoded on this thread
+Arena &ThreadArena()
+{
+    thread_local Arena arena;
+    return arena;
+}
+
+// Releases an arena once a node has been processed
+class ArenaReleaser
+{
+  public:
+    ArenaReleaser(Arena &arena) : arena_(arena) {}
+    ~ArenaReleaser() { arena_.Release(); }
+
+  private:
+    Arena &arena_;
+};
+} // namespace
 
 void Reader::InitCopcReader()
 {
@@ -24,6 +56,10 @@ void Reader::InitCopcReader()
 
     config_ = copc::CopcConfig(las_config_, copc_info);
     hierarchy_ = std::make_shared<Internal::Hierarchy>(copc_info.root_hier_offset, copc_info.root_hier_size);
+
+    auto stats_offset = FetchVlr(vlrs_, las::DimensionStats::USER_ID, las::DimensionStats::RECORD_ID);
+    if (stats_offset != 0)
+        dimension_stats_ = las::DimensionStats::Unpack(ReadVlrData(stats_offset));
 }
 
 CopcInfo Reader::ReadCopcInfoVlr(std::map<uint64_t, las::VlrHeader> &vlrs)
@@ -35,8 +71,9 @@ CopcInfo Reader::ReadCopcInfoVlr(std::map<uint64_t, las::VlrHeader> &vlrs)
         throw std::runtime_error("Reader::ReadCopcInfoVlr: COPC Info VLR was found in the wrong position, MUST be at "
                                  "offset 375 as per COPC specs.");
 
-    in_stream_->seekg(offset + las::VLR_HEADER_SIZE);
-    return lazperf::copc_info_vlr::create(*in_stream_);
+    auto data = ReadVlrData(offset);
+    Internal::MemoryIStream vlr_stream(data.data(), data.size());
+    return lazperf::copc_info_vlr::create(vlr_stream);
 }
 
 std::vector<Entry> Reader::ReadPage(std::shared_ptr<Internal::PageInternal> page)
@@ -44,15 +81,21 @@ std::vector<Entry> Reader::ReadPage(std::shared_ptr<Internal::PageInternal> page
     std::vector<Entry> out;
     if (!page->IsValid())
         throw std::runtime_error("Reader::ReadPage: Cannot load an invalid page.");
+    Internal::TraceSpan span("Reader::ReadPage", page->key, page->byte_size);
+    IOStats::Timer timer(stats_.get(), IOStats::Phase::PageRead);
+    if (stats_)
+        stats_->Add(IOStats::Counter::PagesLoaded);
 
-    // reset the stream to the page's offset
-    in_stream_->seekg(page->offset);
+    // Read the whole page at once, it is usually served from the EVLR block read at initialization
+    auto page_data = ReadBytes(page->offset, page->byte_size);
+    Internal::MemoryIStream page_stream(page_data.data(), page_data.size());
 
     // Iterate through each Entry in the page
     int num_entries = int(page->byte_size / Entry::ENTRY_SIZE);
+    out.reserve(num_entries);
     for (int i = 0; i < num_entries; i++)
     {
-        Entry e = Entry::Unpack(*in_stream_);
+        Entry e = Entry::Unpack(page_stream);
         if (!e.IsValid())
             throw std::runtime_error("Entry is invalid! " + e.ToString());
 
@@ -65,29 +108,106 @@ std::vector<Entry> Reader::ReadPage(std::shared_ptr<Internal::PageInternal> page
 
 las::Points Reader::GetPoints(Node const &node)
 {
-    std::vector<char> point_data = GetPointData(node);
-    return las::Points::Unpack(point_data, config_.LasHeader());
+    Internal::TraceSpan span("Reader::GetPoints", node.key, node.byte_size);
+    auto &arena = ThreadArena();
+    ArenaReleaser releaser(arena);
+    const char *point_data = DecompressNodeData(node, arena);
+    IOStats::Timer timer(stats_.get(), IOStats::Phase::Unpack);
+    return las::Points::Unpack(point_data, node.point_count * config_.LasHeader().PointRecordLength(),
+                               config_.LasHeader());
 }
 
 las::Points Reader::GetPoints(VoxelKey const &key)
 {
-    std::vector<char> point_data = GetPointData(key);
+    if (!key.IsValid())
+        return las::Points(config_.LasHeader());
 
-    if (point_data.empty())
+    auto node = FindNode(key);
+    if (!node.IsValid())
         return las::Points(config_.LasHeader());
 
-    return las::Points::Unpack(point_data, config_.LasHeader());
+    return GetPoints(node);
 }
 
-std::vector<char> Reader::GetPointData(Node const &node)
+las::Points Reader::GetPoints(Node const &node, Arena &arena)
+{
+    Internal::TraceSpan span("Reader::GetPoints", node.key, node.byte_size);
+    auto &buffer_arena = ThreadArena();
+    ArenaReleaser releaser(buffer_arena);
+    const char *point_data = DecompressNodeData(node, buffer_arena);
+    IOStats::Timer timer(stats_.get(), IOStats::Phase::Unpack);
+    return las::Points::Unpack(point_data, node.point_count * config_.LasHeader().PointRecordLength(),
+                               config_.LasHeader(), arena);
+}
+
+las::PointArray Reader::GetPointsArray(Node const &node, const std::vector<std::string> &dimensions)
+{
+    Internal::TraceSpan span("Reader::GetPointsArray", node.key, node.byte_size);
+    auto &arena = ThreadArena();
+    ArenaReleaser releaser(arena);
+    const char *point_data = DecompressNodeData(node, arena);
+    IOStats::Timer timer(stats_.get(), IOStats::Phase::Unpack);
+    return las::PointArray::Unpack(point_data, node.point_count * config_.LasHeader().PointRecordLength(),
+                                   config_.LasHeader(), dimensions);
+}
+
+las::PointArray Reader::GetPointsArray(VoxelKey const &key, const std::vector<std::string> &dimensions)
+{
+    if (!key.IsValid())
+        return las::PointArray::Unpack(nullptr, 0, config_.LasHeader(), dimensions);
+
+    auto node = FindNode(key);
+    if (!node.IsValid())
+        return las::PointArray::Unpack(nullptr, 0, config_.LasHeader(), dimensions);
+
+    return GetPointsArray(node, dimensions);
+}
+
+const char *Reader::DecompressNodeData(const Node &node, Arena &arena)
 {
     if (!node.IsValid())
         throw std::runtime_error("Reader::GetPointData: Cannot load an invalid node.");
+    // Nodes without points, such as the parents kept by ExtractSubset, have no data
+    if (node.point_count <= 0)
+        return arena.Allocate<char>(0);
+
+    // Prefetched data is already in memory, otherwise the compressed data is read into the arena as well
+    std::vector<char> prefetched;
+    const char *compressed_data;
+    if (TakePrefetchedNodeData(node, prefetched))
+    {
+        compressed_data = prefetched.data();
+    }
+    else
+    {
+        char *data = arena.Allocate<char>(node.byte_size);
+        ReadNodeDataFromStream(node, data);
+        compressed_data = data;
+    }
 
-    in_stream_->seekg(node.offset);
+    const auto &las_header = config_.LasHeader();
+    char *point_data = arena.Allocate<char>(node.point_count * las_header.PointRecordLength());
+    {
+        IOStats::Timer timer(stats_.get(), IOStats::Phase::Decompress);
+        laz::Decompressor::DecompressBytes(compressed_data, node.byte_size, las_header, node.point_count, point_data);
+    }
+    RecordNodeRead(node);
+    return point_data;
+}
 
-    auto las_header = config_.LasHeader();
-    std::vector<char> point_data = laz::Decompressor::DecompressBytes(*in_stream_, las_header, node.point_count);
+std::vector<char> Reader::GetPointData(Node const &node)
+{
+    if (!node.IsValid())
+        throw std::runtime_error("Reader::GetPointData: Cannot load an invalid node.");
+    Internal::TraceSpan span("Reader::GetPointData", node.key, node.byte_size);
+    if (node.point_count <= 0)
+        return {};
+
+    auto compressed_data = ReadNodeData(node);
+    IOStats::Timer timer(stats_.get(), IOStats::Phase::Decompress);
+    std::vector<char> point_data =
+        laz::Decompressor::DecompressBytes(compressed_data, config_.LasHeader(), node.point_count);
+    RecordNodeRead(node);
     return point_data;
 }
 
@@ -109,12 +229,7 @@ std::vector<char> Reader::GetPointDataCompressed(Node const &node)
     if (!node.IsValid())
         throw std::runtime_error("Reader::GetPointDataCompressed: Cannot load an invalid node.");
 
-    in_stream_->seekg(node.offset);
-
-    std::vector<char> out;
-    out.resize(node.byte_size);
-    in_stream_->read(&out[0], node.byte_size);
-    return out;
+    return ReadNodeData(node);
 }
 
 std::vector<char> Reader::GetPointDataCompressed(VoxelKey const &key)
@@ -130,12 +245,153 @@ std::vector<char> Reader::GetPointDataCompressed(VoxelKey const &key)
     return GetPointDataCompressed(node);
 }
 
+std::vector<char> Reader::ReadNodeData(const Node &node)
+{
+    std::vector<char> out;
+    if (TakePrefetchedNodeData(node, out))
+        return out;
+
+    out.resize(node.byte_size);
+    ReadNodeDataFromStream(node, out.data());
+    return out;
+}
+
+void Reader::RecordNodeRead(const Node &node)
+{
+    if (stats_)
+    {
+        stats_->Add(IOStats::Counter::NodesRead);
+        stats_->Add(IOStats::Counter::PointsRead, node.point_count);
+    }
+}
+
+bool Reader::TakePrefetchedNodeData(const Node &node, std::vector<char> &data)
+{
+    std::lock_guard<std::mutex> lock(prefetch_mutex_);
+    auto cached = prefetch_cache_.find(node.key);
+    if (cached != prefetch_cache_.end())
+    {
+        data = std::move(cached->second);
+        prefetch_cache_bytes_ -= data.size();
+        prefetch_cache_.erase(cached);
+        prefetches_used_++;
+        return true;
+    }
+    // If the node is still queued for prefetching, read it now and drop it from the queue
+    prefetch_pending_.erase(node.key);
+    if (prefetch_hinted_.erase(node.key) > 0)
+        prefetches_used_++;
+    return false;
+}
+
+void Reader::ReadNodeDataFromStream(const Node &node, char *out)
+{
+    Internal::TraceSpan span("Reader::ReadNodeData", node.key, node.byte_size);
+    IOStats::Timer timer(stats_.get(), IOStats::Phase::NodeRead);
+    if (stats_)
+    {
+        stats_->Add(IOStats::Counter::Seeks);
+        stats_->Add(IOStats::Counter::BytesRead, node.byte_size);
+    }
+    std::lock_guard<std::mutex> lock(stream_mutex_);
+    in_stream_->clear();
+    in_stream_->seekg(node.offset);
+    in_stream_->read(out, node.byte_size);
+}
+
+void Reader::Prefetch(const std::vector<Node> &nodes)
+{
+    std::vector<Node> to_fetch;
+    {
+        std::lock_guard<std::mutex> lock(prefetch_mutex_);
+        for (const auto &node : nodes)
+        {
+            if (node.IsValid() && prefetch_cache_.find(node.key) == prefetch_cache_.end() &&
+                prefetch_pending_.insert(node.key).second)
+                to_fetch.push_back(node);
+        }
+    }
+    if (to_fetch.empty())
+        return;
+
+    // Read in file order, so that the reads are as sequential as possible
+    std::sort(to_fetch.begin(), to_fetch.end(), [](const Node &a, const Node &b) { return a.offset < b.offset; });
+
+    // Queue behind the previous prefetch, so that only one background read runs at a time
+    std::lock_guard<std::mutex> lock(prefetch_task_mutex_);
+    auto previous_task = prefetch_task_;
+    prefetch_task_ = std::async(std::launch::async,
+                                [this, to_fetch, previous_task]()
+                                {
+                                    if (previous_task.valid())
+                                        previous_task.wait();
+                                    ReadPrefetchedNodes(to_fetch);
+                                })
+                         .share();
+}
+
+void Reader::ReadPrefetchedNodes(const std::vector<Node> &nodes)
+{
+    for (const auto &node : nodes)
+    {
+        {
+            std::lock_guard<std::mutex> lock(prefetch_mutex_);
+            if (prefetch_pending_.find(node.key) == prefetch_pending_.end())
+                continue;
+            // Past the memory bound, the node is left to be read when it's needed
+            if (prefetch_cache_bytes_ + node.byte_size > max_prefetch_bytes_)
+            {
+                prefetch_pending_.erase(node.key);
+                continue;
+            }
+        }
+
+        std::vector<char> data(node.byte_size);
+        {
+            std::lock_guard<std::mutex> lock(stream_mutex_);
+            in_stream_->clear();
+            in_stream_->seekg(node.offset);
+            in_stream_->read(data.data(), node.byte_size);
+            // Leave errors to be reported when the node is actually read
+            if (in_stream_->gcount() != node.byte_size)
+                continue;
+        }
+        if (stats_)
+        {
+            stats_->Add(IOStats::Counter::Seeks);
+            stats_->Add(IOStats::Counter::BytesRead, node.byte_size);
+        }
+
+        std::lock_guard<std::mutex> lock(prefetch_mutex_);
+        // Only keep the data if the node wasn't read in the meantime
+        if (prefetch_pending_.erase(node.key) > 0)
+        {
+            prefetched_bytes_ += data.size();
+            prefetch_cache_bytes_ += data.size();
+            prefetch_cache_[node.key] = std::move(data);
+        }
+    }
+}
+
+void Reader::WaitForPrefetch()
+{
+    // The last task waits for the previous ones, it is waited on outside of the lock so that prefetches can be queued
+    std::shared_future<void> task;
+    {
+        std::lock_guard<std::mutex> lock(prefetch_task_mutex_);
+        task = prefetch_task_;
+    }
+    if (task.valid())
+        task.wait();
+}
+
 std::vector<Node> Reader::GetAllChildrenOfPage(const VoxelKey &key)
 {
     std::vector<Node> out;
     if (!key.IsValid())
         return out;
 
+    std::lock_guard<std::recursive_mutex> lock(hierarchy_mutex_);
     // Load all pages upto the current key
     auto node = FindNode(key);
     // If a page with this key doesn't exist, check if the node itself exists and return it
@@ -153,6 +409,7 @@ std::vector<Node> Reader::GetAllChildrenOfPage(const VoxelKey &key)
 
 std::vector<VoxelKey> Reader::GetPageList()
 {
+    std::lock_guard<std::recursive_mutex> lock(hierarchy_mutex_);
     // Load all nodes and pages in hierarchy
     GetAllNodes();
 
@@ -172,10 +429,21 @@ las::Points Reader::GetAllPoints(double resolution)
 
     auto max_depth = GetDepthAtResolution(resolution);
 
-    // Get all nodes in octree
+    // Get all nodes in octree, and reserve the total number of points once
+    std::vector<Node> nodes;
+    uint64_t point_count = 0;
     for (const auto &node : GetAllNodes())
+    {
         if (node.key.d <= max_depth)
-            out.AddPoints(GetPoints(node));
+        {
+            nodes.push_back(node);
+            point_count += node.point_count;
+        }
+    }
+    RecordQuery(nodes.size());
+    out.Reserve(point_count);
+    for (const auto &node : nodes)
+        out.AddPoints(GetPoints(node));
     return out;
 }
 
@@ -191,6 +459,7 @@ std::vector<Node> Reader::GetNodesWithinBox(const Box &box, double resolution)
             out.push_back(node);
     }
 
+    RecordQuery(out.size());
     return out;
 }
 
@@ -207,6 +476,7 @@ std::vector<Node> Reader::GetNodesIntersectBox(const Box &box, double resolution
             out.push_back(node);
     }
 
+    RecordQuery(out.size());
     return out;
 }
 
@@ -215,23 +485,32 @@ las::Points Reader::GetPointsWithinBox(const Box &box, double resolution)
     auto max_depth = GetDepthAtResolution(resolution);
     auto out = las::Points(config_.LasHeader());
 
-    // Get all nodes in octree
+    // Get all nodes in octree that intersect the box, and reserve an upper bound of the number of points once
+    std::vector<Node> nodes;
+    uint64_t point_count = 0;
     for (const auto &node : GetAllNodes())
     {
-        if (node.key.d <= max_depth)
+        if (node.key.d <= max_depth && node.key.Intersects(config_.LasHeader(), box))
         {
-            // If node fits in Box
-            if (node.key.Within(config_.LasHeader(), box))
-            {
-                // If the node is within the box add all points
-                out.AddPoints(GetPoints(node));
-            }
-            else if (node.key.Intersects(config_.LasHeader(), box))
-            {
-                // If the node only crosses the box then get subset of points within box
-                auto points = GetPoints(node);
-                out.AddPoints(points.GetWithin(box));
-            }
+            nodes.push_back(node);
+            point_count += node.point_count;
+        }
+    }
+    RecordQuery(nodes.size());
+    out.Reserve(point_count);
+
+    for (const auto &node : nodes)
+    {
+        // If node fits in Box
+        if (node.key.Within(config_.LasHeader(), box))
+        {
+            // If the node is within the box add all points
+            out.AddPoints(GetPoints(node));
+        }
+        else
+        {
+            // If the node only crosses the box then get subset of points within box
+            out.AddPoints(GetPoints(node).GetWithin(box));
         }
     }
     return out;
@@ -277,6 +556,7 @@ std::vector<Node> Reader::GetNodesAtResolution(double resolution)
             out.push_back(node);
     }
 
+    RecordQuery(out.size());
     return out;
 }
 
@@ -292,9 +572,19 @@ std::vector<Node> Reader::GetNodesWithinResolution(double resolution)
             out.push_back(node);
     }
 
+    RecordQuery(out.size());
     return out;
 }
 
+void Reader::RecordQuery(size_t node_count)
+{
+    if (stats_)
+    {
+        stats_->Add(IOStats::Counter::Queries);
+        stats_->Add(IOStats::Counter::QueryNodes, node_count);
+    }
+}
+
 bool Reader::ValidateSpatialBounds(bool verbose)
 {
     bool is_valid = true;
@@ -380,4 +670,58 @@ bool Reader::ValidateSpatialBounds(bool verbose)
     return is_valid;
 }
 
+void FileReader::LoadHierarchyCache(const std::string &hierarchy_cache_path)
+{
+    auto identity = Internal::HierarchyCache::Identify(file_path_, config_.CopcInfo());
+    auto hierarchy = Internal::HierarchyCache::Read(hierarchy_cache_path, identity);
+    if (hierarchy)
+    {
+        hierarchy_ = hierarchy;
+        hierarchy_cache_hit_ = true;
+        return;
+    }
+
+    // The cache is missing or stale, so load the whole hierarchy and write it for the next time the file is opened.
+    // Failing to write the cache isn't an error, the file can still be read.
+    GetAllNodes();
+    Internal::HierarchyCache::Write(hierarchy_cache_path, identity, *hierarchy_);
+}
+
+void FileReader::Prefetch(const std::vector<Node> &nodes)
+{
+#ifdef COPCLIB_HAS_FADVISE
+    // The handle is opened under the lock, so that concurrent calls don't each open one
+    std::unique_lock<std::mutex> lock(prefetch_mutex_);
+    if (prefetch_fd_ < 0)
+        prefetch_fd_ = ::open(file_path_.c_str(), O_RDONLY);
+    if (prefetch_fd_ >= 0)
+    {
+        for (const auto &node : nodes)
+        {
+            if (!node.IsValid() || prefetch_cache_.find(node.key) != prefetch_cache_.end())
+                continue;
+            auto offset = static_cast<off_t>(node.offset);
+            if (posix_fadvise(prefetch_fd_, offset, node.byte_size, POSIX_FADV_WILLNEED) == 0 &&
+                prefetch_hinted_.insert(node.key).second)
+                prefetched_bytes_ += node.byte_size;
+        }
+        return;
+    }
+    // Reader::Prefetch takes the lock itself
+    lock.unlock();
+#endif
+    // Without OS hints, read the nodes into memory in the background
+    Reader::Prefetch(nodes);
+}
+
+void FileReader::ClosePrefetchHandle()
+{
+    std::lock_guard<std::mutex> lock(prefetch_mutex_);
+#ifdef COPCLIB_HAS_FADVISE
+    if (prefetch_fd_ >= 0)
+        ::close(prefetch_fd_);
+#endif
+    prefetch_fd_ = -1;
+}
+
 } // namespace copc
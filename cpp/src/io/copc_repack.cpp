@@ -0,0 +1,183 @@
+#include "copc-lib/io/copc_repack.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+#include <unordered_set>
+#include <vector>
+
+#include "copc-lib/hierarchy/internal/paging.hpp"
+
+namespace copc
+{
+
+std::string RepackResult::ToString() const
+{
+    std::stringstream ss;
+    ss << "RepackResult:" << std::endl;
+    ss << "\tnode_count: " << node_count << std::endl;
+    ss << "\tempty_node_count: " << empty_node_count << std::endl;
+    ss << "\tpoint_count: " << point_count << std::endl;
+    ss << "\tpage_count: " << page_count << std::endl;
+    return ss.str();
+}
+
+namespace
+{
+// Number of nodes read ahead of the one being written
+const size_t READ_AHEAD_NODES = 64;
+// 3 coordinates of 21 bits fill a 64 bit index
+const int32_t MAX_HILBERT_BITS = 21;
+
+void CheckCompatibleWriter(const las::LasHeader &reader_header, const las::LasHeader &writer_header)
+{
+    if (reader_header.PointFormatId() != writer_header.PointFormatId() ||
+        reader_header.PointRecordLength() != writer_header.PointRecordLength())
+        throw std::runtime_error("RepackCopc: The writer must have the point format and size of the reader.");
+    if (!(reader_header.Scale() == writer_header.Scale()) || !(reader_header.Offset() == writer_header.Offset()))
+        throw std::runtime_error("RepackCopc: The writer must have the scale and offset of the reader.");
+    if (!(reader_header.min == writer_header.min) || !(reader_header.max == writer_header.max))
+        throw std::runtime_error("RepackCopc: The writer must have the bounds of the reader.");
+}
+} // namespace
+
+// Skilling's transform, from "Programming the Hilbert curve" (AIP Conference Proceedings 707, 2004)
+uint64_t HilbertIndex(const VoxelKey &key)
+{
+    int32_t bits = std::min(key.d, MAX_HILBERT_BITS);
+    if (bits <= 0)
+        return 0;
+    int32_t shift = key.d - bits;
+    uint32_t coords[3] = {static_cast<uint32_t>(key.x) >> shift, static_cast<uint32_t>(key.y) >> shift,
+                          static_cast<uint32_t>(key.z) >> shift};
+
+    // Inverse undo of the curve's rotations and reflections
+    const uint32_t top = 1u << (bits - 1);
+    for (uint32_t q = top; q > 1; q >>= 1)
+    {
+        uint32_t p = q - 1;
+        for (auto &coord : coords)
+        {
+            if (coord & q)
+            {
+                coords[0] ^= p;
+            }
+            else
+            {
+                uint32_t t = (coords[0] ^ coord) & p;
+                coords[0] ^= t;
+                coord ^= t;
+            }
+        }
+    }
+
+    // Gray encode
+    coords[1] ^= coords[0];
+    coords[2] ^= coords[1];
+    uint32_t t = 0;
+    for (uint32_t q = top; q > 1; q >>= 1)
+    {
+        if (coords[2] & q)
+            t ^= q - 1;
+    }
+    for (auto &coord : coords)
+        coord ^= t;
+
+    // Interleave the transposed coordinates, most significant bits first
+    uint64_t index = 0;
+    for (int32_t b = bits - 1; b >= 0; b--)
+    {
+        for (auto coord : coords)
+            index = (index << 1) | ((coord >> b) & 1);
+    }
+    return index;
+}
+
+RepackResult RepackCopc(Reader &reader, Writer &writer, RepackOrder order, size_t max_page_nodes)
+{
+    const auto header = reader.CopcConfig().LasHeader();
+    auto writer_header = writer.CopcConfig()->LasHeader();
+    CheckCompatibleWriter(header, *writer_header);
+    writer_header->points_by_return = header.points_by_return;
+
+    auto nodes = reader.GetAllNodes();
+    // Keep the nodes without points whose descendants are written, the octree can't have holes
+    std::unordered_set<VoxelKey> parent_keys;
+    for (const auto &node : nodes)
+    {
+        if (node.point_count <= 0)
+            continue;
+        auto parent = node.key.GetParent();
+        while (parent.IsValid() && parent_keys.insert(parent).second)
+            parent = parent.GetParent();
+    }
+    std::vector<Node> empty_nodes;
+    std::copy_if(nodes.begin(), nodes.end(), std::back_inserter(empty_nodes), [&](const Node &node)
+                 { return node.point_count <= 0 && parent_keys.find(node.key) != parent_keys.end(); });
+    nodes.erase(std::remove_if(nodes.begin(), nodes.end(), [](const Node &node) { return node.point_count <= 0; }),
+                nodes.end());
+    if (order == RepackOrder::Hilbert)
+    {
+        std::vector<std::pair<uint64_t, Node>> indexed;
+        indexed.reserve(nodes.size());
+        for (const auto &node : nodes)
+            indexed.emplace_back(HilbertIndex(node.key), node);
+        std::sort(indexed.begin(), indexed.end(),
+                  [](const std::pair<uint64_t, Node> &a, const std::pair<uint64_t, Node> &b)
+                  { return std::make_tuple(a.second.key.d, a.first) < std::make_tuple(b.second.key.d, b.first); });
+        for (size_t i = 0; i < nodes.size(); i++)
+            nodes[i] = indexed[i].second;
+    }
+    else
+    {
+        std::sort(nodes.begin(), nodes.end(),
+                  [](const Node &a, const Node &b)
+                  {
+                      return std::make_tuple(a.key.d, a.key.x, a.key.y, a.key.z) <
+                             std::make_tuple(b.key.d, b.key.x, b.key.y, b.key.z);
+                  });
+    }
+
+    std::vector<VoxelKey> keys;
+    keys.reserve(nodes.size());
+    for (const auto &node : nodes)
+        keys.push_back(node.key);
+    for (const auto &node : empty_nodes)
+        keys.push_back(node.key);
+    // Pages are assigned here, so that the writer doesn't page the nodes left in the root page again on close
+    auto pages = Internal::AssignPages(keys, max_page_nodes);
+    writer.SetPagingPolicy(PagingPolicy{0, 0});
+
+    RepackResult result;
+    std::unordered_set<VoxelKey> page_keys;
+    for (size_t i = 0; i < nodes.size(); i++)
+    {
+        // Queue the next window of nodes while the current one is written
+        if (i % READ_AHEAD_NODES == 0)
+        {
+            auto begin = nodes.begin() + static_cast<std::ptrdiff_t>(i);
+            auto end = nodes.begin() + static_cast<std::ptrdiff_t>(std::min(nodes.size(), i + 2 * READ_AHEAD_NODES));
+            reader.Prefetch(std::vector<Node>(begin, end));
+        }
+
+        const auto &node = nodes[i];
+        const auto &page_key = pages.at(node.key);
+        writer.AddNodeCompressed(node.key, reader.GetPointDataCompressed(node), node.point_count, page_key);
+        page_keys.insert(page_key);
+        result.node_count++;
+        result.point_count += node.point_count;
+    }
+    for (const auto &node : empty_nodes)
+    {
+        const auto &page_key = pages.at(node.key);
+        writer.AddEmptyNode(node.key, page_key);
+        page_keys.insert(page_key);
+        result.empty_node_count++;
+    }
+    result.page_count = page_keys.size();
+    return result;
+}
+
+} // namespace copc
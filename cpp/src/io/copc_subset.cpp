@@ -0,0 +1,164 @@
+#include "copc-lib/io/copc_subset.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_set>
+#include <vector>
+
+#include "copc-lib/io/internal/parallel.hpp"
+#include "copc-lib/las/header_stats.hpp"
+#include "copc-lib/laz/compressor.hpp"
+
+namespace copc
+{
+
+std::string SubsetResult::ToString() const
+{
+    std::stringstream ss;
+    ss << "SubsetResult:" << std::endl;
+    ss << "\tnodes_copied: " << nodes_copied << std::endl;
+    ss << "\tnodes_filtered: " << nodes_filtered << std::endl;
+    ss << "\tnodes_empty: " << nodes_empty << std::endl;
+    ss << "\tpoint_count: " << point_count << std::endl;
+    ss << "\tmin: " << min.ToString() << std::endl;
+    ss << "\tmax: " << max.ToString() << std::endl;
+    return ss.str();
+}
+
+namespace
+{
+struct SubsetNode
+{
+    std::vector<char> compressed_data;
+    int32_t point_count{0};
+    bool copied{false};
+    // Bounds of the points of filtered nodes
+    las::HeaderStats stats;
+};
+
+void CheckCompatibleWriter(const las::LasHeader &reader_header, const las::LasHeader &writer_header)
+{
+    if (reader_header.PointFormatId() != writer_header.PointFormatId() ||
+        reader_header.PointRecordLength() != writer_header.PointRecordLength())
+        throw std::runtime_error("ExtractSubset: The writer must have the point format and size of the reader.");
+    if (!(reader_header.Scale() == writer_header.Scale()) || !(reader_header.Offset() == writer_header.Offset()))
+        throw std::runtime_error("ExtractSubset: The writer must have the scale and offset of the reader.");
+    if (!(reader_header.min == writer_header.min) || !(reader_header.max == writer_header.max))
+        throw std::runtime_error("ExtractSubset: The writer must have the bounds of the reader.");
+}
+} // namespace
+
+SubsetResult ExtractSubset(Reader &reader, Writer &writer, const Box &box, double resolution,
+                           unsigned int num_threads)
+{
+    const auto header = reader.CopcConfig().LasHeader();
+    auto writer_header = writer.CopcConfig()->LasHeader();
+    CheckCompatibleWriter(header, *writer_header);
+    writer_header->points_by_return = {};
+
+    // Visit the nodes in file order, so that reads are sequential and the output keeps the input's layout. Nodes
+    // without points may still have to be kept as parents.
+    auto nodes = reader.GetNodesIntersectBox(box, resolution);
+    std::vector<Node> empty_nodes;
+    std::copy_if(nodes.begin(), nodes.end(), std::back_inserter(empty_nodes),
+                 [](const Node &node) { return node.point_count <= 0; });
+    nodes.erase(std::remove_if(nodes.begin(), nodes.end(), [](const Node &node) { return node.point_count <= 0; }),
+                nodes.end());
+    std::sort(nodes.begin(), nodes.end(), [](const Node &a, const Node &b) { return a.offset < b.offset; });
+
+    // Nodes are processed in parallel by batches, and each batch is written in order since the writer isn't thread
+    // safe. Batches bound the amount of node data held in memory.
+    num_threads = Internal::ResolveNumThreads(num_threads);
+    const size_t batch_size = static_cast<size_t>(num_threads) * 4;
+
+    SubsetResult result;
+    std::unordered_set<VoxelKey> written_keys;
+    std::vector<SubsetNode> batch;
+    for (size_t batch_start = 0; batch_start < nodes.size(); batch_start += batch_size)
+    {
+        size_t batch_count = std::min(batch_size, nodes.size() - batch_start);
+        batch.assign(batch_count, SubsetNode());
+
+        Internal::ParallelFor(batch_count, num_threads,
+                              [&](size_t i)
+                              {
+                                  const auto &node = nodes[batch_start + i];
+                                  auto &out = batch[i];
+                                  if (node.key.Within(header, box))
+                                  {
+                                      out.compressed_data = reader.GetPointDataCompressed(node);
+                                      out.point_count = node.point_count;
+                                      out.copied = true;
+                                      return;
+                                  }
+
+                                  auto within = reader.GetPoints(node).GetWithin(box);
+                                  if (within.empty())
+                                      return;
+                                  las::Points points(std::move(within));
+                                  auto point_data = points.Pack(header);
+                                  out.stats.Add(point_data, header);
+                                  out.compressed_data = laz::Compressor::CompressBytes(point_data, header);
+                                  out.point_count = static_cast<int32_t>(points.Size());
+                              });
+
+        for (size_t i = 0; i < batch_count; i++)
+        {
+            auto &out = batch[i];
+            const auto &node = nodes[batch_start + i];
+            if (out.point_count == 0)
+            {
+                empty_nodes.push_back(node);
+                continue;
+            }
+            writer.AddNodeCompressed(node.key, out.compressed_data, out.point_count, node.page_key);
+            (out.copied ? result.nodes_copied : result.nodes_filtered)++;
+            result.point_count += out.point_count;
+
+            // Copied nodes aren't decoded, so their cube, within the file's bounds, stands for their points
+            Vector3 min = out.stats.Min(header), max = out.stats.Max(header);
+            if (out.copied)
+            {
+                Box cube(node.key, header);
+                min = Vector3(std::max(cube.x_min, header.min.x), std::max(cube.y_min, header.min.y),
+                              std::max(cube.z_min, header.min.z));
+                max = Vector3(std::min(cube.x_max, header.max.x), std::min(cube.y_max, header.max.y),
+                              std::min(cube.z_max, header.max.z));
+            }
+            if (written_keys.empty())
+            {
+                result.min = min;
+                result.max = max;
+            }
+            else
+            {
+                result.min = Vector3(std::min(result.min.x, min.x), std::min(result.min.y, min.y),
+                                     std::min(result.min.z, min.z));
+                result.max = Vector3(std::max(result.max.x, max.x), std::max(result.max.y, max.y),
+                                     std::max(result.max.z, max.z));
+            }
+            written_keys.insert(node.key);
+        }
+    }
+
+    // Keep the nodes without points whose descendants were written, the octree can't have holes
+    std::unordered_set<VoxelKey> parent_keys;
+    for (const auto &key : written_keys)
+    {
+        auto parent = key.GetParent();
+        while (parent.IsValid() && parent_keys.insert(parent).second)
+            parent = parent.GetParent();
+    }
+    for (const auto &node : empty_nodes)
+    {
+        if (parent_keys.find(node.key) == parent_keys.end())
+            continue;
+        writer.AddEmptyNode(node.key, node.page_key);
+        result.nodes_empty++;
+    }
+    return result;
+}
+
+} // namespace copc
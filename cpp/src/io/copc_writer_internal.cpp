@@ -1,11 +1,17 @@
+#include <algorithm>
 #include <cstring>
-#include <iterator>
 #include <memory>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <tuple>
+#include <unordered_set>
+#include <vector>
 
 #include "copc-lib/hierarchy/internal/hierarchy.hpp"
+#include "copc-lib/hierarchy/internal/paging.hpp"
 #include "copc-lib/io/internal/copc_writer_internal.hpp"
+#include "copc-lib/io/tracing.hpp"
 
 #include <lazperf/lazperf.hpp>
 #include <lazperf/vlr.hpp>
@@ -14,6 +20,15 @@
 namespace copc::Internal
 {
 
+namespace
+{
+// Orders keys by depth, then by position
+bool KeyLess(const VoxelKey &a, const VoxelKey &b)
+{
+    return std::make_tuple(a.d, a.x, a.y, a.z) < std::make_tuple(b.d, b.x, b.y, b.z);
+}
+} // namespace
+
 size_t WriterInternal::OffsetToPointData() const
 {
     size_t base_laz_offset = laz::BaseWriter::OffsetToPointData();
@@ -24,55 +39,83 @@ size_t WriterInternal::OffsetToPointData() const
     return base_laz_offset + copc_info_vlr_size;
 }
 
-WriterInternal::WriterInternal(std::ostream &out_stream, const std::shared_ptr<CopcConfigWriter> &copc_config_writer,
+WriterInternal::WriterInternal(std::shared_ptr<OutputSink> sink,
+                               const std::shared_ptr<CopcConfigWriter> &copc_config_writer,
                                std::shared_ptr<Hierarchy> hierarchy)
-    : BaseWriter(out_stream, std::static_pointer_cast<las::LazConfig>(copc_config_writer)),
+    : BaseWriter(std::move(sink), std::static_pointer_cast<las::LazConfig>(copc_config_writer)),
       hierarchy_(std::move(hierarchy))
 {
     // reserve enough space for the header & VLRs in the file
-    std::fill_n(std::ostream_iterator<char>(out_stream_), FirstChunkOffset(), 0);
+    std::vector<char> zeros(FirstChunkOffset(), 0);
+    sink_->WriteAt(0, zeros.data(), zeros.size());
 }
 
 void WriterInternal::Close()
 {
     if (!open_)
         return;
+    TraceSpan span("Writer::Close");
 
     WriteChunkTable();
 
+    ApplyPagingPolicy();
+
     // Set COPC hierarchy evlr
-    out_stream_.seekp(0, std::ios::end);
-    evlr_offset_ = static_cast<int64_t>(out_stream_.tellp());
+    evlr_offset_ = sink_->Size();
     evlr_count_ += hierarchy_->seen_pages_.size();
 
     // Compute the hierarchy between existing pages
     ComputePageHierarchy();
     // Page writing must be done in a postorder traversal because each parent
-    // has to write the offset of all of its children, which we don't know in advance
-    WritePageTree(hierarchy_->seen_pages_[VoxelKey::RootKey()]);
+    // has to write the offset of all of its children, which we don't know in advance.
+    // Pages are serialized in memory and written at once.
+    std::vector<char> hierarchy_data;
+    WritePageTree(hierarchy_->seen_pages_[VoxelKey::RootKey()], hierarchy_data);
+    sink_->Append(hierarchy_data.data(), hierarchy_data.size());
+
+    if (accumulate_dimension_stats_)
+        WriteDimensionStats();
 
     WriteWKT();
 
+    if (accumulate_header_stats_)
+        ApplyHeaderStats();
+
     WriteHeader();
 
+    sink_->Flush();
     open_ = false;
 }
 
 // Writes the LAS header and VLRs
 void WriterInternal::WriteHeader()
 {
-    WriteLasHeader();
+    std::ostringstream header_stream;
+    WriteLasHeader(header_stream);
 
     // Write the COPC Info VLR.
     lazperf::copc_info_vlr copc_info_vlr = GetConfig()->CopcInfo()->ToLazPerf();
-    copc_info_vlr.header().write(out_stream_);
-    copc_info_vlr.write(out_stream_);
+    copc_info_vlr.header().write(header_stream);
+    copc_info_vlr.write(header_stream);
 
-    WriteLazAndEbVlrs();
+    WriteLazAndEbVlrs(header_stream);
 
     // Make sure that we haven't gone over allocated size
-    if (static_cast<int64_t>(out_stream_.tellp()) > OffsetToPointData())
+    auto header_data = header_stream.str();
+    if (header_data.size() > OffsetToPointData())
         throw std::runtime_error("WriterInternal::WriteHeader: LasHeader + VLRs are bigger than offset to point data.");
+    sink_->WriteAt(0, header_data.data(), header_data.size());
+}
+
+void WriterInternal::ApplyHeaderStats()
+{
+    auto header_stats = GetHeaderStats();
+    if (header_stats.Empty())
+        return;
+    // The header's bounds define the octree cube that the node keys are relative to, so they are kept
+    GetConfig()->LasHeader()->points_by_return = header_stats.PointsByReturn();
+    GetConfig()->CopcInfo()->gpstime_minimum = header_stats.GpsTimeMin();
+    GetConfig()->CopcInfo()->gpstime_maximum = header_stats.GpsTimeMax();
 }
 
 // Writes a node and returns the node's offset and size in the file
@@ -80,23 +123,75 @@ Entry WriterInternal::WriteNode(const std::vector<char> &in, int32_t point_count
 {
     Entry entry;
 
+    if (accumulate_dimension_stats_ && !compressed)
+    {
+        // The node is summarized outside of the lock, which is only held to merge it
+        auto node_stats = dimension_stats_prototype_;
+        node_stats.Add(in);
+        std::lock_guard<std::mutex> lock(dimension_stats_mutex_);
+        dimension_stats_.Merge(node_stats);
+    }
+
     entry.point_count = WriteChunk(in, point_count, compressed, &entry.offset, &entry.byte_size);
 
     return entry;
 }
 
-void WriterInternal::WritePage(const std::shared_ptr<PageInternal> &page)
+void WriterInternal::SetAccumulateDimensionStats(bool accumulate)
 {
-    auto page_size = page->nodes.size() * 32;
-    page_size += page->sub_pages.size() * 32;
+    std::lock_guard<std::mutex> lock(dimension_stats_mutex_);
+    // The dimensions are resolved the first time statistics are enabled
+    if (accumulate && dimension_stats_prototype_.Dimensions().empty())
+    {
+        dimension_stats_prototype_ = las::DimensionStats(*GetConfig()->LasHeader(), GetConfig()->ExtraBytesVlr());
+        dimension_stats_ = dimension_stats_prototype_;
+    }
+    accumulate_dimension_stats_ = accumulate;
+}
 
-    lazperf::evlr_header h{0, "copc", 1000, page_size, page->key.ToString()};
+las::DimensionStats WriterInternal::GetDimensionStats() const
+{
+    std::lock_guard<std::mutex> lock(dimension_stats_mutex_);
+    return dimension_stats_;
+}
 
-    out_stream_.seekp(0, std::ios::end);
-    h.write(out_stream_);
+void WriterInternal::AddDimensionStats(const las::DimensionStats &dimension_stats)
+{
+    std::lock_guard<std::mutex> lock(dimension_stats_mutex_);
+    if (dimension_stats_.Dimensions().empty())
+        throw std::runtime_error("Writer::AddDimensionStats: Dimension statistics aren't enabled.");
+    dimension_stats_.Merge(dimension_stats);
+}
+
+// Appends the statistics EVLR
+void WriterInternal::WriteDimensionStats()
+{
+    auto data = GetDimensionStats().Pack();
+    lazperf::evlr_header h{0, las::DimensionStats::USER_ID, las::DimensionStats::RECORD_ID, data.size(),
+                           "Dimension statistics"};
+    std::ostringstream header_stream;
+    h.write(header_stream);
+    auto header_data = header_stream.str();
+    sink_->Append(header_data.data(), header_data.size());
+    sink_->Append(data.data(), data.size());
+    evlr_count_++;
+}
+
+// Appends the page's EVLR to the serialized hierarchy, which starts at evlr_offset_
+void WriterInternal::WritePage(const std::shared_ptr<PageInternal> &page, std::vector<char> &hierarchy_data)
+{
+    auto page_size = page->nodes.size() * Entry::ENTRY_SIZE;
+    page_size += page->sub_pages.size() * Entry::ENTRY_SIZE;
+    TraceSpan span("Writer::WritePage", page->key, page_size);
+
+    lazperf::evlr_header h{0, "copc", 1000, page_size, page->key.ToString()};
+    std::ostringstream header_stream;
+    h.write(header_stream);
+    auto header_data = header_stream.str();
+    hierarchy_data.insert(hierarchy_data.end(), header_data.begin(), header_data.end());
 
     // Set the page's offset/size
-    auto offset = static_cast<uint64_t>(out_stream_.tellp());
+    auto offset = evlr_offset_ + hierarchy_data.size();
     page->offset = offset;
     if (page_size > (std::numeric_limits<int32_t>::max)())
         throw std::runtime_error("Page is too large!");
@@ -109,10 +204,62 @@ void WriterInternal::WritePage(const std::shared_ptr<PageInternal> &page)
         GetConfig()->CopcInfo()->root_hier_size = page_size;
     }
 
+    // Entries are sorted by key, so that the output doesn't depend on hashing or allocation order
+    std::vector<const Entry *> entries;
+    entries.reserve(page->nodes.size() + page->sub_pages.size());
     for (const auto &node : page->nodes)
-        node.second->Pack(out_stream_);
-    for (const auto &node : page->sub_pages)
-        node->Pack(out_stream_);
+        entries.push_back(node.second.get());
+    auto sub_pages_begin = static_cast<std::ptrdiff_t>(entries.size());
+    for (const auto &sub_page : page->sub_pages)
+        entries.push_back(sub_page.get());
+    auto by_key = [](const Entry *a, const Entry *b) { return KeyLess(a->key, b->key); };
+    std::sort(entries.begin(), entries.begin() + sub_pages_begin, by_key);
+    std::sort(entries.begin() + sub_pages_begin, entries.end(), by_key);
+
+    auto pos = hierarchy_data.size();
+    hierarchy_data.resize(pos + page_size);
+    for (const auto *entry : entries)
+    {
+        entry->Pack(hierarchy_data.data() + pos);
+        pos += Entry::ENTRY_SIZE;
+    }
+}
+
+void WriterInternal::ApplyPagingPolicy()
+{
+    if (paging_policy_.max_page_nodes == 0 && paging_policy_.depth_step <= 0)
+        return;
+    auto root_page = hierarchy_->seen_pages_.find(VoxelKey::RootKey());
+    if (root_page == hierarchy_->seen_pages_.end() || root_page->second == nullptr)
+        return;
+
+    std::vector<VoxelKey> keys;
+    keys.reserve(root_page->second->nodes.size());
+    for (const auto &node : root_page->second->nodes)
+        keys.push_back(node.first);
+    auto pages = paging_policy_.depth_step > 0 ? AssignPagesByDepth(keys, paging_policy_.depth_step)
+                                               : AssignPages(keys, paging_policy_.max_page_nodes);
+
+    // Pages that already exist were made by the user, their nodes aren't mixed with paged ones
+    std::unordered_set<VoxelKey> user_pages;
+    for (const auto &page : hierarchy_->seen_pages_)
+        user_pages.insert(page.first);
+
+    for (const auto &entry : pages)
+    {
+        if (user_pages.count(entry.second) > 0)
+            continue;
+        auto &page = hierarchy_->seen_pages_[entry.second];
+        if (page == nullptr)
+        {
+            page = std::make_shared<PageInternal>(entry.second);
+            page->loaded = true;
+        }
+        auto node = root_page->second->nodes.at(entry.first);
+        node->page_key = entry.second;
+        page->nodes[entry.first] = node;
+        root_page->second->nodes.erase(entry.first);
+    }
 }
 
 void WriterInternal::ComputePageHierarchy()
@@ -135,19 +282,24 @@ void WriterInternal::ComputePageHierarchy()
 }
 
 // https://en.wikipedia.org/wiki/Tree_traversal#Arbitrary_trees
-void WriterInternal::WritePageTree(const std::shared_ptr<PageInternal> &current)
+void WriterInternal::WritePageTree(const std::shared_ptr<PageInternal> &current, std::vector<char> &hierarchy_data)
 {
     // If the current node is empty then return.
     if (current == nullptr)
         return;
 
     // For each i from 1 to the current node's number of subtrees, do:
-    for (const auto &child : current->sub_pages)
+    // Subtrees are visited by key rather than by pointer, so that sibling pages are laid out in a stable order
+    std::vector<std::shared_ptr<PageInternal>> children(current->sub_pages.begin(), current->sub_pages.end());
+    std::sort(children.begin(), children.end(),
+              [](const std::shared_ptr<PageInternal> &a, const std::shared_ptr<PageInternal> &b)
+              { return KeyLess(a->key, b->key); });
+    for (const auto &child : children)
     {
-        WritePageTree(child);
+        WritePageTree(child, hierarchy_data);
     }
 
     // Visit the current node for post-order traversal.
-    WritePage(current);
+    WritePage(current, hierarchy_data);
 }
 } // namespace copc::Internal
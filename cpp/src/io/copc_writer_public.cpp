@@ -2,13 +2,16 @@
 #include "copc-lib/hierarchy/internal/page.hpp"
 #include "copc-lib/io/copc_writer.hpp"
 #include "copc-lib/io/internal/copc_writer_internal.hpp"
+#include "copc-lib/io/tracing.hpp"
 #include "copc-lib/las/point.hpp"
 #include "copc-lib/laz/decompressor.hpp"
 
+#include <utility>
+
 namespace copc
 {
 
-void Writer::InitWriter(std::ostream &out_stream, const CopcConfigWriter &copc_config_writer,
+void Writer::InitWriter(std::shared_ptr<OutputSink> sink, const CopcConfigWriter &copc_config_writer,
                         const std::optional<int8_t> &point_format_id, const std::optional<Vector3> &scale,
                         const std::optional<Vector3> &offset, const std::optional<std::string> &wkt,
                         const std::optional<las::EbVlr> &extra_bytes_vlr, const std::optional<bool> &has_extended_stats)
@@ -53,7 +56,7 @@ void Writer::InitWriter(std::ostream &out_stream, const CopcConfigWriter &copc_c
         this->config_ = std::make_shared<CopcConfigWriter>(copc_config_writer);
     }
     this->hierarchy_ = std::make_shared<Internal::Hierarchy>();
-    this->writer_ = std::make_unique<Internal::WriterInternal>(out_stream, this->config_, this->hierarchy_);
+    this->writer_ = std::make_unique<Internal::WriterInternal>(std::move(sink), this->config_, this->hierarchy_);
 }
 
 void Writer::Close()
@@ -70,12 +73,16 @@ Node Writer::DoAddNode(const VoxelKey &key, const std::vector<char> &in, int32_t
 {
     if (!page_key.IsValid() || !key.IsValid())
         throw std::runtime_error("Invalid page or node key!");
+    Internal::TraceSpan span("Writer::AddNode", key, in.size());
     // TODO[leo]: Check if node already loaded
 
     if (!key.ChildOf(page_key))
         throw std::runtime_error("Target key " + key.ToString() + " is not a child of page node " + key.ToString());
 
-    Entry e = writer_->WriteNode(in, point_count, compressed_data);
+    // Empty nodes have no chunk
+    Entry e(key, 0, 0, 0);
+    if (!in.empty())
+        e = writer_->WriteNode(in, point_count, compressed_data);
     e.key = key;
 
     auto node = std::make_shared<Node>(e, page_key);
@@ -100,20 +107,45 @@ Node Writer::AddNode(const VoxelKey &key, const las::Points &points, const Voxel
         points.PointRecordLength() != config_->LasHeader()->PointRecordLength())
         throw std::runtime_error("Writer::AddNode: New points must be of same format and size.");
 
-    std::vector<char> uncompressed_data = points.Pack(*config_->LasHeader());
-    return AddNode(key, uncompressed_data, page_key);
+    auto stats = Stats();
+    std::vector<char> uncompressed_data;
+    {
+        IOStats::Timer timer(stats.get(), IOStats::Phase::Pack);
+        uncompressed_data = points.Pack(*config_->LasHeader());
+    }
+    // The packed data is ours, so it's sorted in place
+    return AddNode(key, std::move(uncompressed_data), page_key);
 }
 
 Node Writer::AddNode(const VoxelKey &key, std::vector<char> const &uncompressed_data, const VoxelKey &page_key)
 {
-    int point_size = config_->LasHeader()->PointRecordLength();
+    // The caller's data is only copied if it has to be sorted
+    if (writer_->GetPointOrder() != las::PointOrder::Unchanged)
+        return AddNode(key, std::vector<char>(uncompressed_data), page_key);
+
+    CheckPointData(uncompressed_data);
+    return DoAddNode(key, uncompressed_data, 0, false, page_key);
+}
+
+Node Writer::AddNode(const VoxelKey &key, std::vector<char> &&uncompressed_data, const VoxelKey &page_key)
+{
+    CheckPointData(uncompressed_data);
 
+    auto point_order = writer_->GetPointOrder();
+    if (point_order != las::PointOrder::Unchanged)
+    {
+        IOStats::Timer timer(Stats().get(), IOStats::Phase::Pack);
+        las::SortPointData(uncompressed_data, *config_->LasHeader(), point_order);
+    }
+    return DoAddNode(key, uncompressed_data, 0, false, page_key);
+}
+
+void Writer::CheckPointData(const std::vector<char> &uncompressed_data) const
+{
     if (uncompressed_data.empty())
         throw std::runtime_error("Writer::AddNode: Empty point data array.");
-    if (uncompressed_data.size() % point_size != 0)
+    if (uncompressed_data.size() % config_->LasHeader()->PointRecordLength() != 0)
         throw std::runtime_error("Writer::AddNode: Invalid point data array.");
-
-    return DoAddNode(key, uncompressed_data, 0, false, page_key);
 }
 
 Node Writer::AddNodeCompressed(const VoxelKey &key, std::vector<char> const &compressed_data, int32_t point_count,
@@ -121,10 +153,17 @@ Node Writer::AddNodeCompressed(const VoxelKey &key, std::vector<char> const &com
 {
     if (point_count == 0)
         throw std::runtime_error("Point count must be >0!");
+    if (compressed_data.empty())
+        throw std::runtime_error("Writer::AddNodeCompressed: Empty compressed data.");
 
     return DoAddNode(key, compressed_data, point_count, true, page_key);
 }
 
+Node Writer::AddEmptyNode(const VoxelKey &key, const VoxelKey &page_key)
+{
+    return DoAddNode(key, {}, 0, true, page_key);
+}
+
 void Writer::ChangeNodePage(const VoxelKey &node_key, const VoxelKey &new_page_key)
 {
     if (!node_key.IsValid())
@@ -163,6 +202,42 @@ void Writer::ChangeNodePage(const VoxelKey &node_key, const VoxelKey &new_page_k
         hierarchy_->seen_pages_.erase(node->page_key);
 }
 
+void Writer::SetPagingPolicy(const PagingPolicy &paging_policy)
+{
+    if (paging_policy.depth_step < 0)
+        throw std::runtime_error("Writer::SetPagingPolicy: The depth step can't be negative.");
+    writer_->SetPagingPolicy(paging_policy);
+}
+
+PagingPolicy Writer::GetPagingPolicy() const { return writer_->GetPagingPolicy(); }
+
+void Writer::SetPointOrder(las::PointOrder point_order) { writer_->SetPointOrder(point_order); }
+
+las::PointOrder Writer::GetPointOrder() const { return writer_->GetPointOrder(); }
+
+void Writer::SetStats(const std::shared_ptr<IOStats> &stats) { writer_->SetStats(stats); }
+
+std::shared_ptr<IOStats> Writer::Stats() const { return writer_->Stats(); }
+
+void Writer::SetAccumulateHeaderStats(bool accumulate) { writer_->SetAccumulateHeaderStats(accumulate); }
+
+bool Writer::GetAccumulateHeaderStats() const { return writer_->GetAccumulateHeaderStats(); }
+
+las::HeaderStats Writer::GetHeaderStats() const { return writer_->GetHeaderStats(); }
+
+void Writer::AddHeaderStats(const las::HeaderStats &header_stats) { writer_->AddHeaderStats(header_stats); }
+
+void Writer::SetAccumulateDimensionStats(bool accumulate) { writer_->SetAccumulateDimensionStats(accumulate); }
+
+bool Writer::GetAccumulateDimensionStats() const { return writer_->GetAccumulateDimensionStats(); }
+
+las::DimensionStats Writer::GetDimensionStats() const { return writer_->GetDimensionStats(); }
+
+void Writer::AddDimensionStats(const las::DimensionStats &dimension_stats)
+{
+    writer_->AddDimensionStats(dimension_stats);
+}
+
 void FileWriter::Close()
 {
     if (writer_ != nullptr)
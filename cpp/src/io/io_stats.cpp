@@ -0,0 +1,147 @@
+#include "copc-lib/io/io_stats.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+namespace copc
+{
+
+uint64_t IOStats::PhaseSnapshot::PercentileNs(double quantile) const
+{
+    if (quantile < 0 || quantile > 1)
+        throw std::runtime_error("IOStats::PhaseSnapshot::PercentileNs: Quantile must be in [0, 1].");
+    if (count == 0)
+        return 0;
+
+    auto target = static_cast<uint64_t>(quantile * static_cast<double>(count));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; i++)
+    {
+        seen += buckets[i];
+        if (seen > target || seen == count)
+            return std::min(max_ns, (uint64_t{2} << i) - 1);
+    }
+    return max_ns;
+}
+
+std::string IOStats::Snapshot::ToString() const
+{
+    std::stringstream ss;
+    ss << "IOStats:" << std::endl;
+    for (size_t i = 0; i < COUNTER_COUNT; i++)
+        ss << "\t" << CounterName(static_cast<Counter>(i)) << ": " << counters[i] << std::endl;
+    for (size_t i = 0; i < PHASE_COUNT; i++)
+    {
+        const auto &phase = phases[i];
+        if (phase.count == 0)
+            continue;
+        ss << "\t" << PhaseName(static_cast<Phase>(i)) << ": count " << phase.count << ", mean "
+           << phase.MeanNs() / 1000 << " us, p50 " << phase.PercentileNs(0.5) / 1000 << " us, p99 "
+           << phase.PercentileNs(0.99) / 1000 << " us, max " << phase.max_ns / 1000 << " us" << std::endl;
+    }
+    return ss.str();
+}
+
+void IOStats::Record(Phase phase, int64_t duration_ns)
+{
+    auto ns = static_cast<uint64_t>(std::max<int64_t>(duration_ns, 0));
+    size_t bucket = 0;
+    while (bucket + 1 < BUCKET_COUNT && (ns >> (bucket + 1)) > 0)
+        bucket++;
+
+    auto &histogram = phases_[static_cast<size_t>(phase)];
+    histogram.count.fetch_add(1, std::memory_order_relaxed);
+    histogram.total_ns.fetch_add(ns, std::memory_order_relaxed);
+    histogram.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    uint64_t max_ns = histogram.max_ns.load(std::memory_order_relaxed);
+    while (ns > max_ns && !histogram.max_ns.compare_exchange_weak(max_ns, ns, std::memory_order_relaxed))
+    {
+    }
+}
+
+IOStats::Snapshot IOStats::GetSnapshot() const
+{
+    Snapshot snapshot;
+    for (size_t i = 0; i < COUNTER_COUNT; i++)
+        snapshot.counters[i] = counters_[i].load(std::memory_order_relaxed);
+    for (size_t i = 0; i < PHASE_COUNT; i++)
+    {
+        const auto &histogram = phases_[i];
+        auto &phase = snapshot.phases[i];
+        phase.count = histogram.count.load(std::memory_order_relaxed);
+        phase.total_ns = histogram.total_ns.load(std::memory_order_relaxed);
+        phase.max_ns = histogram.max_ns.load(std::memory_order_relaxed);
+        for (size_t b = 0; b < BUCKET_COUNT; b++)
+            phase.buckets[b] = histogram.buckets[b].load(std::memory_order_relaxed);
+    }
+    return snapshot;
+}
+
+void IOStats::Reset()
+{
+    for (auto &counter : counters_)
+        counter.store(0, std::memory_order_relaxed);
+    for (auto &histogram : phases_)
+    {
+        histogram.count.store(0, std::memory_order_relaxed);
+        histogram.total_ns.store(0, std::memory_order_relaxed);
+        histogram.max_ns.store(0, std::memory_order_relaxed);
+        for (auto &bucket : histogram.buckets)
+            bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+std::string IOStats::CounterName(Counter counter)
+{
+    switch (counter)
+    {
+    case Counter::PagesLoaded:
+        return "pages_loaded";
+    case Counter::NodesRead:
+        return "nodes_read";
+    case Counter::PointsRead:
+        return "points_read";
+    case Counter::BytesRead:
+        return "bytes_read";
+    case Counter::Seeks:
+        return "seeks";
+    case Counter::NodesWritten:
+        return "nodes_written";
+    case Counter::PointsWritten:
+        return "points_written";
+    case Counter::BytesWritten:
+        return "bytes_written";
+    case Counter::Queries:
+        return "queries";
+    case Counter::QueryNodes:
+        return "query_nodes";
+    default:
+        throw std::runtime_error("IOStats::CounterName: Unknown counter.");
+    }
+}
+
+std::string IOStats::PhaseName(Phase phase)
+{
+    switch (phase)
+    {
+    case Phase::PageRead:
+        return "page_read";
+    case Phase::NodeRead:
+        return "node_read";
+    case Phase::Decompress:
+        return "decompress";
+    case Phase::Unpack:
+        return "unpack";
+    case Phase::Pack:
+        return "pack";
+    case Phase::Compress:
+        return "compress";
+    case Phase::Write:
+        return "write";
+    default:
+        throw std::runtime_error("IOStats::PhaseName: Unknown phase.");
+    }
+}
+
+} // namespace copc
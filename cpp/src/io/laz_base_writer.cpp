@@ -1,8 +1,11 @@
 #include "copc-lib/io/laz_base_writer.hpp"
 
+#include <sstream>
+
 #include <lazperf/filestream.hpp>
 #include <lazperf/vlr.hpp>
 
+#include "copc-lib/io/internal/memory_stream.hpp"
 #include "copc-lib/laz/compressor.hpp"
 
 namespace copc::laz
@@ -24,52 +27,51 @@ size_t BaseWriter::OffsetToPointData() const
     return las::LasHeader::HEADER_SIZE_BYTES + las_eb_vlr_size + laz_vlr_size;
 }
 
-void BaseWriter::WriteLasHeader()
+void BaseWriter::WriteLasHeader(std::ostream &out_stream)
 {
     // Write LAS header
     auto las_header = config_->LasHeader().ToLazPerf(OffsetToPointData(), point_count_, evlr_offset_, evlr_count_,
                                                      config_->LasHeader().EbByteSize());
-    out_stream_.seekp(0);
-    las_header.write(out_stream_);
+    las_header.write(out_stream);
 }
 
-void BaseWriter::WriteLazAndEbVlrs()
+void BaseWriter::WriteLazAndEbVlrs(std::ostream &out_stream)
 {
 
     // Write optional LAS Extra Byte VLR
     if (config_->LasHeader().EbByteSize() > 0)
     {
         auto ebVlr = this->config_->ExtraBytesVlr();
-        ebVlr.header().write(out_stream_);
-        ebVlr.write(out_stream_);
+        ebVlr.header().write(out_stream);
+        ebVlr.write(out_stream);
     }
 
     // Write the LAZ VLR
     lazperf::laz_vlr lazVlr(config_->LasHeader().PointFormatId(), config_->LasHeader().EbByteSize(),
                             VARIABLE_CHUNK_SIZE);
-    lazVlr.header().write(out_stream_);
-    lazVlr.write(out_stream_);
+    lazVlr.header().write(out_stream);
+    lazVlr.write(out_stream);
 }
 
 // Writes the LAS header and VLRs
 void BaseWriter::WriteHeader()
 {
-    WriteLasHeader();
+    std::ostringstream header_stream;
+    WriteLasHeader(header_stream);
 
-    WriteLazAndEbVlrs();
+    WriteLazAndEbVlrs(header_stream);
 
     // Make sure that we haven't gone over allocated size
-    if (out_stream_.tellp() > OffsetToPointData())
+    auto header_data = header_stream.str();
+    if (header_data.size() > OffsetToPointData())
         throw std::runtime_error("BaseWriter::WriteHeader: LasHeader + VLRs are bigger than offset to point data.");
+    sink_->WriteAt(0, header_data.data(), header_data.size());
 }
 
 void BaseWriter::WriteChunkTable()
 {
-    // move to the end of the file to start emitting our compressed table
-    out_stream_.seekp(0, std::ios::end);
-
-    // take note of where we're writing the chunk table, we need this later
-    auto chunk_table_offset = static_cast<uint64_t>(out_stream_.tellp());
+    // take note of where we're writing the chunk table, at the end of the file, we need this later
+    uint64_t chunk_table_offset = sink_->Size();
 
     // Fixup the chunk table to be relative offsets rather than absolute ones.
     uint64_t prevOffset = FirstChunkOffset();
@@ -81,20 +83,24 @@ void BaseWriter::WriteChunkTable()
     }
 
     // write out the chunk table header (version and total chunks)
+    std::ostringstream table_stream;
     uint32_t version = 0;
-    out_stream_.write((const char *)&version, sizeof(uint32_t));
+    table_stream.write((const char *)&version, sizeof(uint32_t));
     if (chunks_.size() > (std::numeric_limits<uint32_t>::max)())
         throw std::runtime_error("You've got way too many chunks!");
     auto numChunks = static_cast<uint32_t>(chunks_.size());
-    out_stream_.write((const char *)&numChunks, sizeof(uint32_t));
+    table_stream.write((const char *)&numChunks, sizeof(uint32_t));
 
     // Write the chunk table
-    lazperf::OutFileStream w(out_stream_);
+    {
+        lazperf::OutFileStream w(table_stream);
+        compress_chunk_table(w.cb(), chunks_, true);
+    }
+    auto table_data = table_stream.str();
+    sink_->Append(table_data.data(), table_data.size());
 
-    compress_chunk_table(w.cb(), chunks_, true);
     // go back to where we're supposed to write chunk table offset
-    out_stream_.seekp(static_cast<int64_t>(OffsetToPointData()));
-    out_stream_.write(reinterpret_cast<char *>(&chunk_table_offset), sizeof(uint64_t));
+    sink_->WriteAt(OffsetToPointData(), reinterpret_cast<const char *>(&chunk_table_offset), sizeof(uint64_t));
 }
 
 void BaseWriter::WriteWKT()
@@ -104,31 +110,49 @@ void BaseWriter::WriteWKT()
     {
         evlr_count_++;
         lazperf::wkt_vlr wkt_vlr(config_->Wkt());
-        wkt_vlr.eheader().write(out_stream_);
-        wkt_vlr.write(out_stream_);
+        std::ostringstream wkt_stream;
+        wkt_vlr.eheader().write(wkt_stream);
+        wkt_vlr.write(wkt_stream);
+        auto wkt_data = wkt_stream.str();
+        sink_->Append(wkt_data.data(), wkt_data.size());
     }
 }
 
 int32_t BaseWriter::WriteChunk(const std::vector<char> &in, int32_t point_count, bool compressed, uint64_t *offset,
                                int32_t *byte_size)
 {
-    uint64_t startpos = out_stream_.tellp();
-    if (startpos <= 0)
-        throw std::runtime_error("BaseWriter::WriteChunk: Error while writing chunk!");
+    if (accumulate_header_stats_ && !compressed)
+    {
+        las::HeaderStats chunk_stats;
+        chunk_stats.Add(in, config_->LasHeader());
+        AddHeaderStats(chunk_stats);
+    }
+
+    uint64_t startpos = sink_->Size();
     if (offset != nullptr)
-        *offset = static_cast<uint64_t>(startpos);
+        *offset = startpos;
 
     if (compressed)
-        out_stream_.write(in.data(), in.size());
+    {
+        IOStats::Timer timer(stats_.get(), IOStats::Phase::Write);
+        sink_->Append(in.data(), in.size());
+    }
     else
-        point_count = laz::Compressor::CompressBytes(out_stream_, config_->LasHeader(), in);
+    {
+        // The buffer is reused across chunks, so it only grows to the largest one
+        compress_buffer_.clear();
+        {
+            IOStats::Timer timer(stats_.get(), IOStats::Phase::Compress);
+            Internal::VectorOStream compressed_stream(compress_buffer_);
+            point_count = laz::Compressor::CompressBytes(compressed_stream, config_->LasHeader(), in);
+        }
+        IOStats::Timer timer(stats_.get(), IOStats::Phase::Write);
+        sink_->Append(compress_buffer_.data(), compress_buffer_.size());
+    }
 
     point_count_ += point_count;
 
-    uint64_t endpos = out_stream_.tellp();
-    if (endpos <= 0)
-        throw std::runtime_error("BaseWriter::WriteChunk: Error while writing chunk!");
-
+    uint64_t endpos = sink_->Size();
     chunks_.push_back(lazperf::chunk{static_cast<uint64_t>(point_count), endpos});
 
     auto size = endpos - startpos;
@@ -136,6 +160,12 @@ int32_t BaseWriter::WriteChunk(const std::vector<char> &in, int32_t point_count,
         throw std::runtime_error("BaseWriter::WriteChunk: Chunk is too large!");
     if (byte_size != nullptr)
         *byte_size = static_cast<int32_t>(size);
+    if (stats_)
+    {
+        stats_->Add(IOStats::Counter::NodesWritten);
+        stats_->Add(IOStats::Counter::PointsWritten, point_count);
+        stats_->Add(IOStats::Counter::BytesWritten, size);
+    }
     if (point_count > (std::numeric_limits<int32_t>::max)())
         throw std::runtime_error("BaseWriter::WriteChunk: Chunk has too many points!");
     return point_count;
@@ -149,27 +179,40 @@ void BaseWriter::Close()
     WriteChunkTable();
 
     // Set hierarchy evlr
-    out_stream_.seekp(0, std::ios::end);
-    evlr_offset_ = out_stream_.tellp();
+    evlr_offset_ = sink_->Size();
 
     WriteWKT();
 
+    if (accumulate_header_stats_)
+        ApplyHeaderStats();
+
     WriteHeader();
 
+    sink_->Flush();
     open_ = false;
 }
 
-BaseFileWriter::BaseFileWriter(const std::string &file_path)
+las::HeaderStats BaseWriter::GetHeaderStats() const
+{
+    std::lock_guard<std::mutex> lock(header_stats_mutex_);
+    return header_stats_;
+}
+
+void BaseWriter::AddHeaderStats(const las::HeaderStats &header_stats)
+{
+    std::lock_guard<std::mutex> lock(header_stats_mutex_);
+    header_stats_.Merge(header_stats);
+}
+
+BaseFileWriter::BaseFileWriter(const std::string &file_path, const FileSinkOptions &sink_options)
 {
     file_path_ = file_path;
-    f_stream_.open(file_path.c_str(), std::ios::out | std::ios::binary);
-    if (!f_stream_.good())
-        throw std::runtime_error("FileWriterBase: Error while opening file path.");
+    file_sink_ = std::make_shared<FileSink>(file_path, sink_options);
 }
 
 void BaseFileWriter::Close()
 {
-    if (f_stream_.is_open())
-        f_stream_.close();
+    if (file_sink_)
+        file_sink_->Close();
 }
 } // namespace copc::laz
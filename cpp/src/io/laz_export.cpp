@@ -0,0 +1,113 @@
+#include "copc-lib/io/laz_export.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "copc-lib/las/header_stats.hpp"
+#include "copc-lib/laz/decompressor.hpp"
+
+namespace copc
+{
+
+std::string LazExportResult::ToString() const
+{
+    std::stringstream ss;
+    ss << "LazExportResult:" << std::endl;
+    ss << "\tnode_count: " << node_count << std::endl;
+    ss << "\tpoint_count: " << point_count << std::endl;
+    return ss.str();
+}
+
+namespace
+{
+// Number of nodes read ahead of the one being written
+const size_t READ_AHEAD_NODES = 64;
+} // namespace
+
+LazExportResult ExportToLaz(Reader &reader, laz::LazWriter &writer, const Box &box, double resolution)
+{
+    const auto header = reader.CopcConfig().LasHeader();
+    auto writer_header = writer.LazConfig()->LasHeader();
+    if (header.PointFormatId() != writer_header->PointFormatId() ||
+        header.PointRecordLength() != writer_header->PointRecordLength())
+        throw std::runtime_error("ExportToLaz: The writer must have the point format and size of the reader.");
+    if (!(header.Scale() == writer_header->Scale()) || !(header.Offset() == writer_header->Offset()))
+        throw std::runtime_error("ExportToLaz: The writer must have the scale and offset of the reader.");
+
+    auto nodes = reader.GetNodesIntersectBox(box, resolution);
+    nodes.erase(std::remove_if(nodes.begin(), nodes.end(), [](const Node &node) { return node.point_count <= 0; }),
+                nodes.end());
+    std::sort(nodes.begin(), nodes.end(), [](const Node &a, const Node &b) { return a.offset < b.offset; });
+
+    uint64_t export_point_count = 0;
+    for (const auto &node : nodes)
+        export_point_count += node.point_count;
+    // The bounds and points by return of a partial export are only known by decoding its points
+    const bool decode_stats = writer.GetAccumulateHeaderStats() && export_point_count != header.PointCount();
+
+    LazExportResult result;
+    // Union of the written node cubes
+    Box bounds;
+    for (size_t i = 0; i < nodes.size(); i++)
+    {
+        // Queue the next window of nodes while the current one is written
+        if (i % READ_AHEAD_NODES == 0)
+        {
+            auto begin = nodes.begin() + static_cast<std::ptrdiff_t>(i);
+            auto end = nodes.begin() + static_cast<std::ptrdiff_t>(std::min(nodes.size(), i + 2 * READ_AHEAD_NODES));
+            reader.Prefetch(std::vector<Node>(begin, end));
+        }
+
+        const auto &node = nodes[i];
+        auto compressed_data = reader.GetPointDataCompressed(node);
+        writer.WritePointsCompressed(compressed_data, node.point_count);
+        // The writer sets its header from the decoded points on close
+        if (decode_stats)
+        {
+            las::HeaderStats node_stats;
+            node_stats.Add(laz::Decompressor::DecompressBytes(compressed_data, header, node.point_count), header);
+            writer.AddHeaderStats(node_stats);
+        }
+        result.node_count++;
+        result.point_count += node.point_count;
+
+        Box node_box(node.key, header);
+        if (result.node_count == 1)
+            bounds = node_box;
+        bounds.x_min = std::min(bounds.x_min, node_box.x_min);
+        bounds.y_min = std::min(bounds.y_min, node_box.y_min);
+        bounds.z_min = std::min(bounds.z_min, node_box.z_min);
+        bounds.x_max = std::max(bounds.x_max, node_box.x_max);
+        bounds.y_max = std::max(bounds.y_max, node_box.y_max);
+        bounds.z_max = std::max(bounds.z_max, node_box.z_max);
+    }
+
+    if (result.point_count == header.PointCount())
+    {
+        writer_header->min = header.min;
+        writer_header->max = header.max;
+        writer_header->points_by_return = header.points_by_return;
+    }
+    else
+    {
+        // Unknown without decoding the points. When they are decoded, the writer replaces these on close.
+        writer_header->points_by_return = {};
+        if (result.node_count > 0)
+        {
+            writer_header->min = Vector3(std::max(bounds.x_min, header.min.x), std::max(bounds.y_min, header.min.y),
+                                         std::max(bounds.z_min, header.min.z));
+            writer_header->max = Vector3(std::min(bounds.x_max, header.max.x), std::min(bounds.y_max, header.max.y),
+                                         std::min(bounds.z_max, header.max.z));
+        }
+        else
+        {
+            writer_header->min = Vector3();
+            writer_header->max = Vector3();
+        }
+    }
+    return result;
+}
+
+} // namespace copc
@@ -1,21 +1,32 @@
 #include "copc-lib/io/laz_reader.hpp"
 
+#include <lazperf/readers.hpp>
+
 namespace copc::laz
 {
 std::vector<char> LazReader::GetPointData()
 {
     auto las_header = las_config_.LasHeader();
+
+    // The LAZ decompressor is only needed here, so it is created on demand rather than when opening the file
+    in_stream_->clear();
+    in_stream_->seekg(0);
+    lazperf::reader::generic_file reader(*in_stream_);
+
     // Seek to the end of the chunk table offset/start of the points
     in_stream_->seekg(las_header.PointOffset() + sizeof(int64_t));
 
+    IOStats::Timer timer(stats_.get(), IOStats::Phase::Decompress);
     std::vector<char> out;
     int point_size = copc::las::PointByteSize(las_header.PointFormatId(), las_header.EbByteSize());
     char buff[255];
     for (size_t i = 0; i < las_header.PointCount(); i++)
     {
-        reader_->readPoint(buff);
+        reader.readPoint(buff);
         out.insert(out.end(), buff, buff + point_size);
     }
+    if (stats_)
+        stats_->Add(IOStats::Counter::PointsRead, las_header.PointCount());
 
     return out;
 }
@@ -27,6 +38,7 @@ las::Points LazReader::GetPoints()
     if (point_data.empty())
         return las::Points(las_config_.LasHeader());
 
+    IOStats::Timer timer(stats_.get(), IOStats::Phase::Unpack);
     return las::Points::Unpack(point_data, las_config_.LasHeader());
 }
 } // namespace copc::laz
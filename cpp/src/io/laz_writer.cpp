@@ -1,16 +1,24 @@
 #include "copc-lib/io/laz_writer.hpp"
 
 #include <memory>
+#include <utility>
+#include <vector>
 
 namespace copc::laz
 {
 
 LazWriter::LazWriter(std::ostream &out_stream, const las::LazConfigWriter &laz_config_writer)
-    : BaseWriter(out_stream,
+    : LazWriter(std::make_shared<StreamSink>(out_stream), laz_config_writer)
+{
+}
+
+LazWriter::LazWriter(std::shared_ptr<OutputSink> sink, const las::LazConfigWriter &laz_config_writer)
+    : BaseWriter(std::move(sink),
                  std::static_pointer_cast<las::LazConfig>(std::make_shared<las::LazConfigWriter>(laz_config_writer)))
 {
     // reserve enough space for the header & VLRs in the file
-    std::fill_n(std::ostream_iterator<char>(out_stream_), FirstChunkOffset(), 0);
+    std::vector<char> zeros(FirstChunkOffset(), 0);
+    sink_->WriteAt(0, zeros.data(), zeros.size());
 }
 
 // Write a group of points as a chunk
@@ -22,7 +30,11 @@ void LazWriter::WritePoints(const las::Points &points)
         points.PointRecordLength() != config_->LasHeader().PointRecordLength())
         throw std::runtime_error("LazWriter::WritePoints: New points must be of same format and size.");
 
-    std::vector<char> uncompressed_data = points.Pack(config_->LasHeader());
+    std::vector<char> uncompressed_data;
+    {
+        IOStats::Timer timer(stats_.get(), IOStats::Phase::Pack);
+        uncompressed_data = points.Pack(config_->LasHeader());
+    }
     WriteChunk(uncompressed_data);
 }
 
@@ -35,4 +47,6 @@ void LazWriter::WritePointsCompressed(std::vector<char> const &compressed_data,
     WriteChunk(compressed_data, point_count, true);
 }
 
+void LazWriter::ApplyHeaderStats() { GetHeaderStats().Apply(*LazConfig()->LasHeader()); }
+
 } // namespace copc::laz
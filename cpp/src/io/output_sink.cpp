@@ -0,0 +1,185 @@
+#include "copc-lib/io/output_sink.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#define COPCLIB_HAS_PWRITE
+#endif
+
+namespace copc
+{
+
+void MemorySink::WriteAt(uint64_t offset, const char *data, size_t size)
+{
+    if (offset > data_.size())
+        throw std::runtime_error("MemorySink::WriteAt: Writes can't start past the end of the data.");
+    if (offset + size > data_.size())
+        data_.resize(offset + size);
+    std::memcpy(data_.data() + offset, data, size);
+}
+
+StreamSink::StreamSink(std::ostream &out_stream) : out_stream_(out_stream)
+{
+    auto position = out_stream_.tellp();
+    // Force a seek on the first write if the position is unknown
+    position_ = position < 0 ? UINT64_MAX : static_cast<uint64_t>(position);
+}
+
+void StreamSink::WriteAt(uint64_t offset, const char *data, size_t size)
+{
+    if (offset > size_)
+        throw std::runtime_error("StreamSink::WriteAt: Writes can't start past the end of the stream.");
+    if (offset != position_)
+        out_stream_.seekp(static_cast<std::streamoff>(offset));
+    out_stream_.write(data, static_cast<std::streamsize>(size));
+    if (!out_stream_.good())
+        throw std::runtime_error("StreamSink::WriteAt: Error while writing to the stream.");
+    position_ = offset + size;
+    size_ = std::max(size_, position_);
+}
+
+FileSink::FileSink(const std::string &file_path, const FileSinkOptions &options) : file_path_(file_path)
+{
+    capacity_ = std::max<size_t>(1, (options.buffer_size + BLOCK_SIZE - 1) / BLOCK_SIZE) * BLOCK_SIZE;
+    buffer_storage_.resize(capacity_ + BLOCK_SIZE);
+    auto address = reinterpret_cast<uintptr_t>(buffer_storage_.data());
+    buffer_ = buffer_storage_.data() + (BLOCK_SIZE - address % BLOCK_SIZE) % BLOCK_SIZE;
+
+#ifdef COPCLIB_HAS_PWRITE
+    fd_ = ::open(file_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd_ < 0)
+        throw std::runtime_error("FileSink: Error while opening file path.");
+#ifdef O_DIRECT
+    // Some file systems, such as tmpfs, don't support direct I/O, in which case every write goes through fd_
+    if (options.direct)
+        direct_fd_ = ::open(file_path.c_str(), O_WRONLY | O_DIRECT);
+#endif
+#else
+    f_stream_.open(file_path.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!f_stream_.good())
+        throw std::runtime_error("FileSink: Error while opening file path.");
+#endif
+    open_ = true;
+}
+
+FileSink::~FileSink()
+{
+    try
+    {
+        Close();
+    }
+    catch (...)
+    {
+        // Errors can only be reported by calling Close() explicitly
+    }
+}
+
+void FileSink::WriteAt(uint64_t offset, const char *data, size_t size)
+{
+    if (!open_)
+        throw std::runtime_error("FileSink::WriteAt: The file is closed.");
+    if (offset > size_)
+        throw std::runtime_error("FileSink::WriteAt: Writes can't start past the end of the file.");
+
+    while (size > 0)
+    {
+        size_t count;
+        if (offset < buffer_offset_)
+        {
+            // Bytes before the buffer have already been written out
+            count = static_cast<size_t>(std::min<uint64_t>(size, buffer_offset_ - offset));
+            WriteFile(offset, data, count, false);
+        }
+        else
+        {
+            // The buffer is never full between writes, so the offset is always within it
+            auto position = static_cast<size_t>(offset - buffer_offset_);
+            count = std::min(size, capacity_ - position);
+            std::memcpy(buffer_ + position, data, count);
+            buffered_ = std::max(buffered_, position + count);
+            if (buffered_ == capacity_)
+                FlushBlocks();
+        }
+        offset += count;
+        data += count;
+        size -= count;
+        size_ = std::max(size_, offset);
+    }
+}
+
+void FileSink::FlushBlocks()
+{
+    size_t count = IsDirect() ? buffered_ / BLOCK_SIZE * BLOCK_SIZE : buffered_;
+    if (count == 0)
+        return;
+    WriteFile(buffer_offset_, buffer_, count, IsDirect());
+    std::memmove(buffer_, buffer_ + count, buffered_ - count);
+    buffer_offset_ += count;
+    buffered_ -= count;
+}
+
+void FileSink::Flush()
+{
+    if (!open_)
+        return;
+    FlushBlocks();
+    if (buffered_ > 0)
+        WriteFile(buffer_offset_, buffer_, buffered_, false);
+#ifndef COPCLIB_HAS_PWRITE
+    f_stream_.flush();
+#endif
+}
+
+void FileSink::Close()
+{
+    if (!open_)
+        return;
+    Flush();
+#ifdef COPCLIB_HAS_PWRITE
+    if (direct_fd_ >= 0)
+        ::close(direct_fd_);
+    ::close(fd_);
+    direct_fd_ = -1;
+    fd_ = -1;
+#else
+    f_stream_.close();
+#endif
+    open_ = false;
+}
+
+void FileSink::WriteFile(uint64_t offset, const char *data, size_t size, bool direct)
+{
+#ifdef COPCLIB_HAS_PWRITE
+    while (size > 0)
+    {
+        auto written = ::pwrite(direct ? direct_fd_ : fd_, data, size, static_cast<off_t>(offset));
+        if (written < 0 && errno == EINTR)
+            continue;
+        if (written < 0 && direct && errno == EINVAL)
+        {
+            // The file system accepted O_DIRECT when opening but not when writing, so stop using it
+            ::close(direct_fd_);
+            direct_fd_ = -1;
+            direct = false;
+            continue;
+        }
+        if (written <= 0)
+            throw std::runtime_error("FileSink: Error while writing to file " + file_path_ + ".");
+        offset += written;
+        data += written;
+        size -= written;
+    }
+#else
+    f_stream_.seekp(static_cast<std::streamoff>(offset));
+    f_stream_.write(data, static_cast<std::streamsize>(size));
+    if (!f_stream_.good())
+        throw std::runtime_error("FileSink: Error while writing to file " + file_path_ + ".");
+#endif
+}
+
+} // namespace copc
@@ -0,0 +1,106 @@
+#include "copc-lib/io/tracing.hpp"
+
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <stdexcept>
+
+namespace copc
+{
+
+namespace
+{
+// Serializes SetTracer, so that tracing_enabled matches the registered tracer. Spans read the tracer with an atomic
+// load instead, without taking the mutex.
+std::mutex tracer_mutex;
+std::shared_ptr<Tracer> registered_tracer;
+} // namespace
+
+namespace Internal
+{
+std::atomic<bool> tracing_enabled{false};
+
+void TraceSpan::Begin(const char *name, const VoxelKey &key, uint64_t bytes)
+{
+    tracer_ = GetTracer();
+    if (!tracer_)
+        return;
+    name_ = name;
+    key_ = key;
+    bytes_ = bytes;
+    tracer_->OnEvent(
+        {TraceEvent::Type::Begin, name_, key_, bytes_, std::this_thread::get_id(), std::chrono::steady_clock::now()});
+}
+
+void TraceSpan::End()
+{
+    tracer_->OnEvent(
+        {TraceEvent::Type::End, name_, key_, bytes_, std::this_thread::get_id(), std::chrono::steady_clock::now()});
+}
+} // namespace Internal
+
+void SetTracer(const std::shared_ptr<Tracer> &tracer)
+{
+    std::lock_guard<std::mutex> lock(tracer_mutex);
+    std::atomic_store(&registered_tracer, tracer);
+    Internal::tracing_enabled.store(tracer != nullptr, std::memory_order_relaxed);
+}
+
+std::shared_ptr<Tracer> GetTracer() { return std::atomic_load(&registered_tracer); }
+
+void ChromeTraceExporter::OnEvent(const TraceEvent &event)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    events_.push_back(event);
+}
+
+size_t ChromeTraceExporter::EventCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return events_.size();
+}
+
+void ChromeTraceExporter::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    events_.clear();
+}
+
+void ChromeTraceExporter::Write(std::ostream &out_stream) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // The trace format wants integer thread ids, number the threads in order of appearance
+    std::map<std::thread::id, size_t> thread_ids;
+    auto start = events_.empty() ? std::chrono::steady_clock::time_point() : events_.front().time;
+    auto flags = out_stream.flags();
+    auto precision = out_stream.precision();
+
+    out_stream << "{\"traceEvents\":[";
+    for (size_t i = 0; i < events_.size(); i++)
+    {
+        const auto &event = events_[i];
+        auto tid = thread_ids.emplace(event.thread_id, thread_ids.size()).first->second;
+        auto ts = std::chrono::duration<double, std::micro>(event.time - start).count();
+
+        out_stream << (i == 0 ? "" : ",") << "\n{\"name\":\"" << event.name << "\",\"ph\":\""
+                   << (event.type == TraceEvent::Type::Begin ? "B" : "E") << "\",\"ts\":" << std::fixed
+                   << std::setprecision(3) << ts << ",\"pid\":1,\"tid\":" << tid << ",\"args\":{";
+        if (event.key.IsValid())
+            out_stream << "\"key\":\"" << event.key.ToString() << "\",";
+        out_stream << "\"bytes\":" << event.bytes << "}}";
+    }
+    out_stream << "\n]}" << std::endl;
+    out_stream.flags(flags);
+    out_stream.precision(precision);
+}
+
+void ChromeTraceExporter::Save(const std::string &file_path) const
+{
+    std::ofstream out_stream(file_path);
+    if (!out_stream.good())
+        throw std::runtime_error("ChromeTraceExporter::Save: Error while opening " + file_path);
+    Write(out_stream);
+}
+
+} // namespace copc
@@ -0,0 +1,368 @@
+#include "copc-lib/las/dimension_stats.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+#include "copc-lib/las/utils.hpp"
+
+namespace copc::las
+{
+
+namespace
+{
+using FieldType = ExtraBytesSchema::FieldType;
+
+const uint32_t VERSION = 1;
+// Size of a dimension in the EVLR: its name, count, minimum, maximum, mean and variance
+const size_t DIMENSION_SIZE = DimensionStats::NAME_SIZE + sizeof(uint64_t) + 4 * sizeof(double);
+
+template <typename T> void Gather(const char *data, size_t point_count, uint32_t stride, double *out)
+{
+    for (size_t i = 0; i < point_count; i++)
+    {
+        T value;
+        std::memcpy(&value, data + i * stride, sizeof(T));
+        out[i] = static_cast<double>(value);
+    }
+}
+
+// Reads one value per record, from the field at data
+void GatherColumn(const char *data, size_t point_count, uint32_t stride, FieldType type, double *out)
+{
+    switch (type)
+    {
+    case FieldType::UInt8:
+        return Gather<uint8_t>(data, point_count, stride, out);
+    case FieldType::Int8:
+        return Gather<int8_t>(data, point_count, stride, out);
+    case FieldType::UInt16:
+        return Gather<uint16_t>(data, point_count, stride, out);
+    case FieldType::Int16:
+        return Gather<int16_t>(data, point_count, stride, out);
+    case FieldType::UInt32:
+        return Gather<uint32_t>(data, point_count, stride, out);
+    case FieldType::Int32:
+        return Gather<int32_t>(data, point_count, stride, out);
+    case FieldType::UInt64:
+        return Gather<uint64_t>(data, point_count, stride, out);
+    case FieldType::Int64:
+        return Gather<int64_t>(data, point_count, stride, out);
+    case FieldType::Float:
+        return Gather<float>(data, point_count, stride, out);
+    case FieldType::Double:
+        return Gather<double>(data, point_count, stride, out);
+    }
+}
+
+// Reductions use several independent lanes, so that they vectorize without reordering floating point operations
+const size_t LANES = 4;
+
+void MinMaxSum(const double *values, size_t count, double &minimum, double &maximum, double &sum)
+{
+    double lane_min[LANES], lane_max[LANES], lane_sum[LANES];
+    for (size_t l = 0; l < LANES; l++)
+    {
+        lane_min[l] = std::numeric_limits<double>::infinity();
+        lane_max[l] = -std::numeric_limits<double>::infinity();
+        lane_sum[l] = 0;
+    }
+    size_t i = 0;
+    for (; i + LANES <= count; i += LANES)
+    {
+        for (size_t l = 0; l < LANES; l++)
+        {
+            double value = values[i + l];
+            lane_min[l] = value < lane_min[l] ? value : lane_min[l];
+            lane_max[l] = value > lane_max[l] ? value : lane_max[l];
+            lane_sum[l] += value;
+        }
+    }
+    for (; i < count; i++)
+    {
+        lane_min[0] = std::min(lane_min[0], values[i]);
+        lane_max[0] = std::max(lane_max[0], values[i]);
+        lane_sum[0] += values[i];
+    }
+    minimum = *std::min_element(lane_min, lane_min + LANES);
+    maximum = *std::max_element(lane_max, lane_max + LANES);
+    sum = (lane_sum[0] + lane_sum[1]) + (lane_sum[2] + lane_sum[3]);
+}
+
+double SquaredDeviations(const double *values, size_t count, double mean)
+{
+    double lane_sum[LANES] = {};
+    size_t i = 0;
+    for (; i + LANES <= count; i += LANES)
+    {
+        for (size_t l = 0; l < LANES; l++)
+        {
+            double deviation = values[i + l] - mean;
+            lane_sum[l] += deviation * deviation;
+        }
+    }
+    for (; i < count; i++)
+        lane_sum[0] += (values[i] - mean) * (values[i] - mean);
+    return (lane_sum[0] + lane_sum[1]) + (lane_sum[2] + lane_sum[3]);
+}
+
+template <typename T> void Write(std::vector<char> &out, const T &value)
+{
+    auto bytes = reinterpret_cast<const char *>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T> T Read(const std::vector<char> &data, size_t &pos)
+{
+    if (pos + sizeof(T) > data.size())
+        throw std::runtime_error("DimensionStats::Unpack: Unexpected end of data.");
+    T value;
+    std::memcpy(&value, data.data() + pos, sizeof(T));
+    pos += sizeof(T);
+    return value;
+}
+} // namespace
+
+DimensionStats::DimensionStats(const LasHeader &header, const EbVlr &extra_bytes_vlr)
+{
+    auto point_format_id = header.PointFormatId();
+    if (point_format_id < 6 || point_format_id > 8)
+        throw std::runtime_error("DimensionStats: Point format must be 6, 7 or 8.");
+    point_record_length_ = header.PointRecordLength();
+    classification_offset_ = 16;
+
+    auto scale = header.Scale();
+    auto offset = header.Offset();
+    AddDimension("x", {{0, FieldType::Int32, scale.x, offset.x, false, 0}, 0, 0});
+    AddDimension("y", {{4, FieldType::Int32, scale.y, offset.y, false, 0}, 0, 0});
+    AddDimension("z", {{8, FieldType::Int32, scale.z, offset.z, false, 0}, 0, 0});
+    AddDimension("intensity", {{12, FieldType::UInt16, 1, 0, false, 0}, 0, 0});
+    AddDimension("return_number", {{14, FieldType::UInt8, 1, 0, false, 0}, 0, 0x0F});
+    AddDimension("number_of_returns", {{14, FieldType::UInt8, 1, 0, false, 0}, 4, 0x0F});
+    AddDimension("classification", {{16, FieldType::UInt8, 1, 0, false, 0}, 0, 0});
+    AddDimension("user_data", {{17, FieldType::UInt8, 1, 0, false, 0}, 0, 0});
+    AddDimension("scan_angle", {{18, FieldType::Int16, 1, 0, false, 0}, 0, 0});
+    AddDimension("point_source_id", {{20, FieldType::UInt16, 1, 0, false, 0}, 0, 0});
+    AddDimension("gps_time", {{22, FieldType::Double, 1, 0, false, 0}, 0, 0});
+    if (point_format_id >= 7)
+    {
+        AddDimension("red", {{30, FieldType::UInt16, 1, 0, false, 0}, 0, 0});
+        AddDimension("green", {{32, FieldType::UInt16, 1, 0, false, 0}, 0, 0});
+        AddDimension("blue", {{34, FieldType::UInt16, 1, 0, false, 0}, 0, 0});
+    }
+    if (point_format_id == 8)
+        AddDimension("nir", {{36, FieldType::UInt16, 1, 0, false, 0}, 0, 0});
+
+    ExtraBytesSchema schema(extra_bytes_vlr, header);
+    for (size_t f = 0; f < schema.Fields().size(); f++)
+    {
+        // Undocumented extra bytes have no meaningful values
+        if (extra_bytes_vlr.items[f].data_type == 0)
+            continue;
+        const auto &field = schema.Fields()[f];
+        for (uint8_t e = 0; e < field.count; e++)
+        {
+            auto name = field.count == 1 ? field.name : field.name + "[" + std::to_string(e) + "]";
+            AddDimension(name, {field.GetElement(e), 0, 0});
+        }
+    }
+}
+
+void DimensionStats::AddDimension(const std::string &name, const Column &column)
+{
+    if (name.size() > NAME_SIZE)
+        throw std::runtime_error("DimensionStats: Dimension name " + name + " is too long.");
+    columns_.push_back(column);
+    dimensions_.push_back({name});
+    m2_.push_back(0);
+}
+
+void DimensionStats::Add(const char *data, size_t point_count)
+{
+    if (point_count == 0)
+        return;
+    if (columns_.size() != dimensions_.size() || point_record_length_ == 0)
+        throw std::runtime_error("DimensionStats::Add: The point record layout is unknown.");
+
+    std::vector<double> values(point_count);
+    for (size_t d = 0; d < columns_.size(); d++)
+    {
+        const auto &column = columns_[d];
+        const auto &element = column.element;
+        GatherColumn(data + element.record_offset, point_count, point_record_length_, element.type, values.data());
+
+        size_t count = point_count;
+        if (column.mask != 0)
+        {
+            for (size_t i = 0; i < count; i++)
+                values[i] = static_cast<double>((static_cast<uint8_t>(values[i]) >> column.shift) & column.mask);
+        }
+        if (element.has_no_data)
+        {
+            double no_data = element.no_data;
+            auto end = std::remove_if(values.begin(), values.begin() + count,
+                                      [no_data](double value) { return value == no_data; });
+            count = static_cast<size_t>(end - values.begin());
+        }
+        if (element.scale != 1.0 || element.offset != 0.0)
+        {
+            for (size_t i = 0; i < count; i++)
+                values[i] = values[i] * element.scale + element.offset;
+        }
+        if (count == 0)
+            continue;
+
+        double minimum, maximum, sum;
+        MinMaxSum(values.data(), count, minimum, maximum, sum);
+        double mean = sum / static_cast<double>(count);
+        MergeDimension(d, count, minimum, maximum, mean, SquaredDeviations(values.data(), count, mean));
+    }
+
+    const char *classification = data + classification_offset_;
+    for (size_t i = 0; i < point_count; i++)
+        classification_histogram_[static_cast<uint8_t>(classification[i * point_record_length_])]++;
+    point_count_ += point_count;
+}
+
+void DimensionStats::Add(const std::vector<char> &data)
+{
+    if (point_record_length_ == 0 || data.size() % point_record_length_ != 0)
+        throw std::runtime_error("DimensionStats::Add: Data must be a whole number of point records.");
+    Add(data.data(), data.size() / point_record_length_);
+}
+
+// Combines the counts, means and squared deviations of two sets of values, see
+// https://en.wikipedia.org/wiki/Algorithms_for_calculating_variance#Parallel_algorithm
+void DimensionStats::MergeDimension(size_t index, uint64_t count, double minimum, double maximum, double mean,
+                                    double m2)
+{
+    auto &dimension = dimensions_[index];
+    if (count == 0)
+        return;
+    if (dimension.count == 0)
+    {
+        dimension.count = count;
+        dimension.minimum = minimum;
+        dimension.maximum = maximum;
+        dimension.mean = mean;
+        m2_[index] = m2;
+    }
+    else
+    {
+        auto total = static_cast<double>(dimension.count + count);
+        double delta = mean - dimension.mean;
+        dimension.mean += delta * static_cast<double>(count) / total;
+        m2_[index] += m2 + delta * delta * static_cast<double>(dimension.count) * static_cast<double>(count) / total;
+        dimension.count += count;
+        dimension.minimum = std::min(dimension.minimum, minimum);
+        dimension.maximum = std::max(dimension.maximum, maximum);
+    }
+    dimension.variance = m2_[index] / static_cast<double>(dimension.count);
+}
+
+void DimensionStats::Merge(const DimensionStats &other)
+{
+    if (other.dimensions_.size() != dimensions_.size())
+        throw std::runtime_error("DimensionStats::Merge: Statistics must have the same dimensions.");
+    for (size_t d = 0; d < dimensions_.size(); d++)
+    {
+        if (other.dimensions_[d].name != dimensions_[d].name)
+            throw std::runtime_error("DimensionStats::Merge: Statistics must have the same dimensions.");
+    }
+
+    for (size_t d = 0; d < dimensions_.size(); d++)
+    {
+        const auto &dimension = other.dimensions_[d];
+        MergeDimension(d, dimension.count, dimension.minimum, dimension.maximum, dimension.mean, other.m2_[d]);
+    }
+    for (size_t c = 0; c < classification_histogram_.size(); c++)
+        classification_histogram_[c] += other.classification_histogram_[c];
+    point_count_ += other.point_count_;
+}
+
+bool DimensionStats::HasDimension(const std::string &name) const
+{
+    return std::any_of(dimensions_.begin(), dimensions_.end(),
+                       [&name](const Dimension &dimension) { return dimension.name == name; });
+}
+
+const DimensionStats::Dimension &DimensionStats::GetDimension(const std::string &name) const
+{
+    for (const auto &dimension : dimensions_)
+    {
+        if (dimension.name == name)
+            return dimension;
+    }
+    throw std::runtime_error("DimensionStats::GetDimension: No dimension named " + name + ".");
+}
+
+std::vector<char> DimensionStats::Pack() const
+{
+    std::vector<char> out;
+    out.reserve(sizeof(uint32_t) * 2 + sizeof(uint64_t) + dimensions_.size() * DIMENSION_SIZE +
+                classification_histogram_.size() * sizeof(uint64_t));
+    Write(out, VERSION);
+    Write(out, point_count_);
+    Write(out, static_cast<uint32_t>(dimensions_.size()));
+    for (const auto &dimension : dimensions_)
+    {
+        char name[NAME_SIZE] = {};
+        std::memcpy(name, dimension.name.data(), dimension.name.size());
+        out.insert(out.end(), name, name + NAME_SIZE);
+        Write(out, dimension.count);
+        Write(out, dimension.minimum);
+        Write(out, dimension.maximum);
+        Write(out, dimension.mean);
+        Write(out, dimension.variance);
+    }
+    for (auto count : classification_histogram_)
+        Write(out, count);
+    return out;
+}
+
+DimensionStats DimensionStats::Unpack(const std::vector<char> &data)
+{
+    size_t pos = 0;
+    if (Read<uint32_t>(data, pos) != VERSION)
+        throw std::runtime_error("DimensionStats::Unpack: Unsupported version.");
+
+    DimensionStats stats;
+    stats.point_count_ = Read<uint64_t>(data, pos);
+    auto dimension_count = Read<uint32_t>(data, pos);
+    if (dimension_count > data.size() / DIMENSION_SIZE)
+        throw std::runtime_error("DimensionStats::Unpack: Unexpected end of data.");
+    for (uint32_t d = 0; d < dimension_count; d++)
+    {
+        auto name = Read<std::array<char, NAME_SIZE>>(data, pos);
+        Dimension dimension;
+        dimension.name = std::string(name.begin(), std::find(name.begin(), name.end(), '\0'));
+        dimension.count = Read<uint64_t>(data, pos);
+        dimension.minimum = Read<double>(data, pos);
+        dimension.maximum = Read<double>(data, pos);
+        dimension.mean = Read<double>(data, pos);
+        dimension.variance = Read<double>(data, pos);
+        stats.m2_.push_back(dimension.variance * static_cast<double>(dimension.count));
+        stats.dimensions_.push_back(dimension);
+    }
+    for (auto &count : stats.classification_histogram_)
+        count = Read<uint64_t>(data, pos);
+    return stats;
+}
+
+std::string DimensionStats::ToString() const
+{
+    std::stringstream ss;
+    ss << "DimensionStats:" << std::endl;
+    ss << "\tpoint_count: " << point_count_ << std::endl;
+    for (const auto &dimension : dimensions_)
+    {
+        ss << "\t" << dimension.name << ": count " << dimension.count << ", min " << dimension.minimum << ", max "
+           << dimension.maximum << ", mean " << dimension.mean << ", variance " << dimension.variance << std::endl;
+    }
+    return ss.str();
+}
+
+} // namespace copc::las
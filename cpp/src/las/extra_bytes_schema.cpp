@@ -0,0 +1,268 @@
+#include "copc-lib/las/extra_bytes_schema.hpp"
+
+#include <cmath>
+#include <limits>
+
+#include "copc-lib/las/utils.hpp"
+
+namespace copc::las
+{
+namespace
+{
+// LAS 1.4 extra bytes options bits
+const uint8_t NO_DATA_BIT = 1 << 0;
+const uint8_t SCALE_BIT = 1 << 3;
+const uint8_t OFFSET_BIT = 1 << 4;
+
+// Element types of data types 1-10, which data types 11-30 repeat as 2 and 3 element arrays
+const ExtraBytesSchema::FieldType DATA_TYPES[10]{
+    ExtraBytesSchema::FieldType::UInt8,  ExtraBytesSchema::FieldType::Int8,   ExtraBytesSchema::FieldType::UInt16,
+    ExtraBytesSchema::FieldType::Int16,  ExtraBytesSchema::FieldType::UInt32, ExtraBytesSchema::FieldType::Int32,
+    ExtraBytesSchema::FieldType::UInt64, ExtraBytesSchema::FieldType::Int64,  ExtraBytesSchema::FieldType::Float,
+    ExtraBytesSchema::FieldType::Double};
+
+template <typename T> double ReadAs(const char *src)
+{
+    T value;
+    std::memcpy(&value, src, sizeof(T));
+    return static_cast<double>(value);
+}
+
+double Read(const char *src, ExtraBytesSchema::FieldType type)
+{
+    switch (type)
+    {
+    case ExtraBytesSchema::FieldType::UInt8:
+        return ReadAs<uint8_t>(src);
+    case ExtraBytesSchema::FieldType::Int8:
+        return ReadAs<int8_t>(src);
+    case ExtraBytesSchema::FieldType::UInt16:
+        return ReadAs<uint16_t>(src);
+    case ExtraBytesSchema::FieldType::Int16:
+        return ReadAs<int16_t>(src);
+    case ExtraBytesSchema::FieldType::UInt32:
+        return ReadAs<uint32_t>(src);
+    case ExtraBytesSchema::FieldType::Int32:
+        return ReadAs<int32_t>(src);
+    case ExtraBytesSchema::FieldType::UInt64:
+        return ReadAs<uint64_t>(src);
+    case ExtraBytesSchema::FieldType::Int64:
+        return ReadAs<int64_t>(src);
+    case ExtraBytesSchema::FieldType::Float:
+        return ReadAs<float>(src);
+    default:
+        return ReadAs<double>(src);
+    }
+}
+
+template <typename T> void WriteAs(char *dst, T value) { std::memcpy(dst, &value, sizeof(T)); }
+
+// Writes a scaled value, rounding it for integer types
+void Write(char *dst, const ExtraBytesSchema::Element &element, double value)
+{
+    switch (element.type)
+    {
+    case ExtraBytesSchema::FieldType::UInt8:
+        return WriteAs(dst, RemoveScale<uint8_t>(value, element.scale, element.offset));
+    case ExtraBytesSchema::FieldType::Int8:
+        return WriteAs(dst, RemoveScale<int8_t>(value, element.scale, element.offset));
+    case ExtraBytesSchema::FieldType::UInt16:
+        return WriteAs(dst, RemoveScale<uint16_t>(value, element.scale, element.offset));
+    case ExtraBytesSchema::FieldType::Int16:
+        return WriteAs(dst, RemoveScale<int16_t>(value, element.scale, element.offset));
+    case ExtraBytesSchema::FieldType::UInt32:
+        return WriteAs(dst, RemoveScale<uint32_t>(value, element.scale, element.offset));
+    case ExtraBytesSchema::FieldType::Int32:
+        return WriteAs(dst, RemoveScale<int32_t>(value, element.scale, element.offset));
+    case ExtraBytesSchema::FieldType::UInt64:
+        return WriteAs(dst, RemoveScale<uint64_t>(value, element.scale, element.offset));
+    case ExtraBytesSchema::FieldType::Int64:
+        return WriteAs(dst, RemoveScale<int64_t>(value, element.scale, element.offset));
+    case ExtraBytesSchema::FieldType::Float:
+        return WriteAs(dst, static_cast<float>((value - element.offset) / element.scale));
+    default:
+        return WriteAs(dst, (value - element.offset) / element.scale);
+    }
+}
+
+// Writes a raw no-data value
+void WriteNoData(char *dst, const ExtraBytesSchema::Element &element)
+{
+    Write(dst, {0, element.type, 1, 0, false, 0}, element.no_data);
+}
+} // namespace
+
+ExtraBytesSchema::ExtraBytesSchema(const EbVlr &eb_vlr, const int8_t &point_format_id)
+{
+    size_t record_offset = PointBaseByteSize(point_format_id);
+    for (const auto &item : eb_vlr.items)
+    {
+        if (item.data_type > 30)
+            throw std::runtime_error("ExtraBytesSchema: Invalid data type for field " + item.name + ".");
+
+        Field field{};
+        field.name = item.name;
+        field.record_offset = record_offset;
+        if (item.data_type == 0)
+        {
+            // Undocumented extra bytes, options holds their number
+            field.type = FieldType::UInt8;
+            field.count = item.options;
+        }
+        else
+        {
+            field.type = DATA_TYPES[(item.data_type - 1) % 10];
+            field.count = static_cast<uint8_t>((item.data_type - 1) / 10 + 1);
+            field.has_no_data = item.options & NO_DATA_BIT;
+            field.has_scale = item.options & SCALE_BIT;
+            field.has_offset = item.options & OFFSET_BIT;
+            for (int e = 0; e < 3; e++)
+            {
+                field.no_data[e] = item.no_data[e];
+                field.scale[e] = item.scale[e];
+                field.offset[e] = item.offset[e];
+            }
+        }
+        record_offset += field.ByteSize();
+        fields_.push_back(field);
+    }
+    point_record_length_ = static_cast<uint32_t>(record_offset);
+}
+
+ExtraBytesSchema::ExtraBytesSchema(const EbVlr &eb_vlr, const LasHeader &header)
+    : ExtraBytesSchema(eb_vlr, header.PointFormatId())
+{
+    if (point_record_length_ != header.PointRecordLength())
+        throw std::runtime_error("ExtraBytesSchema: The extra bytes VLR does not match the header's point record "
+                                 "length.");
+}
+
+size_t ExtraBytesSchema::ElementSize(FieldType type)
+{
+    switch (type)
+    {
+    case FieldType::UInt8:
+    case FieldType::Int8:
+        return 1;
+    case FieldType::UInt16:
+    case FieldType::Int16:
+        return 2;
+    case FieldType::UInt32:
+    case FieldType::Int32:
+    case FieldType::Float:
+        return 4;
+    default:
+        return 8;
+    }
+}
+
+bool ExtraBytesSchema::HasField(const std::string &name) const
+{
+    for (const auto &field : fields_)
+    {
+        if (field.name == name)
+            return true;
+    }
+    return false;
+}
+
+const ExtraBytesSchema::Field &ExtraBytesSchema::GetField(const std::string &name) const
+{
+    for (const auto &field : fields_)
+    {
+        if (field.name == name)
+            return field;
+    }
+    throw std::runtime_error("ExtraBytesSchema: No extra bytes field named " + name + ".");
+}
+
+std::vector<ExtraBytesSchema::Element> ExtraBytesSchema::ResolveElements(const std::vector<std::string> &names) const
+{
+    std::vector<Element> elements;
+    for (const auto &name : names)
+    {
+        const auto &field = GetField(name);
+        for (uint8_t e = 0; e < field.count; e++)
+            elements.push_back(field.GetElement(e));
+    }
+    return elements;
+}
+
+size_t ExtraBytesSchema::PointCount(const std::vector<char> &point_data) const
+{
+    if (point_data.size() % point_record_length_ != 0)
+        throw std::runtime_error("ExtraBytesSchema: The number of bytes in point_data doesn't correspond to the "
+                                 "point record length.");
+    return point_data.size() / point_record_length_;
+}
+
+std::vector<std::vector<double>> ExtraBytesSchema::ExtractScaled(const std::vector<char> &point_data,
+                                                                 const std::vector<std::string> &names) const
+{
+    auto elements = ResolveElements(names);
+    size_t point_count = PointCount(point_data);
+    std::vector<std::vector<double>> columns(elements.size(), std::vector<double>(point_count));
+
+    const char *record = point_data.data();
+    for (size_t i = 0; i < point_count; i++, record += point_record_length_)
+    {
+        for (size_t c = 0; c < elements.size(); c++)
+        {
+            const auto &element = elements[c];
+            double raw = Read(record + element.record_offset, element.type);
+            columns[c][i] = (element.has_no_data && raw == element.no_data)
+                                ? std::numeric_limits<double>::quiet_NaN()
+                                : ApplyScale(raw, element.scale, element.offset);
+        }
+    }
+    return columns;
+}
+
+std::vector<double> ExtraBytesSchema::ExtractScaled(const std::vector<char> &point_data,
+                                                    const std::string &name) const
+{
+    if (GetField(name).count != 1)
+        throw std::runtime_error("ExtraBytesSchema::ExtractScaled: Field " + name + " has several elements.");
+    return std::move(ExtractScaled(point_data, std::vector<std::string>{name})[0]);
+}
+
+void ExtraBytesSchema::InjectScaled(std::vector<char> &point_data, const std::vector<std::string> &names,
+                                    const std::vector<std::vector<double>> &columns) const
+{
+    auto elements = ResolveElements(names);
+    size_t point_count = PointCount(point_data);
+    if (columns.size() != elements.size())
+        throw std::runtime_error("ExtraBytesSchema::InjectScaled: Number of columns does not match the fields.");
+    for (const auto &column : columns)
+    {
+        if (column.size() != point_count)
+            throw std::runtime_error("ExtraBytesSchema::InjectScaled: Number of values does not match number of "
+                                     "points.");
+    }
+
+    char *record = point_data.data();
+    for (size_t i = 0; i < point_count; i++, record += point_record_length_)
+    {
+        for (size_t c = 0; c < elements.size(); c++)
+        {
+            const auto &element = elements[c];
+            double value = columns[c][i];
+            if (!std::isnan(value))
+                Write(record + element.record_offset, element, value);
+            else if (element.has_no_data)
+                WriteNoData(record + element.record_offset, element);
+            else
+                throw std::runtime_error("ExtraBytesSchema::InjectScaled: NaN value for a field without no-data.");
+        }
+    }
+}
+
+void ExtraBytesSchema::InjectScaled(std::vector<char> &point_data, const std::string &name,
+                                    const std::vector<double> &values) const
+{
+    if (GetField(name).count != 1)
+        throw std::runtime_error("ExtraBytesSchema::InjectScaled: Field " + name + " has several elements.");
+    InjectScaled(point_data, std::vector<std::string>{name}, {values});
+}
+
+} // namespace copc::las
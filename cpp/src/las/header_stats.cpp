@@ -0,0 +1,130 @@
+#include "copc-lib/las/header_stats.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+#include "copc-lib/las/utils.hpp"
+
+namespace copc::las
+{
+
+void HeaderStats::Add(const char *data, size_t point_count, uint16_t point_record_length)
+{
+    if (point_count == 0)
+        return;
+    if (point_record_length < MIN_RECORD_LENGTH)
+        throw std::runtime_error("HeaderStats::Add: Point records must be of point format 6, 7 or 8.");
+
+    // Accumulate in locals, which the compiler keeps in registers, and without branches on the values
+    int32_t min_x = std::numeric_limits<int32_t>::max(), min_y = min_x, min_z = min_x;
+    int32_t max_x = std::numeric_limits<int32_t>::min(), max_y = max_x, max_z = max_x;
+    double gps_time_min = std::numeric_limits<double>::max();
+    double gps_time_max = std::numeric_limits<double>::lowest();
+    std::array<uint64_t, 16> returns{};
+
+    for (size_t i = 0; i < point_count; i++)
+    {
+        const char *record = data + i * point_record_length;
+        int32_t xyz[3];
+        double gps_time;
+        std::memcpy(xyz, record, sizeof(xyz));
+        std::memcpy(&gps_time, record + GPS_TIME_OFFSET, sizeof(gps_time));
+
+        min_x = std::min(min_x, xyz[0]);
+        max_x = std::max(max_x, xyz[0]);
+        min_y = std::min(min_y, xyz[1]);
+        max_y = std::max(max_y, xyz[1]);
+        min_z = std::min(min_z, xyz[2]);
+        max_z = std::max(max_z, xyz[2]);
+        gps_time_min = std::min(gps_time_min, gps_time);
+        gps_time_max = std::max(gps_time_max, gps_time);
+        returns[static_cast<uint8_t>(record[RETURNS_OFFSET]) & 0x0F]++;
+    }
+
+    HeaderStats stats;
+    stats.point_count_ = point_count;
+    stats.min_ = {min_x, min_y, min_z};
+    stats.max_ = {max_x, max_y, max_z};
+    stats.returns_ = returns;
+    stats.gps_time_min_ = gps_time_min;
+    stats.gps_time_max_ = gps_time_max;
+    Merge(stats);
+}
+
+void HeaderStats::Add(const std::vector<char> &data, const LasHeader &header)
+{
+    auto point_record_length = header.PointRecordLength();
+    if (point_record_length == 0 || data.size() % point_record_length != 0)
+        throw std::runtime_error("HeaderStats::Add: Data must be a whole number of point records.");
+    Add(data.data(), data.size() / point_record_length, point_record_length);
+}
+
+void HeaderStats::Merge(const HeaderStats &other)
+{
+    if (other.Empty())
+        return;
+    if (Empty())
+    {
+        *this = other;
+        return;
+    }
+
+    point_count_ += other.point_count_;
+    for (int i = 0; i < 3; i++)
+    {
+        min_[i] = std::min(min_[i], other.min_[i]);
+        max_[i] = std::max(max_[i], other.max_[i]);
+    }
+    for (size_t i = 0; i < returns_.size(); i++)
+        returns_[i] += other.returns_[i];
+    gps_time_min_ = std::min(gps_time_min_, other.gps_time_min_);
+    gps_time_max_ = std::max(gps_time_max_, other.gps_time_max_);
+}
+
+Vector3 HeaderStats::Min(const LasHeader &header) const
+{
+    // Negative scales swap the bounds
+    auto a = header.ApplyScale(Vector3(min_[0], min_[1], min_[2]));
+    auto b = header.ApplyScale(Vector3(max_[0], max_[1], max_[2]));
+    return Vector3(std::min(a.x, b.x), std::min(a.y, b.y), std::min(a.z, b.z));
+}
+
+Vector3 HeaderStats::Max(const LasHeader &header) const
+{
+    auto a = header.ApplyScale(Vector3(min_[0], min_[1], min_[2]));
+    auto b = header.ApplyScale(Vector3(max_[0], max_[1], max_[2]));
+    return Vector3(std::max(a.x, b.x), std::max(a.y, b.y), std::max(a.z, b.z));
+}
+
+std::array<uint64_t, 15> HeaderStats::PointsByReturn() const
+{
+    std::array<uint64_t, 15> points_by_return{};
+    std::copy(returns_.begin() + 1, returns_.end(), points_by_return.begin());
+    return points_by_return;
+}
+
+void HeaderStats::Apply(LasHeader &header) const
+{
+    if (Empty())
+        return;
+    header.min = Min(header);
+    header.max = Max(header);
+    header.points_by_return = PointsByReturn();
+}
+
+std::string HeaderStats::ToString() const
+{
+    std::stringstream ss;
+    ss << "HeaderStats:" << std::endl;
+    ss << "\tpoint_count: " << point_count_ << std::endl;
+    ss << "\tmin: (" << min_[0] << ", " << min_[1] << ", " << min_[2] << ")" << std::endl;
+    ss << "\tmax: (" << max_[0] << ", " << max_[1] << ", " << max_[2] << ")" << std::endl;
+    ss << "\tgps_time_min: " << gps_time_min_ << std::endl;
+    ss << "\tgps_time_max: " << gps_time_max_ << std::endl;
+    return ss.str();
+}
+
+} // namespace copc::las
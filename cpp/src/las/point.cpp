@@ -1,8 +1,34 @@
 #include "copc-lib/las/point.hpp"
+#include "copc-lib/las/point_codec.hpp"
 #include "copc-lib/utils.hpp"
 
 namespace copc::las
 {
+namespace
+{
+// Holds a single record, on the stack unless its extra bytes are larger than the specialized codecs handle
+class RecordBuffer
+{
+  public:
+    explicit RecordBuffer(uint32_t size) : size_(size)
+    {
+        if (size_ > STACK_SIZE)
+            heap_.resize(size_);
+    }
+
+    char *Data() { return heap_.empty() ? stack_ : heap_.data(); }
+    std::streamsize Size() const { return static_cast<std::streamsize>(size_); }
+
+  private:
+    // The base size of point format 8, the largest
+    static const uint32_t STACK_SIZE = 38 + PointCodec::MAX_SPECIALIZED_EB_BYTE_SIZE;
+
+    char stack_[STACK_SIZE];
+    std::vector<char> heap_;
+    uint32_t size_;
+};
+} // namespace
+
 Point::Point(const int8_t &point_format_id, const uint16_t &eb_byte_size) : point_format_id_(point_format_id)
 {
     if (point_format_id < 6 || point_format_id > 8)
@@ -80,63 +106,18 @@ bool Point::Within(const Box &box) const { return box.Contains(Vector3(X(), Y(),
 std::shared_ptr<Point> Point::Unpack(std::istream &in_stream, const int8_t &point_format_id, const Vector3 &scale,
                                      const Vector3 &offset, const uint16_t &eb_byte_size)
 {
-    std::shared_ptr<Point> p = std::make_shared<Point>(point_format_id, eb_byte_size);
-
-    p->x_scaled_ = ApplyScale(unpack<int32_t>(in_stream), scale.x, offset.x);
-    p->y_scaled_ = ApplyScale(unpack<int32_t>(in_stream), scale.y, offset.y);
-    p->z_scaled_ = ApplyScale(unpack<int32_t>(in_stream), scale.z, offset.z);
-    p->intensity_ = unpack<uint16_t>(in_stream);
-    p->returns_ = unpack<uint8_t>(in_stream);
-    p->flags_ = unpack<uint8_t>(in_stream);
-    p->classification_ = unpack<uint8_t>(in_stream);
-    p->user_data_ = unpack<uint8_t>(in_stream);
-    p->scan_angle_ = unpack<int16_t>(in_stream);
-    p->point_source_id_ = unpack<uint16_t>(in_stream);
-    p->gps_time_ = unpack<double>(in_stream);
-    if (p->has_rgb_)
-    {
-        p->rgb_[0] = unpack<uint16_t>(in_stream);
-        p->rgb_[1] = unpack<uint16_t>(in_stream);
-        p->rgb_[2] = unpack<uint16_t>(in_stream);
-    }
-    if (p->has_nir_)
-    {
-        p->nir_ = unpack<uint16_t>(in_stream);
-    }
-
-    for (uint32_t i = 0; i < eb_byte_size; i++)
-    {
-        p->extra_bytes_[i] = unpack<uint8_t>(in_stream);
-    }
-    return p;
+    const auto &codec = PointCodec::Get(point_format_id, eb_byte_size);
+    RecordBuffer record(codec.PointRecordLength());
+    in_stream.read(record.Data(), record.Size());
+    return codec.UnpackPoint(record.Data(), scale, offset);
 }
 
 void Point::Pack(std::ostream &out_stream, const Vector3 &scale, const Vector3 &offset) const
 {
-    // Point
-    pack(RemoveScale<int32_t>(x_scaled_, scale.x, offset.x), out_stream);
-    pack(RemoveScale<int32_t>(y_scaled_, scale.y, offset.y), out_stream);
-    pack(RemoveScale<int32_t>(z_scaled_, scale.z, offset.z), out_stream);
-    pack(intensity_, out_stream);
-    pack(returns_, out_stream);
-    pack(flags_, out_stream);
-    pack(classification_, out_stream);
-    pack(user_data_, out_stream);
-    pack(scan_angle_, out_stream);
-    pack(point_source_id_, out_stream);
-
-    pack(gps_time_, out_stream);
-    if (has_rgb_)
-    {
-        pack(rgb_[0], out_stream);
-        pack(rgb_[1], out_stream);
-        pack(rgb_[2], out_stream);
-    }
-    if (has_nir_)
-        pack(nir_, out_stream);
-
-    for (auto eb : extra_bytes_)
-        pack(eb, out_stream);
+    const auto &codec = PointCodec::Get(point_format_id_, EbByteSize());
+    RecordBuffer record(codec.PointRecordLength());
+    codec.PackPoint(*this, record.Data(), scale, offset);
+    out_stream.write(record.Data(), record.Size());
 }
 
 void Point::ToPointFormat(const int8_t &point_format_id)
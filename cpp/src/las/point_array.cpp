@@ -0,0 +1,382 @@
+#include "copc-lib/las/point_array.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "copc-lib/las/utils.hpp"
+
+namespace copc::las
+{
+namespace
+{
+enum class Dimension
+{
+    X,
+    Y,
+    Z,
+    Intensity,
+    ReturnNumber,
+    NumberOfReturns,
+    Synthetic,
+    KeyPoint,
+    Withheld,
+    Overlap,
+    ScannerChannel,
+    ScanDirectionFlag,
+    EdgeOfFlightLine,
+    Classification,
+    UserData,
+    ScanAngle,
+    PointSourceId,
+    GPSTime,
+    Red,
+    Green,
+    Blue,
+    Nir
+};
+
+struct DimensionInfo
+{
+    const char *name;
+    Dimension dimension;
+    PointArray::DimensionType type;
+};
+
+// Dimensions of point formats 6-8, in record order. Names match the Python Point properties.
+const DimensionInfo DIMENSIONS[] = {
+    {"x", Dimension::X, PointArray::DimensionType::Float64},
+    {"y", Dimension::Y, PointArray::DimensionType::Float64},
+    {"z", Dimension::Z, PointArray::DimensionType::Float64},
+    {"intensity", Dimension::Intensity, PointArray::DimensionType::UInt16},
+    {"return_number", Dimension::ReturnNumber, PointArray::DimensionType::UInt8},
+    {"number_of_returns", Dimension::NumberOfReturns, PointArray::DimensionType::UInt8},
+    {"synthetic", Dimension::Synthetic, PointArray::DimensionType::Bool},
+    {"key_point", Dimension::KeyPoint, PointArray::DimensionType::Bool},
+    {"withheld", Dimension::Withheld, PointArray::DimensionType::Bool},
+    {"overlap", Dimension::Overlap, PointArray::DimensionType::Bool},
+    {"scanner_channel", Dimension::ScannerChannel, PointArray::DimensionType::UInt8},
+    {"scan_direction_flag", Dimension::ScanDirectionFlag, PointArray::DimensionType::Bool},
+    {"edge_of_flight_line", Dimension::EdgeOfFlightLine, PointArray::DimensionType::Bool},
+    {"classification", Dimension::Classification, PointArray::DimensionType::UInt8},
+    {"user_data", Dimension::UserData, PointArray::DimensionType::UInt8},
+    {"scan_angle", Dimension::ScanAngle, PointArray::DimensionType::Int16},
+    {"point_source_id", Dimension::PointSourceId, PointArray::DimensionType::UInt16},
+    {"gps_time", Dimension::GPSTime, PointArray::DimensionType::Float64},
+    {"red", Dimension::Red, PointArray::DimensionType::UInt16},
+    {"green", Dimension::Green, PointArray::DimensionType::UInt16},
+    {"blue", Dimension::Blue, PointArray::DimensionType::UInt16},
+    {"nir", Dimension::Nir, PointArray::DimensionType::UInt16},
+};
+
+bool FormatHasDimension(const int8_t &point_format_id, Dimension dimension)
+{
+    switch (dimension)
+    {
+    case Dimension::Red:
+    case Dimension::Green:
+    case Dimension::Blue:
+        return FormatHasRgb(point_format_id);
+    case Dimension::Nir:
+        return FormatHasNir(point_format_id);
+    default:
+        return true;
+    }
+}
+
+const DimensionInfo &FindDimension(const std::string &name)
+{
+    for (const auto &info : DIMENSIONS)
+    {
+        if (name == info.name)
+            return info;
+    }
+    throw std::runtime_error("PointArray: Unknown dimension " + name + ".");
+}
+
+// Reads fields of fixed-length point records
+struct RecordReader
+{
+    const char *data;
+    size_t record_length;
+
+    template <typename T> T Get(size_t i, size_t offset) const
+    {
+        T value;
+        std::memcpy(&value, data + i * record_length + offset, sizeof(T));
+        return value;
+    }
+};
+
+// Fills a column by applying the getter to each of count items
+template <typename T, typename Getter> void FillColumn(PointArray::Column &column, size_t count, Getter &&getter)
+{
+    auto *out = reinterpret_cast<T *>(column.Data());
+    for (size_t i = 0; i < count; i++)
+        out[i] = static_cast<T>(getter(i));
+}
+
+} // namespace
+
+PointArray::PointArray(const int8_t &point_format_id, size_t size, const std::vector<std::string> &dimensions)
+    : size_(size)
+{
+    if (point_format_id < 6 || point_format_id > 8)
+        throw std::runtime_error("PointArray: Point format must be 6-8.");
+
+    auto names = dimensions.empty() ? AvailableDimensions(point_format_id) : dimensions;
+    columns_.reserve(names.size());
+    for (const auto &name : names)
+    {
+        const auto &info = FindDimension(name);
+        if (!FormatHasDimension(point_format_id, info.dimension))
+            throw std::runtime_error("PointArray: Point format " + std::to_string(point_format_id) +
+                                     " does not have dimension " + name + ".");
+        if (HasDimension(name))
+            throw std::runtime_error("PointArray: Dimension " + name + " was requested more than once.");
+
+        Column column;
+        column.name = info.name;
+        column.type = info.type;
+        column.data.resize(size * ItemSize(info.type));
+        columns_.push_back(std::move(column));
+    }
+}
+
+PointArray PointArray::Unpack(const std::vector<char> &point_data, const LasHeader &header,
+                              const std::vector<std::string> &dimensions)
+{
+    return Unpack(point_data, header.PointFormatId(), header.EbByteSize(), header.Scale(), header.Offset(),
+                  dimensions);
+}
+
+PointArray PointArray::Unpack(const std::vector<char> &point_data, const int8_t &point_format_id,
+                              const uint16_t &eb_byte_size, const Vector3 &scale, const Vector3 &offset,
+                              const std::vector<std::string> &dimensions)
+{
+    return Unpack(point_data.data(), point_data.size(), point_format_id, eb_byte_size, scale, offset, dimensions);
+}
+
+PointArray PointArray::Unpack(const char *point_data, const size_t &size, const LasHeader &header,
+                              const std::vector<std::string> &dimensions)
+{
+    return Unpack(point_data, size, header.PointFormatId(), header.EbByteSize(), header.Scale(), header.Offset(),
+                  dimensions);
+}
+
+PointArray PointArray::Unpack(const char *point_data, const size_t &size, const int8_t &point_format_id,
+                              const uint16_t &eb_byte_size, const Vector3 &scale, const Vector3 &offset,
+                              const std::vector<std::string> &dimensions)
+{
+    size_t record_length = PointByteSize(point_format_id, eb_byte_size);
+    if (size % record_length != 0)
+        throw std::runtime_error("PointArray::Unpack: The number of bytes in point_data doesn't correspond to the "
+                                 "point record length.");
+
+    size_t count = size / record_length;
+    PointArray array(point_format_id, count, dimensions);
+
+    // Record layout of point formats 6-8, see Point::Unpack
+    RecordReader records{point_data, record_length};
+    // Each column is filled in its own pass over the records, so that the inner loops are branch free
+    for (auto &column : array.columns_)
+    {
+        switch (FindDimension(column.name).dimension)
+        {
+        case Dimension::X:
+            FillColumn<double>(column, count,
+                               [&](size_t i) { return ApplyScale(records.Get<int32_t>(i, 0), scale.x, offset.x); });
+            break;
+        case Dimension::Y:
+            FillColumn<double>(column, count,
+                               [&](size_t i) { return ApplyScale(records.Get<int32_t>(i, 4), scale.y, offset.y); });
+            break;
+        case Dimension::Z:
+            FillColumn<double>(column, count,
+                               [&](size_t i) { return ApplyScale(records.Get<int32_t>(i, 8), scale.z, offset.z); });
+            break;
+        case Dimension::Intensity:
+            FillColumn<uint16_t>(column, count, [&](size_t i) { return records.Get<uint16_t>(i, 12); });
+            break;
+        case Dimension::ReturnNumber:
+            FillColumn<uint8_t>(column, count, [&](size_t i) { return records.Get<uint8_t>(i, 14) & 0xF; });
+            break;
+        case Dimension::NumberOfReturns:
+            FillColumn<uint8_t>(column, count, [&](size_t i) { return records.Get<uint8_t>(i, 14) >> 4; });
+            break;
+        case Dimension::Synthetic:
+            FillColumn<uint8_t>(column, count, [&](size_t i) { return records.Get<uint8_t>(i, 15) & 0x1; });
+            break;
+        case Dimension::KeyPoint:
+            FillColumn<uint8_t>(column, count, [&](size_t i) { return (records.Get<uint8_t>(i, 15) >> 1) & 0x1; });
+            break;
+        case Dimension::Withheld:
+            FillColumn<uint8_t>(column, count, [&](size_t i) { return (records.Get<uint8_t>(i, 15) >> 2) & 0x1; });
+            break;
+        case Dimension::Overlap:
+            FillColumn<uint8_t>(column, count, [&](size_t i) { return (records.Get<uint8_t>(i, 15) >> 3) & 0x1; });
+            break;
+        case Dimension::ScannerChannel:
+            FillColumn<uint8_t>(column, count, [&](size_t i) { return (records.Get<uint8_t>(i, 15) >> 4) & 0x3; });
+            break;
+        case Dimension::ScanDirectionFlag:
+            FillColumn<uint8_t>(column, count, [&](size_t i) { return (records.Get<uint8_t>(i, 15) >> 6) & 0x1; });
+            break;
+        case Dimension::EdgeOfFlightLine:
+            FillColumn<uint8_t>(column, count, [&](size_t i) { return records.Get<uint8_t>(i, 15) >> 7; });
+            break;
+        case Dimension::Classification:
+            FillColumn<uint8_t>(column, count, [&](size_t i) { return records.Get<uint8_t>(i, 16); });
+            break;
+        case Dimension::UserData:
+            FillColumn<uint8_t>(column, count, [&](size_t i) { return records.Get<uint8_t>(i, 17); });
+            break;
+        case Dimension::ScanAngle:
+            FillColumn<int16_t>(column, count, [&](size_t i) { return records.Get<int16_t>(i, 18); });
+            break;
+        case Dimension::PointSourceId:
+            FillColumn<uint16_t>(column, count, [&](size_t i) { return records.Get<uint16_t>(i, 20); });
+            break;
+        case Dimension::GPSTime:
+            FillColumn<double>(column, count, [&](size_t i) { return records.Get<double>(i, 22); });
+            break;
+        case Dimension::Red:
+            FillColumn<uint16_t>(column, count, [&](size_t i) { return records.Get<uint16_t>(i, 30); });
+            break;
+        case Dimension::Green:
+            FillColumn<uint16_t>(column, count, [&](size_t i) { return records.Get<uint16_t>(i, 32); });
+            break;
+        case Dimension::Blue:
+            FillColumn<uint16_t>(column, count, [&](size_t i) { return records.Get<uint16_t>(i, 34); });
+            break;
+        case Dimension::Nir:
+            FillColumn<uint16_t>(column, count, [&](size_t i) { return records.Get<uint16_t>(i, 36); });
+            break;
+        }
+    }
+    return array;
+}
+
+PointArray PointArray::FromPoints(const Points &points, const std::vector<std::string> &dimensions)
+{
+    size_t count = points.Size();
+    PointArray array(points.PointFormatId(), count, dimensions);
+
+    for (auto &column : array.columns_)
+    {
+        switch (FindDimension(column.name).dimension)
+        {
+        case Dimension::X:
+            FillColumn<double>(column, count, [&](size_t i) { return points[i]->X(); });
+            break;
+        case Dimension::Y:
+            FillColumn<double>(column, count, [&](size_t i) { return points[i]->Y(); });
+            break;
+        case Dimension::Z:
+            FillColumn<double>(column, count, [&](size_t i) { return points[i]->Z(); });
+            break;
+        case Dimension::Intensity:
+            FillColumn<uint16_t>(column, count, [&](size_t i) { return points[i]->Intensity(); });
+            break;
+        case Dimension::ReturnNumber:
+            FillColumn<uint8_t>(column, count, [&](size_t i) { return points[i]->ReturnNumber(); });
+            break;
+        case Dimension::NumberOfReturns:
+            FillColumn<uint8_t>(column, count, [&](size_t i) { return points[i]->NumberOfReturns(); });
+            break;
+        case Dimension::Synthetic:
+            FillColumn<uint8_t>(column, count, [&](size_t i) { return points[i]->Synthetic(); });
+            break;
+        case Dimension::KeyPoint:
+            FillColumn<uint8_t>(column, count, [&](size_t i) { return points[i]->KeyPoint(); });
+            break;
+        case Dimension::Withheld:
+            FillColumn<uint8_t>(column, count, [&](size_t i) { return points[i]->Withheld(); });
+            break;
+        case Dimension::Overlap:
+            FillColumn<uint8_t>(column, count, [&](size_t i) { return points[i]->Overlap(); });
+            break;
+        case Dimension::ScannerChannel:
+            FillColumn<uint8_t>(column, count, [&](size_t i) { return points[i]->ScannerChannel(); });
+            break;
+        case Dimension::ScanDirectionFlag:
+            FillColumn<uint8_t>(column, count, [&](size_t i) { return points[i]->ScanDirectionFlag(); });
+            break;
+        case Dimension::EdgeOfFlightLine:
+            FillColumn<uint8_t>(column, count, [&](size_t i) { return points[i]->EdgeOfFlightLineFlag(); });
+            break;
+        case Dimension::Classification:
+            FillColumn<uint8_t>(column, count, [&](size_t i) { return points[i]->Classification(); });
+            break;
+        case Dimension::UserData:
+            FillColumn<uint8_t>(column, count, [&](size_t i) { return points[i]->UserData(); });
+            break;
+        case Dimension::ScanAngle:
+            FillColumn<int16_t>(column, count, [&](size_t i) { return points[i]->ScanAngle(); });
+            break;
+        case Dimension::PointSourceId:
+            FillColumn<uint16_t>(column, count, [&](size_t i) { return points[i]->PointSourceId(); });
+            break;
+        case Dimension::GPSTime:
+            FillColumn<double>(column, count, [&](size_t i) { return points[i]->GPSTime(); });
+            break;
+        case Dimension::Red:
+            FillColumn<uint16_t>(column, count, [&](size_t i) { return points[i]->Red(); });
+            break;
+        case Dimension::Green:
+            FillColumn<uint16_t>(column, count, [&](size_t i) { return points[i]->Green(); });
+            break;
+        case Dimension::Blue:
+            FillColumn<uint16_t>(column, count, [&](size_t i) { return points[i]->Blue(); });
+            break;
+        case Dimension::Nir:
+            FillColumn<uint16_t>(column, count, [&](size_t i) { return points[i]->Nir(); });
+            break;
+        }
+    }
+    return array;
+}
+
+std::vector<std::string> PointArray::AvailableDimensions(const int8_t &point_format_id)
+{
+    std::vector<std::string> names;
+    for (const auto &info : DIMENSIONS)
+    {
+        if (FormatHasDimension(point_format_id, info.dimension))
+            names.emplace_back(info.name);
+    }
+    return names;
+}
+
+size_t PointArray::ItemSize(DimensionType type)
+{
+    switch (type)
+    {
+    case DimensionType::Bool:
+    case DimensionType::UInt8:
+        return 1;
+    case DimensionType::Int16:
+    case DimensionType::UInt16:
+        return 2;
+    case DimensionType::Float64:
+        return 8;
+    }
+    return 0;
+}
+
+bool PointArray::HasDimension(const std::string &name) const
+{
+    return std::any_of(columns_.begin(), columns_.end(), [&](const Column &column) { return column.name == name; });
+}
+
+const PointArray::Column &PointArray::GetColumn(const std::string &name) const
+{
+    for (const auto &column : columns_)
+    {
+        if (column.name == name)
+            return column;
+    }
+    throw std::runtime_error("PointArray::GetColumn: Dimension " + name + " is not in the array.");
+}
+
+} // namespace copc::las
@@ -0,0 +1,195 @@
+#include "copc-lib/las/point_codec.hpp"
+
+#include <array>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+#include "copc-lib/las/utils.hpp"
+
+namespace copc::las
+{
+namespace
+{
+// Record layout of point formats 6-8, known at compile time
+template <int8_t PointFormatId> struct Layout
+{
+    static_assert(PointFormatId >= 6 && PointFormatId <= 8, "Point format must be 6-8");
+    static const bool HAS_RGB = PointFormatId >= 7;
+    static const bool HAS_NIR = PointFormatId == 8;
+    static const uint32_t BASE_BYTE_SIZE = 30 + (HAS_RGB ? 6 : 0) + (HAS_NIR ? 2 : 0);
+};
+
+template <typename T> T Read(const char *data, size_t offset)
+{
+    T value;
+    std::memcpy(&value, data + offset, sizeof(T));
+    return value;
+}
+
+template <typename T> void Write(char *data, size_t offset, const T &value)
+{
+    std::memcpy(data + offset, &value, sizeof(T));
+}
+} // namespace
+
+PointCodec::PointCodec(int8_t point_format_id, uint16_t eb_byte_size, UnpackPointFunction unpack_point,
+                       PackPointFunction pack_point, UnpackPointsFunction unpack_points,
+                       PackPointsFunction pack_points)
+    : point_format_id_(point_format_id), eb_byte_size_(eb_byte_size),
+      point_record_length_(PointByteSize(point_format_id, eb_byte_size)), unpack_point_(unpack_point),
+      pack_point_(pack_point), unpack_points_(unpack_points), pack_points_(pack_points)
+{
+}
+
+template <int8_t PointFormatId, int EbSize>
+void PointCodec::UnpackRecord(const char *data, Point &point, const Vector3 &scale, const Vector3 &offset,
+                              uint16_t eb_byte_size)
+{
+    using L = Layout<PointFormatId>;
+    point.x_scaled_ = ApplyScale(Read<int32_t>(data, 0), scale.x, offset.x);
+    point.y_scaled_ = ApplyScale(Read<int32_t>(data, 4), scale.y, offset.y);
+    point.z_scaled_ = ApplyScale(Read<int32_t>(data, 8), scale.z, offset.z);
+    point.intensity_ = Read<uint16_t>(data, 12);
+    point.returns_ = Read<uint8_t>(data, 14);
+    point.flags_ = Read<uint8_t>(data, 15);
+    point.classification_ = Read<uint8_t>(data, 16);
+    point.user_data_ = Read<uint8_t>(data, 17);
+    point.scan_angle_ = Read<int16_t>(data, 18);
+    point.point_source_id_ = Read<uint16_t>(data, 20);
+    point.gps_time_ = Read<double>(data, 22);
+    if constexpr (L::HAS_RGB)
+        std::memcpy(point.rgb_, data + 30, sizeof(point.rgb_));
+    if constexpr (L::HAS_NIR)
+        point.nir_ = Read<uint16_t>(data, 36);
+
+    if constexpr (EbSize > 0)
+        std::memcpy(point.extra_bytes_.data(), data + L::BASE_BYTE_SIZE, EbSize);
+    else if constexpr (EbSize < 0)
+        std::memcpy(point.extra_bytes_.data(), data + L::BASE_BYTE_SIZE, eb_byte_size);
+}
+
+template <int8_t PointFormatId, int EbSize>
+void PointCodec::PackRecord(const Point &point, char *data, const Vector3 &scale, const Vector3 &offset,
+                            uint16_t eb_byte_size)
+{
+    using L = Layout<PointFormatId>;
+    Write(data, 0, RemoveScale<int32_t>(point.x_scaled_, scale.x, offset.x));
+    Write(data, 4, RemoveScale<int32_t>(point.y_scaled_, scale.y, offset.y));
+    Write(data, 8, RemoveScale<int32_t>(point.z_scaled_, scale.z, offset.z));
+    Write(data, 12, point.intensity_);
+    Write(data, 14, point.returns_);
+    Write(data, 15, point.flags_);
+    Write(data, 16, point.classification_);
+    Write(data, 17, point.user_data_);
+    Write(data, 18, point.scan_angle_);
+    Write(data, 20, point.point_source_id_);
+    Write(data, 22, point.gps_time_);
+    if constexpr (L::HAS_RGB)
+        std::memcpy(data + 30, point.rgb_, sizeof(point.rgb_));
+    if constexpr (L::HAS_NIR)
+        Write(data, 36, point.nir_);
+
+    if constexpr (EbSize > 0)
+        std::memcpy(data + L::BASE_BYTE_SIZE, point.extra_bytes_.data(), EbSize);
+    else if constexpr (EbSize < 0)
+        std::memcpy(data + L::BASE_BYTE_SIZE, point.extra_bytes_.data(), eb_byte_size);
+}
+
+template <int8_t PointFormatId, int EbSize>
+std::shared_ptr<Point> PointCodec::UnpackPointImpl(const char *data, const Vector3 &scale, const Vector3 &offset,
+                                                   uint16_t eb_byte_size)
+{
+    auto point = std::make_shared<Point>(PointFormatId, eb_byte_size);
+    UnpackRecord<PointFormatId, EbSize>(data, *point, scale, offset, eb_byte_size);
+    return point;
+}
+
+template <int8_t PointFormatId, int EbSize>
+void PointCodec::PackPointImpl(const Point &point, char *data, const Vector3 &scale, const Vector3 &offset,
+                               uint16_t eb_byte_size)
+{
+    if (point.PointFormatId() != PointFormatId || point.EbByteSize() != eb_byte_size)
+        throw std::runtime_error("PointCodec::PackPoint: The point's format does not match the codec.");
+    PackRecord<PointFormatId, EbSize>(point, data, scale, offset, eb_byte_size);
+}
+
+template <int8_t PointFormatId, int EbSize>
+std::vector<std::shared_ptr<Point>> PointCodec::UnpackPointsImpl(const char *data, size_t count,
+                                                                 const Vector3 &scale, const Vector3 &offset,
+                                                                 uint16_t eb_byte_size, Arena *arena)
+{
+    const size_t record_length = Layout<PointFormatId>::BASE_BYTE_SIZE + (EbSize >= 0 ? EbSize : eb_byte_size);
+    std::vector<std::shared_ptr<Point>> points;
+    points.reserve(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        auto point = arena ? std::allocate_shared<Point>(ArenaAllocator<Point>(*arena), PointFormatId, eb_byte_size)
+                           : std::make_shared<Point>(PointFormatId, eb_byte_size);
+        UnpackRecord<PointFormatId, EbSize>(data + i * record_length, *point, scale, offset, eb_byte_size);
+        points.push_back(std::move(point));
+    }
+    return points;
+}
+
+template <int8_t PointFormatId, int EbSize>
+void PointCodec::PackPointsImpl(const std::vector<std::shared_ptr<Point>> &points, char *data, const Vector3 &scale,
+                                const Vector3 &offset, uint16_t eb_byte_size)
+{
+    const size_t record_length = Layout<PointFormatId>::BASE_BYTE_SIZE + (EbSize >= 0 ? EbSize : eb_byte_size);
+    for (size_t i = 0; i < points.size(); i++)
+    {
+        const auto &point = *points[i];
+        // Extra bytes can be resized on a point after it was added to a Points object
+        if (point.point_record_length_ != record_length || point.point_format_id_ != PointFormatId)
+            throw std::runtime_error("PointCodec::PackPoints: Point " + std::to_string(i) +
+                                     " does not match the codec's format.");
+        PackRecord<PointFormatId, EbSize>(point, data + i * record_length, scale, offset, eb_byte_size);
+    }
+}
+
+template <int8_t PointFormatId, int EbSize> PointCodec PointCodec::Make(uint16_t eb_byte_size)
+{
+    return PointCodec(PointFormatId, eb_byte_size, &UnpackPointImpl<PointFormatId, EbSize>,
+                      &PackPointImpl<PointFormatId, EbSize>, &UnpackPointsImpl<PointFormatId, EbSize>,
+                      &PackPointsImpl<PointFormatId, EbSize>);
+}
+
+template <int8_t PointFormatId> const PointCodec &PointCodec::GetForFormat(uint16_t eb_byte_size)
+{
+    static const std::array<PointCodec, MAX_SPECIALIZED_EB_BYTE_SIZE + 1> specialized{
+        Make<PointFormatId, 0>(0), Make<PointFormatId, 1>(1), Make<PointFormatId, 2>(2),
+        Make<PointFormatId, 3>(3), Make<PointFormatId, 4>(4), Make<PointFormatId, 5>(5),
+        Make<PointFormatId, 6>(6), Make<PointFormatId, 7>(7), Make<PointFormatId, 8>(8)};
+    static_assert(MAX_SPECIALIZED_EB_BYTE_SIZE == 8, "The specialized codecs must cover MAX_SPECIALIZED_EB_BYTE_SIZE");
+    if (eb_byte_size <= MAX_SPECIALIZED_EB_BYTE_SIZE)
+        return specialized[eb_byte_size];
+
+    // Larger extra bytes sizes share the implementation with a runtime size, and are created on first use
+    static std::mutex mutex;
+    static std::map<uint16_t, PointCodec> generic;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = generic.find(eb_byte_size);
+    if (it == generic.end())
+        it = generic.emplace(eb_byte_size, Make<PointFormatId, -1>(eb_byte_size)).first;
+    return it->second;
+}
+
+const PointCodec &PointCodec::Get(const int8_t &point_format_id, const uint16_t &eb_byte_size)
+{
+    switch (point_format_id)
+    {
+    case 6:
+        return GetForFormat<6>(eb_byte_size);
+    case 7:
+        return GetForFormat<7>(eb_byte_size);
+    case 8:
+        return GetForFormat<8>(eb_byte_size);
+    default:
+        throw std::runtime_error("PointCodec::Get: Point format must be 6-8.");
+    }
+}
+
+} // namespace copc::las
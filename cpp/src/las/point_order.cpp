@@ -0,0 +1,173 @@
+#include "copc-lib/las/point_order.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include "copc-lib/las/utils.hpp"
+
+namespace copc::las
+{
+
+namespace
+{
+// Bits of each coordinate in a 64 bit Morton code
+const int MORTON_BITS = 21;
+
+// Moves the low 21 bits of value to every third bit
+uint64_t SpreadBits(uint64_t value)
+{
+    value &= (uint64_t{1} << MORTON_BITS) - 1;
+    value = (value | value << 32) & 0x001F00000000FFFF;
+    value = (value | value << 16) & 0x001F0000FF0000FF;
+    value = (value | value << 8) & 0x100F00F00F00F00F;
+    value = (value | value << 4) & 0x10C30C30C30C30C3;
+    value = (value | value << 2) & 0x1249249249249249;
+    return value;
+}
+
+// Maps a double to an integer of the same order, negative values included
+uint64_t OrderedBits(double value)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (bits >> 63) ? ~bits : bits | (uint64_t{1} << 63);
+}
+
+void MortonKeys(const char *data, size_t point_count, uint16_t point_record_length, uint64_t *keys)
+{
+    // Coordinates are taken relative to the minimum of the records, and shifted so that the largest range fits the
+    // code, the same shift for every axis to keep the curve's cells cubic
+    std::array<int32_t, 3> min_xyz, max_xyz;
+    min_xyz.fill(std::numeric_limits<int32_t>::max());
+    max_xyz.fill(std::numeric_limits<int32_t>::min());
+    for (size_t i = 0; i < point_count; i++)
+    {
+        int32_t xyz[3];
+        std::memcpy(xyz, data + i * point_record_length, sizeof(xyz));
+        for (int a = 0; a < 3; a++)
+        {
+            min_xyz[a] = std::min(min_xyz[a], xyz[a]);
+            max_xyz[a] = std::max(max_xyz[a], xyz[a]);
+        }
+    }
+    int shift = 0;
+    for (int a = 0; a < 3; a++)
+    {
+        auto range = static_cast<uint32_t>(static_cast<int64_t>(max_xyz[a]) - min_xyz[a]);
+        while ((range >> shift) >= (uint32_t{1} << MORTON_BITS))
+            shift++;
+    }
+
+    for (size_t i = 0; i < point_count; i++)
+    {
+        int32_t xyz[3];
+        std::memcpy(xyz, data + i * point_record_length, sizeof(xyz));
+        uint32_t relative[3];
+        for (int a = 0; a < 3; a++)
+            relative[a] = static_cast<uint32_t>(static_cast<int64_t>(xyz[a]) - min_xyz[a]) >> shift;
+        keys[i] = MortonCode(relative[0], relative[1], relative[2]);
+    }
+}
+
+void GpsTimeKeys(const char *data, size_t point_count, uint16_t point_record_length, uint64_t *keys)
+{
+    for (size_t i = 0; i < point_count; i++)
+    {
+        double gps_time;
+        std::memcpy(&gps_time, data + i * point_record_length + GPS_TIME_OFFSET, sizeof(gps_time));
+        keys[i] = OrderedBits(gps_time);
+    }
+}
+
+// Sorts the indices by their keys, a byte per pass from the least significant. The histograms of every byte are
+// counted in a single pass, and bytes that are the same for all keys are skipped.
+void RadixSort(std::vector<uint64_t> &keys, std::vector<uint32_t> &indices)
+{
+    const size_t count = keys.size();
+    std::vector<std::array<size_t, 256>> histograms(sizeof(uint64_t));
+    for (auto &histogram : histograms)
+        histogram.fill(0);
+    for (auto key : keys)
+        for (size_t b = 0; b < sizeof(uint64_t); b++)
+            histograms[b][(key >> (8 * b)) & 0xFF]++;
+
+    std::vector<uint64_t> sorted_keys(count);
+    std::vector<uint32_t> sorted_indices(count);
+    for (size_t b = 0; b < sizeof(uint64_t); b++)
+    {
+        auto &histogram = histograms[b];
+        const int shift = static_cast<int>(8 * b);
+        if (histogram[(keys[0] >> shift) & 0xFF] == count)
+            continue;
+
+        size_t offset = 0;
+        for (auto &bucket : histogram)
+        {
+            auto bucket_count = bucket;
+            bucket = offset;
+            offset += bucket_count;
+        }
+        for (size_t i = 0; i < count; i++)
+        {
+            auto position = histogram[(keys[i] >> shift) & 0xFF]++;
+            sorted_keys[position] = keys[i];
+            sorted_indices[position] = indices[i];
+        }
+        keys.swap(sorted_keys);
+        indices.swap(sorted_indices);
+    }
+}
+} // namespace
+
+uint64_t MortonCode(uint32_t x, uint32_t y, uint32_t z)
+{
+    return SpreadBits(x) | SpreadBits(y) << 1 | SpreadBits(z) << 2;
+}
+
+void SortPointData(char *data, size_t point_count, uint16_t point_record_length, PointOrder order)
+{
+    if (order == PointOrder::Unchanged || point_count < 2)
+        return;
+    if (point_record_length < MIN_RECORD_LENGTH)
+        throw std::runtime_error("SortPointData: Point records must be of point format 6, 7 or 8.");
+    if (point_count > std::numeric_limits<uint32_t>::max())
+        throw std::runtime_error("SortPointData: Too many points.");
+
+    std::vector<uint64_t> keys(point_count);
+    switch (order)
+    {
+    case PointOrder::Morton:
+        MortonKeys(data, point_count, point_record_length, keys.data());
+        break;
+    case PointOrder::GpsTime:
+        GpsTimeKeys(data, point_count, point_record_length, keys.data());
+        break;
+    default:
+        throw std::runtime_error("SortPointData: Unknown point order.");
+    }
+
+    std::vector<uint32_t> indices(point_count);
+    for (size_t i = 0; i < point_count; i++)
+        indices[i] = static_cast<uint32_t>(i);
+    RadixSort(keys, indices);
+
+    // Gather the records in their new order, then copy them back
+    std::vector<char> sorted(point_count * point_record_length);
+    for (size_t i = 0; i < point_count; i++)
+        std::memcpy(sorted.data() + i * point_record_length, data + size_t{indices[i]} * point_record_length,
+                    point_record_length);
+    std::memcpy(data, sorted.data(), sorted.size());
+}
+
+void SortPointData(std::vector<char> &data, const LasHeader &header, PointOrder order)
+{
+    auto point_record_length = header.PointRecordLength();
+    if (point_record_length == 0 || data.size() % point_record_length != 0)
+        throw std::runtime_error("SortPointData: Data must be a whole number of point records.");
+    SortPointData(data.data(), data.size() / point_record_length, point_record_length, order);
+}
+
+} // namespace copc::las
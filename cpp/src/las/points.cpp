@@ -1,7 +1,9 @@
 #include "copc-lib/las/points.hpp"
+#include <iterator>
 #include <sstream>
 #include <string>
 
+#include "copc-lib/las/point_codec.hpp"
 #include "copc-lib/las/utils.hpp"
 
 namespace copc::las
@@ -28,6 +30,17 @@ Points::Points(const std::vector<std::shared_ptr<Point>> &points)
     AddPoints(points);
 }
 
+Points::Points(std::vector<std::shared_ptr<Point>> &&points)
+{
+    if (points.empty())
+        throw std::runtime_error("Can't add empty vector of points to Points!");
+
+    point_record_length_ = points[0]->PointRecordLength();
+    point_format_id_ = points[0]->PointFormatId();
+
+    AddPoints(std::move(points));
+}
+
 void Points::ToPointFormat(const int8_t &point_format_id)
 {
     if (point_format_id < 6 || point_format_id > 8)
@@ -47,13 +60,25 @@ void Points::AddPoint(const std::shared_ptr<Point> &point)
         throw std::runtime_error("New point must be of same format and byte_size.");
 }
 
-void Points::AddPoints(Points points)
+void Points::AddPoints(const Points &points)
+{
+    if (points.PointFormatId() != point_format_id_ || points.PointRecordLength() != point_record_length_)
+        throw std::runtime_error("New points must be of same format and byte_size.");
+
+    points_.insert(points_.end(), points.points_.begin(), points.points_.end());
+}
+
+void Points::AddPoints(Points &&points)
 {
     if (points.PointFormatId() != point_format_id_ || points.PointRecordLength() != point_record_length_)
         throw std::runtime_error("New points must be of same format and byte_size.");
 
-    auto point_vec = points.Get();
-    points_.insert(points_.end(), point_vec.begin(), point_vec.end());
+    if (points_.empty() && points.points_.capacity() >= points_.capacity())
+        points_ = std::move(points.points_);
+    else
+        points_.insert(points_.end(), std::make_move_iterator(points.points_.begin()),
+                       std::make_move_iterator(points.points_.end()));
+    points.points_.clear();
 }
 
 void Points::AddPoints(std::vector<std::shared_ptr<Point>> points)
@@ -64,7 +89,29 @@ void Points::AddPoints(std::vector<std::shared_ptr<Point>> points)
             throw std::runtime_error("New points must be of same format and byte_size.");
     }
 
-    points_.insert(points_.end(), points.begin(), points.end());
+    if (points_.empty() && points.capacity() >= points_.capacity())
+        points_ = std::move(points);
+    else
+        points_.insert(points_.end(), std::make_move_iterator(points.begin()), std::make_move_iterator(points.end()));
+}
+
+void Points::AddPoints(std::vector<Points> &&points_list)
+{
+    size_t total_size = points_.size();
+    for (const auto &points : points_list)
+    {
+        if (points.PointFormatId() != point_format_id_ || points.PointRecordLength() != point_record_length_)
+            throw std::runtime_error("New points must be of same format and byte_size.");
+        total_size += points.Size();
+    }
+
+    points_.reserve(total_size);
+    for (auto &points : points_list)
+    {
+        points_.insert(points_.end(), std::make_move_iterator(points.points_.begin()),
+                       std::make_move_iterator(points.points_.end()));
+        points.points_.clear();
+    }
 }
 
 Points Points::Unpack(const std::vector<char> &point_data, const LasHeader &header)
@@ -75,25 +122,32 @@ Points Points::Unpack(const std::vector<char> &point_data, const LasHeader &head
 Points Points::Unpack(const std::vector<char> &point_data, const int8_t &point_format_id, const uint16_t &eb_byte_size,
                       const Vector3 &scale, const Vector3 &offset)
 {
-    auto point_record_length = PointByteSize(point_format_id, eb_byte_size);
-    if (point_data.size() % point_record_length != 0)
-        throw std::runtime_error("Invalid input point array!");
-
-    uint64_t point_count = point_data.size() / point_record_length;
+    return Unpack(point_data.data(), point_data.size(), point_format_id, eb_byte_size, scale, offset, nullptr);
+}
 
-    // Make a stream out of the vector of char
-    auto ss = std::istringstream(std::string(point_data.begin(), point_data.end()));
+Points Points::Unpack(const char *point_data, const size_t &size, const LasHeader &header)
+{
+    return Unpack(point_data, size, header.PointFormatId(), header.EbByteSize(), header.Scale(), header.Offset(),
+                  nullptr);
+}
 
-    // Go through each Point to unpack the data from the stream
-    Points points(point_format_id, eb_byte_size);
-    points.Reserve(point_count);
+Points Points::Unpack(const char *point_data, const size_t &size, const LasHeader &header, Arena &arena)
+{
+    return Unpack(point_data, size, header.PointFormatId(), header.EbByteSize(), header.Scale(), header.Offset(),
+                  &arena);
+}
 
-    // Unpack points
-    for (int i = 0; i < point_count; i++)
-    {
-        points.AddPoint(las::Point::Unpack(ss, point_format_id, scale, offset, eb_byte_size));
-    }
+Points Points::Unpack(const char *point_data, const size_t &size, const int8_t &point_format_id,
+                      const uint16_t &eb_byte_size, const Vector3 &scale, const Vector3 &offset, Arena *arena)
+{
+    const auto &codec = PointCodec::Get(point_format_id, eb_byte_size);
+    if (size % codec.PointRecordLength() != 0)
+        throw std::runtime_error("Invalid input point array!");
 
+    Points points(point_format_id, eb_byte_size);
+    size_t count = size / codec.PointRecordLength();
+    points.points_ = arena ? codec.UnpackPoints(point_data, count, scale, offset, *arena)
+                           : codec.UnpackPoints(point_data, count, scale, offset);
     return points;
 }
 
@@ -104,18 +158,20 @@ void Points::Pack(std::ostream &out_stream, const LasHeader &header) const
 
 void Points::Pack(std::ostream &out_stream, const Vector3 &scale, const Vector3 &offset) const
 {
-    for (const auto &point : points_)
-        point->Pack(out_stream, scale, offset);
+    auto point_data = Pack(scale, offset);
+    out_stream.write(point_data.data(), static_cast<std::streamsize>(point_data.size()));
 }
 
 std::vector<char> Points::Pack(const LasHeader &header) const { return Pack(header.Scale(), header.Offset()); }
 
 std::vector<char> Points::Pack(const Vector3 &scale, const Vector3 &offset) const
 {
-    std::stringstream out;
-    Pack(out, scale, offset);
-    auto ostr = out.str();
-    return std::vector<char>(ostr.begin(), ostr.end());
+    if (points_.empty())
+        return {};
+    const auto &codec = PointCodec::Get(point_format_id_, EbByteSize());
+    std::vector<char> point_data(points_.size() * codec.PointRecordLength());
+    codec.PackPoints(points_, point_data.data(), scale, offset);
+    return point_data;
 }
 
 std::string Points::ToString() const
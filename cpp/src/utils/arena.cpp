@@ -0,0 +1,68 @@
+#include "copc-lib/utils/arena.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace copc
+{
+
+void *Arena::Allocate(size_t bytes, size_t alignment)
+{
+    if (alignment > alignof(std::max_align_t) || (alignment & (alignment - 1)) != 0)
+        throw std::runtime_error("Arena::Allocate: Unsupported alignment.");
+
+    // Blocks are allocated with max_align_t alignment, so aligning the offset is enough
+    if (!blocks_.empty())
+    {
+        size_t offset = (offset_ + alignment - 1) & ~(alignment - 1);
+        if (offset + bytes <= blocks_.back().size)
+        {
+            offset_ = offset + bytes;
+            bytes_used_ += bytes;
+            return blocks_.back().data.get() + offset;
+        }
+    }
+
+    // Grow geometrically, so that the number of blocks stays small for large nodes
+    size_t size = std::max(block_size_, bytes);
+    if (!blocks_.empty())
+        size = std::max(size, blocks_.back().size * 2);
+    AddBlock(size);
+    offset_ = bytes;
+    bytes_used_ += bytes;
+    return blocks_.back().data.get();
+}
+
+void Arena::Release()
+{
+    size_t capacity = Capacity();
+    if (capacity > max_retained_bytes_)
+    {
+        blocks_.clear();
+        if (block_size_ <= max_retained_bytes_)
+            AddBlock(block_size_);
+    }
+    else if (blocks_.size() > 1)
+    {
+        blocks_.clear();
+        AddBlock(capacity);
+    }
+    offset_ = 0;
+    bytes_used_ = 0;
+}
+
+size_t Arena::Capacity() const
+{
+    size_t capacity = 0;
+    for (const auto &block : blocks_)
+        capacity += block.size;
+    return capacity;
+}
+
+void Arena::AddBlock(size_t size)
+{
+    blocks_.push_back({std::unique_ptr<char[]>(new char[size]), size});
+    block_allocations_++;
+}
+
+} // namespace copc
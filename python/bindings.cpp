@@ -5,21 +5,35 @@
 #include <utility>
 #include <vector>
 
+#include <pybind11/numpy.h>
 #include <pybind11/operators.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <pybind11/stl_bind.h>
 
+#include <copc-lib/catalog/catalog.hpp>
 #include <copc-lib/copc/info.hpp>
 #include <copc-lib/geometry/box.hpp>
 #include <copc-lib/hierarchy/key.hpp>
 #include <copc-lib/hierarchy/node.hpp>
+#include <copc-lib/io/copc_merge.hpp>
 #include <copc-lib/io/copc_reader.hpp>
+#include <copc-lib/io/copc_repack.hpp>
+#include <copc-lib/io/copc_subset.hpp>
 #include <copc-lib/io/copc_writer.hpp>
+#include <copc-lib/io/io_stats.hpp>
+#include <copc-lib/io/laz_export.hpp>
 #include <copc-lib/io/laz_reader.hpp>
 #include <copc-lib/io/laz_writer.hpp>
+#include <copc-lib/io/output_sink.hpp>
+#include <copc-lib/io/tracing.hpp>
+#include <copc-lib/las/dimension_stats.hpp>
+#include <copc-lib/las/extra_bytes_schema.hpp>
 #include <copc-lib/las/header.hpp>
+#include <copc-lib/las/header_stats.hpp>
 #include <copc-lib/las/point.hpp>
+#include <copc-lib/las/point_array.hpp>
+#include <copc-lib/las/point_order.hpp>
 #include <copc-lib/las/points.hpp>
 #include <copc-lib/las/vlr.hpp>
 #include <copc-lib/laz/compressor.hpp>
@@ -30,9 +44,85 @@ using namespace copc;
 
 PYBIND11_MAKE_OPAQUE(std::vector<char>)
 
+// Releases the GIL while the bound function runs, for functions that do I/O or heavy work without touching Python
+// objects
+using release_gil = py::call_guard<py::gil_scoped_release>;
+
+py::dtype NumpyDtype(las::PointArray::DimensionType type)
+{
+    switch (type)
+    {
+    case las::PointArray::DimensionType::Bool:
+        return py::dtype::of<bool>();
+    case las::PointArray::DimensionType::UInt8:
+        return py::dtype::of<uint8_t>();
+    case las::PointArray::DimensionType::Int16:
+        return py::dtype::of<int16_t>();
+    case las::PointArray::DimensionType::UInt16:
+        return py::dtype::of<uint16_t>();
+    default:
+        return py::dtype::of<double>();
+    }
+}
+
+// Returns a dict of NumPy arrays that wrap the columns of the PointArray without copying them.
+// The arrays share ownership of the PointArray, which is freed once all of them are garbage collected.
+py::dict PointArrayToNumpy(las::PointArray &&array)
+{
+    auto owner = new std::shared_ptr<las::PointArray>(std::make_shared<las::PointArray>(std::move(array)));
+    py::capsule base(owner, [](void *p) { delete reinterpret_cast<std::shared_ptr<las::PointArray> *>(p); });
+
+    py::dict out;
+    for (auto &column : (*owner)->Columns())
+    {
+        auto size = static_cast<py::ssize_t>((*owner)->Size());
+        auto stride = static_cast<py::ssize_t>(column.ItemSize());
+        out[py::str(column.name)] = py::array(NumpyDtype(column.type), {size}, {stride}, column.Data(), base);
+    }
+    return out;
+}
+
+// Lets Tracer be subclassed in Python. OnEvent takes the GIL, which the functions doing parallel work release.
+class PyTracer : public Tracer
+{
+  public:
+    void OnEvent(const TraceEvent &event) override { PYBIND11_OVERRIDE_PURE(void, Tracer, OnEvent, event); }
+};
+
+// Registers a tracer created in Python. The registered pointer shares ownership of the Python object, so that the
+// methods of a Python subclass outlive the caller's reference, until the tracer is replaced and its last span ends.
+void SetPythonTracer(const py::object &tracer)
+{
+    if (tracer.is_none())
+    {
+        SetTracer(nullptr);
+        return;
+    }
+    auto held = tracer.cast<std::shared_ptr<Tracer>>();
+    // The last span can end on any thread, so the Python object is released with the GIL
+    auto owner = new py::object(tracer);
+    SetTracer(std::shared_ptr<Tracer>(held.get(),
+                                      [held, owner](Tracer *)
+                                      {
+                                          py::gil_scoped_acquire gil;
+                                          delete owner;
+                                      }));
+}
+
 PYBIND11_MODULE(_core, m)
 {
     py::bind_vector<std::vector<char>>(m, "VectorChar", py::buffer_protocol())
+        // Copies any contiguous buffer (bytes, NumPy arrays...) at once, rather than element by element
+        .def(py::init(
+                 [](const py::buffer &buffer)
+                 {
+                     auto info = buffer.request();
+                     if (!PyBuffer_IsContiguous(info.view(), 'C'))
+                         throw std::runtime_error("VectorChar: The buffer must be contiguous.");
+                     auto data = static_cast<const char *>(info.ptr);
+                     return std::vector<char>(data, data + info.size * info.itemsize);
+                 }),
+             py::arg("buffer"), py::prepend())
         .def(py::pickle(
             [](const std::vector<char> &vec) { // __getstate__
                 // Convert vector<char> to string for pickling
@@ -163,6 +253,52 @@ PYBIND11_MODULE(_core, m)
                 return h;
             }));
 
+    py::class_<las::HeaderStats>(m, "HeaderStats")
+        .def(py::init<>())
+        .def("Add", py::overload_cast<const std::vector<char> &, const las::LasHeader &>(&las::HeaderStats::Add),
+             py::arg("point_data"), py::arg("header"), release_gil())
+        .def("Merge", &las::HeaderStats::Merge, py::arg("other"))
+        .def_property_readonly("point_count", &las::HeaderStats::PointCount)
+        .def("Min", &las::HeaderStats::Min, py::arg("header"))
+        .def("Max", &las::HeaderStats::Max, py::arg("header"))
+        .def_property_readonly("points_by_return", &las::HeaderStats::PointsByReturn)
+        .def_property_readonly("gps_time_min", &las::HeaderStats::GpsTimeMin)
+        .def_property_readonly("gps_time_max", &las::HeaderStats::GpsTimeMax)
+        .def("Apply", &las::HeaderStats::Apply, py::arg("header"))
+        .def("__str__", &las::HeaderStats::ToString)
+        .def("__repr__", &las::HeaderStats::ToString);
+
+    py::class_<las::DimensionStats> dimension_stats(m, "DimensionStats");
+    py::class_<las::DimensionStats::Dimension>(dimension_stats, "Dimension")
+        .def_readonly("name", &las::DimensionStats::Dimension::name)
+        .def_readonly("count", &las::DimensionStats::Dimension::count)
+        .def_readonly("minimum", &las::DimensionStats::Dimension::minimum)
+        .def_readonly("maximum", &las::DimensionStats::Dimension::maximum)
+        .def_readonly("mean", &las::DimensionStats::Dimension::mean)
+        .def_readonly("variance", &las::DimensionStats::Dimension::variance);
+    dimension_stats
+        .def(py::init<const las::LasHeader &, const las::EbVlr &>(), py::arg("header"),
+             py::arg("extra_bytes_vlr") = las::EbVlr())
+        .def("Add", py::overload_cast<const std::vector<char> &>(&las::DimensionStats::Add), py::arg("point_data"),
+             release_gil())
+        .def("Merge", &las::DimensionStats::Merge, py::arg("other"))
+        .def_property_readonly("point_count", &las::DimensionStats::PointCount)
+        .def_property_readonly("dimensions", &las::DimensionStats::Dimensions)
+        .def("HasDimension", &las::DimensionStats::HasDimension, py::arg("name"))
+        .def("GetDimension", &las::DimensionStats::GetDimension, py::arg("name"))
+        .def_property_readonly("classification_histogram", &las::DimensionStats::ClassificationHistogram)
+        .def("__str__", &las::DimensionStats::ToString)
+        .def("__repr__", &las::DimensionStats::ToString);
+
+    py::enum_<las::PointOrder>(m, "PointOrder")
+        .value("Unchanged", las::PointOrder::Unchanged)
+        .value("Morton", las::PointOrder::Morton)
+        .value("GpsTime", las::PointOrder::GpsTime);
+    m.def("SortPointData",
+          py::overload_cast<std::vector<char> &, const las::LasHeader &, las::PointOrder>(&las::SortPointData),
+          py::arg("point_data"), py::arg("header"), py::arg("order"), release_gil());
+    m.def("MortonCode", &las::MortonCode, py::arg("x"), py::arg("y"), py::arg("z"));
+
     py::class_<VoxelKey>(m, "VoxelKey")
         .def(py::init<>())
         .def(py::init<const int32_t &, const int32_t &, const int32_t &, const int32_t &>(), py::arg("d"), py::arg("x"),
@@ -464,6 +600,96 @@ PYBIND11_MODULE(_core, m)
         .def_readonly("items", &las::EbVlr::items)
         .def("add_field", py::overload_cast<const las::EbVlr::ebfield &>(&las::EbVlr::addField), py::arg("field"));
 
+    py::enum_<las::ExtraBytesSchema::FieldType>(m, "ExtraBytesFieldType")
+        .value("UInt8", las::ExtraBytesSchema::FieldType::UInt8)
+        .value("Int8", las::ExtraBytesSchema::FieldType::Int8)
+        .value("UInt16", las::ExtraBytesSchema::FieldType::UInt16)
+        .value("Int16", las::ExtraBytesSchema::FieldType::Int16)
+        .value("UInt32", las::ExtraBytesSchema::FieldType::UInt32)
+        .value("Int32", las::ExtraBytesSchema::FieldType::Int32)
+        .value("UInt64", las::ExtraBytesSchema::FieldType::UInt64)
+        .value("Int64", las::ExtraBytesSchema::FieldType::Int64)
+        .value("Float", las::ExtraBytesSchema::FieldType::Float)
+        .value("Double", las::ExtraBytesSchema::FieldType::Double);
+
+    py::class_<las::ExtraBytesSchema::Field>(m, "ExtraBytesField")
+        .def_readonly("name", &las::ExtraBytesSchema::Field::name)
+        .def_readonly("type", &las::ExtraBytesSchema::Field::type)
+        .def_readonly("count", &las::ExtraBytesSchema::Field::count)
+        .def_readonly("record_offset", &las::ExtraBytesSchema::Field::record_offset)
+        .def_readonly("has_no_data", &las::ExtraBytesSchema::Field::has_no_data)
+        .def_readonly("has_scale", &las::ExtraBytesSchema::Field::has_scale)
+        .def_readonly("has_offset", &las::ExtraBytesSchema::Field::has_offset);
+
+    py::class_<las::ExtraBytesSchema>(m, "ExtraBytesSchema")
+        .def(py::init<const las::EbVlr &, const int8_t &>(), py::arg("extra_bytes_vlr"), py::arg("point_format_id"))
+        .def(py::init<const las::EbVlr &, const las::LasHeader &>(), py::arg("extra_bytes_vlr"),
+             py::arg("las_header"))
+        .def_property_readonly("point_record_length", &las::ExtraBytesSchema::PointRecordLength)
+        .def_property_readonly("fields", &las::ExtraBytesSchema::Fields)
+        .def("HasField", &las::ExtraBytesSchema::HasField, py::arg("name"))
+        .def("GetField", &las::ExtraBytesSchema::GetField, py::arg("name"), py::return_value_policy::copy)
+        // Returns a dict of float64 arrays, of shape (n,) or (n, count) for fields with several elements
+        .def(
+            "ExtractScaled",
+            [](const las::ExtraBytesSchema &self, const std::vector<char> &point_data,
+               const std::vector<std::string> &names)
+            {
+                std::vector<std::vector<double>> columns;
+                {
+                    py::gil_scoped_release release;
+                    columns = self.ExtractScaled(point_data, names);
+                }
+                py::dict out;
+                size_t c = 0;
+                for (const auto &name : names)
+                {
+                    auto count = static_cast<py::ssize_t>(self.GetField(name).count);
+                    auto size = static_cast<py::ssize_t>(columns[c].size());
+                    py::array_t<double> array(count == 1 ? std::vector<py::ssize_t>{size}
+                                                         : std::vector<py::ssize_t>{size, count});
+                    auto data = array.mutable_data();
+                    for (py::ssize_t e = 0; e < count; e++, c++)
+                    {
+                        for (py::ssize_t i = 0; i < size; i++)
+                            data[i * count + e] = columns[c][i];
+                    }
+                    out[py::str(name)] = array;
+                }
+                return out;
+            },
+            py::arg("point_data"), py::arg("names"))
+        // Takes a dict of arrays laid out as returned by ExtractScaled, and writes them into point_data in place
+        .def(
+            "InjectScaled",
+            [](const las::ExtraBytesSchema &self, std::vector<char> &point_data, const py::dict &values)
+            {
+                std::vector<std::string> names;
+                std::vector<std::vector<double>> columns;
+                for (const auto &item : values)
+                {
+                    auto name = item.first.cast<std::string>();
+                    auto count = static_cast<py::ssize_t>(self.GetField(name).count);
+                    auto array = py::array_t<double, py::array::c_style | py::array::forcecast>::ensure(item.second);
+                    if (!array || array.size() % count != 0)
+                        throw std::runtime_error("ExtraBytesSchema.InjectScaled: Invalid array for field " + name +
+                                                 ".");
+                    auto size = array.size() / count;
+                    auto data = array.data();
+                    for (py::ssize_t e = 0; e < count; e++)
+                    {
+                        std::vector<double> column(size);
+                        for (py::ssize_t i = 0; i < size; i++)
+                            column[i] = data[i * count + e];
+                        columns.push_back(std::move(column));
+                    }
+                    names.push_back(name);
+                }
+                py::gil_scoped_release release;
+                self.InjectScaled(point_data, names, columns);
+            },
+            py::arg("point_data"), py::arg("values"));
+
     py::class_<las::Points>(m, "Points")
         .def(py::init<const uint8_t &, const uint16_t &>(),
              py::arg("point_format_id"), py::arg("eb_byte_size") = 0)
@@ -489,18 +715,19 @@ PYBIND11_MODULE(_core, m)
         .def_property_readonly("point_record_length", &las::Points::PointRecordLength)
         .def_property_readonly("eb_byte_size", &las::Points::EbByteSize)
         .def("AddPoint", &las::Points::AddPoint)
-        .def("AddPoints", py::overload_cast<las::Points>(&las::Points::AddPoints))
+        .def("AddPoints", py::overload_cast<const las::Points &>(&las::Points::AddPoints))
         .def("AddPoints", py::overload_cast<std::vector<std::shared_ptr<las::Point>>>(&las::Points::AddPoints))
         .def("CreatePoint", &las::Points::CreatePoint)
         .def("ToPointFormat", &las::Points::ToPointFormat, py::arg("point_format_id"))
         .def("Within", &las::Points::Within, py::arg("box"))
         .def("GetWithin", &las::Points::GetWithin, py::arg("box"))
         .def("Pack", py::overload_cast<const Vector3 &,
-                                         const Vector3 &>(&las::Points::Pack, py::const_))
-        .def("Pack", py::overload_cast<const las::LasHeader &>(&las::Points::Pack, py::const_))
-        .def("Unpack", py::overload_cast<const std::vector<char> &, const las::LasHeader &>(&las::Points::Unpack))
+                                         const Vector3 &>(&las::Points::Pack, py::const_), release_gil())
+        .def("Pack", py::overload_cast<const las::LasHeader &>(&las::Points::Pack, py::const_), release_gil())
+        .def("Unpack", py::overload_cast<const std::vector<char> &, const las::LasHeader &>(&las::Points::Unpack),
+             release_gil())
         .def("Unpack", py::overload_cast<const std::vector<char> &, const int8_t &, const uint16_t &, const Vector3 &,
-                                         const Vector3 &>(&las::Points::Unpack))
+                                         const Vector3 &>(&las::Points::Unpack), release_gil())
         .def("GetExtraBytesFieldUInt8", &las::Points::GetExtraBytesField<std::uint8_t>, py::arg("vlr"), py::arg("name"))
         .def("GetExtraBytesFieldInt8", &las::Points::GetExtraBytesField<std::int8_t>, py::arg("vlr"), py::arg("name"))
         .def("GetExtraBytesFieldUInt16", &las::Points::GetExtraBytesField<std::uint16_t>, py::arg("vlr"), py::arg("name"))
@@ -573,6 +800,18 @@ PYBIND11_MODULE(_core, m)
                      start += step;
                  }
              })
+        .def(
+            "as_numpy",
+            [](const las::Points &self, const std::vector<std::string> &dimensions)
+            {
+                las::PointArray array;
+                {
+                    py::gil_scoped_release release;
+                    array = las::PointArray::FromPoints(self, dimensions);
+                }
+                return PointArrayToNumpy(std::move(array));
+            },
+            py::arg("dims") = std::vector<std::string>())
         .def("__str__", &las::Points::ToString)
         .def("__repr__", &las::Points::ToString);
 
@@ -603,32 +842,160 @@ PYBIND11_MODULE(_core, m)
 
     py::implicitly_convertible<CopcConfig, las::LazConfig>();
 
+    py::class_<IOStats::PhaseSnapshot>(m, "IOStatsPhase")
+        .def_readonly("count", &IOStats::PhaseSnapshot::count)
+        .def_readonly("total_ns", &IOStats::PhaseSnapshot::total_ns)
+        .def_readonly("max_ns", &IOStats::PhaseSnapshot::max_ns)
+        .def_readonly("buckets", &IOStats::PhaseSnapshot::buckets)
+        .def_property_readonly("mean_ns", &IOStats::PhaseSnapshot::MeanNs)
+        .def("PercentileNs", &IOStats::PhaseSnapshot::PercentileNs, py::arg("quantile"));
+
+    py::class_<IOStats::Snapshot>(m, "IOStatsSnapshot")
+        .def_property_readonly("counters",
+                               [](const IOStats::Snapshot &snapshot)
+                               {
+                                   std::map<std::string, uint64_t> counters;
+                                   for (size_t i = 0; i < IOStats::COUNTER_COUNT; i++)
+                                       counters[IOStats::CounterName(static_cast<IOStats::Counter>(i))] =
+                                           snapshot.counters[i];
+                                   return counters;
+                               })
+        .def_property_readonly("phases",
+                               [](const IOStats::Snapshot &snapshot)
+                               {
+                                   std::map<std::string, IOStats::PhaseSnapshot> phases;
+                                   for (size_t i = 0; i < IOStats::PHASE_COUNT; i++)
+                                       phases[IOStats::PhaseName(static_cast<IOStats::Phase>(i))] = snapshot.phases[i];
+                                   return phases;
+                               })
+        .def("__str__", &IOStats::Snapshot::ToString)
+        .def("__repr__", &IOStats::Snapshot::ToString);
+
+    py::class_<IOStats, std::shared_ptr<IOStats>>(m, "IOStats")
+        .def(py::init<>())
+        .def("GetSnapshot", &IOStats::GetSnapshot)
+        .def("Reset", &IOStats::Reset);
+
+    py::enum_<TraceEvent::Type>(m, "TraceEventType")
+        .value("Begin", TraceEvent::Type::Begin)
+        .value("End", TraceEvent::Type::End);
+
+    py::class_<TraceEvent>(m, "TraceEvent")
+        .def_readonly("type", &TraceEvent::type)
+        .def_property_readonly("name", [](const TraceEvent &event) { return std::string(event.name); })
+        .def_readonly("key", &TraceEvent::key)
+        .def_readonly("bytes", &TraceEvent::bytes)
+        .def_property_readonly("thread_id",
+                               [](const TraceEvent &event) { return std::hash<std::thread::id>()(event.thread_id); })
+        // Seconds on the steady clock, only meaningful relative to other events
+        .def_property_readonly(
+            "time", [](const TraceEvent &event)
+            { return std::chrono::duration<double>(event.time.time_since_epoch()).count(); });
+
+    py::class_<Tracer, PyTracer, std::shared_ptr<Tracer>>(m, "Tracer")
+        .def(py::init<>())
+        .def("OnEvent", &Tracer::OnEvent, py::arg("event"));
+
+    py::class_<ChromeTraceExporter, Tracer, std::shared_ptr<ChromeTraceExporter>>(m, "ChromeTraceExporter")
+        .def(py::init<>())
+        .def_property_readonly("event_count", &ChromeTraceExporter::EventCount)
+        .def("Clear", &ChromeTraceExporter::Clear)
+        .def("Save", &ChromeTraceExporter::Save, py::arg("file_path"));
+
+    m.def("SetTracer", &SetPythonTracer, py::arg("tracer").none(true));
+    // A Python tracer must be released while the interpreter is alive, rather than with the globals of the library
+    py::module_::import("atexit").attr("register")(py::cpp_function([]() { SetTracer(nullptr); }));
+    m.def("GetTracer", &GetTracer);
+
     py::class_<FileReader>(m, "FileReader")
-        .def(py::init<std::string &>())
+        .def(py::init<const std::string &, const std::string &>(), py::arg("file_path"),
+             py::arg("hierarchy_cache_path") = "")
         .def("Close", &FileReader::Close)
         .def_property_readonly("path", &FileReader::FilePath)
-        .def("FindNode", &Reader::FindNode, py::arg("key"))
+        .def_property_readonly("hierarchy_cache_hit", &FileReader::HierarchyCacheHit)
+        .def("FindNode", &Reader::FindNode, py::arg("key"), release_gil())
         .def_property_readonly("copc_config", &Reader::CopcConfig)
-        .def("GetPointData", py::overload_cast<const Node &>(&Reader::GetPointData), py::arg("node"))
-        .def("GetPointData", py::overload_cast<const VoxelKey &>(&Reader::GetPointData), py::arg("key"))
-        .def("GetPoints", py::overload_cast<const Node &>(&Reader::GetPoints), py::arg("node"))
-        .def("GetPoints", py::overload_cast<const VoxelKey &>(&Reader::GetPoints), py::arg("key"))
+        .def_property_readonly("dimension_stats", &Reader::GetDimensionStats)
+        .def("GetPointData", py::overload_cast<const Node &>(&Reader::GetPointData), py::arg("node"), release_gil())
+        .def("GetPointData", py::overload_cast<const VoxelKey &>(&Reader::GetPointData), py::arg("key"), release_gil())
+        .def("GetPoints", py::overload_cast<const Node &>(&Reader::GetPoints), py::arg("node"), release_gil())
+        .def("GetPoints", py::overload_cast<const VoxelKey &>(&Reader::GetPoints), py::arg("key"), release_gil())
+        .def(
+            "GetPointsArray",
+            [](Reader &self, const Node &node, const std::vector<std::string> &dimensions)
+            {
+                las::PointArray array;
+                {
+                    py::gil_scoped_release release;
+                    array = self.GetPointsArray(node, dimensions);
+                }
+                return PointArrayToNumpy(std::move(array));
+            },
+            py::arg("node"), py::arg("dims") = std::vector<std::string>())
+        .def(
+            "GetPointsArray",
+            [](Reader &self, const VoxelKey &key, const std::vector<std::string> &dimensions)
+            {
+                las::PointArray array;
+                {
+                    py::gil_scoped_release release;
+                    array = self.GetPointsArray(key, dimensions);
+                }
+                return PointArrayToNumpy(std::move(array));
+            },
+            py::arg("key"), py::arg("dims") = std::vector<std::string>())
         .def("GetPointDataCompressed", py::overload_cast<const Node &>(&Reader::GetPointDataCompressed),
-             py::arg("node"))
+             py::arg("node"), release_gil())
         .def("GetPointDataCompressed", py::overload_cast<const VoxelKey &>(&Reader::GetPointDataCompressed),
-             py::arg("key"))
-        .def("GetAllChildrenOfPage", &Reader::GetAllChildrenOfPage, py::arg("key"))
-        .def("GetAllNodes", &Reader::GetAllNodes)
-        .def("GetPageList", &Reader::GetPageList)
-        .def("GetAllPoints", &Reader::GetAllPoints, py::arg("resolution") = 0)
-        .def("GetNodesWithinBox", &Reader::GetNodesWithinBox, py::arg("box"), py::arg("resolution") = 0)
-        .def("GetNodesIntersectBox", &Reader::GetNodesIntersectBox, py::arg("box"), py::arg("resolution") = 0)
-        .def("GetPointsWithinBox", &Reader::GetPointsWithinBox, py::arg("box"), py::arg("resolution") = 0)
-        .def("GetDepthAtResolution", &Reader::GetDepthAtResolution, py::arg("resolution"))
-        .def("GetMaxDepth", &Reader::GetMaxDepth)
-        .def("GetNodesAtResolution", &Reader::GetNodesAtResolution, py::arg("resolution"))
-        .def("GetNodesWithinResolution", &Reader::GetNodesWithinResolution, py::arg("resolution"))
-        .def("ValidateSpatialBounds", &Reader::ValidateSpatialBounds, py::arg("verbose") = false);
+             py::arg("key"), release_gil())
+        .def("GetAllChildrenOfPage", &Reader::GetAllChildrenOfPage, py::arg("key"), release_gil())
+        .def("GetAllNodes", &Reader::GetAllNodes, release_gil())
+        .def("GetPageList", &Reader::GetPageList, release_gil())
+        .def("Prefetch", &FileReader::Prefetch, py::arg("nodes"), release_gil())
+        .def("WaitForPrefetch", &Reader::WaitForPrefetch, release_gil())
+        .def_property_readonly("prefetched_bytes", &Reader::PrefetchedBytes)
+        .def_property_readonly("prefetches_used", &Reader::PrefetchesUsed)
+        .def_property("max_prefetch_bytes", &Reader::GetMaxPrefetchBytes, &Reader::SetMaxPrefetchBytes)
+        .def_property("stats", &Reader::Stats, &Reader::SetStats)
+        .def("GetAllPoints", &Reader::GetAllPoints, py::arg("resolution") = 0, release_gil())
+        .def("GetNodesWithinBox", &Reader::GetNodesWithinBox, py::arg("box"), py::arg("resolution") = 0, release_gil())
+        .def("GetNodesIntersectBox", &Reader::GetNodesIntersectBox, py::arg("box"), py::arg("resolution") = 0,
+             release_gil())
+        .def("GetPointsWithinBox", &Reader::GetPointsWithinBox, py::arg("box"), py::arg("resolution") = 0,
+             release_gil())
+        .def("GetDepthAtResolution", &Reader::GetDepthAtResolution, py::arg("resolution"), release_gil())
+        .def("GetMaxDepth", &Reader::GetMaxDepth, release_gil())
+        .def("GetNodesAtResolution", &Reader::GetNodesAtResolution, py::arg("resolution"), release_gil())
+        .def("GetNodesWithinResolution", &Reader::GetNodesWithinResolution, py::arg("resolution"), release_gil())
+        .def("ValidateSpatialBounds", &Reader::ValidateSpatialBounds, py::arg("verbose") = false, release_gil());
+
+    py::class_<CatalogFile>(m, "CatalogFile")
+        .def(py::init<>())
+        .def_readwrite("path", &CatalogFile::path)
+        .def_readwrite("bounds", &CatalogFile::bounds)
+        .def_readwrite("cube", &CatalogFile::cube)
+        .def_readwrite("spacing", &CatalogFile::spacing)
+        .def_readwrite("point_count", &CatalogFile::point_count)
+        .def("__str__", &CatalogFile::ToString)
+        .def("__repr__", &CatalogFile::ToString);
+
+    py::class_<Catalog>(m, "Catalog")
+        .def(py::init<size_t, unsigned int>(), py::arg("max_open_readers") = 64, py::arg("num_threads") = 0)
+        .def("AddFiles", &Catalog::AddFiles, py::arg("paths"), release_gil())
+        .def("AddFile", &Catalog::AddFile, py::arg("path"), release_gil())
+        .def_property_readonly("files", &Catalog::Files)
+        .def("__len__", &Catalog::Size)
+        .def_property_readonly("open_readers", [](Catalog &catalog) { return catalog.Readers().Size(); })
+        .def("GetFilesIntersectBox", &Catalog::GetFilesIntersectBox, py::arg("box"))
+        .def("GetFilesWithinBox", &Catalog::GetFilesWithinBox, py::arg("box"))
+        .def("GetNodesIntersectBox", &Catalog::GetNodesIntersectBox, py::arg("box"), py::arg("resolution") = 0,
+             release_gil())
+        .def("GetNodesWithinBox", &Catalog::GetNodesWithinBox, py::arg("box"), py::arg("resolution") = 0, release_gil())
+        .def("GetNodesWithinResolution", &Catalog::GetNodesWithinResolution, py::arg("resolution"), release_gil())
+        .def("GetPointsWithinBox", &Catalog::GetPointsWithinBox, py::arg("box"), py::arg("resolution") = 0,
+             release_gil())
+        .def("Save", &Catalog::Save, py::arg("path"))
+        .def("Load", &Catalog::Load, py::arg("path"));
 
     py::class_<CopcConfigWriter, std::shared_ptr<CopcConfigWriter>>(m, "CopcConfigWriter")
         .def(
@@ -646,59 +1013,166 @@ PYBIND11_MODULE(_core, m)
 
     py::implicitly_convertible<CopcConfig, CopcConfigWriter>();
 
+    py::class_<PagingPolicy>(m, "PagingPolicy")
+        .def(py::init(
+                 [](size_t max_page_nodes, int32_t depth_step) {
+                     return PagingPolicy{max_page_nodes, depth_step};
+                 }),
+             py::arg("max_page_nodes") = 0, py::arg("depth_step") = 0)
+        .def_readwrite("max_page_nodes", &PagingPolicy::max_page_nodes)
+        .def_readwrite("depth_step", &PagingPolicy::depth_step);
+
+    py::class_<FileSinkOptions>(m, "FileSinkOptions")
+        .def(py::init([](size_t buffer_size, bool direct) { return FileSinkOptions{buffer_size, direct}; }),
+             py::arg("buffer_size") = 8 * 1024 * 1024, py::arg("direct") = false)
+        .def_readwrite("buffer_size", &FileSinkOptions::buffer_size)
+        .def_readwrite("direct", &FileSinkOptions::direct);
+
     py::class_<FileWriter>(m, "FileWriter")
         .def(
             py::init<const std::string &, const CopcConfigWriter &, const std::optional<uint8_t> &,
                      const std::optional<Vector3> &, const std::optional<Vector3> &, const std::optional<std::string> &,
-                     const std::optional<las::EbVlr> &, const std::optional<bool> &>(),
+                     const std::optional<las::EbVlr> &, const std::optional<bool> &, const FileSinkOptions &>(),
             py::arg("file_path"), py::arg("config"), py::arg("point_format_id") = py::none(),
             py::arg("scale") = py::none(), py::arg("offset") = py::none(), py::arg("wkt") = py::none(),
-            py::arg("extra_bytes_vlr") = py::none(), py::arg("has_extended_stats") = py::none())
+            py::arg("extra_bytes_vlr") = py::none(), py::arg("has_extended_stats") = py::none(),
+            py::arg("sink_options") = FileSinkOptions())
         .def_property_readonly("copc_config", &Writer::CopcConfig)
         .def_property_readonly("path", &FileWriter::FilePath)
         .def("FindNode", &Writer::FindNode)
-        .def("Close", &FileWriter::Close)
+        .def("Close", &FileWriter::Close, release_gil())
         .def("AddNode", py::overload_cast<const VoxelKey &, const las::Points &, const VoxelKey &>(&Writer::AddNode),
-             py::arg("key"), py::arg("points"), py::arg("page_key") = VoxelKey::RootKey())
+             py::arg("key"), py::arg("points"), py::arg("page_key") = VoxelKey::RootKey(), release_gil())
         .def("AddNodeCompressed", &Writer::AddNodeCompressed, py::arg("key"), py::arg("compressed_data"),
-             py::arg("point_count"), py::arg("page_key") = VoxelKey::RootKey())
+             py::arg("point_count"), py::arg("page_key") = VoxelKey::RootKey(), release_gil())
         .def("AddNode",
              py::overload_cast<const VoxelKey &, std::vector<char> const &, const VoxelKey &>(&Writer::AddNode),
-             py::arg("key"), py::arg("uncompressed_data"), py::arg("page_key") = VoxelKey::RootKey())
-        .def("ChangeNodePage", &Writer::ChangeNodePage, py::arg("node_key"), py::arg("new_page_key"));
+             py::arg("key"), py::arg("uncompressed_data"), py::arg("page_key") = VoxelKey::RootKey(), release_gil())
+        .def("AddEmptyNode", &Writer::AddEmptyNode, py::arg("key"), py::arg("page_key") = VoxelKey::RootKey())
+        .def("ChangeNodePage", &Writer::ChangeNodePage, py::arg("node_key"), py::arg("new_page_key"))
+        .def_property("paging_policy", &Writer::GetPagingPolicy, &Writer::SetPagingPolicy)
+        .def_property("point_order", &Writer::GetPointOrder, &Writer::SetPointOrder)
+        .def_property("accumulate_header_stats", &Writer::GetAccumulateHeaderStats,
+                      &Writer::SetAccumulateHeaderStats)
+        .def_property_readonly("header_stats", &Writer::GetHeaderStats)
+        .def("AddHeaderStats", &Writer::AddHeaderStats, py::arg("header_stats"))
+        .def_property("accumulate_dimension_stats", &Writer::GetAccumulateDimensionStats,
+                      &Writer::SetAccumulateDimensionStats)
+        .def_property_readonly("dimension_stats", &Writer::GetDimensionStats)
+        .def("AddDimensionStats", &Writer::AddDimensionStats, py::arg("dimension_stats"))
+        .def_property("stats", &Writer::Stats, &Writer::SetStats);
+
+    py::class_<SubsetResult>(m, "SubsetResult")
+        .def_readonly("nodes_copied", &SubsetResult::nodes_copied)
+        .def_readonly("nodes_filtered", &SubsetResult::nodes_filtered)
+        .def_readonly("nodes_empty", &SubsetResult::nodes_empty)
+        .def_readonly("point_count", &SubsetResult::point_count)
+        .def_readonly("min", &SubsetResult::min)
+        .def_readonly("max", &SubsetResult::max)
+        .def("__str__", &SubsetResult::ToString)
+        .def("__repr__", &SubsetResult::ToString);
+
+    m.def(
+        "ExtractSubset",
+        [](FileReader &reader, FileWriter &writer, const Box &box, double resolution, unsigned int num_threads)
+        { return ExtractSubset(reader, writer, box, resolution, num_threads); },
+        py::arg("reader"), py::arg("writer"), py::arg("box"), py::arg("resolution") = 0, py::arg("num_threads") = 0,
+        release_gil());
+
+    py::class_<MergeResult>(m, "MergeResult")
+        .def_readonly("nodes_copied", &MergeResult::nodes_copied)
+        .def_readonly("nodes_merged", &MergeResult::nodes_merged)
+        .def_readonly("nodes_empty", &MergeResult::nodes_empty)
+        .def_readonly("point_count", &MergeResult::point_count)
+        .def_readonly("points_dropped", &MergeResult::points_dropped)
+        .def("__str__", &MergeResult::ToString)
+        .def("__repr__", &MergeResult::ToString);
+
+    m.def(
+        "MergeCopc",
+        [](const std::vector<FileReader *> &readers, FileWriter &writer, bool subsample, size_t max_page_nodes,
+           unsigned int num_threads)
+        {
+            std::vector<Reader *> base_readers(readers.begin(), readers.end());
+            return MergeCopc(base_readers, writer, subsample, max_page_nodes, num_threads);
+        },
+        py::arg("readers"), py::arg("writer"), py::arg("subsample") = false, py::arg("max_page_nodes") = 4096,
+        py::arg("num_threads") = 0, release_gil());
+
+    py::enum_<RepackOrder>(m, "RepackOrder")
+        .value("BreadthFirst", RepackOrder::BreadthFirst)
+        .value("Hilbert", RepackOrder::Hilbert);
+
+    py::class_<RepackResult>(m, "RepackResult")
+        .def_readonly("node_count", &RepackResult::node_count)
+        .def_readonly("empty_node_count", &RepackResult::empty_node_count)
+        .def_readonly("point_count", &RepackResult::point_count)
+        .def_readonly("page_count", &RepackResult::page_count)
+        .def("__str__", &RepackResult::ToString)
+        .def("__repr__", &RepackResult::ToString);
+
+    m.def(
+        "RepackCopc",
+        [](FileReader &reader, FileWriter &writer, RepackOrder order, size_t max_page_nodes)
+        { return RepackCopc(reader, writer, order, max_page_nodes); },
+        py::arg("reader"), py::arg("writer"), py::arg("order") = RepackOrder::Hilbert,
+        py::arg("max_page_nodes") = 4096, release_gil());
 
     py::class_<laz::LazFileReader>(m, "LazReader")
         .def(py::init<const std::string &>(), py::arg("file_path"))
         .def_property_readonly("laz_config", &laz::LazReader::LazConfig)
         .def_property_readonly("path", &laz::LazFileReader::FilePath)
-        .def("GetPoints", py::overload_cast<>(&laz::LazReader::GetPoints));
+        .def_property("stats", &laz::LazReader::Stats, &laz::LazReader::SetStats)
+        .def("GetPoints", py::overload_cast<>(&laz::LazReader::GetPoints), release_gil());
 
     py::class_<laz::LazFileWriter>(m, "LazWriter")
-        .def(py::init<const std::string &, const las::LazConfigWriter &>(), py::arg("file_path"), py::arg("config"))
+        .def(py::init<const std::string &, const las::LazConfigWriter &, const FileSinkOptions &>(),
+             py::arg("file_path"), py::arg("config"), py::arg("sink_options") = FileSinkOptions())
         .def_property_readonly("laz_config", &laz::LazWriter::LazConfig)
         .def_property_readonly("point_count", &laz::LazWriter::PointCount)
         .def_property_readonly("chunk_count", &laz::LazWriter::ChunkCount)
         .def_property_readonly("path", &laz::LazFileWriter::FilePath)
-        .def("Close", &laz::LazFileWriter::Close)
-        .def("WritePoints", py::overload_cast<const las::Points &>(&laz::LazWriter::WritePoints), py::arg("points"))
+        .def_property("stats", &laz::LazWriter::Stats, &laz::LazWriter::SetStats)
+        .def_property("accumulate_header_stats", &laz::LazWriter::GetAccumulateHeaderStats,
+                      &laz::LazWriter::SetAccumulateHeaderStats)
+        .def_property_readonly("header_stats", &laz::LazWriter::GetHeaderStats)
+        .def("AddHeaderStats", &laz::LazWriter::AddHeaderStats, py::arg("header_stats"))
+        .def("Close", &laz::LazFileWriter::Close, release_gil())
+        .def("WritePoints", py::overload_cast<const las::Points &>(&laz::LazWriter::WritePoints), py::arg("points"),
+             release_gil())
         .def("WritePointsCompressed", &laz::LazWriter::WritePointsCompressed, py::arg("compressed_data"),
-             py::arg("point_count"));
+             py::arg("point_count"), release_gil());
+
+    py::class_<LazExportResult>(m, "LazExportResult")
+        .def_readonly("node_count", &LazExportResult::node_count)
+        .def_readonly("point_count", &LazExportResult::point_count)
+        .def("__str__", &LazExportResult::ToString)
+        .def("__repr__", &LazExportResult::ToString);
+
+    m.def(
+        "ExportToLaz",
+        [](FileReader &reader, laz::LazFileWriter &writer, const Box &box, double resolution)
+        { return ExportToLaz(reader, writer, box, resolution); },
+        py::arg("reader"), py::arg("writer"), py::arg("box") = Box::MaxBox(), py::arg("resolution") = 0,
+        release_gil());
 
     m.def(
         "CompressBytes",
         py::overload_cast<const std::vector<char> &, const int8_t &, const uint16_t &>(&laz::Compressor::CompressBytes),
-        py::arg("in"), py::arg("point_format_id"), py::arg("eb_byte_size"));
+        py::arg("in"), py::arg("point_format_id"), py::arg("eb_byte_size"), release_gil());
     m.def("CompressBytes",
-          py::overload_cast<std::vector<char> &, const las::LasHeader &>(&laz::Compressor::CompressBytes));
+          py::overload_cast<std::vector<char> &, const las::LasHeader &>(&laz::Compressor::CompressBytes),
+          release_gil());
 
     m.def("DecompressBytes",
           py::overload_cast<const std::vector<char> &, const las::LasHeader &, const int &>(
               &laz::Decompressor::DecompressBytes),
-          py::arg("compressed_data"), py::arg("header"), py::arg("point_count"));
+          py::arg("compressed_data"), py::arg("header"), py::arg("point_count"), release_gil());
     m.def("DecompressBytes",
           py::overload_cast<const std::vector<char> &, const int8_t &, const uint16_t &, const int &>(
               &laz::Decompressor::DecompressBytes),
-          py::arg("compressed_data"), py::arg("point_format_id"), py::arg("eb_byte_size"), py::arg("point_count"));
+          py::arg("compressed_data"), py::arg("point_format_id"), py::arg("eb_byte_size"), py::arg("point_count"),
+          release_gil());
 
     py::class_<las::LazConfigWriter, std::shared_ptr<las::LazConfigWriter>>(m, "LazConfigWriter")
         .def(py::init<const int8_t &, const Vector3 &, const Vector3 &, const std::string &, const las::EbVlr &>(),
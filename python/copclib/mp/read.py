@@ -1,9 +1,14 @@
-from .utils import chunks
+from .shared_memory import (
+    OutstandingBlocks,
+    check_transport,
+    free_results,
+    share_results,
+    unshare_results,
+)
+from .utils import make_executor, make_tasks, stream_tasks
 import copclib as copc
 import numpy as np
 
-import concurrent.futures
-
 # Initialize each multiprocessing thread with a copy of the copc reader
 def init_mp(copc_path):
     _read_node.copc_reader = copc.FileReader(copc_path)
@@ -19,6 +24,9 @@ def read_multithreaded(
     completed_callback=None,
     chunk_size=1024,
     max_workers=None,
+    backend="process",
+    transport="pickle",
+    group_points=0,
 ):
     """Scaffolding for reading COPC files in a multithreaded way to increase performance.
     It queues all nodes from either the provided list of nodes or nodes within the given resolution to be processed.
@@ -43,8 +51,19 @@ def read_multithreaded(
         progress (tqdm.tqdm, optional): A TQDM progress bar to track progress. Defaults to None.
         completed_callback (function, optional): A function which is called after a node is processed
             and returned from multiprocessing. Defaults to None.
-        chunk_size (int, optional): Limits the amount of nodes which are queued for multiprocessing at once. Defaults to 1024.
+        chunk_size (int, optional): Limits the amount of tasks which are queued for multiprocessing at once. Nodes are
+            submitted from the largest to the smallest, and a new task is submitted as soon as one completes.
+            Defaults to 1024.
         max_workers (int, optional): Manually set the number of processors to use when multiprocessing. Defaults to all processors.
+        backend (str, optional): "process" runs `read_function` in worker processes, each with its own reader, and
+            pickles the results back to the main process. "thread" runs it in worker threads that share `reader`, and
+            passes the results back without pickling. copclib releases the GIL while reading and decompressing, so the
+            thread backend scales when `read_function` mostly calls into copclib or NumPy. Defaults to "process".
+        transport (str, optional): How the process backend sends results back. "pickle" pickles them, while
+            "shared_memory" moves the large NumPy arrays of the results through shared memory, which is faster for
+            large nodes (requires Python 3.8+). Ignored by the thread backend. Defaults to "pickle".
+        group_points (int, optional): Nodes with fewer points than this are processed in groups of at least this many
+            points, which amortizes the cost of a task over several small nodes. Defaults to 0 (no grouping).
 
     Raises:
         RuntimeError
@@ -63,31 +82,41 @@ def read_multithreaded(
         if progress is not None:
             progress.reset(len(nodes))
 
-    # Initialize the multiprocessing
-    with concurrent.futures.ProcessPoolExecutor(
-        max_workers=max_workers,
-        initializer=init_mp,
-        initargs=(reader.path,),
+    # With threads, the workers share the reader, otherwise each process opens its own in init_mp
+    shared_reader = reader if backend == "thread" else None
+    use_shared_memory = check_transport(transport) and backend == "process"
+
+    # Initialize the multiprocessing. The executor is exited first, so that the results of the tasks still running
+    # when an error interrupts the loop are freed too.
+    with OutstandingBlocks() as outstanding, make_executor(
+        backend, max_workers, init_mp, (reader.path,)
     ) as executor:
-        # Chunk the nodes so we're not flooding executor.submit
-        for chunk in chunks(nodes, chunk_size):
-            futures = []
-            # Call _read_node, which calls the read_function
-            for node in chunk:
-                future = executor.submit(
-                    _read_node,
-                    read_function,
-                    read_function_args,
-                    node,
-                )
-                # Update the progress bar, if necessary
-                if progress is not None:
-                    future.add_done_callback(lambda _: progress.update())
-                futures.append(future)
 
+        def submit(task):
+            # Call _read_nodes, which calls the read_function on each node of the task
+            future = executor.submit(
+                _read_nodes,
+                read_function,
+                read_function_args,
+                task,
+                shared_reader,
+                use_shared_memory,
+            )
+            if use_shared_memory:
+                future.add_done_callback(outstanding.track)
+            # Update the progress bar, if necessary
+            if progress is not None:
+                future.add_done_callback(lambda _: progress.update(len(task)))
+            return future
+
+        # Stream the most expensive nodes first, with at most chunk_size tasks in flight
+        for fut in stream_tasks(submit, make_tasks(nodes, group_points), chunk_size):
             # As each node completes
-            for fut in concurrent.futures.as_completed(futures):
-                node, return_vals = fut.result()
+            for node, return_vals in fut.result():
+                if use_shared_memory:
+                    shared_vals = return_vals
+                    return_vals = unshare_results(shared_vals)
+                    outstanding.collected(shared_vals)
                 # Call competed_callback if provided
                 if completed_callback:
                     completed_callback(
@@ -96,11 +125,35 @@ def read_multithreaded(
                     )
 
 
-def _read_node(read_function, read_function_args, node):
+def _read_nodes(
+    read_function, read_function_args, nodes, reader=None, use_shared_memory=False
+):
     """Helper function which gets called by executor.submit in the multiprocessing.
+    Calls _read_node on each node of a task.
+    """
+    results = []
+    try:
+        for node in nodes:
+            results.append(
+                _read_node(
+                    read_function, read_function_args, node, reader, use_shared_memory
+                )
+            )
+    except BaseException:
+        # The results of the task are lost, so are the blocks of its nodes that were already shared
+        free_results(results)
+        raise
+    return results
+
+
+def _read_node(
+    read_function, read_function_args, node, reader=None, use_shared_memory=False
+):
+    """Helper function which gets called by _read_nodes in the multiprocessing.
     Calls read_function and returns the results.
     """
-    reader = _read_node.copc_reader
+    if reader is None:
+        reader = _read_node.copc_reader
     # Decompress and unpack the points within each thread
     points = reader.GetPoints(node)
 
@@ -117,6 +170,8 @@ def _read_node(read_function, read_function_args, node):
         ret, dict
     ), "The read_function return value should be a dictionary of kwargs!"
 
+    if use_shared_memory:
+        ret = share_results(ret)
     return node, ret
 
 
@@ -132,15 +187,14 @@ def _do_read_xyz(points, class_limits=None, **kwargs):
     Returns:
         dict(xyz=np.array): The numpy array of points, with "xyz" as their kwarg key
     """
-    xyzs = []
-    # Iterate over each point in the node and check if it's
-    # within the provided classificaiton limits
-    for point in points:
-        if not class_limits or point.classification in class_limits:
-            xyzs.append([point.x, point.y, point.z])
-
-    # Reshape to always be (Nx3), in case there's no points
-    return dict(xyz=np.array(xyzs).reshape(len(xyzs), 3))
+    arrays = points.as_numpy(["x", "y", "z", "classification"])
+    # Stack into (Nx3), which also holds when there's no points
+    xyz = np.stack([arrays["x"], arrays["y"], arrays["z"]], axis=1)
+    # Keep the points within the provided classification limits
+    if class_limits:
+        xyz = xyz[np.isin(arrays["classification"], class_limits)]
+
+    return dict(xyz=xyz)
 
 
 def read_concat_xyz_class_limit(
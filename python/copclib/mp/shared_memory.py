@@ -0,0 +1,208 @@
+"""Transport of NumPy arrays from worker processes through shared memory, instead of pickling them.
+
+A worker copies each large array of its results into a shared memory block and returns a small `SharedArray`
+descriptor in its place. The parent process copies the array out of the block and frees it. This costs one memory
+copy in each process, instead of pickling, sending the bytes through a pipe and unpickling them.
+The parent tracks the blocks of the results it hasn't collected yet with `OutstandingBlocks`, and frees them if it's
+interrupted, such as by a callback raising.
+Requires Python 3.8+.
+"""
+import threading
+
+try:
+    from multiprocessing import resource_tracker, shared_memory
+except ImportError:  # Python < 3.8
+    resource_tracker = shared_memory = None
+
+import numpy as np
+
+# Arrays smaller than this are pickled, since creating a shared memory block has a fixed cost
+DEFAULT_MIN_BYTES = 64 * 1024
+
+
+class SharedArray:
+    """Descriptor of a NumPy array that was placed in a shared memory block."""
+
+    __slots__ = ("name", "shape", "dtype")
+
+    def __init__(self, name, shape, dtype):
+        self.name = name
+        self.shape = shape
+        self.dtype = dtype
+
+    def __getstate__(self):
+        return (self.name, self.shape, self.dtype)
+
+    def __setstate__(self, state):
+        self.name, self.shape, self.dtype = state
+
+
+def check_transport(transport):
+    """Validates a `transport` argument of the mp functions.
+
+    Args:
+        transport (str): "pickle" or "shared_memory".
+
+    Raises:
+        RuntimeError
+
+    Returns:
+        bool: Whether results should go through shared memory.
+    """
+    if transport == "pickle":
+        return False
+    if transport == "shared_memory":
+        if shared_memory is None:
+            raise RuntimeError("The shared_memory transport requires Python 3.8+!")
+        return True
+    raise RuntimeError(
+        f"Unknown transport '{transport}', must be 'pickle' or 'shared_memory'!"
+    )
+
+
+def to_shared(array):
+    """Copies an array into a new shared memory block. Called in the worker process.
+
+    Args:
+        array (np.ndarray): The array to share.
+
+    Returns:
+        SharedArray: The descriptor of the block, to be passed to `from_shared` in the parent process.
+    """
+    array = np.ascontiguousarray(array)
+    # Zero-sized blocks aren't allowed. The block stays registered with the resource tracker, which the workers share
+    # with the parent, until the parent unlinks it, so the tracker still frees it when the parent exits otherwise.
+    block = shared_memory.SharedMemory(create=True, size=max(array.nbytes, 1))
+    try:
+        np.ndarray(array.shape, dtype=array.dtype, buffer=block.buf)[...] = array
+    except BaseException:
+        block.close()
+        block.unlink()
+        raise
+    # The parent process unlinks the block once it has copied the array out
+    block.close()
+    return SharedArray(block.name, array.shape, array.dtype.str)
+
+
+def from_shared(descriptor):
+    """Retrieves an array that a worker placed in shared memory, and frees the block. Called in the parent process.
+
+    Args:
+        descriptor (SharedArray): The descriptor returned by `to_shared`.
+
+    Returns:
+        np.ndarray: The array.
+    """
+    block = shared_memory.SharedMemory(name=descriptor.name)
+    try:
+        shared = np.ndarray(
+            descriptor.shape, dtype=np.dtype(descriptor.dtype), buffer=block.buf
+        )
+        array = shared.copy()
+        # Release the export of the block's buffer, so that it can be closed
+        del shared
+    finally:
+        block.close()
+        block.unlink()
+    return array
+
+
+def free_shared(descriptor):
+    """Frees the block of an array that won't be retrieved. Blocks that were already freed are ignored.
+
+    Args:
+        descriptor (SharedArray): The descriptor returned by `to_shared`.
+    """
+    try:
+        block = shared_memory.SharedMemory(name=descriptor.name)
+    except FileNotFoundError:
+        return
+    block.close()
+    block.unlink()
+
+
+def iter_descriptors(value):
+    """Yields the shared memory descriptors within results, searching dictionaries, lists and tuples."""
+    if isinstance(value, SharedArray):
+        yield value
+    elif isinstance(value, dict):
+        for item in value.values():
+            yield from iter_descriptors(item)
+    elif isinstance(value, (list, tuple)):
+        for item in value:
+            yield from iter_descriptors(item)
+
+
+def free_results(results):
+    """Frees the blocks of every descriptor within results that won't be retrieved."""
+    for descriptor in list(iter_descriptors(results)):
+        free_shared(descriptor)
+
+
+def share_results(return_vals, min_bytes=DEFAULT_MIN_BYTES):
+    """Replaces the arrays of at least `min_bytes` in a dictionary of results with shared memory descriptors."""
+    shared = {}
+    try:
+        for key, value in return_vals.items():
+            if isinstance(value, np.ndarray) and value.nbytes >= min_bytes:
+                value = to_shared(value)
+            shared[key] = value
+    except BaseException:
+        # Don't leave the blocks already created behind
+        free_results(shared)
+        raise
+    return shared
+
+
+def unshare_results(return_vals):
+    """Replaces the shared memory descriptors in a dictionary of results with the arrays they describe."""
+    return {
+        key: from_shared(value) if isinstance(value, SharedArray) else value
+        for key, value in return_vals.items()
+    }
+
+
+class OutstandingBlocks:
+    """Blocks of the results of tasks that the parent process hasn't collected yet.
+
+    Used as a context manager around the executor, so that it's exited once the running tasks are done: the blocks of
+    every result that wasn't collected, such as those of the tasks still running when a callback raised, are freed.
+    """
+
+    def __init__(self):
+        self._lock = threading.Lock()
+        self._names = {}
+
+    def __enter__(self):
+        # Start the resource tracker before the executor forks its workers, so that they share it with the parent:
+        # the blocks they register are then unregistered when the parent unlinks them
+        if resource_tracker is not None:
+            resource_tracker.ensure_running()
+        return self
+
+    def __exit__(self, *exc_info):
+        self.free()
+        return False
+
+    def track(self, future):
+        """Done callback of a task's future, which records the blocks of its results."""
+        if future.cancelled() or future.exception() is not None:
+            return
+        descriptors = list(iter_descriptors(future.result()))
+        with self._lock:
+            for descriptor in descriptors:
+                self._names[descriptor.name] = descriptor
+
+    def collected(self, results):
+        """Marks the blocks of results as collected, once their arrays were copied out."""
+        with self._lock:
+            for descriptor in iter_descriptors(results):
+                self._names.pop(descriptor.name, None)
+
+    def free(self):
+        """Frees the blocks that weren't collected."""
+        with self._lock:
+            descriptors = list(self._names.values())
+            self._names.clear()
+        for descriptor in descriptors:
+            free_shared(descriptor)
@@ -1,8 +1,14 @@
 from typing import Any, Callable, Dict, List, Optional, Union
-from .utils import chunks
+from .shared_memory import (
+    OutstandingBlocks,
+    check_transport,
+    free_results,
+    share_results,
+    unshare_results,
+)
+from .utils import make_executor, make_tasks, stream_tasks
 import copclib as copc
-
-import concurrent.futures
+import numpy as np
 
 
 def _copy_points_transform(points, **kwargs):
@@ -31,6 +37,9 @@ def transform_multithreaded(
     update_minmax: bool = False,
     mp_init_function: Optional[Callable] = None,
     mp_init_function_args: Dict[str, Any] = {},
+    backend: str = "process",
+    transport: str = "pickle",
+    group_points: int = 0,
 ):
     """Scaffolding for reading COPC files and writing them back out in a multithreaded way.
     It queues all nodes from either the provided list of nodes or nodes within the given resolution to be processed.
@@ -58,13 +67,25 @@ def transform_multithreaded(
         progress (tqdm.tqdm, optional): A TQDM progress bar to track progress. Defaults to None.
         completed_callback (function, optional): A function which is called after a node is processed
             and returned from multiprocessing. Defaults to None.
-        chunk_size (int, optional): Limits the amount of nodes which are queued for multiprocessing at once. Defaults to 1024.
+        chunk_size (int, optional): Limits the amount of tasks which are queued for multiprocessing at once. Nodes are
+            submitted from the largest to the smallest, and a new task is submitted as soon as one completes.
+            Defaults to 1024.
         max_workers (int, optional): Manually set the number of processors to use when multiprocessing. Defaults to all processors.
         update_minmax (bool, optional): If true, updates the header of the output file with the correct XYZ min/max.
             Defaults to False.
         mp_init_function: (function, optional): A function that gets called in the ProcessPoolExeuctor initializer
         mp_init_function_args: (dict, optional): A key/value pair of keyword arguments that get passed to `mp_init_function`.
             Defaults to {}.
+        backend (str, optional): "process" runs `transform_function` in worker processes, each with its own reader.
+            "thread" runs it in worker threads that share `reader`, and calls `mp_init_function` once in the calling
+            thread. copclib releases the GIL while decompressing and compressing, so the thread backend scales when
+            `transform_function` mostly calls into copclib or NumPy. Defaults to "process".
+        transport (str, optional): How the process backend sends results back. "pickle" pickles them, while
+            "shared_memory" moves the compressed points and the large NumPy arrays of the `transform_function` return
+            values through shared memory, which is faster for large nodes (requires Python 3.8+). Ignored by the thread
+            backend. Defaults to "pickle".
+        group_points (int, optional): Nodes with fewer points than this are processed in groups of at least this many
+            points, which amortizes the cost of a task over several small nodes. Defaults to 0 (no grouping).
 
     Raises:
         RuntimeError
@@ -97,40 +118,57 @@ def transform_multithreaded(
     # keep track of all the mins and maxs
     all_mins = []
     all_maxs = []
-    # Initialize the multiprocessing
-    with concurrent.futures.ProcessPoolExecutor(
-        max_workers=max_workers,
-        initializer=init_mp,
-        initargs=(reader.path, mp_init_function, mp_init_function_args),
+    # With threads, the workers share the reader, otherwise each process opens its own in init_mp
+    shared_reader = None
+    use_shared_memory = check_transport(transport) and backend == "process"
+    if backend == "thread":
+        shared_reader = reader
+        if mp_init_function:
+            mp_init_function(**mp_init_function_args)
+
+    # Initialize the multiprocessing. The executor is exited first, so that the results of the tasks still running
+    # when an error interrupts the loop are freed too.
+    with OutstandingBlocks() as outstanding, make_executor(
+        backend,
+        max_workers,
+        init_mp,
+        (reader.path, mp_init_function, mp_init_function_args),
     ) as executor:
-        # Chunk the nodes so we're not flooding executor.submit
-        for chunk in chunks(nodes, chunk_size):
-            futures = []
-            for node in chunk:
-                # Call _transform_node, which calls the transform_function
-                future = executor.submit(
-                    _transform_node,
-                    transform_function,
-                    transform_function_args,
-                    node,
-                    writer_header,
-                    update_minmax,
-                )
-                # Update the progress bar, if necessary
-                if progress is not None:
-                    future.add_done_callback(lambda _: progress.update())
-                futures.append(future)
 
+        def submit(task):
+            # Call _transform_nodes, which calls the transform_function on each node of the task
+            future = executor.submit(
+                _transform_nodes,
+                transform_function,
+                transform_function_args,
+                task,
+                writer_header,
+                update_minmax,
+                shared_reader,
+                use_shared_memory,
+            )
+            if use_shared_memory:
+                future.add_done_callback(outstanding.track)
+            # Update the progress bar, if necessary
+            if progress is not None:
+                future.add_done_callback(lambda _: progress.update(len(task)))
+            return future
+
+        # Stream the most expensive nodes first, with at most chunk_size tasks in flight
+        for fut in stream_tasks(submit, make_tasks(nodes, group_points), chunk_size):
             # As each node completes
-            for fut in concurrent.futures.as_completed(futures):
-                (
-                    compressed_points,
-                    node,
-                    point_count,
-                    xyz_min,
-                    xyz_max,
-                    return_vals,
-                ) = fut.result()
+            for (
+                compressed_points,
+                node,
+                point_count,
+                xyz_min,
+                xyz_max,
+                return_vals,
+            ) in fut.result():
+                if use_shared_memory:
+                    shared = (compressed_points, return_vals)
+                    compressed_points, return_vals = _unshare_node_results(*shared)
+                    outstanding.collected(shared)
                 # Call competed_callback if provided
                 if completed_callback:
                     completed_callback(
@@ -170,13 +208,53 @@ def transform_multithreaded(
         writer_header.max = list(global_max)
 
 
-def _transform_node(
-    transform_function, transform_function_args, node, writer_header, update_minmax
+def _transform_nodes(
+    transform_function,
+    transform_function_args,
+    nodes,
+    writer_header,
+    update_minmax,
+    reader=None,
+    use_shared_memory=False,
 ):
     """Helper function that gets called by executor.submit in the multiprocess.
+    Calls _transform_node on each node of a task.
+    """
+    results = []
+    try:
+        for node in nodes:
+            results.append(
+                _transform_node(
+                    transform_function,
+                    transform_function_args,
+                    node,
+                    writer_header,
+                    update_minmax,
+                    reader,
+                    use_shared_memory,
+                )
+            )
+    except BaseException:
+        # The results of the task are lost, so are the blocks of its nodes that were already shared
+        free_results(results)
+        raise
+    return results
+
+
+def _transform_node(
+    transform_function,
+    transform_function_args,
+    node,
+    writer_header,
+    update_minmax,
+    reader=None,
+    use_shared_memory=False,
+):
+    """Helper function that gets called by _transform_nodes in the multiprocess.
     Calls transform_function and keeps track of the min/max XYZ in case they need to be updated.
     """
-    reader = _transform_node.copc_reader
+    if reader is None:
+        reader = _transform_node.copc_reader
     # Decompress and unpack the points within each thread
     points = reader.GetPoints(node)
 
@@ -209,14 +287,44 @@ def _transform_node(
         points = ret
         return_vals = {}
 
-    # compute the minimum and maximum of the node's points, if necessary
+    point_count = len(points)
+    # Repack the points using the new writer header
+    point_data = points.Pack(writer_header)
+
+    # compute the minimum and maximum of the node's points from the packed records, if necessary
     xyz_min = None
     xyz_max = None
-    if update_minmax and len(points) > 0:
-        xyz_min = [min(points.x), min(points.y), min(points.z)]
-        xyz_max = [max(points.x), max(points.y), max(points.z)]
+    if update_minmax and point_count > 0:
+        header_stats = copc.HeaderStats()
+        header_stats.Add(point_data, writer_header)
+        node_min = header_stats.Min(writer_header)
+        node_max = header_stats.Max(writer_header)
+        xyz_min = [node_min.x, node_min.y, node_min.z]
+        xyz_max = [node_max.x, node_max.y, node_max.z]
 
-    point_count = len(points)
-    # Repack and compress the points using the new writer header
-    compressed_points = copc.CompressBytes(points.Pack(writer_header), writer_header)
+    # Compress the points
+    compressed_points = copc.CompressBytes(point_data, writer_header)
+    if use_shared_memory:
+        compressed_points, return_vals = _share_node_results(
+            compressed_points, return_vals
+        )
     return compressed_points, node, point_count, xyz_min, xyz_max, return_vals
+
+
+def _share_node_results(compressed_points, return_vals):
+    """Moves the compressed points and the return values of a node to shared memory, in the worker process."""
+    # The compressed points are shared as a byte array, which doesn't copy them
+    shared = share_results(
+        dict(compressed_points=np.frombuffer(compressed_points, dtype=np.uint8))
+    )
+    return shared["compressed_points"], share_results(return_vals)
+
+
+def _unshare_node_results(compressed_points, return_vals):
+    """Retrieves the compressed points and return values of a node from shared memory, in the parent process."""
+    unshared = unshare_results(dict(compressed_points=compressed_points))
+    compressed_points = unshared["compressed_points"]
+    # Nodes below the shared memory threshold weren't shared, and arrive as the NumPy array that was pickled
+    if not isinstance(compressed_points, copc.VectorChar):
+        compressed_points = copc.VectorChar(compressed_points)
+    return compressed_points, unshare_results(return_vals)
@@ -1,4 +1,95 @@
+import concurrent.futures
+import itertools
+
+
 def chunks(lst, n):
     """Yield successive n-sized chunks from lst."""
     for i in range(0, len(lst), n):
         yield lst[i : i + n]
+
+
+def make_executor(backend, max_workers, initializer, initargs):
+    """Creates the executor that runs the per-node tasks.
+
+    Args:
+        backend (str): "process" for a ProcessPoolExecutor, which calls `initializer(*initargs)` in each worker process,
+            or "thread" for a ThreadPoolExecutor, whose workers share the caller's objects and aren't initialized.
+        max_workers (int): The number of workers, or None for the executor's default.
+        initializer (function): The process initializer.
+        initargs (tuple): The arguments of `initializer`.
+
+    Raises:
+        RuntimeError
+
+    Returns:
+        concurrent.futures.Executor: The executor.
+    """
+    if backend == "process":
+        return concurrent.futures.ProcessPoolExecutor(
+            max_workers=max_workers,
+            initializer=initializer,
+            initargs=initargs,
+        )
+    if backend == "thread":
+        return concurrent.futures.ThreadPoolExecutor(max_workers=max_workers)
+    raise RuntimeError(f"Unknown backend '{backend}', must be 'process' or 'thread'!")
+
+
+def node_cost(node):
+    """The estimated cost of processing a node, which grows with its number of points and compressed size."""
+    return (node.point_count, node.byte_size)
+
+
+def make_tasks(nodes, group_points=0):
+    """Splits nodes into tasks, ordered from the most to the least expensive.
+
+    Args:
+        nodes (list[copc.Node]): The nodes to process.
+        group_points (int, optional): Nodes with fewer points than this are grouped into tasks of at least this many
+            points, to amortize the cost of submitting a task. Defaults to 0, which puts each node in its own task.
+
+    Returns:
+        list[list[copc.Node]]: The nodes of each task.
+    """
+    tasks = []
+    group = []
+    group_count = 0
+    for node in sorted(nodes, key=node_cost, reverse=True):
+        if node.point_count >= group_points:
+            tasks.append([node])
+            continue
+        group.append(node)
+        group_count += node.point_count
+        if group_count >= group_points:
+            tasks.append(group)
+            group = []
+            group_count = 0
+    if group:
+        tasks.append(group)
+    return tasks
+
+
+def stream_tasks(submit, tasks, max_in_flight):
+    """Submits tasks while keeping at most `max_in_flight` of them queued or running, and yields their futures as they
+    complete. A new task is submitted as soon as one completes, so a slow task never holds back the others.
+
+    Args:
+        submit (function): Submits a task to the executor and returns its future.
+        tasks (iterable): The tasks to submit, in submission order.
+        max_in_flight (int): The maximum number of tasks queued or running at once.
+
+    Yields:
+        concurrent.futures.Future: The future of each completed task.
+    """
+    tasks = iter(tasks)
+    in_flight = {
+        submit(task) for task in itertools.islice(tasks, max(max_in_flight, 1))
+    }
+    while in_flight:
+        done, in_flight = concurrent.futures.wait(
+            in_flight, return_when=concurrent.futures.FIRST_COMPLETED
+        )
+        # Refill before handing the results over, so the workers stay busy meanwhile
+        for task in itertools.islice(tasks, len(done)):
+            in_flight.add(submit(task))
+        yield from done
@@ -0,0 +1,107 @@
+#include <cstdint>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+#include <copc-lib/las/points.hpp>
+#include <copc-lib/utils/arena.hpp>
+
+using namespace copc;
+
+TEST_CASE("Arena", "[Arena]")
+{
+    SECTION("Allocations are aligned and come from one block")
+    {
+        Arena arena(1024);
+        auto *a = arena.Allocate<char>(3);
+        auto *b = arena.Allocate<double>(4);
+        auto *c = arena.Allocate<int16_t>(1);
+        REQUIRE(reinterpret_cast<uintptr_t>(b) % alignof(double) == 0);
+        REQUIRE(reinterpret_cast<uintptr_t>(c) % alignof(int16_t) == 0);
+        REQUIRE(reinterpret_cast<char *>(b) >= a + 3);
+        REQUIRE(reinterpret_cast<char *>(c) >= reinterpret_cast<char *>(b + 4));
+        REQUIRE(arena.BytesUsed() == 3 + 4 * sizeof(double) + sizeof(int16_t));
+        REQUIRE(arena.Capacity() == 1024);
+        REQUIRE(arena.BlockAllocations() == 1);
+
+        REQUIRE_THROWS(arena.Allocate(8, 3));
+        REQUIRE_THROWS(arena.Allocate(8, 2 * alignof(std::max_align_t)));
+    }
+
+    SECTION("Release merges the blocks for reuse")
+    {
+        Arena arena(1024);
+        arena.Allocate(1000);
+        arena.Allocate(1000);
+        arena.Allocate(5000);
+        REQUIRE(arena.BlockAllocations() == 3);
+        size_t capacity = arena.Capacity();
+        REQUIRE(capacity >= 7000);
+
+        arena.Release();
+        REQUIRE(arena.BytesUsed() == 0);
+        REQUIRE(arena.Capacity() == capacity);
+        REQUIRE(arena.BlockAllocations() == 4);
+
+        // The same allocations now fit in the merged block
+        arena.Allocate(1000);
+        arena.Allocate(1000);
+        arena.Allocate(5000);
+        arena.Release();
+        REQUIRE(arena.BlockAllocations() == 4);
+    }
+
+    SECTION("Release trims arenas beyond the retention cap")
+    {
+        Arena arena(1024, 16384);
+        arena.Allocate(4000);
+        arena.Allocate(4000);
+        size_t capacity = arena.Capacity();
+        REQUIRE(capacity <= 16384);
+        arena.Release();
+        REQUIRE(arena.Capacity() == capacity);
+
+        // A large node's memory isn't kept
+        arena.Allocate(100000);
+        REQUIRE(arena.Capacity() > 100000);
+        arena.Release();
+        REQUIRE(arena.BytesUsed() == 0);
+        REQUIRE(arena.Capacity() == 1024);
+        REQUIRE(arena.Allocate<char>(16) != nullptr);
+    }
+
+    SECTION("ArenaAllocator")
+    {
+        Arena arena;
+        std::vector<int, ArenaAllocator<int>> values{ArenaAllocator<int>(arena)};
+        for (int i = 0; i < 1000; i++)
+            values.push_back(i);
+        REQUIRE(values[999] == 999);
+        REQUIRE(arena.BytesUsed() >= 1000 * sizeof(int));
+        REQUIRE(arena.BlockAllocations() == 1);
+        REQUIRE(ArenaAllocator<int>(arena) == ArenaAllocator<double>(arena));
+    }
+
+    SECTION("Points unpacked into an arena")
+    {
+        las::LasHeader header(7, las::PointByteSize(7, 2), {0.01, 0.01, 0.01}, {0, 0, 0}, false);
+        las::Points points(header);
+        for (int i = 0; i < 100; i++)
+        {
+            auto point = points.CreatePoint();
+            point->X(i);
+            point->Rgb(i, i, i);
+            points.AddPoint(point);
+        }
+        auto point_data = points.Pack(header);
+
+        Arena arena;
+        {
+            auto unpacked = las::Points::Unpack(point_data.data(), point_data.size(), header, arena);
+            REQUIRE(unpacked.Size() == 100);
+            REQUIRE(unpacked.Pack(header) == point_data);
+            REQUIRE(arena.BytesUsed() >= 100 * sizeof(las::Point));
+        }
+        arena.Release();
+        REQUIRE_THROWS(las::Points::Unpack(point_data.data(), point_data.size() - 1, header, arena));
+    }
+}
@@ -0,0 +1,189 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+#include <copc-lib/catalog/catalog.hpp>
+#include <copc-lib/catalog/internal/rtree.hpp>
+#include <copc-lib/io/copc_writer.hpp>
+
+using namespace copc;
+using namespace std;
+
+namespace
+{
+// Writes a COPC file with a root node and one child node, spanning [x, x + 10] in X and Y
+string WriteTile(int x)
+{
+    string file_path = "catalog_test_" + to_string(x) + ".copc.laz";
+
+    CopcConfigWriter cfg(6, {0.01, 0.01, 0.01}, {0, 0, 0});
+    cfg.LasHeader()->min = Vector3(x, x, 0);
+    cfg.LasHeader()->max = Vector3(x + 10, x + 10, 10);
+    cfg.CopcInfo()->center_x = x + 5;
+    cfg.CopcInfo()->center_y = x + 5;
+    cfg.CopcInfo()->center_z = 5;
+    cfg.CopcInfo()->halfsize = 5;
+    cfg.CopcInfo()->spacing = 1;
+    FileWriter writer(file_path, cfg);
+
+    las::Points points(*writer.CopcConfig()->LasHeader());
+    for (int i = 0; i < 10; i++)
+    {
+        auto point = points.CreatePoint();
+        point->X(x + i + 0.5);
+        point->Y(x + i + 0.5);
+        point->Z(i + 0.5);
+        points.AddPoint(point);
+    }
+    writer.AddNode(VoxelKey::RootKey(), points);
+    writer.AddNode(VoxelKey(1, 0, 0, 0), points);
+    writer.Close();
+    return file_path;
+}
+} // namespace
+
+TEST_CASE("RTree", "[Catalog]")
+{
+    GIVEN("A grid of boxes")
+    {
+        vector<Box> boxes;
+        for (int x = 0; x < 40; x++)
+            for (int y = 0; y < 40; y++)
+                boxes.emplace_back(x, y, 0, x + 1, y + 1, 1);
+        Internal::RTree tree(boxes);
+        REQUIRE(tree.Size() == boxes.size());
+
+        for (const auto &query : {Box(5.5, 5.5, 0, 7.5, 8.5, 1), Box(-10, -10, 10, 10), Box(39.5, 39.5, 50, 50),
+                                  Box(100, 100, 200, 200), Box::MaxBox()})
+        {
+            vector<size_t> expected_intersects, expected_within;
+            for (size_t i = 0; i < boxes.size(); i++)
+            {
+                if (boxes[i].Intersects(query))
+                    expected_intersects.push_back(i);
+                if (boxes[i].Within(query))
+                    expected_within.push_back(i);
+            }
+            REQUIRE(tree.Intersects(query) == expected_intersects);
+            REQUIRE(tree.Within(query) == expected_within);
+        }
+    }
+
+    GIVEN("An empty tree")
+    {
+        Internal::RTree tree;
+        REQUIRE(tree.Intersects(Box::MaxBox()).empty());
+    }
+}
+
+TEST_CASE("Catalog", "[Catalog]")
+{
+    vector<string> paths;
+    for (int x = 0; x < 50; x += 10)
+        paths.push_back(WriteTile(x));
+
+    GIVEN("A catalog of files")
+    {
+        Catalog catalog(2, 4);
+        catalog.AddFiles(paths);
+        REQUIRE(catalog.Size() == paths.size());
+        REQUIRE(catalog.Readers().Size() <= 2);
+
+        // Adding a file twice is a no-op
+        catalog.AddFile(paths[0]);
+        REQUIRE(catalog.Size() == paths.size());
+
+        auto file = catalog.Files()[1];
+        REQUIRE(file.path == paths[1]);
+        REQUIRE(file.bounds.x_min == 10);
+        REQUIRE(file.bounds.x_max == 20);
+        REQUIRE(file.cube.x_min == 10);
+        REQUIRE(file.cube.z_max == 10);
+        REQUIRE(file.spacing == 1);
+        REQUIRE(file.point_count == 20);
+
+        SECTION("File queries")
+        {
+            auto files = catalog.GetFilesIntersectBox(Box(15, 15, 25, 25));
+            REQUIRE(files.size() == 2);
+            REQUIRE(files[0].path == paths[1]);
+            REQUIRE(files[1].path == paths[2]);
+
+            REQUIRE(catalog.GetFilesWithinBox(Box(5, 5, 35, 35)).size() == 2);
+            REQUIRE(catalog.GetFilesIntersectBox(Box(100, 100, 200, 200)).empty());
+        }
+
+        SECTION("Node queries")
+        {
+            auto nodes = catalog.GetNodesIntersectBox(Box(15, 15, 25, 25));
+            REQUIRE(nodes.size() == 2);
+            REQUIRE(nodes[paths[1]].size() == 2);
+            REQUIRE(nodes[paths[2]].size() == 2);
+
+            auto root_nodes = catalog.GetNodesIntersectBox(Box(15, 15, 25, 25), 2);
+            REQUIRE(root_nodes[paths[1]].size() == 1);
+
+            auto resolution_nodes = catalog.GetNodesWithinResolution(2);
+            REQUIRE(resolution_nodes.size() == paths.size());
+            for (const auto &path : paths)
+                REQUIRE(resolution_nodes[path].size() == 1);
+
+            // The pool never keeps more readers open than its cap
+            REQUIRE(catalog.Readers().Size() <= 2);
+        }
+
+        SECTION("Point queries")
+        {
+            auto points = catalog.GetPointsWithinBox(Box(0, 0, 0, 14, 14, 14));
+            REQUIRE(points.size() == 2);
+            REQUIRE(points.at(paths[0]).Size() == 20);
+            // 10.5 to 13.5 from both nodes
+            REQUIRE(points.at(paths[1]).Size() == 8);
+        }
+
+        SECTION("Save and Load")
+        {
+            string catalog_path = "catalog_test.catalog";
+            catalog.Save(catalog_path);
+
+            Catalog loaded_catalog;
+            loaded_catalog.Load(catalog_path);
+            REQUIRE(loaded_catalog.Size() == catalog.Size());
+            // Loading doesn't open the files
+            REQUIRE(loaded_catalog.Readers().Size() == 0);
+            for (size_t i = 0; i < catalog.Size(); i++)
+            {
+                REQUIRE(loaded_catalog.Files()[i].path == catalog.Files()[i].path);
+                REQUIRE(loaded_catalog.Files()[i].bounds.x_min == catalog.Files()[i].bounds.x_min);
+                REQUIRE(loaded_catalog.Files()[i].cube.z_max == catalog.Files()[i].cube.z_max);
+                REQUIRE(loaded_catalog.Files()[i].point_count == catalog.Files()[i].point_count);
+            }
+            REQUIRE(loaded_catalog.GetNodesIntersectBox(Box(15, 15, 25, 25)).size() == 2);
+
+            REQUIRE_THROWS(loaded_catalog.Load(paths[0]));
+            REQUIRE_THROWS(loaded_catalog.Load("invalid_path/non_existant.catalog"));
+        }
+
+        SECTION("Invalid files")
+        {
+            REQUIRE_THROWS(catalog.AddFile("invalid_path/non_existant_file.copc.laz"));
+            REQUIRE(catalog.Size() == paths.size());
+        }
+    }
+
+    GIVEN("A reader pool")
+    {
+        REQUIRE_THROWS(ReaderPool(0));
+
+        ReaderPool pool(2);
+        auto first = pool.Get(paths[0]);
+        REQUIRE(pool.Get(paths[0]) == first);
+        pool.Get(paths[1]);
+        pool.Get(paths[2]);
+        REQUIRE(pool.Size() == 2);
+        // The least recently used reader was evicted, but remains usable by its holder
+        REQUIRE(pool.Get(paths[0]) != first);
+        REQUIRE(first->CopcConfig().LasHeader().PointCount() == 20);
+    }
+}
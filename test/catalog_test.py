@@ -0,0 +1,62 @@
+import copclib as copc
+import pytest
+
+
+def write_tile(dir_path, x):
+    """Writes a COPC file with 10 points in a root node, spanning [x, x + 10] in X and Y."""
+    file_path = str(dir_path / ("tile_%d.copc.laz" % x))
+
+    cfg = copc.CopcConfigWriter(6, [0.01, 0.01, 0.01], [0, 0, 0])
+    cfg.las_header.min = copc.Vector3(x, x, 0)
+    cfg.las_header.max = copc.Vector3(x + 10, x + 10, 10)
+    cfg.copc_info.center_x = x + 5
+    cfg.copc_info.center_y = x + 5
+    cfg.copc_info.center_z = 5
+    cfg.copc_info.halfsize = 5
+    cfg.copc_info.spacing = 1
+
+    writer = copc.FileWriter(file_path, cfg)
+    points = copc.Points(writer.copc_config.las_header)
+    for i in range(10):
+        point = points.CreatePoint()
+        point.x = x + i + 0.5
+        point.y = x + i + 0.5
+        point.z = i + 0.5
+        points.AddPoint(point)
+    writer.AddNode(copc.VoxelKey.RootKey(), points)
+    writer.Close()
+    return file_path
+
+
+def test_catalog(tmp_path):
+    paths = [write_tile(tmp_path, x) for x in range(0, 50, 10)]
+
+    catalog = copc.Catalog(max_open_readers=2, num_threads=4)
+    catalog.AddFiles(paths)
+    assert len(catalog) == len(paths)
+    assert catalog.open_readers <= 2
+
+    files = catalog.GetFilesIntersectBox(copc.Box(15, 15, 25, 25))
+    assert [f.path for f in files] == paths[1:3]
+    assert files[0].bounds.x_min == 10
+    assert files[0].point_count == 10
+
+    nodes = catalog.GetNodesIntersectBox(copc.Box(15, 15, 25, 25))
+    assert sorted(nodes.keys()) == paths[1:3]
+    assert len(nodes[paths[1]]) == 1
+
+    points = catalog.GetPointsWithinBox(copc.Box(0, 0, 0, 14, 14, 14))
+    assert len(points[paths[0]]) == 10
+    assert len(points[paths[1]]) == 4
+
+    # Save and Load
+    catalog_path = str(tmp_path / "tiles.catalog")
+    catalog.Save(catalog_path)
+    loaded_catalog = copc.Catalog()
+    loaded_catalog.Load(catalog_path)
+    assert [f.path for f in loaded_catalog.files] == paths
+    assert loaded_catalog.open_readers == 0
+    assert len(loaded_catalog.GetNodesWithinResolution(1)) == len(paths)
+
+    with pytest.raises(RuntimeError):
+        catalog.AddFile(str(tmp_path / "non_existant_file.copc.laz"))
@@ -0,0 +1,224 @@
+#include <sstream>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+#include <copc-lib/io/copc_reader.hpp>
+#include <copc-lib/io/copc_writer.hpp>
+#include <copc-lib/las/dimension_stats.hpp>
+#include <copc-lib/laz/compressor.hpp>
+
+using namespace copc;
+using namespace copc::las;
+
+namespace
+{
+EbVlr MakeEbVlr()
+{
+    EbVlr eb_vlr;
+    // float
+    auto hag = lazperf::eb_vlr::ebfield();
+    hag.name = "hag";
+    hag.data_type = 9;
+    eb_vlr.addField(hag);
+    // uint8 with scale and no-data
+    auto confidence = lazperf::eb_vlr::ebfield();
+    confidence.name = "confidence";
+    confidence.data_type = 1;
+    confidence.options = 0x1 | 0x8;
+    confidence.scale[0] = 0.5;
+    confidence.no_data[0] = 255;
+    eb_vlr.addField(confidence);
+    // 2 undocumented bytes
+    auto raw = lazperf::eb_vlr::ebfield();
+    raw.name = "raw";
+    raw.options = 2;
+    eb_vlr.addField(raw);
+    return eb_vlr;
+}
+
+Points MakePoints(const LasHeader &header, const EbVlr &eb_vlr, int first, int count)
+{
+    Points points(header);
+    for (int i = first; i < first + count; i++)
+    {
+        auto point = points.CreatePoint();
+        point->X(i);
+        point->Y(-i);
+        point->Z(1);
+        point->Intensity(static_cast<uint16_t>(i * 10));
+        point->ReturnNumber(1);
+        point->NumberOfReturns(1);
+        point->Classification(i % 3 == 0 ? 2 : 6);
+        point->GPSTime(1000 + i);
+        point->SetExtraBytesField<float>(eb_vlr, "hag", i * 0.5f);
+        point->SetExtraBytesField<uint8_t>(eb_vlr, "confidence", i == 3 ? 255 : static_cast<uint8_t>(i));
+        points.AddPoint(point);
+    }
+    return points;
+}
+} // namespace
+
+TEST_CASE("DimensionStats", "[DimensionStats]")
+{
+    auto eb_vlr = MakeEbVlr();
+    auto eb_byte_size = static_cast<uint16_t>(NumBytesFromExtraBytes(eb_vlr.items));
+    LasHeader header(7, PointByteSize(7, eb_byte_size), {0.01, 0.01, 0.01}, {0, 0, 0}, false);
+
+    DimensionStats stats(header, eb_vlr);
+    stats.Add(MakePoints(header, eb_vlr, 0, 10).Pack(header));
+
+    SECTION("Dimensions")
+    {
+        REQUIRE(stats.PointCount() == 10);
+        REQUIRE(stats.HasDimension("red"));
+        REQUIRE_FALSE(stats.HasDimension("nir"));
+        REQUIRE(stats.HasDimension("hag"));
+        REQUIRE_FALSE(stats.HasDimension("raw"));
+        REQUIRE_THROWS(stats.GetDimension("raw"));
+
+        const auto &x = stats.GetDimension("x");
+        REQUIRE(x.count == 10);
+        REQUIRE(x.minimum == Catch::Approx(0));
+        REQUIRE(x.maximum == Catch::Approx(9));
+        REQUIRE(x.mean == Catch::Approx(4.5));
+        REQUIRE(x.variance == Catch::Approx(8.25));
+        REQUIRE(stats.GetDimension("y").mean == Catch::Approx(-4.5));
+        REQUIRE(stats.GetDimension("z").variance == Catch::Approx(0));
+        REQUIRE(stats.GetDimension("intensity").maximum == 90);
+        REQUIRE(stats.GetDimension("gps_time").minimum == 1000);
+        REQUIRE(stats.GetDimension("hag").maximum == 4.5);
+
+        // The no-data value is left out, and the scale is applied
+        const auto &confidence = stats.GetDimension("confidence");
+        REQUIRE(confidence.count == 9);
+        REQUIRE(confidence.maximum == 4.5);
+        REQUIRE(confidence.mean == Catch::Approx((45 - 3) * 0.5 / 9));
+
+        REQUIRE(stats.ClassificationHistogram()[2] == 4);
+        REQUIRE(stats.ClassificationHistogram()[6] == 6);
+    }
+
+    SECTION("Merge")
+    {
+        DimensionStats merged(header, eb_vlr);
+        DimensionStats other(header, eb_vlr);
+        merged.Add(MakePoints(header, eb_vlr, 0, 3).Pack(header));
+        other.Add(MakePoints(header, eb_vlr, 3, 7).Pack(header));
+        merged.Merge(other);
+
+        REQUIRE(merged.PointCount() == stats.PointCount());
+        for (const auto &dimension : stats.Dimensions())
+        {
+            const auto &merged_dimension = merged.GetDimension(dimension.name);
+            REQUIRE(merged_dimension.count == dimension.count);
+            REQUIRE(merged_dimension.minimum == dimension.minimum);
+            REQUIRE(merged_dimension.maximum == dimension.maximum);
+            REQUIRE(merged_dimension.mean == Catch::Approx(dimension.mean));
+            REQUIRE(merged_dimension.variance == Catch::Approx(dimension.variance).margin(1e-12));
+        }
+        REQUIRE(merged.ClassificationHistogram() == stats.ClassificationHistogram());
+
+        // Point format 6 has no colors
+        LasHeader other_header(6, PointByteSize(6, eb_byte_size), {0.01, 0.01, 0.01}, {0, 0, 0}, false);
+        REQUIRE_THROWS(merged.Merge(DimensionStats(other_header, eb_vlr)));
+    }
+
+    SECTION("Pack and Unpack")
+    {
+        auto unpacked = DimensionStats::Unpack(stats.Pack());
+        REQUIRE(unpacked.PointCount() == stats.PointCount());
+        REQUIRE(unpacked.Dimensions().size() == stats.Dimensions().size());
+        REQUIRE(unpacked.GetDimension("confidence").variance == stats.GetDimension("confidence").variance);
+        REQUIRE(unpacked.ClassificationHistogram() == stats.ClassificationHistogram());
+
+        // Unpacked statistics can be merged into, but not added to
+        unpacked.Merge(stats);
+        REQUIRE(unpacked.GetDimension("x").count == 20);
+        REQUIRE(unpacked.GetDimension("x").variance == Catch::Approx(8.25));
+        REQUIRE_THROWS(unpacked.Add(MakePoints(header, eb_vlr, 0, 1).Pack(header)));
+
+        auto data = stats.Pack();
+        data.resize(data.size() - 1);
+        REQUIRE_THROWS(DimensionStats::Unpack(data));
+    }
+
+    SECTION("Invalid data")
+    {
+        REQUIRE_THROWS(stats.Add(std::vector<char>(header.PointRecordLength() + 1)));
+        // The extra bytes don't match the point record length
+        REQUIRE_THROWS(DimensionStats(header));
+        REQUIRE_THROWS(DimensionStats().Add(std::vector<char>(header.PointRecordLength())));
+    }
+}
+
+TEST_CASE("Writer dimension stats", "[DimensionStats]")
+{
+    auto eb_vlr = MakeEbVlr();
+    CopcConfigWriter cfg(7, {0.01, 0.01, 0.01}, {0, 0, 0}, "TEST_WKT", eb_vlr);
+    cfg.LasHeader()->min = Vector3(-16, -16, -16);
+    cfg.LasHeader()->max = Vector3(16, 16, 16);
+
+    SECTION("Enabled")
+    {
+        std::stringstream out_stream;
+        DimensionStats expected;
+        {
+            Writer writer(out_stream, cfg);
+            writer.SetAccumulateDimensionStats(true);
+            REQUIRE(writer.GetAccumulateDimensionStats());
+            auto header = *writer.CopcConfig()->LasHeader();
+            expected = DimensionStats(header, eb_vlr);
+
+            auto points = MakePoints(header, eb_vlr, 0, 10);
+            expected.Add(points.Pack(header));
+            writer.AddNode(VoxelKey::RootKey(), points);
+
+            // Compressed nodes are summarized by the caller
+            auto point_data = MakePoints(header, eb_vlr, 10, 5).Pack(header);
+            DimensionStats compressed_stats(header, eb_vlr);
+            compressed_stats.Add(point_data);
+            expected.Add(point_data);
+            writer.AddNodeCompressed(VoxelKey(1, 1, 0, 1), laz::Compressor::CompressBytes(point_data, header), 5);
+            writer.AddDimensionStats(compressed_stats);
+
+            REQUIRE(writer.GetDimensionStats().PointCount() == 15);
+            writer.Close();
+        }
+
+        Reader reader(&out_stream);
+        auto stats = reader.GetDimensionStats();
+        REQUIRE(stats.has_value());
+        REQUIRE(stats->PointCount() == 15);
+        REQUIRE(stats->Dimensions().size() == expected.Dimensions().size());
+        for (const auto &dimension : expected.Dimensions())
+        {
+            const auto &read_dimension = stats->GetDimension(dimension.name);
+            REQUIRE(read_dimension.count == dimension.count);
+            REQUIRE(read_dimension.minimum == dimension.minimum);
+            REQUIRE(read_dimension.maximum == dimension.maximum);
+            REQUIRE(read_dimension.mean == Catch::Approx(dimension.mean));
+            REQUIRE(read_dimension.variance == Catch::Approx(dimension.variance).margin(1e-12));
+        }
+        REQUIRE(stats->ClassificationHistogram()[2] == 5);
+
+        // The other EVLRs are still found
+        REQUIRE(reader.GetAllNodes().size() == 2);
+        REQUIRE(reader.CopcConfig().Wkt() == "TEST_WKT");
+        REQUIRE(reader.GetPoints(VoxelKey(1, 1, 0, 1)).Size() == 5);
+    }
+
+    SECTION("Disabled")
+    {
+        std::stringstream out_stream;
+        {
+            Writer writer(out_stream, cfg);
+            auto header = *writer.CopcConfig()->LasHeader();
+            writer.AddNode(VoxelKey::RootKey(), MakePoints(header, eb_vlr, 0, 10));
+            REQUIRE_THROWS(writer.AddDimensionStats(DimensionStats(header, eb_vlr)));
+            writer.Close();
+        }
+
+        Reader reader(&out_stream);
+        REQUIRE_FALSE(reader.GetDimensionStats().has_value());
+    }
+}
@@ -0,0 +1,105 @@
+import copclib as copc
+import os
+import pytest
+
+from .utils import get_data_dir
+
+
+def _make_eb_vlr():
+    eb_vlr = copc.EbVlr(0)
+    hag = copc.EbField()
+    hag.name = "hag"
+    hag.data_type = 9
+    eb_vlr.add_field(hag)
+    # uint8 with scale and no-data
+    confidence = copc.EbField()
+    confidence.name = "confidence"
+    confidence.data_type = 1
+    confidence.options = 0x1 | 0x8
+    confidence.scale = 0.5
+    confidence.no_data = 255
+    eb_vlr.add_field(confidence)
+    return eb_vlr
+
+
+def _make_points(header, eb_vlr, first, count):
+    points = copc.Points(header)
+    for i in range(first, first + count):
+        point = points.CreatePoint()
+        point.x = i
+        point.y = -i
+        point.z = 1
+        point.classification = 2 if i % 3 == 0 else 6
+        point.gps_time = 1000 + i
+        point.SetExtraBytesFieldFloat32(eb_vlr, "hag", i * 0.5)
+        point.SetExtraBytesFieldUInt8(eb_vlr, "confidence", 255 if i == 3 else i)
+        points.AddPoint(point)
+    return points
+
+
+def test_dimension_stats():
+    eb_vlr = _make_eb_vlr()
+    cfg = copc.CopcConfigWriter(7, [0.01, 0.01, 0.01], [0, 0, 0], "", eb_vlr)
+    header = cfg.las_header
+
+    stats = copc.DimensionStats(header, eb_vlr)
+    stats.Add(_make_points(header, eb_vlr, 0, 3).Pack(header))
+    other = copc.DimensionStats(header, eb_vlr)
+    other.Add(_make_points(header, eb_vlr, 3, 7).Pack(header))
+    stats.Merge(other)
+
+    assert stats.point_count == 10
+    assert stats.HasDimension("red")
+    assert not stats.HasDimension("nir")
+    x = stats.GetDimension("x")
+    assert x.count == 10
+    assert x.minimum == pytest.approx(0)
+    assert x.maximum == pytest.approx(9)
+    assert x.mean == pytest.approx(4.5)
+    assert x.variance == pytest.approx(8.25)
+
+    # The no-data value is left out, and the scale is applied
+    confidence = stats.GetDimension("confidence")
+    assert confidence.count == 9
+    assert confidence.maximum == 4.5
+    assert stats.classification_histogram[2] == 4
+
+    with pytest.raises(RuntimeError):
+        stats.GetDimension("nir")
+
+
+def test_writer_dimension_stats():
+    file_path = os.path.join(get_data_dir(), "dimension_stats_test.copc.laz")
+
+    eb_vlr = _make_eb_vlr()
+    cfg = copc.CopcConfigWriter(7, [0.01, 0.01, 0.01], [0, 0, 0], "", eb_vlr)
+    cfg.las_header.min = copc.Vector3(-16, -16, -16)
+    cfg.las_header.max = copc.Vector3(16, 16, 16)
+    writer = copc.FileWriter(file_path, cfg)
+    assert writer.accumulate_dimension_stats is False
+    writer.accumulate_dimension_stats = True
+
+    header = writer.copc_config.las_header
+    writer.AddNode(copc.VoxelKey.RootKey(), _make_points(header, eb_vlr, 0, 10))
+
+    # Compressed nodes are summarized by the caller
+    point_data = _make_points(header, eb_vlr, 10, 5).Pack(header)
+    writer.AddNodeCompressed(copc.VoxelKey(1, 1, 0, 1), copc.CompressBytes(point_data, header), 5)
+    stats = copc.DimensionStats(header, eb_vlr)
+    stats.Add(point_data)
+    writer.AddDimensionStats(stats)
+    assert writer.dimension_stats.point_count == 15
+    writer.Close()
+
+    stats = copc.FileReader(file_path).dimension_stats
+    assert stats is not None
+    assert stats.point_count == 15
+    assert stats.GetDimension("gps_time").minimum == 1000
+    assert stats.GetDimension("gps_time").maximum == 1014
+    assert stats.GetDimension("hag").mean == pytest.approx(3.5)
+
+    # The statistics EVLR is only written when enabled
+    writer = copc.FileWriter(file_path, cfg)
+    writer.AddNode(copc.VoxelKey.RootKey(), _make_points(header, eb_vlr, 0, 10))
+    writer.Close()
+    assert copc.FileReader(file_path).dimension_stats is None
@@ -0,0 +1,158 @@
+#include <cmath>
+#include <cstring>
+
+#include <catch2/catch_all.hpp>
+#include <copc-lib/las/extra_bytes_schema.hpp>
+#include <copc-lib/las/points.hpp>
+
+using namespace copc;
+using namespace copc::las;
+
+namespace
+{
+EbVlr::ebfield MakeField(const std::string &name, uint8_t data_type, uint8_t options = 0)
+{
+    auto field = lazperf::eb_vlr::ebfield();
+    field.name = name;
+    field.data_type = data_type;
+    field.options = options;
+    return field;
+}
+} // namespace
+
+TEST_CASE("ExtraBytesSchema", "[ExtraBytesSchema]")
+{
+    EbVlr eb_vlr;
+    // float, no scaling
+    eb_vlr.addField(MakeField("hag", 9));
+    // uint8 with scale, offset and no-data
+    auto confidence = MakeField("confidence", 1, 0x1 | 0x8 | 0x10);
+    confidence.scale[0] = 0.01;
+    confidence.offset[0] = -1;
+    confidence.no_data[0] = 255;
+    eb_vlr.addField(confidence);
+    // Deprecated 3 element int16 array, with scale
+    auto normal = MakeField("normal", 24, 0x8);
+    for (int e = 0; e < 3; e++)
+        normal.scale[e] = 0.001;
+    eb_vlr.addField(normal);
+    // 2 undocumented bytes
+    eb_vlr.addField(MakeField("raw", 0, 2));
+
+    int8_t point_format_id = 7;
+    auto eb_byte_size = static_cast<uint16_t>(NumBytesFromExtraBytes(eb_vlr.items));
+    REQUIRE(eb_byte_size == 4 + 1 + 6 + 2);
+    ExtraBytesSchema schema(eb_vlr, point_format_id);
+    REQUIRE(schema.PointRecordLength() == PointByteSize(point_format_id, eb_byte_size));
+
+    Vector3 scale(0.01, 0.01, 0.01);
+    Vector3 offset(0, 0, 0);
+    Points points(point_format_id, eb_byte_size);
+    for (int i = 0; i < 10; i++)
+    {
+        auto point = points.CreatePoint();
+        point->SetExtraBytesField<float>(eb_vlr, "hag", i * 0.5f);
+        point->SetExtraBytesField<uint8_t>(eb_vlr, "confidence", i == 3 ? 255 : i * 10);
+        for (int e = 0; e < 3; e++)
+            point->SetExtraBytesField<int16_t>(EbVlrItemToPosition(eb_vlr, "normal") + e * 2, eb_byte_size,
+                                               static_cast<int16_t>(i * 100 - e));
+        point->SetExtraBytesField<uint16_t>(eb_vlr, "raw", static_cast<uint16_t>(i));
+        points.AddPoint(point);
+    }
+    auto point_data = points.Pack(scale, offset);
+
+    SECTION("Fields")
+    {
+        REQUIRE(schema.Fields().size() == 4);
+        REQUIRE(schema.HasField("hag"));
+        REQUIRE_FALSE(schema.HasField("intensity"));
+        REQUIRE_THROWS(schema.GetField("intensity"));
+
+        const auto &normal_field = schema.GetField("normal");
+        REQUIRE(normal_field.type == ExtraBytesSchema::FieldType::Int16);
+        REQUIRE(normal_field.count == 3);
+        REQUIRE(normal_field.record_offset == PointBaseByteSize(point_format_id) + 5);
+        REQUIRE(normal_field.has_scale);
+        REQUIRE_FALSE(normal_field.has_no_data);
+
+        const auto &raw_field = schema.GetField("raw");
+        REQUIRE(raw_field.type == ExtraBytesSchema::FieldType::UInt8);
+        REQUIRE(raw_field.count == 2);
+
+        LasHeader header(point_format_id, PointByteSize(point_format_id, eb_byte_size), scale, offset, false);
+        REQUIRE_NOTHROW(ExtraBytesSchema(eb_vlr, header));
+        LasHeader wrong_header(point_format_id, PointByteSize(point_format_id, 0), scale, offset, false);
+        REQUIRE_THROWS(ExtraBytesSchema(eb_vlr, wrong_header));
+    }
+
+    SECTION("Elements")
+    {
+        auto elements = schema.ResolveElements({"confidence", "normal"});
+        REQUIRE(elements.size() == 4);
+        REQUIRE(elements[0].record_offset == PointBaseByteSize(point_format_id) + 4);
+        REQUIRE(elements[0].scale == 0.01);
+        REQUIRE(elements[0].offset == -1);
+        REQUIRE(elements[0].has_no_data);
+        REQUIRE(elements[0].no_data == 255);
+        REQUIRE(elements[3].record_offset == PointBaseByteSize(point_format_id) + 5 + 2 * 2);
+        REQUIRE(elements[3].type == ExtraBytesSchema::FieldType::Int16);
+        REQUIRE(elements[3].scale == 0.001);
+        REQUIRE(elements[3].offset == 0);
+        REQUIRE_THROWS(schema.ResolveElements({"intensity"}));
+    }
+
+    SECTION("Extract")
+    {
+        auto hag = schema.Extract<float>(point_data, "hag");
+        auto normal_z = schema.Extract<int16_t>(point_data, "normal", 2);
+        REQUIRE(hag.size() == points.Size());
+        for (size_t i = 0; i < points.Size(); i++)
+        {
+            REQUIRE(hag[i] == points[i]->GetExtraBytesField<float>(eb_vlr, "hag"));
+            REQUIRE(normal_z[i] == static_cast<int16_t>(i * 100 - 2));
+        }
+
+        REQUIRE_THROWS(schema.Extract<double>(point_data, "hag"));
+        REQUIRE_THROWS(schema.Extract<int16_t>(point_data, "normal", 3));
+        REQUIRE_THROWS(schema.Extract<float>(std::vector<char>(point_data.begin(), point_data.end() - 1), "hag"));
+    }
+
+    SECTION("ExtractScaled")
+    {
+        auto columns = schema.ExtractScaled(point_data, {"confidence", "normal", "hag"});
+        REQUIRE(columns.size() == 5);
+        for (size_t i = 0; i < points.Size(); i++)
+        {
+            if (i == 3)
+                REQUIRE(std::isnan(columns[0][i]));
+            else
+                REQUIRE(columns[0][i] == ApplyScale(static_cast<int>(i * 10), 0.01, -1));
+            for (int e = 0; e < 3; e++)
+                REQUIRE(columns[1 + e][i] == ApplyScale(static_cast<int>(i * 100 - e), 0.001, 0));
+            REQUIRE(columns[4][i] == i * 0.5);
+        }
+        REQUIRE(schema.ExtractScaled(point_data, "hag") == columns[4]);
+        REQUIRE_THROWS(schema.ExtractScaled(point_data, "normal"));
+    }
+
+    SECTION("Inject")
+    {
+        auto columns = schema.ExtractScaled(point_data, {"confidence", "normal", "hag"});
+        std::vector<char> new_point_data(point_data.size());
+        // Fields that aren't injected are left untouched
+        schema.Inject(new_point_data, "raw", schema.Extract<uint8_t>(point_data, "raw", 0), 0);
+        schema.Inject(new_point_data, "raw", schema.Extract<uint8_t>(point_data, "raw", 1), 1);
+        schema.InjectScaled(new_point_data, {"confidence", "normal", "hag"}, columns);
+
+        auto unpacked = Points::Unpack(new_point_data, point_format_id, eb_byte_size, scale, offset);
+        for (size_t i = 0; i < points.Size(); i++)
+            REQUIRE(unpacked[i]->ExtraBytes() == points[i]->ExtraBytes());
+
+        // NaN needs a no-data value
+        columns[4][0] = std::nan("");
+        REQUIRE_THROWS(schema.InjectScaled(new_point_data, {"confidence", "normal", "hag"}, columns));
+        REQUIRE_THROWS(schema.InjectScaled(new_point_data, "hag", std::vector<double>(3)));
+        // Out of range for a uint8
+        REQUIRE_THROWS(schema.InjectScaled(new_point_data, "confidence", std::vector<double>(points.Size(), 10)));
+    }
+}
@@ -0,0 +1,58 @@
+import copclib as copc
+import numpy as np
+import pytest
+
+
+def _make_field(name, data_type, options=0):
+    field = copc.EbField()
+    field.name = name
+    field.data_type = data_type
+    field.options = options
+    return field
+
+
+def test_extra_bytes_schema():
+    eb_vlr = copc.EbVlr(0)
+    # float
+    eb_vlr.add_field(_make_field("hag", 9))
+    # uint16 with scale and no-data
+    confidence = _make_field("confidence", 3, 0x1 | 0x8)
+    confidence.scale = 0.01
+    confidence.no_data = 65535
+    eb_vlr.add_field(confidence)
+
+    point_format_id = 6
+    schema = copc.ExtraBytesSchema(eb_vlr, point_format_id)
+    assert schema.point_record_length == 30 + 4 + 2
+    assert schema.HasField("hag")
+    assert not schema.HasField("intensity")
+    field = schema.GetField("confidence")
+    assert field.type == copc.ExtraBytesFieldType.UInt16
+    assert field.count == 1
+    assert field.record_offset == 34
+    assert field.has_no_data and field.has_scale and not field.has_offset
+    assert [field.name for field in schema.fields] == ["hag", "confidence"]
+
+    points = copc.Points(point_format_id, 6)
+    for i in range(10):
+        point = points.CreatePoint()
+        point.SetExtraBytesFieldFloat32(eb_vlr, "hag", i * 0.5)
+        point.SetExtraBytesFieldUInt16(eb_vlr, "confidence", 65535 if i == 3 else i)
+        points.AddPoint(point)
+    point_data = points.Pack(copc.Vector3(1, 1, 1), copc.Vector3(0, 0, 0))
+
+    values = schema.ExtractScaled(point_data, ["hag", "confidence"])
+    np.testing.assert_array_equal(values["hag"], np.arange(10) * 0.5)
+    expected = np.arange(10) * 0.01
+    expected[3] = np.nan
+    np.testing.assert_allclose(values["confidence"], expected)
+
+    # Write the values back into empty point data
+    new_point_data = copc.VectorChar(bytes(len(point_data)))
+    schema.InjectScaled(new_point_data, values)
+    new_values = schema.ExtractScaled(new_point_data, ["hag", "confidence"])
+    np.testing.assert_array_equal(new_values["hag"], values["hag"])
+    np.testing.assert_array_equal(new_values["confidence"], values["confidence"])
+
+    with pytest.raises(RuntimeError):
+        schema.ExtractScaled(point_data, ["intensity"])
@@ -0,0 +1,172 @@
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+#include <copc-lib/io/copc_reader.hpp>
+#include <copc-lib/io/copc_writer.hpp>
+#include <copc-lib/io/laz_reader.hpp>
+#include <copc-lib/io/laz_writer.hpp>
+#include <copc-lib/las/header_stats.hpp>
+#include <copc-lib/laz/compressor.hpp>
+
+using namespace copc;
+
+namespace
+{
+las::Points MakePoints(const las::LasHeader &header, double x_min, double x_max, int count, double gps_time_min)
+{
+    las::Points points(header);
+    for (int i = 0; i < count; i++)
+    {
+        auto point = points.CreatePoint();
+        point->X(x_min + (x_max - x_min) * i / (count - 1));
+        point->Y(2 + i % 3);
+        point->Z(-1 - i % 5);
+        point->ReturnNumber(1 + i % 3);
+        point->NumberOfReturns(3);
+        point->GPSTime(gps_time_min + i);
+        points.AddPoint(point);
+    }
+    return points;
+}
+} // namespace
+
+TEST_CASE("HeaderStats", "[HeaderStats]")
+{
+    las::LasHeader header(6, las::PointBaseByteSize(6), {0.01, 0.01, 0.01}, {0, 0, 0}, false);
+
+    SECTION("Empty")
+    {
+        las::HeaderStats stats;
+        REQUIRE(stats.Empty());
+        stats.Add(std::vector<char>(), header);
+        REQUIRE(stats.PointCount() == 0);
+
+        header.min = Vector3(1, 2, 3);
+        stats.Apply(header);
+        REQUIRE(header.min == Vector3(1, 2, 3));
+    }
+
+    SECTION("Add and Merge")
+    {
+        las::HeaderStats stats;
+        stats.Add(MakePoints(header, 0, 10, 6, 100).Pack(header), header);
+
+        las::HeaderStats other;
+        other.Add(MakePoints(header, -5, 1, 4, 50).Pack(header), header);
+        stats.Merge(other);
+
+        REQUIRE(stats.PointCount() == 10);
+        REQUIRE(stats.MinInt()[0] == -500);
+        REQUIRE(stats.MaxInt()[0] == 1000);
+        REQUIRE(stats.Min(header) == Vector3(-5, 2, -5));
+        REQUIRE(stats.Max(header) == Vector3(10, 4, -1));
+        REQUIRE(stats.GpsTimeMin() == 50);
+        REQUIRE(stats.GpsTimeMax() == 105);
+        auto points_by_return = stats.PointsByReturn();
+        REQUIRE(points_by_return[0] == 4);
+        REQUIRE(points_by_return[1] == 3);
+        REQUIRE(points_by_return[2] == 3);
+        REQUIRE(points_by_return[3] == 0);
+
+        stats.Apply(header);
+        REQUIRE(header.min == Vector3(-5, 2, -5));
+        REQUIRE(header.max == Vector3(10, 4, -1));
+        REQUIRE(header.points_by_return == points_by_return);
+    }
+
+    SECTION("Invalid data")
+    {
+        las::HeaderStats stats;
+        REQUIRE_THROWS(stats.Add(std::vector<char>(header.PointRecordLength() + 1), header));
+        REQUIRE_THROWS(stats.Add(std::vector<char>(20).data(), 1, 20));
+    }
+}
+
+TEST_CASE("Writer header stats", "[HeaderStats]")
+{
+    SECTION("COPC Writer")
+    {
+        std::stringstream out_stream;
+        std::string node_box;
+        {
+            CopcConfigWriter cfg(6, {0.01, 0.01, 0.01}, {0, 0, 0}, "TEST_WKT");
+            cfg.LasHeader()->min = Vector3(-8, -8, -8);
+            cfg.LasHeader()->max = Vector3(8, 8, 8);
+            Writer writer(out_stream, cfg);
+            REQUIRE_FALSE(writer.GetAccumulateHeaderStats());
+            writer.SetAccumulateHeaderStats(true);
+            REQUIRE(writer.GetAccumulateHeaderStats());
+
+            auto header = *writer.CopcConfig()->LasHeader();
+            node_box = Box(VoxelKey(1, 0, 0, 0), header).ToString();
+            writer.AddNode(VoxelKey::RootKey(), MakePoints(header, 0, 6, 7, 10));
+            writer.AddNode(VoxelKey(1, 0, 0, 0), MakePoints(header, -4, -1, 4, 1000).Pack(header));
+
+            // Compressed nodes are only summarized by the caller
+            auto compressed_points = MakePoints(header, 1, 7, 3, 5);
+            auto compressed_data = laz::Compressor::CompressBytes(compressed_points.Pack(header), header);
+            writer.AddNodeCompressed(VoxelKey(1, 1, 0, 0), compressed_data, 3);
+            REQUIRE(writer.GetHeaderStats().PointCount() == 11);
+            las::HeaderStats compressed_stats;
+            compressed_stats.Add(compressed_points.Pack(header), header);
+            writer.AddHeaderStats(compressed_stats);
+            REQUIRE(writer.GetHeaderStats().PointCount() == 14);
+            REQUIRE(writer.GetHeaderStats().Min(header) == Vector3(-4, 2, -5));
+            REQUIRE(writer.GetHeaderStats().Max(header) == Vector3(7, 4, -1));
+            writer.Close();
+        }
+
+        Reader reader(&out_stream);
+        auto header = reader.CopcConfig().LasHeader();
+        // The bounds define the octree cube, so they are kept
+        REQUIRE(header.min == Vector3(-8, -8, -8));
+        REQUIRE(header.max == Vector3(8, 8, 8));
+        REQUIRE(Box(VoxelKey(1, 0, 0, 0), header).ToString() == node_box);
+        REQUIRE(header.points_by_return[0] == 6);
+        REQUIRE(header.points_by_return[1] == 4);
+        REQUIRE(header.points_by_return[2] == 4);
+        REQUIRE(reader.CopcConfig().CopcInfo().gpstime_minimum == 5);
+        REQUIRE(reader.CopcConfig().CopcInfo().gpstime_maximum == 1003);
+    }
+
+    SECTION("Disabled")
+    {
+        std::stringstream out_stream;
+        {
+            CopcConfigWriter cfg(6, {0.01, 0.01, 0.01}, {0, 0, 0}, "TEST_WKT");
+            cfg.LasHeader()->min = Vector3(-8, -8, -8);
+            cfg.LasHeader()->max = Vector3(8, 8, 8);
+            Writer writer(out_stream, cfg);
+            auto header = *writer.CopcConfig()->LasHeader();
+            writer.AddNode(VoxelKey::RootKey(), MakePoints(header, 0, 6, 7, 10));
+            REQUIRE(writer.GetHeaderStats().Empty());
+            writer.Close();
+        }
+
+        Reader reader(&out_stream);
+        REQUIRE(reader.CopcConfig().LasHeader().min == Vector3(-8, -8, -8));
+        REQUIRE(reader.CopcConfig().LasHeader().max == Vector3(8, 8, 8));
+    }
+
+    SECTION("LazWriter")
+    {
+        std::stringstream out_stream;
+        {
+            las::LazConfigWriter cfg(6, {0.01, 0.01, 0.01}, {0, 0, 0}, "TEST_WKT");
+            laz::LazWriter writer(out_stream, cfg);
+            writer.SetAccumulateHeaderStats(true);
+            auto header = writer.LazConfig()->LasHeader();
+            writer.WritePoints(MakePoints(*header, 0, 6, 7, 10));
+            writer.WritePoints(MakePoints(*header, -4, -1, 4, 1000));
+            writer.Close();
+        }
+
+        laz::LazReader reader(&out_stream);
+        auto header = reader.LazConfig().LasHeader();
+        REQUIRE(header.min == Vector3(-4, 2, -5));
+        REQUIRE(header.max == Vector3(6, 4, -1));
+        REQUIRE(header.points_by_return[0] == 5);
+    }
+}
@@ -0,0 +1,84 @@
+import copclib as copc
+import os
+
+from .utils import get_data_dir
+
+
+def _make_points(header, x_min, x_max, count, gps_time_min):
+    points = copc.Points(header)
+    for i in range(count):
+        point = points.CreatePoint()
+        point.x = x_min + (x_max - x_min) * i / (count - 1)
+        point.y = 2 + i % 3
+        point.z = -1 - i % 5
+        point.return_number = 1 + i % 3
+        point.number_of_returns = 3
+        point.gps_time = gps_time_min + i
+        points.AddPoint(point)
+    return points
+
+
+def test_header_stats():
+    header = copc.LazConfigWriter(6, [0.01, 0.01, 0.01], [0, 0, 0]).las_header
+
+    stats = copc.HeaderStats()
+    stats.Add(_make_points(header, 0, 10, 6, 100).Pack(header), header)
+    other = copc.HeaderStats()
+    other.Add(_make_points(header, -5, 1, 4, 50).Pack(header), header)
+    stats.Merge(other)
+
+    assert stats.point_count == 10
+    assert stats.Min(header) == copc.Vector3(-5, 2, -5)
+    assert stats.Max(header) == copc.Vector3(10, 4, -1)
+    assert stats.gps_time_min == 50
+    assert stats.gps_time_max == 105
+    assert list(stats.points_by_return[:4]) == [4, 3, 3, 0]
+
+    stats.Apply(header)
+    assert header.min == copc.Vector3(-5, 2, -5)
+    assert header.max == copc.Vector3(10, 4, -1)
+
+
+def test_writer_header_stats():
+    file_path = os.path.join(get_data_dir(), "header_stats_test.copc.laz")
+
+    cfg = copc.CopcConfigWriter(6, [0.01, 0.01, 0.01], [0, 0, 0])
+    cfg.las_header.min = copc.Vector3(-8, -8, -8)
+    cfg.las_header.max = copc.Vector3(8, 8, 8)
+    writer = copc.FileWriter(file_path, cfg)
+    assert writer.accumulate_header_stats is False
+    writer.accumulate_header_stats = True
+
+    header = writer.copc_config.las_header
+    writer.AddNode(copc.VoxelKey.RootKey(), _make_points(header, 0, 6, 7, 10))
+
+    # Compressed nodes are summarized by the caller
+    points = _make_points(header, 1, 7, 3, 5)
+    writer.AddNodeCompressed(
+        copc.VoxelKey(1, 1, 0, 0),
+        copc.CompressBytes(points.Pack(header), header),
+        len(points),
+    )
+    stats = copc.HeaderStats()
+    stats.Add(points.Pack(header), header)
+    writer.AddHeaderStats(stats)
+    assert writer.header_stats.point_count == 10
+    writer.Close()
+
+    reader = copc.FileReader(file_path)
+    header = reader.copc_config.las_header
+    # The bounds define the octree cube, so they are kept
+    assert header.min == copc.Vector3(-8, -8, -8)
+    assert header.max == copc.Vector3(8, 8, 8)
+    assert reader.copc_config.copc_info.gpstime_minimum == 5
+    assert reader.copc_config.copc_info.gpstime_maximum == 16
+
+    laz_path = os.path.join(get_data_dir(), "header_stats_test.laz")
+    writer = copc.LazWriter(laz_path, copc.LazConfigWriter(reader.copc_config))
+    writer.accumulate_header_stats = True
+    writer.WritePoints(_make_points(writer.laz_config.las_header, -4, -1, 4, 1000))
+    writer.Close()
+
+    header = copc.LazReader(laz_path).laz_config.las_header
+    assert header.min == copc.Vector3(-4, 2, -4)
+    assert header.max == copc.Vector3(-1, 4, -1)
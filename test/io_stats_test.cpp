@@ -0,0 +1,190 @@
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+#include <copc-lib/io/copc_reader.hpp>
+#include <copc-lib/io/copc_writer.hpp>
+#include <copc-lib/io/io_stats.hpp>
+#include <copc-lib/io/laz_reader.hpp>
+#include <copc-lib/io/laz_writer.hpp>
+#include <copc-lib/laz/compressor.hpp>
+
+using namespace copc;
+
+TEST_CASE("IOStats", "[IOStats]")
+{
+    SECTION("Counters and histograms")
+    {
+        IOStats stats;
+        stats.Add(IOStats::Counter::Seeks);
+        stats.Add(IOStats::Counter::BytesRead, 100);
+        stats.Add(IOStats::Counter::BytesRead, 50);
+        // Buckets 0, 3, 3 and 10
+        stats.Record(IOStats::Phase::Decompress, 0);
+        stats.Record(IOStats::Phase::Decompress, 8);
+        stats.Record(IOStats::Phase::Decompress, 15);
+        stats.Record(IOStats::Phase::Decompress, 1500);
+
+        auto snapshot = stats.GetSnapshot();
+        REQUIRE(snapshot.Get(IOStats::Counter::Seeks) == 1);
+        REQUIRE(snapshot.Get(IOStats::Counter::BytesRead) == 150);
+        REQUIRE(snapshot.Get(IOStats::Counter::PagesLoaded) == 0);
+
+        const auto &phase = snapshot.Get(IOStats::Phase::Decompress);
+        REQUIRE(phase.count == 4);
+        REQUIRE(phase.total_ns == 1523);
+        REQUIRE(phase.max_ns == 1500);
+        REQUIRE(phase.buckets[0] == 1);
+        REQUIRE(phase.buckets[3] == 2);
+        REQUIRE(phase.buckets[10] == 1);
+        REQUIRE(phase.MeanNs() == 1523.0 / 4);
+        REQUIRE(phase.PercentileNs(0) == 1);
+        REQUIRE(phase.PercentileNs(0.5) == 15);
+        REQUIRE(phase.PercentileNs(1) == 1500);
+        REQUIRE_THROWS(phase.PercentileNs(2));
+        REQUIRE(snapshot.Get(IOStats::Phase::Unpack).count == 0);
+        REQUIRE(snapshot.Get(IOStats::Phase::Unpack).PercentileNs(0.5) == 0);
+
+        REQUIRE(snapshot.ToString().find("bytes_read: 150") != std::string::npos);
+        REQUIRE(snapshot.ToString().find("decompress: count 4") != std::string::npos);
+
+        stats.Reset();
+        snapshot = stats.GetSnapshot();
+        REQUIRE(snapshot.Get(IOStats::Counter::BytesRead) == 0);
+        REQUIRE(snapshot.Get(IOStats::Phase::Decompress).count == 0);
+        REQUIRE(snapshot.Get(IOStats::Phase::Decompress).buckets[3] == 0);
+    }
+
+    SECTION("Timer")
+    {
+        IOStats stats;
+        {
+            IOStats::Timer timer(&stats, IOStats::Phase::Write);
+        }
+        {
+            // A null stats object is a no-op
+            IOStats::Timer timer(nullptr, IOStats::Phase::Write);
+        }
+        REQUIRE(stats.GetSnapshot().Get(IOStats::Phase::Write).count == 1);
+    }
+
+    SECTION("Concurrent updates")
+    {
+        IOStats stats;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; t++)
+        {
+            threads.emplace_back(
+                [&stats, t]
+                {
+                    for (int i = 0; i < 1000; i++)
+                    {
+                        stats.Add(IOStats::Counter::NodesRead);
+                        stats.Record(IOStats::Phase::Unpack, t * 1000 + i);
+                    }
+                });
+        }
+        for (auto &thread : threads)
+            thread.join();
+
+        auto snapshot = stats.GetSnapshot();
+        REQUIRE(snapshot.Get(IOStats::Counter::NodesRead) == 4000);
+        REQUIRE(snapshot.Get(IOStats::Phase::Unpack).count == 4000);
+        REQUIRE(snapshot.Get(IOStats::Phase::Unpack).max_ns == 3999);
+    }
+}
+
+TEST_CASE("IOStats of readers and writers", "[IOStats]")
+{
+    las::Points points(6);
+    for (int i = 0; i < 20; i++)
+    {
+        auto point = points.CreatePoint();
+        point->X(i);
+        points.AddPoint(point);
+    }
+
+    GIVEN("A COPC file")
+    {
+        std::stringstream stream;
+        auto write_stats = std::make_shared<IOStats>();
+        {
+            Writer writer(stream, CopcConfigWriter(6));
+            REQUIRE(writer.Stats() == nullptr);
+            writer.SetStats(write_stats);
+            REQUIRE(writer.Stats() == write_stats);
+
+            auto header = *writer.CopcConfig()->LasHeader();
+            auto point_data = points.Pack(header);
+            writer.AddNode(VoxelKey::RootKey(), points);
+            writer.AddNode(VoxelKey(1, 0, 0, 0), points, VoxelKey(1, 0, 0, 0));
+            writer.AddNodeCompressed(VoxelKey(1, 1, 0, 0), laz::Compressor::CompressBytes(point_data, header), 20);
+            writer.Close();
+        }
+        auto snapshot = write_stats->GetSnapshot();
+        REQUIRE(snapshot.Get(IOStats::Counter::NodesWritten) == 3);
+        REQUIRE(snapshot.Get(IOStats::Counter::PointsWritten) == 60);
+        REQUIRE(snapshot.Get(IOStats::Counter::BytesWritten) > 0);
+        REQUIRE(snapshot.Get(IOStats::Phase::Pack).count == 2);
+        REQUIRE(snapshot.Get(IOStats::Phase::Compress).count == 2);
+        // Every chunk is written out, compressed by the writer or not
+        REQUIRE(snapshot.Get(IOStats::Phase::Write).count == 3);
+
+        Reader reader(&stream);
+        REQUIRE(reader.Stats() == nullptr);
+        auto read_stats = std::make_shared<IOStats>();
+        reader.SetStats(read_stats);
+
+        auto nodes = reader.GetAllNodes();
+        REQUIRE(nodes.size() == 3);
+        for (const auto &node : nodes)
+            REQUIRE(reader.GetPoints(node).Size() == 20);
+        reader.GetPointsArray(nodes[0]);
+        reader.GetNodesIntersectBox(Box::MaxBox());
+
+        snapshot = read_stats->GetSnapshot();
+        REQUIRE(snapshot.Get(IOStats::Counter::PagesLoaded) == 2);
+        REQUIRE(snapshot.Get(IOStats::Counter::NodesRead) == 4);
+        REQUIRE(snapshot.Get(IOStats::Counter::PointsRead) == 80);
+        REQUIRE(snapshot.Get(IOStats::Counter::Seeks) >= 4);
+        REQUIRE(snapshot.Get(IOStats::Counter::BytesRead) > 0);
+        REQUIRE(snapshot.Get(IOStats::Counter::Queries) == 1);
+        REQUIRE(snapshot.Get(IOStats::Counter::QueryNodes) == 3);
+        REQUIRE(snapshot.Get(IOStats::Phase::PageRead).count == 2);
+        REQUIRE(snapshot.Get(IOStats::Phase::NodeRead).count == 4);
+        REQUIRE(snapshot.Get(IOStats::Phase::Decompress).count == 4);
+        REQUIRE(snapshot.Get(IOStats::Phase::Unpack).count == 4);
+        REQUIRE(snapshot.Get(IOStats::Phase::Compress).count == 0);
+    }
+
+    GIVEN("A LAZ file")
+    {
+        std::stringstream stream;
+        auto stats = std::make_shared<IOStats>();
+        {
+            laz::LazWriter writer(stream, las::LazConfigWriter(6));
+            writer.SetStats(stats);
+            writer.WritePoints(points);
+            writer.WritePoints(points);
+            writer.Close();
+        }
+        auto snapshot = stats->GetSnapshot();
+        REQUIRE(snapshot.Get(IOStats::Counter::NodesWritten) == 2);
+        REQUIRE(snapshot.Get(IOStats::Counter::PointsWritten) == 40);
+        REQUIRE(snapshot.Get(IOStats::Phase::Pack).count == 2);
+        REQUIRE(snapshot.Get(IOStats::Phase::Compress).count == 2);
+        REQUIRE(snapshot.Get(IOStats::Phase::Write).count == 2);
+
+        stats->Reset();
+        laz::LazReader reader(&stream);
+        reader.SetStats(stats);
+        REQUIRE(reader.GetPoints().Size() == 40);
+        snapshot = stats->GetSnapshot();
+        REQUIRE(snapshot.Get(IOStats::Counter::PointsRead) == 40);
+        REQUIRE(snapshot.Get(IOStats::Phase::Decompress).count == 1);
+        REQUIRE(snapshot.Get(IOStats::Phase::Unpack).count == 1);
+        REQUIRE(snapshot.Get(IOStats::Counter::NodesWritten) == 0);
+    }
+}
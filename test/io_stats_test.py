@@ -0,0 +1,77 @@
+import copclib as copc
+import os
+
+from .utils import get_data_dir
+
+
+def _write_points(points, count):
+    for i in range(count):
+        point = points.CreatePoint()
+        point.x = i
+        points.AddPoint(point)
+    return points
+
+
+def test_io_stats_copc():
+    file_path = os.path.join(get_data_dir(), "io_stats_test.copc.laz")
+
+    write_stats = copc.IOStats()
+    writer = copc.FileWriter(file_path, copc.CopcConfigWriter(6))
+    assert writer.stats is None
+    writer.stats = write_stats
+    points = _write_points(copc.Points(writer.copc_config.las_header), 20)
+    writer.AddNode(copc.VoxelKey.RootKey(), points)
+    writer.AddNode(copc.VoxelKey(1, 0, 0, 0), points)
+    writer.Close()
+
+    snapshot = write_stats.GetSnapshot()
+    assert snapshot.counters["nodes_written"] == 2
+    assert snapshot.counters["points_written"] == 40
+    assert snapshot.phases["pack"].count == 2
+    assert snapshot.phases["compress"].count == 2
+    # Compressed chunks are written out separately
+    assert snapshot.phases["write"].count == 2
+
+    read_stats = copc.IOStats()
+    reader = copc.FileReader(file_path)
+    reader.stats = read_stats
+    for node in reader.GetAllNodes():
+        assert len(reader.GetPoints(node)) == 20
+    reader.GetNodesIntersectBox(copc.Box.MaxBox())
+
+    snapshot = read_stats.GetSnapshot()
+    assert snapshot.counters["nodes_read"] == 2
+    assert snapshot.counters["points_read"] == 40
+    assert snapshot.counters["queries"] == 1
+    assert snapshot.counters["query_nodes"] == 2
+    decompress = snapshot.phases["decompress"]
+    assert decompress.count == 2
+    assert decompress.total_ns >= decompress.max_ns
+    assert sum(decompress.buckets) == 2
+    assert decompress.PercentileNs(0.5) <= decompress.max_ns
+    assert "nodes_read: 2" in str(snapshot)
+
+    read_stats.Reset()
+    assert read_stats.GetSnapshot().counters["nodes_read"] == 0
+    reader.stats = None
+    reader.GetPoints(copc.VoxelKey.RootKey())
+    assert read_stats.GetSnapshot().counters["nodes_read"] == 0
+
+
+def test_io_stats_laz():
+    file_path = os.path.join(get_data_dir(), "io_stats_test.laz")
+
+    stats = copc.IOStats()
+    writer = copc.LazWriter(file_path, copc.LazConfigWriter(6))
+    writer.stats = stats
+    writer.WritePoints(_write_points(copc.Points(writer.laz_config.las_header), 20))
+    writer.Close()
+    assert stats.GetSnapshot().counters["points_written"] == 20
+
+    stats.Reset()
+    reader = copc.LazReader(file_path)
+    reader.stats = stats
+    assert len(reader.GetPoints()) == 20
+    snapshot = stats.GetSnapshot()
+    assert snapshot.counters["points_read"] == 20
+    assert snapshot.phases["unpack"].count == 1
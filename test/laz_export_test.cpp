@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+#include <copc-lib/io/copc_reader.hpp>
+#include <copc-lib/io/copc_writer.hpp>
+#include <copc-lib/io/io_stats.hpp>
+#include <copc-lib/io/laz_export.hpp>
+#include <copc-lib/io/laz_reader.hpp>
+#include <copc-lib/io/laz_writer.hpp>
+
+using namespace copc;
+
+namespace
+{
+las::Points MakePoints(const las::LasHeader &header, double x_min, double x_max, int count)
+{
+    las::Points points(header);
+    for (int i = 0; i < count; i++)
+    {
+        auto point = points.CreatePoint();
+        point->X(x_min + (x_max - x_min) * (i + 0.5) / count);
+        point->Y(1);
+        point->Z(1);
+        point->ReturnNumber(1);
+        point->NumberOfReturns(1);
+        points.AddPoint(point);
+    }
+    return points;
+}
+
+std::vector<double> SortedX(const las::Points &points)
+{
+    std::vector<double> x = points.X();
+    std::sort(x.begin(), x.end());
+    return x;
+}
+} // namespace
+
+TEST_CASE("ExportToLaz", "[LazExport]")
+{
+    std::stringstream copc_stream;
+    {
+        CopcConfigWriter cfg(6, {0.01, 0.01, 0.01}, {0, 0, 0}, "TEST_WKT");
+        cfg.LasHeader()->min = Vector3(0, 0, 0);
+        cfg.LasHeader()->max = Vector3(16, 16, 16);
+        cfg.LasHeader()->points_by_return = {56};
+        Writer writer(copc_stream, cfg);
+        auto header = *writer.CopcConfig()->LasHeader();
+        writer.AddNode(VoxelKey::RootKey(), MakePoints(header, 0, 16, 16));
+        writer.AddNode(VoxelKey(1, 0, 0, 0), MakePoints(header, 0, 8, 20), VoxelKey(1, 0, 0, 0));
+        writer.AddNode(VoxelKey(1, 1, 0, 0), MakePoints(header, 8, 16, 20));
+        writer.Close();
+    }
+    Reader reader(&copc_stream);
+    auto stats = std::make_shared<IOStats>();
+    reader.SetStats(stats);
+
+    SECTION("Whole file")
+    {
+        std::stringstream laz_stream;
+        {
+            laz::LazWriter writer(laz_stream, las::LazConfigWriter(reader.CopcConfig()));
+            auto result = ExportToLaz(reader, writer);
+            REQUIRE(result.node_count == 3);
+            REQUIRE(result.point_count == 56);
+            REQUIRE(writer.ChunkCount() == 3);
+            writer.Close();
+        }
+        // Nodes are copied without decoding them
+        REQUIRE(stats->GetSnapshot().Get(IOStats::Phase::Decompress).count == 0);
+
+        laz::LazReader laz_reader(&laz_stream);
+        auto header = laz_reader.LazConfig().LasHeader();
+        REQUIRE(!header.IsCopc());
+        REQUIRE(header.PointCount() == 56);
+        REQUIRE(header.min == reader.CopcConfig().LasHeader().min);
+        REQUIRE(header.max == reader.CopcConfig().LasHeader().max);
+        REQUIRE(header.points_by_return[0] == 56);
+        REQUIRE(laz_reader.LazConfig().Wkt() == "TEST_WKT");
+        REQUIRE(SortedX(laz_reader.GetPoints()) == SortedX(reader.GetAllPoints()));
+    }
+
+    SECTION("Box")
+    {
+        std::stringstream laz_stream;
+        {
+            laz::LazWriter writer(laz_stream, las::LazConfigWriter(reader.CopcConfig()));
+            // Only crosses the root and (1, 0, 0, 0), which are written whole
+            auto result = ExportToLaz(reader, writer, Box(1, 1, 2, 2));
+            REQUIRE(result.node_count == 2);
+            REQUIRE(result.point_count == 36);
+            writer.Close();
+        }
+
+        laz::LazReader laz_reader(&laz_stream);
+        auto header = laz_reader.LazConfig().LasHeader();
+        REQUIRE(header.PointCount() == 36);
+        REQUIRE(header.min == Vector3(0, 0, 0));
+        REQUIRE(header.max == Vector3(16, 16, 16));
+        REQUIRE(header.points_by_return[0] == 0);
+        REQUIRE(laz_reader.GetPoints().Size() == 36);
+    }
+
+    SECTION("Box with header stats")
+    {
+        std::stringstream laz_stream;
+        {
+            laz::LazWriter writer(laz_stream, las::LazConfigWriter(reader.CopcConfig()));
+            writer.SetAccumulateHeaderStats(true);
+            auto result = ExportToLaz(reader, writer, Box(1, 1, 2, 2));
+            REQUIRE(result.point_count == 36);
+            writer.Close();
+        }
+
+        // The written nodes are decoded for the exact header
+        laz::LazReader laz_reader(&laz_stream);
+        auto header = laz_reader.LazConfig().LasHeader();
+        REQUIRE(header.PointCount() == 36);
+        REQUIRE(header.min.x == Catch::Approx(0.2));
+        REQUIRE(header.max.x == Catch::Approx(15.5));
+        REQUIRE(header.min.y == Catch::Approx(1));
+        REQUIRE(header.max.z == Catch::Approx(1));
+        REQUIRE(header.points_by_return[0] == 36);
+    }
+
+    SECTION("Resolution")
+    {
+        std::stringstream laz_stream;
+        laz::LazWriter writer(laz_stream, las::LazConfigWriter(reader.CopcConfig()));
+        auto resolution = VoxelKey::GetResolutionAtDepth(0, reader.CopcConfig().LasHeader(),
+                                                         reader.CopcConfig().CopcInfo());
+        auto result = ExportToLaz(reader, writer, Box::MaxBox(), resolution);
+        REQUIRE(result.node_count == 1);
+        REQUIRE(result.point_count == 16);
+        writer.Close();
+    }
+
+    SECTION("Incompatible writer")
+    {
+        std::stringstream laz_stream;
+        laz::LazWriter writer(laz_stream, las::LazConfigWriter(7));
+        REQUIRE_THROWS(ExportToLaz(reader, writer));
+    }
+}
@@ -0,0 +1,65 @@
+import copclib as copc
+import os
+
+import pytest
+
+from .utils import get_data_dir
+
+
+def _make_points(header, x_min, x_max, count):
+    points = copc.Points(header)
+    for i in range(count):
+        point = points.CreatePoint()
+        point.x = x_min + (x_max - x_min) * (i + 0.5) / count
+        point.y = 1
+        point.z = 1
+        point.return_number = 1
+        point.number_of_returns = 1
+        points.AddPoint(point)
+    return points
+
+
+def test_export_to_laz():
+    in_path = os.path.join(get_data_dir(), "laz_export_test_in.copc.laz")
+    out_path = os.path.join(get_data_dir(), "laz_export_test_out.laz")
+
+    cfg = copc.CopcConfigWriter(6, [0.01, 0.01, 0.01], [0, 0, 0])
+    cfg.las_header.min = copc.Vector3(0, 0, 0)
+    cfg.las_header.max = copc.Vector3(16, 16, 16)
+    writer = copc.FileWriter(in_path, cfg)
+    header = writer.copc_config.las_header
+    writer.AddNode(copc.VoxelKey.RootKey(), _make_points(header, 0, 16, 16))
+    writer.AddNode(copc.VoxelKey(1, 0, 0, 0), _make_points(header, 0, 8, 20))
+    writer.AddNode(copc.VoxelKey(1, 1, 0, 0), _make_points(header, 8, 16, 20))
+    writer.Close()
+
+    reader = copc.FileReader(in_path)
+    writer = copc.LazWriter(out_path, copc.LazConfigWriter(reader.copc_config))
+    result = copc.ExportToLaz(reader, writer, copc.Box(1, 1, 2, 2))
+    assert writer.chunk_count == 2
+    writer.Close()
+
+    assert result.node_count == 2
+    assert result.point_count == 36
+
+    laz_reader = copc.LazReader(out_path)
+    assert laz_reader.laz_config.las_header.point_count == 36
+    assert len(laz_reader.GetPoints()) == 36
+
+
+def test_export_to_laz_header_stats():
+    in_path = os.path.join(get_data_dir(), "laz_export_test_in.copc.laz")
+    out_path = os.path.join(get_data_dir(), "laz_export_test_stats_out.laz")
+    test_export_to_laz()
+
+    reader = copc.FileReader(in_path)
+    writer = copc.LazWriter(out_path, copc.LazConfigWriter(reader.copc_config))
+    writer.accumulate_header_stats = True
+    result = copc.ExportToLaz(reader, writer, copc.Box(1, 1, 2, 2))
+    writer.Close()
+    assert result.point_count == 36
+
+    header = copc.LazReader(out_path).laz_config.las_header
+    assert header.min.x == pytest.approx(0.2)
+    assert header.max.x == pytest.approx(15.5)
+    assert header.points_by_return[0] == 36
@@ -0,0 +1,231 @@
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+#include <copc-lib/hierarchy/internal/paging.hpp>
+#include <copc-lib/io/copc_merge.hpp>
+#include <copc-lib/io/copc_reader.hpp>
+#include <copc-lib/io/copc_subset.hpp>
+#include <copc-lib/io/copc_writer.hpp>
+
+using namespace copc;
+
+namespace
+{
+las::Points MakePoints(const las::LasHeader &header, double x_min, double x_max, int count)
+{
+    las::Points points(header);
+    for (int i = 0; i < count; i++)
+    {
+        auto point = points.CreatePoint();
+        point->X(x_min + (x_max - x_min) * (i + 0.5) / count);
+        point->Y(1);
+        point->Z(1);
+        point->ReturnNumber(1);
+        point->NumberOfReturns(1);
+        points.AddPoint(point);
+    }
+    return points;
+}
+
+// Writes a tile of the [0, 16] cube with a root node and a single child node on the given side of it
+void WriteTile(std::stringstream &stream, int side, double max_x, double gpstime)
+{
+    CopcConfigWriter cfg(6, {0.01, 0.01, 0.01}, {0, 0, 0});
+    cfg.LasHeader()->min = Vector3(0, 0, 0);
+    cfg.LasHeader()->max = Vector3(max_x, 16, 16);
+    cfg.LasHeader()->points_by_return = {30};
+    cfg.CopcInfo()->gpstime_minimum = gpstime;
+    cfg.CopcInfo()->gpstime_maximum = gpstime + 1;
+    Writer writer(stream, cfg);
+    auto header = *writer.CopcConfig()->LasHeader();
+    writer.AddNode(VoxelKey::RootKey(), MakePoints(header, side * 8, side * 8 + 8, 10));
+    writer.AddNode(VoxelKey(1, side, 0, 0), MakePoints(header, side * 8, side * 8 + 8, 20));
+    writer.Close();
+}
+} // namespace
+
+TEST_CASE("MergeCopc", "[Merge]")
+{
+    std::stringstream left_stream, right_stream;
+    WriteTile(left_stream, 0, 16, 10);
+    WriteTile(right_stream, 1, 15, 20);
+    Reader left(&left_stream);
+    Reader right(&right_stream);
+
+    SECTION("Subsample")
+    {
+        std::stringstream out_stream;
+        {
+            Writer writer(out_stream, left.CopcConfig());
+            auto result = MergeCopc({&left, &right}, writer, true, 4096, 2);
+            REQUIRE(result.nodes_copied == 2);
+            REQUIRE(result.nodes_merged == 1);
+            REQUIRE(result.point_count == 50);
+            REQUIRE(result.points_dropped == 10);
+            writer.Close();
+        }
+
+        Reader merged(&out_stream);
+        auto header = merged.CopcConfig().LasHeader();
+        REQUIRE(header.PointCount() == 50);
+        REQUIRE(header.min == Vector3(0, 0, 0));
+        REQUIRE(header.max == Vector3(16, 16, 16));
+        // The inputs' returns, less the dropped points
+        REQUIRE(header.points_by_return[0] == 50);
+        REQUIRE(merged.CopcConfig().CopcInfo().gpstime_minimum == 10);
+        REQUIRE(merged.CopcConfig().CopcInfo().gpstime_maximum == 21);
+
+        // The root keeps points of both inputs
+        auto root = merged.GetPoints(VoxelKey::RootKey());
+        REQUIRE(root.Size() == 10);
+        auto x = root.X();
+        REQUIRE(*std::min_element(x.begin(), x.end()) < 8);
+        REQUIRE(*std::max_element(x.begin(), x.end()) > 8);
+
+        // Nodes of a single input are copied as is
+        REQUIRE(merged.GetPointDataCompressed(VoxelKey(1, 0, 0, 0)) ==
+                left.GetPointDataCompressed(VoxelKey(1, 0, 0, 0)));
+        REQUIRE(merged.GetPointDataCompressed(VoxelKey(1, 1, 0, 0)) ==
+                right.GetPointDataCompressed(VoxelKey(1, 1, 0, 0)));
+    }
+
+    SECTION("No subsampling")
+    {
+        std::stringstream out_stream;
+        {
+            Writer writer(out_stream, left.CopcConfig());
+            auto result = MergeCopc({&left, &right}, writer);
+            REQUIRE(result.point_count == 60);
+            REQUIRE(result.points_dropped == 0);
+            writer.Close();
+        }
+
+        Reader merged(&out_stream);
+        REQUIRE(merged.CopcConfig().LasHeader().points_by_return[0] == 60);
+        REQUIRE(merged.GetPoints(VoxelKey::RootKey()).Size() == 20);
+        REQUIRE(merged.GetAllPoints().Size() == 60);
+    }
+
+    SECTION("Leaves keep their points")
+    {
+        std::stringstream out_stream;
+        {
+            Writer writer(out_stream, left.CopcConfig());
+            // Both nodes are merged, but only the root is subsampled
+            auto result = MergeCopc({&left, &left}, writer, true);
+            REQUIRE(result.nodes_merged == 2);
+            REQUIRE(result.point_count == 50);
+            REQUIRE(result.points_dropped == 10);
+            writer.Close();
+        }
+
+        Reader merged(&out_stream);
+        REQUIRE(merged.GetPoints(VoxelKey::RootKey()).Size() == 10);
+        REQUIRE(merged.GetPoints(VoxelKey(1, 0, 0, 0)).Size() == 40);
+        REQUIRE(merged.CopcConfig().LasHeader().points_by_return[0] == 50);
+    }
+
+    SECTION("Incompatible inputs")
+    {
+        std::stringstream other_stream;
+        {
+            CopcConfigWriter cfg(6, {0.01, 0.01, 0.01}, {0, 0, 0});
+            cfg.LasHeader()->min = Vector3(0, 0, 0);
+            cfg.LasHeader()->max = Vector3(32, 32, 32);
+            Writer writer(other_stream, cfg);
+            writer.AddNode(VoxelKey::RootKey(), MakePoints(*writer.CopcConfig()->LasHeader(), 0, 8, 10));
+            writer.Close();
+        }
+        Reader other(&other_stream);
+
+        std::stringstream out_stream;
+        Writer writer(out_stream, left.CopcConfig());
+        REQUIRE_THROWS(MergeCopc({&left, &other}, writer));
+        REQUIRE_THROWS(MergeCopc({}, writer));
+    }
+}
+
+TEST_CASE("MergeCopc of subsets", "[Merge]")
+{
+    // A root node, a depth 1 node on the right of x = 8 and a depth 2 node of its children near x = 8
+    std::stringstream in_stream;
+    {
+        CopcConfigWriter cfg(6, {0.01, 0.01, 0.01}, {0, 0, 0});
+        cfg.LasHeader()->min = Vector3(0, 0, 0);
+        cfg.LasHeader()->max = Vector3(16, 16, 16);
+        cfg.CopcInfo()->center_x = 8;
+        cfg.CopcInfo()->center_y = 8;
+        cfg.CopcInfo()->center_z = 8;
+        cfg.CopcInfo()->halfsize = 8;
+        cfg.CopcInfo()->spacing = 1;
+        Writer writer(in_stream, cfg);
+        auto header = *writer.CopcConfig()->LasHeader();
+        writer.AddNode(VoxelKey::RootKey(), MakePoints(header, 0, 16, 16));
+        writer.AddNode(VoxelKey(1, 1, 0, 0), MakePoints(header, 8.5, 16, 20));
+        writer.AddNode(VoxelKey(2, 2, 0, 0), MakePoints(header, 8, 8.2, 4));
+        writer.Close();
+    }
+    Reader reader(&in_stream);
+
+    // The first subset keeps (1, 1, 0, 0) as an empty parent of (2, 2, 0, 0), the second only has a root
+    std::stringstream near_stream, left_stream;
+    {
+        Writer writer(near_stream, reader.CopcConfig());
+        REQUIRE(ExtractSubset(reader, writer, Box(0, 0, 8.3, 16)).nodes_empty == 1);
+        writer.Close();
+    }
+    {
+        Writer writer(left_stream, reader.CopcConfig());
+        REQUIRE(ExtractSubset(reader, writer, Box(0, 0, 4, 16)).nodes_empty == 0);
+        writer.Close();
+    }
+    Reader near(&near_stream);
+    Reader left(&left_stream);
+
+    std::stringstream out_stream;
+    {
+        Writer writer(out_stream, reader.CopcConfig());
+        auto result = MergeCopc({&near, &left}, writer);
+        REQUIRE(result.nodes_merged == 1);
+        REQUIRE(result.nodes_copied == 1);
+        REQUIRE(result.nodes_empty == 1);
+        writer.Close();
+    }
+
+    Reader merged(&out_stream);
+    auto parent = merged.FindNode(VoxelKey(1, 1, 0, 0));
+    REQUIRE(parent.IsValid());
+    REQUIRE(parent.point_count == 0);
+    REQUIRE(merged.FindNode(VoxelKey(2, 2, 0, 0)).point_count == 4);
+    REQUIRE(merged.ValidateSpatialBounds());
+}
+
+TEST_CASE("AssignPages", "[Merge]")
+{
+    std::vector<VoxelKey> keys{VoxelKey::RootKey()};
+    for (const auto &child : VoxelKey::RootKey().GetChildren())
+    {
+        keys.push_back(child);
+        for (const auto &grandchild : child.GetChildren())
+            keys.push_back(grandchild);
+    }
+
+    SECTION("Single page")
+    {
+        for (const auto &entry : Internal::AssignPages(keys, 0))
+            REQUIRE(entry.second == VoxelKey::RootKey());
+        for (const auto &entry : Internal::AssignPages(keys, keys.size()))
+            REQUIRE(entry.second == VoxelKey::RootKey());
+    }
+
+    SECTION("Subtree pages")
+    {
+        auto pages = Internal::AssignPages(keys, 16);
+        REQUIRE(pages.size() == keys.size());
+        REQUIRE(pages[VoxelKey::RootKey()] == VoxelKey::RootKey());
+        REQUIRE(pages[VoxelKey(1, 1, 0, 0)] == VoxelKey(1, 1, 0, 0));
+        REQUIRE(pages[VoxelKey(2, 3, 1, 0)] == VoxelKey(1, 1, 0, 0));
+    }
+}
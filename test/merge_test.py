@@ -0,0 +1,54 @@
+import copclib as copc
+import os
+
+from .utils import get_data_dir
+
+
+def _write_tile(path, side):
+    cfg = copc.CopcConfigWriter(6, [0.01, 0.01, 0.01], [0, 0, 0])
+    cfg.las_header.min = copc.Vector3(0, 0, 0)
+    cfg.las_header.max = copc.Vector3(16, 16, 16)
+    writer = copc.FileWriter(path, cfg)
+    header = writer.copc_config.las_header
+    for key, count in [(copc.VoxelKey.RootKey(), 10), (copc.VoxelKey(1, side, 0, 0), 20)]:
+        points = copc.Points(header)
+        for i in range(count):
+            point = points.CreatePoint()
+            point.x = side * 8 + 8 * (i + 0.5) / count
+            point.y = 1
+            point.z = 1
+            points.AddPoint(point)
+        writer.AddNode(key, points)
+    writer.Close()
+
+
+def test_merge_copc():
+    left_path = os.path.join(get_data_dir(), "merge_test_left.copc.laz")
+    right_path = os.path.join(get_data_dir(), "merge_test_right.copc.laz")
+    out_path = os.path.join(get_data_dir(), "merge_test_out.copc.laz")
+    _write_tile(left_path, 0)
+    _write_tile(right_path, 1)
+
+    readers = [copc.FileReader(left_path), copc.FileReader(right_path)]
+    writer = copc.FileWriter(out_path, readers[0].copc_config)
+    result = copc.MergeCopc(readers, writer, num_threads=2)
+    writer.Close()
+
+    # No point is lost by default
+    assert result.nodes_copied == 2
+    assert result.nodes_merged == 1
+    assert result.point_count == 60
+    assert result.points_dropped == 0
+
+    merged = copc.FileReader(out_path)
+    assert merged.copc_config.las_header.point_count == 60
+    assert len(merged.GetPoints(copc.VoxelKey.RootKey())) == 20
+    key = copc.VoxelKey(1, 1, 0, 0)
+    assert merged.GetPointDataCompressed(key) == readers[1].GetPointDataCompressed(key)
+
+    writer = copc.FileWriter(out_path, readers[0].copc_config)
+    result = copc.MergeCopc(readers, writer, subsample=True)
+    writer.Close()
+    assert result.point_count == 50
+    assert result.points_dropped == 10
+    assert len(copc.FileReader(out_path).GetPoints(copc.VoxelKey.RootKey())) == 10
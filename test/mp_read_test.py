@@ -1,17 +1,27 @@
+import os
 import sys
 
 from .utils import generate_test_file
 
 import copclib as copc
-from copclib.mp.read import read_concat_xyz_class_limit, read_map_xyz_class_limit
+from copclib.mp.read import (
+    read_concat_xyz_class_limit,
+    read_map_xyz_class_limit,
+    read_multithreaded,
+)
+from copclib.mp.shared_memory import SharedArray, share_results, unshare_results
 import pytest
 import numpy as np
 
 
 @pytest.mark.skipif(sys.version_info < (3, 7), reason="requires python3.7")
-def test_xyz_noclass_limit():
+@pytest.mark.parametrize("backend", ["process", "thread"])
+@pytest.mark.parametrize("transport", ["pickle", "shared_memory"])
+def test_xyz_noclass_limit(backend, transport):
     reader = copc.FileReader(generate_test_file())
-    xyz = read_concat_xyz_class_limit(reader)
+    xyz = read_concat_xyz_class_limit(
+        reader, backend=backend, transport=transport, max_workers=4
+    )
 
     assert len(xyz) == reader.copc_config.las_header.point_count
 
@@ -44,13 +54,18 @@ def test_xyz_map_noclass_limit():
 
 
 @pytest.mark.skipif(sys.version_info < (3, 7), reason="requires python3.7")
-def test_xyz_map_class_limit():
+@pytest.mark.parametrize("backend", ["process", "thread"])
+@pytest.mark.parametrize("transport", ["pickle", "shared_memory"])
+def test_xyz_map_class_limit(backend, transport):
     classification_limits = [0, 1, 2]
 
     reader = copc.FileReader(generate_test_file())
 
     key_xyz_map = read_map_xyz_class_limit(
-        reader, classification_limits=classification_limits
+        reader,
+        classification_limits=classification_limits,
+        backend=backend,
+        transport=transport,
     )
 
     for node in reader.GetAllNodes():
@@ -65,3 +80,72 @@ def test_xyz_map_class_limit():
             xyz_real = np.stack([points.x, points.y, points.z], axis=1)
             print(xyz_real.shape, xyz_test.shape)
             np.testing.assert_allclose(xyz_real, xyz_test)
+
+
+def test_invalid_backend():
+    reader = copc.FileReader(generate_test_file())
+    with pytest.raises(RuntimeError):
+        read_concat_xyz_class_limit(reader, backend="invalid")
+
+
+def test_invalid_transport():
+    reader = copc.FileReader(generate_test_file())
+    with pytest.raises(RuntimeError):
+        read_concat_xyz_class_limit(reader, transport="invalid")
+
+
+@pytest.mark.skipif(sys.version_info < (3, 8), reason="requires python3.8")
+def test_shared_memory_roundtrip():
+    xyz = np.random.rand(1000, 3)
+    shared = share_results({"xyz": xyz, "small": np.arange(3), "key": "0-0-0-0"})
+    assert isinstance(shared["xyz"], SharedArray)
+    assert isinstance(shared["small"], np.ndarray)
+
+    results = unshare_results(shared)
+    np.testing.assert_array_equal(results["xyz"], xyz)
+    np.testing.assert_array_equal(results["small"], np.arange(3))
+    assert results["key"] == "0-0-0-0"
+
+
+def _read_fun_large(**kwargs):
+    return dict(data=np.zeros(100000))
+
+
+@pytest.mark.skipif(
+    sys.version_info < (3, 8) or not os.path.isdir("/dev/shm"),
+    reason="requires python3.8 and /dev/shm",
+)
+def test_shared_memory_freed_on_error():
+    reader = copc.FileReader(generate_test_file())
+    before = set(os.listdir("/dev/shm"))
+
+    def completed_callback(**kwargs):
+        raise ValueError("stop")
+
+    with pytest.raises(ValueError):
+        read_multithreaded(
+            reader,
+            _read_fun_large,
+            completed_callback=completed_callback,
+            chunk_size=2,
+            max_workers=2,
+            transport="shared_memory",
+        )
+
+    # Neither the collected nor the outstanding results leave a block behind
+    assert set(os.listdir("/dev/shm")) - before == set()
+
+
+@pytest.mark.skipif(sys.version_info < (3, 7), reason="requires python3.7")
+@pytest.mark.parametrize("backend", ["process", "thread"])
+def test_xyz_map_group_points(backend):
+    reader = copc.FileReader(generate_test_file())
+    # Group every node with less than 10000 points
+    key_xyz_map = read_map_xyz_class_limit(
+        reader, backend=backend, group_points=10000, chunk_size=2
+    )
+
+    nodes = [node for node in reader.GetAllNodes() if node.point_count > 0]
+    assert len(key_xyz_map) == len(nodes)
+    for node in nodes:
+        assert len(key_xyz_map[str(node.key)]) == node.point_count
@@ -4,13 +4,19 @@ import sys
 from .utils import generate_test_file, get_data_dir
 
 import copclib as copc
-from copclib.mp.transform import transform_multithreaded
+from copclib.mp.transform import (
+    transform_multithreaded,
+    _share_node_results,
+    _unshare_node_results,
+)
 import numpy as np
 import pytest
 
 
 @pytest.mark.skipif(sys.version_info < (3, 7), reason="requires python3.7")
-def test_copc_copy():
+@pytest.mark.parametrize("backend", ["process", "thread"])
+@pytest.mark.parametrize("transport", ["pickle", "shared_memory"])
+def test_copc_copy(backend, transport):
     file_path = os.path.join(get_data_dir(), "writer_test.copc.laz")
     reader = copc.FileReader(generate_test_file())
     writer = copc.FileWriter(
@@ -18,7 +24,7 @@ def test_copc_copy():
         reader.copc_config,
     )
 
-    transform_multithreaded(reader, writer)
+    transform_multithreaded(reader, writer, backend=backend, transport=transport)
     writer.Close()
 
     # validate
@@ -186,3 +192,17 @@ def test_translate_laz_empty():
 
     assert new_reader.laz_config.las_header.point_count == 0
     assert len(new_reader.GetPoints()) == 0
+
+
+@pytest.mark.parametrize("size", [16, 1024 * 1024])
+def test_unshare_node_results(size):
+    compressed_points = copc.VectorChar((np.arange(size) % 256).astype(np.uint8))
+    shared, return_vals = _share_node_results(compressed_points, dict(value=1))
+    # Nodes below the threshold stay NumPy arrays, larger ones are shared
+    if size < 64 * 1024:
+        assert isinstance(shared, np.ndarray)
+
+    unshared, return_vals = _unshare_node_results(shared, return_vals)
+    assert isinstance(unshared, copc.VectorChar)
+    assert unshared == compressed_points
+    assert return_vals == dict(value=1)
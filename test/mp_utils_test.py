@@ -0,0 +1,58 @@
+from collections import namedtuple
+import concurrent.futures
+import threading
+import time
+
+from copclib.mp.utils import make_tasks, stream_tasks
+
+Node = namedtuple("Node", ["point_count", "byte_size"])
+
+
+def test_make_tasks_order():
+    nodes = [Node(10, 100), Node(1000, 5000), Node(10, 200), Node(0, 0)]
+    tasks = make_tasks(nodes)
+
+    assert tasks == [[Node(1000, 5000)], [Node(10, 200)], [Node(10, 100)], [Node(0, 0)]]
+
+
+def test_make_tasks_group():
+    nodes = [Node(1000, 0), Node(40, 0), Node(30, 0), Node(50, 0), Node(20, 0)]
+    tasks = make_tasks(nodes, group_points=60)
+
+    assert tasks == [
+        [Node(1000, 0)],
+        [Node(50, 0), Node(40, 0)],
+        [Node(30, 0), Node(20, 0)],
+    ]
+    # Every node is in exactly one task
+    assert sorted(node for task in tasks for node in task) == sorted(nodes)
+
+
+def test_stream_tasks():
+    in_flight = 0
+    max_seen = 0
+    lock = threading.Lock()
+
+    def work(delay):
+        nonlocal in_flight, max_seen
+        with lock:
+            in_flight += 1
+            max_seen = max(max_seen, in_flight)
+        time.sleep(delay)
+        with lock:
+            in_flight -= 1
+        return delay
+
+    # A slow first task doesn't hold back the others
+    delays = [0.5] + [0.01] * 20
+    with concurrent.futures.ThreadPoolExecutor(max_workers=4) as executor:
+        results = [
+            fut.result()
+            for fut in stream_tasks(
+                lambda delay: executor.submit(work, delay), delays, max_in_flight=3
+            )
+        ]
+
+    assert sorted(results) == sorted(delays)
+    assert results[-1] == 0.5
+    assert max_seen <= 3
@@ -0,0 +1,192 @@
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+#include <copc-lib/io/copc_reader.hpp>
+#include <copc-lib/io/copc_writer.hpp>
+#include <copc-lib/io/laz_reader.hpp>
+#include <copc-lib/io/laz_writer.hpp>
+#include <copc-lib/io/output_sink.hpp>
+
+using namespace copc;
+
+namespace
+{
+std::vector<char> ReadFile(const std::string &file_path)
+{
+    std::ifstream in_stream(file_path, std::ios::in | std::ios::binary);
+    return {std::istreambuf_iterator<char>(in_stream), std::istreambuf_iterator<char>()};
+}
+
+// Mix of appends and overwrites, some of them before the staging buffer of a FileSink
+void WritePattern(OutputSink &sink)
+{
+    std::vector<char> data(3000);
+    for (size_t i = 0; i < data.size(); i++)
+        data[i] = static_cast<char>(i % 251);
+    for (int i = 0; i < 20; i++)
+        sink.Append(data.data(), data.size() - i * 7);
+    sink.WriteAt(10, "header", 6);
+    sink.WriteAt(sink.Size() - 3, "tail", 4);
+    sink.WriteAt(5000, data.data(), 100);
+}
+
+las::Points MakePoints(const las::LasHeader &header, int count)
+{
+    las::Points points(header);
+    for (int i = 0; i < count; i++)
+    {
+        auto point = points.CreatePoint();
+        point->X(i % 16);
+        point->Y((i * 3) % 16);
+        point->Z((i * 7) % 16);
+        point->ReturnNumber(1);
+        point->NumberOfReturns(1);
+        points.AddPoint(point);
+    }
+    return points;
+}
+
+CopcConfigWriter MakeConfig()
+{
+    CopcConfigWriter cfg(6, {0.01, 0.01, 0.01}, {0, 0, 0}, "TEST_WKT");
+    cfg.LasHeader()->min = Vector3(0, 0, 0);
+    cfg.LasHeader()->max = Vector3(16, 16, 16);
+    return cfg;
+}
+
+void WriteNodes(Writer &writer)
+{
+    auto header = *writer.CopcConfig()->LasHeader();
+    writer.AddNode(VoxelKey::RootKey(), MakePoints(header, 100));
+    writer.AddNode(VoxelKey(1, 0, 0, 0), MakePoints(header, 50), VoxelKey(1, 0, 0, 0));
+    writer.AddNode(VoxelKey(1, 1, 1, 1), MakePoints(header, 30));
+    writer.Close();
+}
+} // namespace
+
+TEST_CASE("OutputSink", "[OutputSink]")
+{
+    MemorySink expected;
+    WritePattern(expected);
+
+    SECTION("MemorySink")
+    {
+        REQUIRE(expected.Size() == expected.Data().size());
+        REQUIRE(std::string(expected.Data().data() + 10, 6) == "header");
+        REQUIRE(std::string(expected.Data().end() - 4, expected.Data().end()) == "tail");
+        REQUIRE_THROWS(expected.WriteAt(expected.Size() + 1, "x", 1));
+    }
+
+    SECTION("StreamSink")
+    {
+        std::stringstream out_stream;
+        StreamSink sink(out_stream);
+        WritePattern(sink);
+        REQUIRE(sink.Size() == expected.Size());
+        auto data = out_stream.str();
+        REQUIRE(std::vector<char>(data.begin(), data.end()) == expected.Data());
+    }
+
+    SECTION("FileSink")
+    {
+        std::string file_path = "output_sink_test.bin";
+        // Buffers smaller and larger than the data
+        for (size_t buffer_size : {size_t{1}, size_t{8192}, size_t{1} << 20})
+        {
+            for (bool direct : {false, true})
+            {
+                {
+                    FileSink sink(file_path, FileSinkOptions{buffer_size, direct});
+                    if (!direct)
+                        REQUIRE_FALSE(sink.IsDirect());
+                    WritePattern(sink);
+                    REQUIRE(sink.Size() == expected.Size());
+                    // Flushing in the middle of a block doesn't lose the staged bytes
+                    sink.Flush();
+                    REQUIRE(ReadFile(file_path) == expected.Data());
+                    sink.Append("more", 4);
+                    sink.Close();
+                    REQUIRE_THROWS(sink.Append("x", 1));
+                }
+                auto data = ReadFile(file_path);
+                REQUIRE(data.size() == expected.Size() + 4);
+                REQUIRE(std::vector<char>(data.begin(), data.end() - 4) == expected.Data());
+                REQUIRE(std::string(data.end() - 4, data.end()) == "more");
+            }
+        }
+    }
+
+    SECTION("Invalid file path")
+    {
+        REQUIRE_THROWS(FileSink("does_not_exist/output_sink_test.bin"));
+    }
+}
+
+TEST_CASE("Writers with an OutputSink", "[OutputSink]")
+{
+    SECTION("COPC Writer")
+    {
+        std::stringstream out_stream;
+        {
+            Writer writer(out_stream, MakeConfig());
+            WriteNodes(writer);
+        }
+        auto expected = out_stream.str();
+
+        auto sink = std::make_shared<MemorySink>();
+        {
+            Writer writer(sink, MakeConfig());
+            WriteNodes(writer);
+        }
+        REQUIRE(std::string(sink->Data().begin(), sink->Data().end()) == expected);
+
+        for (bool direct : {false, true})
+        {
+            std::string file_path = "output_sink_test.copc.laz";
+            {
+                FileWriter writer(file_path, MakeConfig(), {}, {}, {}, {}, {}, {}, FileSinkOptions{4096, direct});
+                WriteNodes(writer);
+            }
+            auto data = ReadFile(file_path);
+            REQUIRE(std::string(data.begin(), data.end()) == expected);
+
+            FileReader reader(file_path);
+            REQUIRE(reader.CopcConfig().LasHeader().PointCount() == 180);
+            REQUIRE(reader.GetAllNodes().size() == 3);
+            REQUIRE(reader.GetPoints(VoxelKey(1, 0, 0, 0)).Size() == 50);
+        }
+    }
+
+    SECTION("LazWriter")
+    {
+        las::LazConfigWriter cfg(6, {0.01, 0.01, 0.01}, {0, 0, 0}, "TEST_WKT");
+
+        std::stringstream out_stream;
+        {
+            laz::LazWriter writer(out_stream, cfg);
+            writer.WritePoints(MakePoints(writer.LazConfig()->LasHeader(), 100));
+            writer.Close();
+        }
+        auto expected = out_stream.str();
+
+        auto sink = std::make_shared<MemorySink>();
+        {
+            laz::LazWriter writer(sink, cfg);
+            writer.WritePoints(MakePoints(writer.LazConfig()->LasHeader(), 100));
+            writer.Close();
+        }
+        REQUIRE(std::string(sink->Data().begin(), sink->Data().end()) == expected);
+
+        std::string file_path = "output_sink_test.laz";
+        {
+            laz::LazFileWriter writer(file_path, cfg, FileSinkOptions{4096, true});
+            writer.WritePoints(MakePoints(writer.LazConfig()->LasHeader(), 100));
+        }
+        laz::LazFileReader reader(file_path);
+        REQUIRE(reader.LazConfig().LasHeader().PointCount() == 100);
+    }
+}
@@ -0,0 +1,58 @@
+import copclib as copc
+import os
+
+from .utils import get_data_dir
+
+
+def _make_points(header, count):
+    points = copc.Points(header)
+    for i in range(count):
+        point = points.CreatePoint()
+        point.x = i % 16
+        point.y = (i * 3) % 16
+        point.z = (i * 7) % 16
+        points.AddPoint(point)
+    return points
+
+
+def _write_copc(file_path, sink_options):
+    cfg = copc.CopcConfigWriter(6, [0.01, 0.01, 0.01], [0, 0, 0])
+    cfg.las_header.min = copc.Vector3(0, 0, 0)
+    cfg.las_header.max = copc.Vector3(16, 16, 16)
+    writer = copc.FileWriter(file_path, cfg, sink_options=sink_options)
+    header = writer.copc_config.las_header
+    writer.AddNode(copc.VoxelKey.RootKey(), _make_points(header, 100))
+    writer.AddNode(copc.VoxelKey(1, 0, 0, 0), _make_points(header, 50))
+    writer.Close()
+
+
+def test_file_sink_options():
+    options = copc.FileSinkOptions()
+    assert options.buffer_size == 8 * 1024 * 1024
+    assert options.direct is False
+
+    default_path = os.path.join(get_data_dir(), "output_sink_test_default.copc.laz")
+    _write_copc(default_path, options)
+
+    direct_path = os.path.join(get_data_dir(), "output_sink_test_direct.copc.laz")
+    _write_copc(direct_path, copc.FileSinkOptions(buffer_size=4096, direct=True))
+
+    with open(default_path, "rb") as f:
+        expected = f.read()
+    with open(direct_path, "rb") as f:
+        assert f.read() == expected
+
+    reader = copc.FileReader(direct_path)
+    assert reader.copc_config.las_header.point_count == 150
+    assert len(reader.GetAllNodes()) == 2
+
+    laz_path = os.path.join(get_data_dir(), "output_sink_test.laz")
+    writer = copc.LazWriter(
+        laz_path,
+        copc.LazConfigWriter(reader.copc_config),
+        sink_options=copc.FileSinkOptions(buffer_size=1, direct=True),
+    )
+    writer.WritePoints(_make_points(writer.laz_config.las_header, 100))
+    writer.Close()
+
+    assert copc.LazReader(laz_path).laz_config.las_header.point_count == 100
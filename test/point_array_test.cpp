@@ -0,0 +1,133 @@
+#include <sstream>
+
+#include <catch2/catch_all.hpp>
+#include <copc-lib/io/copc_reader.hpp>
+#include <copc-lib/io/copc_writer.hpp>
+#include <copc-lib/las/point_array.hpp>
+#include <copc-lib/las/points.hpp>
+
+using namespace copc;
+using namespace copc::las;
+
+TEST_CASE("PointArray", "[PointArray]")
+{
+    LasHeader header(8, PointByteSize(8, 0), Vector3(0.01, 0.01, 0.01), Vector3(50, 50, 50), false);
+    Points points(header);
+    for (int i = 0; i < 20; i++)
+    {
+        auto point = points.CreatePoint();
+        point->X(i * 1.5);
+        point->Y(-i * 0.25);
+        point->Z(100 + i);
+        point->Intensity(i * 100);
+        point->ReturnNumber(i % 4);
+        point->NumberOfReturns(5);
+        point->Withheld(i % 2);
+        point->ScannerChannel(i % 3);
+        point->EdgeOfFlightLineFlag(i % 5 == 0);
+        point->Classification(i % 10);
+        point->UserData(i);
+        point->ScanAngle(static_cast<int16_t>(-i * 10));
+        point->PointSourceId(i + 7);
+        point->GPSTime(i * 0.1);
+        point->Rgb(i, i + 1, i + 2);
+        point->Nir(1000 + i);
+        points.AddPoint(point);
+    }
+
+    SECTION("Unpack matches Points")
+    {
+        auto point_data = points.Pack(header);
+        auto array = PointArray::Unpack(point_data, header);
+        // Compare against unpacked points, so that XYZ went through the same scaling
+        auto unpacked_points = Points::Unpack(point_data, header);
+        REQUIRE(array.Size() == points.Size());
+        REQUIRE(array.Columns().size() == PointArray::AvailableDimensions(8).size());
+
+        auto x = array.Data<double>("x");
+        auto y = array.Data<double>("y");
+        auto z = array.Data<double>("z");
+        auto intensity = array.Data<uint16_t>("intensity");
+        auto return_number = array.Data<uint8_t>("return_number");
+        auto number_of_returns = array.Data<uint8_t>("number_of_returns");
+        auto withheld = array.Data<uint8_t>("withheld");
+        auto scanner_channel = array.Data<uint8_t>("scanner_channel");
+        auto edge_of_flight_line = array.Data<uint8_t>("edge_of_flight_line");
+        auto classification = array.Data<uint8_t>("classification");
+        auto scan_angle = array.Data<int16_t>("scan_angle");
+        auto point_source_id = array.Data<uint16_t>("point_source_id");
+        auto gps_time = array.Data<double>("gps_time");
+        auto blue = array.Data<uint16_t>("blue");
+        auto nir = array.Data<uint16_t>("nir");
+        for (size_t i = 0; i < points.Size(); i++)
+        {
+            REQUIRE(x[i] == unpacked_points[i]->X());
+            REQUIRE(y[i] == unpacked_points[i]->Y());
+            REQUIRE(z[i] == unpacked_points[i]->Z());
+            REQUIRE(intensity[i] == points[i]->Intensity());
+            REQUIRE(return_number[i] == points[i]->ReturnNumber());
+            REQUIRE(number_of_returns[i] == points[i]->NumberOfReturns());
+            REQUIRE(withheld[i] == points[i]->Withheld());
+            REQUIRE(scanner_channel[i] == points[i]->ScannerChannel());
+            REQUIRE(edge_of_flight_line[i] == points[i]->EdgeOfFlightLineFlag());
+            REQUIRE(classification[i] == points[i]->Classification());
+            REQUIRE(scan_angle[i] == points[i]->ScanAngle());
+            REQUIRE(point_source_id[i] == points[i]->PointSourceId());
+            REQUIRE(gps_time[i] == points[i]->GPSTime());
+            REQUIRE(blue[i] == points[i]->Blue());
+            REQUIRE(nir[i] == points[i]->Nir());
+        }
+    }
+
+    SECTION("Dimension selection")
+    {
+        auto array = PointArray::Unpack(points.Pack(header), header, {"z", "classification"});
+        REQUIRE(array.Columns().size() == 2);
+        REQUIRE(array.Columns()[0].name == "z");
+        REQUIRE(array.Columns()[1].type == PointArray::DimensionType::UInt8);
+        REQUIRE(array.HasDimension("classification"));
+        REQUIRE_FALSE(array.HasDimension("x"));
+        REQUIRE_THROWS(array.GetColumn("x"));
+        REQUIRE_THROWS(array.Data<double>("classification"));
+
+        REQUIRE_THROWS(PointArray::Unpack(points.Pack(header), header, {"not_a_dimension"}));
+        REQUIRE_THROWS(PointArray::Unpack(points.Pack(header), header, {"z", "z"}));
+        REQUIRE_THROWS(PointArray::Unpack(std::vector<char>(10), header));
+
+        LasHeader header_6(6, PointByteSize(6, 0), Vector3::DefaultScale(), Vector3::DefaultOffset(), false);
+        REQUIRE_THROWS(PointArray::Unpack({}, header_6, {"red"}));
+        REQUIRE(PointArray::AvailableDimensions(6).size() == PointArray::AvailableDimensions(8).size() - 4);
+    }
+
+    SECTION("FromPoints matches Unpack")
+    {
+        auto unpacked = PointArray::Unpack(points.Pack(header), header);
+        auto from_points = PointArray::FromPoints(points);
+        REQUIRE(from_points.Columns().size() == unpacked.Columns().size());
+        for (size_t c = 0; c < unpacked.Columns().size(); c++)
+        {
+            const auto &column = unpacked.Columns()[c];
+            REQUIRE(from_points.Columns()[c].name == column.name);
+            // XYZ may differ by the rounding of the scale
+            if (column.type != PointArray::DimensionType::Float64)
+                REQUIRE(from_points.Columns()[c].data == column.data);
+        }
+    }
+
+    SECTION("Reader GetPointsArray")
+    {
+        std::stringstream out_stream;
+        CopcConfigWriter cfg(8, header.Scale(), header.Offset());
+        Writer writer(out_stream, cfg);
+        writer.AddNode(VoxelKey::RootKey(), points);
+        writer.Close();
+
+        Reader reader(&out_stream);
+        auto array = reader.GetPointsArray(VoxelKey::RootKey(), {"gps_time", "nir"});
+        REQUIRE(array.Size() == points.Size());
+        REQUIRE(array.Data<double>("gps_time")[3] == points[3]->GPSTime());
+        REQUIRE(array.Data<uint16_t>("nir")[19] == points[19]->Nir());
+
+        REQUIRE(reader.GetPointsArray(VoxelKey(5, 0, 0, 0)).Size() == 0);
+    }
+}
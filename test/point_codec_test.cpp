@@ -0,0 +1,124 @@
+#include <sstream>
+
+#include <catch2/catch_all.hpp>
+#include <copc-lib/las/point_codec.hpp>
+#include <copc-lib/las/points.hpp>
+
+using namespace copc;
+using namespace copc::las;
+
+namespace
+{
+Points MakePoints(const int8_t &point_format_id, const uint16_t &eb_byte_size, int count)
+{
+    Points points(point_format_id, eb_byte_size);
+    for (int i = 0; i < count; i++)
+    {
+        auto point = points.CreatePoint();
+        point->X(i * 1.5);
+        point->Y(-i * 0.25);
+        point->Z(100 + i);
+        point->Intensity(i * 100);
+        point->ReturnsBitField(i);
+        point->FlagsBitField(255 - i);
+        point->Classification(i % 10);
+        point->UserData(i);
+        point->ScanAngle(static_cast<int16_t>(-i * 10));
+        point->PointSourceId(i + 7);
+        point->GPSTime(i * 0.1);
+        if (point->HasRgb())
+            point->Rgb(i, i + 1, i + 2);
+        if (point->HasNir())
+            point->Nir(1000 + i);
+        std::vector<uint8_t> extra_bytes(eb_byte_size);
+        for (uint16_t b = 0; b < eb_byte_size; b++)
+            extra_bytes[b] = static_cast<uint8_t>(i + b);
+        point->ExtraBytes(extra_bytes);
+        points.AddPoint(point);
+    }
+    return points;
+}
+
+// Packs the points one field at a time, as the LAS specification lays them out
+std::vector<char> PackFieldByField(const Points &points, const Vector3 &scale, const Vector3 &offset)
+{
+    std::stringstream out;
+    for (const auto &point : points)
+    {
+        pack(RemoveScale<int32_t>(point->X(), scale.x, offset.x), out);
+        pack(RemoveScale<int32_t>(point->Y(), scale.y, offset.y), out);
+        pack(RemoveScale<int32_t>(point->Z(), scale.z, offset.z), out);
+        pack(point->Intensity(), out);
+        pack(point->ReturnsBitField(), out);
+        pack(point->FlagsBitField(), out);
+        pack(point->Classification(), out);
+        pack(point->UserData(), out);
+        pack(point->ScanAngle(), out);
+        pack(point->PointSourceId(), out);
+        pack(point->GPSTime(), out);
+        if (point->HasRgb())
+        {
+            pack(point->Red(), out);
+            pack(point->Green(), out);
+            pack(point->Blue(), out);
+        }
+        if (point->HasNir())
+            pack(point->Nir(), out);
+        for (auto eb : point->ExtraBytes())
+            pack(eb, out);
+    }
+    auto str = out.str();
+    return std::vector<char>(str.begin(), str.end());
+}
+} // namespace
+
+TEST_CASE("PointCodec", "[PointCodec]")
+{
+    Vector3 scale(0.01, 0.01, 0.01);
+    Vector3 offset(50, 50, 50);
+
+    SECTION("Pack and unpack")
+    {
+        // Specialized and runtime extra bytes sizes
+        for (int8_t point_format_id = 6; point_format_id <= 8; point_format_id++)
+        {
+            for (uint16_t eb_byte_size : {0, 1, 5, 8, 9, 20})
+            {
+                const auto &codec = PointCodec::Get(point_format_id, eb_byte_size);
+                REQUIRE(codec.PointFormatId() == point_format_id);
+                REQUIRE(codec.EbByteSize() == eb_byte_size);
+                REQUIRE(codec.PointRecordLength() == PointByteSize(point_format_id, eb_byte_size));
+                // The same codec is returned for the same layout
+                REQUIRE(&PointCodec::Get(point_format_id, eb_byte_size) == &codec);
+
+                auto points = MakePoints(point_format_id, eb_byte_size, 20);
+                auto point_data = points.Pack(scale, offset);
+                REQUIRE(point_data == PackFieldByField(points, scale, offset));
+
+                auto unpacked = Points::Unpack(point_data, point_format_id, eb_byte_size, scale, offset);
+                REQUIRE(unpacked.Size() == points.Size());
+                for (size_t i = 0; i < points.Size(); i++)
+                    REQUIRE(*unpacked[i] == *points[i]);
+
+                std::vector<char> record(codec.PointRecordLength());
+                codec.PackPoint(*points[3], record.data(), scale, offset);
+                REQUIRE(*codec.UnpackPoint(record.data(), scale, offset) == *points[3]);
+            }
+        }
+    }
+
+    SECTION("Mismatched points")
+    {
+        REQUIRE_THROWS(PointCodec::Get(5, 0));
+        REQUIRE_THROWS(PointCodec::Get(9, 0));
+
+        auto points = MakePoints(7, 2, 3);
+        std::vector<char> record(PointByteSize(7, 2));
+        REQUIRE_THROWS(PointCodec::Get(8, 2).PackPoint(*points[0], record.data(), scale, offset));
+        REQUIRE_THROWS(PointCodec::Get(7, 3).PackPoint(*points[0], record.data(), scale, offset));
+
+        // Resizing a point's extra bytes after adding it changes its record length
+        points[1]->SetExtraBytesField<uint32_t>(0, 4, 1);
+        REQUIRE_THROWS(points.Pack(scale, offset));
+    }
+}
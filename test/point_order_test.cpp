@@ -0,0 +1,140 @@
+#include <random>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+#include <copc-lib/io/copc_reader.hpp>
+#include <copc-lib/io/copc_writer.hpp>
+#include <copc-lib/las/point_order.hpp>
+
+using namespace copc;
+using namespace copc::las;
+
+namespace
+{
+// Random points with distinct intensities, to follow them through the sort
+Points MakePoints(const LasHeader &header, int count)
+{
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> xyz(-500, 500);
+    std::uniform_int_distribution<int> gps_time(0, 50);
+    Points points(header);
+    for (int i = 0; i < count; i++)
+    {
+        auto point = points.CreatePoint();
+        point->X(xyz(rng) * header.Scale().x);
+        point->Y(xyz(rng) * header.Scale().y);
+        point->Z(xyz(rng) * header.Scale().z);
+        point->GPSTime(gps_time(rng) - 10.5);
+        point->Intensity(static_cast<uint16_t>(i));
+        points.AddPoint(point);
+    }
+    return points;
+}
+
+// Morton code of the point's coordinates relative to min, with a scale of 1
+uint64_t PointMortonCode(const Point &point, int32_t min)
+{
+    return MortonCode(static_cast<uint32_t>(point.X() - min), static_cast<uint32_t>(point.Y() - min),
+                      static_cast<uint32_t>(point.Z() - min));
+}
+} // namespace
+
+TEST_CASE("MortonCode", "[PointOrder]")
+{
+    REQUIRE(MortonCode(0, 0, 0) == 0);
+    REQUIRE(MortonCode(1, 0, 0) == 1);
+    REQUIRE(MortonCode(0, 1, 0) == 2);
+    REQUIRE(MortonCode(0, 0, 1) == 4);
+    REQUIRE(MortonCode(2, 0, 0) == 8);
+    REQUIRE(MortonCode(0x1FFFFF, 0x1FFFFF, 0x1FFFFF) == 0x7FFFFFFFFFFFFFFF);
+}
+
+TEST_CASE("SortPointData", "[PointOrder]")
+{
+    LasHeader header(6, PointBaseByteSize(6), {1, 1, 1}, {0, 0, 0}, false);
+    auto points = MakePoints(header, 1000);
+    auto point_data = points.Pack(header);
+
+    SECTION("Unchanged")
+    {
+        auto sorted_data = point_data;
+        SortPointData(sorted_data, header, PointOrder::Unchanged);
+        REQUIRE(sorted_data == point_data);
+    }
+
+    SECTION("GPS time")
+    {
+        SortPointData(point_data, header, PointOrder::GpsTime);
+        auto sorted = Points::Unpack(point_data, header);
+        REQUIRE(sorted.Size() == points.Size());
+        for (size_t i = 1; i < sorted.Size(); i++)
+        {
+            REQUIRE(sorted[i - 1]->GPSTime() <= sorted[i]->GPSTime());
+            // The sort is stable
+            if (sorted[i - 1]->GPSTime() == sorted[i]->GPSTime())
+                REQUIRE(sorted[i - 1]->Intensity() < sorted[i]->Intensity());
+        }
+    }
+
+    SECTION("Morton")
+    {
+        SortPointData(point_data, header, PointOrder::Morton);
+        auto sorted = Points::Unpack(point_data, header);
+        REQUIRE(sorted.Size() == points.Size());
+        for (size_t i = 1; i < sorted.Size(); i++)
+            REQUIRE(PointMortonCode(*sorted[i - 1], -500) <= PointMortonCode(*sorted[i], -500));
+
+        // Sorting again keeps the order
+        auto sorted_data = point_data;
+        SortPointData(sorted_data, header, PointOrder::Morton);
+        REQUIRE(sorted_data == point_data);
+    }
+
+    SECTION("Invalid data")
+    {
+        point_data.push_back(0);
+        REQUIRE_THROWS(SortPointData(point_data, header, PointOrder::Morton));
+    }
+}
+
+TEST_CASE("Writer point order", "[PointOrder]")
+{
+    CopcConfigWriter cfg(6, {0.01, 0.01, 0.01}, {0, 0, 0}, "TEST_WKT");
+    cfg.LasHeader()->min = Vector3(-8, -8, -8);
+    cfg.LasHeader()->max = Vector3(8, 8, 8);
+
+    auto points = MakePoints(*cfg.LasHeader(), 500);
+    std::stringstream out_stream;
+    {
+        Writer writer(out_stream, cfg);
+        REQUIRE(writer.GetPointOrder() == PointOrder::Unchanged);
+        writer.SetPointOrder(PointOrder::GpsTime);
+        REQUIRE(writer.GetPointOrder() == PointOrder::GpsTime);
+
+        writer.AddNode(VoxelKey::RootKey(), points);
+        // Packed data is sorted in a copy, unless it's moved into the writer
+        auto packed = points.Pack(*cfg.LasHeader());
+        auto packed_copy = packed;
+        writer.AddNode(VoxelKey(1, 1, 0, 0), packed);
+        REQUIRE(packed == packed_copy);
+        writer.AddNode(VoxelKey(1, 0, 1, 0), std::move(packed));
+        writer.SetPointOrder(PointOrder::Unchanged);
+        writer.AddNode(VoxelKey(1, 0, 0, 0), points);
+        writer.Close();
+    }
+
+    Reader reader(&out_stream);
+    for (const auto &key : {VoxelKey::RootKey(), VoxelKey(1, 1, 0, 0), VoxelKey(1, 0, 1, 0)})
+    {
+        auto sorted = reader.GetPoints(key);
+        REQUIRE(sorted.Size() == points.Size());
+        for (size_t i = 1; i < sorted.Size(); i++)
+            REQUIRE(sorted[i - 1]->GPSTime() <= sorted[i]->GPSTime());
+    }
+
+    auto unchanged = reader.GetPoints(VoxelKey(1, 0, 0, 0));
+    for (size_t i = 0; i < unchanged.Size(); i++)
+        REQUIRE(unchanged[i]->Intensity() == points[i]->Intensity());
+}
@@ -0,0 +1,60 @@
+import copclib as copc
+import os
+import random
+import struct
+
+from .utils import get_data_dir
+
+
+def _make_points(header, count):
+    random.seed(42)
+    points = copc.Points(header)
+    for i in range(count):
+        point = points.CreatePoint()
+        point.x = random.uniform(-5, 5)
+        point.y = random.uniform(-5, 5)
+        point.z = random.uniform(-5, 5)
+        point.gps_time = random.randint(0, 50) - 10.5
+        point.intensity = i
+        points.AddPoint(point)
+    return points
+
+
+def test_morton_code():
+    assert copc.MortonCode(1, 0, 0) == 1
+    assert copc.MortonCode(0, 1, 0) == 2
+    assert copc.MortonCode(0, 0, 1) == 4
+    assert copc.MortonCode(2, 0, 0) == 8
+
+
+def test_sort_point_data():
+    header = copc.LazConfigWriter(6, [0.01, 0.01, 0.01], [0, 0, 0]).las_header
+    point_data = _make_points(header, 500).Pack(header)
+
+    copc.SortPointData(point_data, header, copc.PointOrder.GpsTime)
+    # GPS time is at byte 22 of the records
+    data = bytes(point_data)
+    record_length = header.point_record_length
+    gps_times = [struct.unpack_from("<d", data, i + 22)[0] for i in range(0, len(data), record_length)]
+    assert len(gps_times) == 500
+    assert gps_times == sorted(gps_times)
+
+
+def test_writer_point_order():
+    file_path = os.path.join(get_data_dir(), "point_order_test.copc.laz")
+
+    cfg = copc.CopcConfigWriter(6, [0.01, 0.01, 0.01], [0, 0, 0])
+    cfg.las_header.min = copc.Vector3(-8, -8, -8)
+    cfg.las_header.max = copc.Vector3(8, 8, 8)
+    writer = copc.FileWriter(file_path, cfg)
+    assert writer.point_order == copc.PointOrder.Unchanged
+    writer.point_order = copc.PointOrder.GpsTime
+
+    points = _make_points(writer.copc_config.las_header, 500)
+    writer.AddNode(copc.VoxelKey.RootKey(), points)
+    writer.Close()
+
+    reader = copc.FileReader(file_path)
+    gps_times = [point.gps_time for point in reader.GetPoints(copc.VoxelKey.RootKey())]
+    assert len(gps_times) == 500
+    assert gps_times == sorted(gps_times)
@@ -102,6 +102,55 @@ TEST_CASE("Points tests", "[Point]")
         REQUIRE_THROWS(points.AddPoints(points_other));
     }
 
+    SECTION("Moving Points into Points")
+    {
+        auto point = std::make_shared<Point>(6, 4);
+        point->X(5);
+        auto points = Points(std::vector<std::shared_ptr<Point>>(10, std::make_shared<Point>(6, 4)));
+        auto points_other = Points(std::vector<std::shared_ptr<Point>>(5, point));
+
+        points.AddPoints(std::move(points_other));
+        REQUIRE(points.Size() == 15);
+        REQUIRE(points[14]->X() == 5);
+        REQUIRE(points_other.Size() == 0);
+
+        // An empty Points takes the other's storage
+        auto empty = Points(6, 4);
+        const auto *data = points.View().data();
+        empty.AddPoints(std::move(points));
+        REQUIRE(empty.Size() == 15);
+        REQUIRE(empty.View().data() == data);
+
+        // Test check on point format
+        REQUIRE_THROWS(empty.AddPoints(Points(std::vector<std::shared_ptr<Point>>(10, std::make_shared<Point>(7, 4)))));
+        REQUIRE(empty.Size() == 15);
+    }
+
+    SECTION("Concatenating Points")
+    {
+        std::vector<Points> points_list;
+        for (int i = 0; i < 4; i++)
+        {
+            auto point = std::make_shared<Point>(6, 4);
+            point->X(i);
+            points_list.emplace_back(std::vector<std::shared_ptr<Point>>(i + 1, point));
+        }
+
+        auto points = Points(6, 4);
+        points.AddPoints(std::move(points_list));
+        REQUIRE(points.Size() == 10);
+        REQUIRE(points.View().capacity() == 10);
+        REQUIRE(points[0]->X() == 0);
+        REQUIRE(points[9]->X() == 3);
+
+        // Test check on extra bytes, no points are added
+        std::vector<Points> bad_list;
+        bad_list.emplace_back(std::vector<std::shared_ptr<Point>>(2, std::make_shared<Point>(6, 4)));
+        bad_list.emplace_back(std::vector<std::shared_ptr<Point>>(2, std::make_shared<Point>(6, 1)));
+        REQUIRE_THROWS(points.AddPoints(std::move(bad_list)));
+        REQUIRE(points.Size() == 10);
+    }
+
     SECTION("Points format conversion")
     {
         auto points = Points(std::vector<std::shared_ptr<Point>>(10, std::make_shared<Point>(6, 4)));
@@ -350,6 +350,38 @@ def test_points_accessors():
     assert all([z == -70 for z in points.z])
 
 
+def test_points_as_numpy():
+    np = pytest.importorskip("numpy")
+
+    points = copc.Points(7, 0)
+    for i in range(100):
+        p = points.CreatePoint()
+        p.x = i
+        p.y = i * 3
+        p.z = i - 80
+        p.classification = i % 20
+        p.withheld = i % 2 == 1
+        p.red = i * 10
+        points.AddPoint(p)
+
+    arrays = points.as_numpy()
+    assert "nir" not in arrays
+    assert arrays["x"].dtype == np.float64
+    assert arrays["classification"].dtype == np.uint8
+    assert arrays["withheld"].dtype == np.bool_
+    np.testing.assert_array_equal(arrays["y"], np.arange(100) * 3)
+    np.testing.assert_array_equal(arrays["red"], points.red)
+    assert arrays["withheld"].sum() == 50
+
+    arrays = points.as_numpy(["z", "classification"])
+    assert list(arrays.keys()) == ["z", "classification"]
+    np.testing.assert_array_equal(arrays["z"], points.z)
+    assert list(points.as_numpy(dims=["z"]).keys()) == ["z"]
+
+    with pytest.raises(RuntimeError):
+        points.as_numpy(["nir"])
+
+
 def test_points_indexer_setter():
     points = copc.Points(6, 4)
 
@@ -1,8 +1,12 @@
 #include <catch2/catch_all.hpp>
 #include <cmath>
 #include <copc-lib/io/copc_reader.hpp>
+#include <copc-lib/io/copc_writer.hpp>
+#include <filesystem>
 #include <fstream>
 #include <limits>
+#include <sstream>
+#include <thread>
 
 using namespace copc;
 using namespace std;
@@ -268,3 +272,368 @@ TEST_CASE("Spatial Query Functions", "[Reader]")
         REQUIRE(reader.GetNodesWithinResolution(0).size() == reader.GetAllNodes().size());
     }
 }
+
+// Streambuf over an in-memory file that counts how many times the underlying data is accessed
+class CountingStreamBuf : public std::stringbuf
+{
+  public:
+    CountingStreamBuf(const std::string &data) : std::stringbuf(data, std::ios::in | std::ios::binary) {}
+
+    int reads{0};
+
+  protected:
+    std::streamsize xsgetn(char *s, std::streamsize n) override
+    {
+        reads++;
+        return std::stringbuf::xsgetn(s, n);
+    }
+};
+
+TEST_CASE("Reader open I/O", "[Reader]")
+{
+    GIVEN("A COPC file with a WKT, extra bytes and a hierarchy")
+    {
+        las::EbVlr eb_vlr;
+        auto field = lazperf::eb_vlr::ebfield();
+        field.data_type = 0;
+        field.options = 4;
+        field.name = "eb1";
+        eb_vlr.addField(field);
+
+        stringstream out_stream;
+        {
+            CopcConfigWriter cfg(7, {0.1, 0.1, 0.1}, {0, 0, 0}, "TEST_WKT", eb_vlr);
+            Writer writer(out_stream, cfg);
+
+            las::Points points(*writer.CopcConfig()->LasHeader());
+            for (int i = 0; i < 10; i++)
+            {
+                auto point = points.CreatePoint();
+                point->X(i);
+                point->Y(i);
+                point->Z(i);
+                points.AddPoint(point);
+            }
+            writer.AddNode(VoxelKey::RootKey(), points);
+            writer.AddNode(VoxelKey(1, 0, 0, 0), points, VoxelKey(1, 0, 0, 0));
+            writer.Close();
+        }
+
+        CountingStreamBuf buf(out_stream.str());
+        std::istream in_stream(&buf);
+        Reader reader(&in_stream);
+
+        // Header and VLRs in one read, EVLRs in another
+        REQUIRE(buf.reads == 2);
+
+        REQUIRE(reader.CopcConfig().LasHeader().PointFormatId() == 7);
+        REQUIRE(reader.CopcConfig().LasHeader().PointCount() == 20);
+        REQUIRE(reader.CopcConfig().Wkt() == "TEST_WKT");
+        REQUIRE(reader.CopcConfig().ExtraBytesVlr().items.size() == 1);
+        REQUIRE(reader.CopcConfig().ExtraBytesVlr().items[0].name == "eb1");
+
+        // Hierarchy pages are served from the EVLR block without touching the stream
+        auto nodes = reader.GetAllNodes();
+        REQUIRE(nodes.size() == 2);
+        REQUIRE(buf.reads == 2);
+
+        auto points = reader.GetPoints(VoxelKey(1, 0, 0, 0));
+        REQUIRE(points.Size() == 10);
+        REQUIRE(points.Get(9)->X() == 9);
+    }
+}
+
+TEST_CASE("Hierarchy cache", "[Reader]")
+{
+    GIVEN("A COPC file with sub pages")
+    {
+        string file_path = "hierarchy_cache_test.copc.laz";
+        string cache_path = "hierarchy_cache_test.copc.laz.hier";
+        std::remove(cache_path.c_str());
+
+        auto write_file = [&](int num_nodes)
+        {
+            FileWriter writer(file_path, CopcConfigWriter(6));
+            las::Points points(*writer.CopcConfig()->LasHeader());
+            points.AddPoint(points.CreatePoint());
+
+            writer.AddNode(VoxelKey::RootKey(), points);
+            writer.AddNode(VoxelKey(1, 1, 1, 1), points, VoxelKey(1, 1, 1, 1));
+            for (int i = 0; i < num_nodes; i++)
+                writer.AddNode(VoxelKey(2, 2 + i % 2, 2 + i / 2, 2), points, VoxelKey(1, 1, 1, 1));
+            writer.Close();
+        };
+        write_file(2);
+
+        std::vector<Node> nodes;
+        {
+            FileReader reader(file_path);
+            nodes = reader.GetAllNodes();
+            REQUIRE(nodes.size() == 4);
+            REQUIRE(!reader.HierarchyCacheHit());
+        }
+
+        // The first open with a cache path writes the cache
+        {
+            FileReader reader(file_path, cache_path);
+            REQUIRE(!reader.HierarchyCacheHit());
+            REQUIRE(std::ifstream(cache_path).good());
+        }
+
+        // Later opens load the hierarchy from the cache
+        {
+            FileReader reader(file_path, cache_path);
+            REQUIRE(reader.HierarchyCacheHit());
+
+            auto cached_nodes = reader.GetAllNodes();
+            REQUIRE(cached_nodes.size() == nodes.size());
+            for (const auto &node : nodes)
+            {
+                auto cached_node = reader.FindNode(node.key);
+                REQUIRE(cached_node.offset == node.offset);
+                REQUIRE(cached_node.byte_size == node.byte_size);
+                REQUIRE(cached_node.point_count == node.point_count);
+                REQUIRE(cached_node.page_key == node.page_key);
+            }
+            REQUIRE(reader.GetPageList().size() == 2);
+            REQUIRE(reader.GetPoints(VoxelKey(2, 3, 2, 2)).Size() == 1);
+        }
+
+        // A modified file makes the cache stale, so the hierarchy is read from the file and the cache rewritten
+        write_file(3);
+        {
+            FileReader reader(file_path, cache_path);
+            REQUIRE(!reader.HierarchyCacheHit());
+            REQUIRE(reader.GetAllNodes().size() == 5);
+        }
+        {
+            FileReader reader(file_path, cache_path);
+            REQUIRE(reader.HierarchyCacheHit());
+            REQUIRE(reader.GetAllNodes().size() == 5);
+        }
+
+        // A corrupted cache is ignored
+        {
+            std::ofstream cache(cache_path, std::ios::binary | std::ios::trunc);
+            cache << "not a cache";
+        }
+        {
+            FileReader reader(file_path, cache_path);
+            REQUIRE(!reader.HierarchyCacheHit());
+            REQUIRE(reader.GetAllNodes().size() == 5);
+        }
+
+        // Readers writing the same cache at once each use their own temporary file
+        std::remove(cache_path.c_str());
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 4; i++)
+            threads.emplace_back([&]() { FileReader reader(file_path, cache_path); });
+        for (auto &thread : threads)
+            thread.join();
+        {
+            FileReader reader(file_path, cache_path);
+            REQUIRE(reader.HierarchyCacheHit());
+            REQUIRE(reader.GetAllNodes().size() == 5);
+        }
+        for (const auto &entry : std::filesystem::directory_iterator("."))
+            REQUIRE(entry.path().filename().string().rfind("hierarchy_cache_test.copc.laz.hier.tmp", 0) != 0);
+    }
+}
+
+TEST_CASE("Reader Prefetch", "[Reader]")
+{
+    string file_path = "prefetch_test.copc.laz";
+    {
+        FileWriter writer(file_path, CopcConfigWriter(6));
+        las::Points points(*writer.CopcConfig()->LasHeader());
+        for (int i = 0; i < 10; i++)
+        {
+            auto point = points.CreatePoint();
+            point->X(i);
+            points.AddPoint(point);
+        }
+        writer.AddNode(VoxelKey::RootKey(), points);
+        writer.AddNode(VoxelKey(1, 0, 0, 0), points);
+        writer.AddNode(VoxelKey(1, 1, 0, 0), points);
+        writer.Close();
+    }
+
+    GIVEN("A stream reader")
+    {
+        fstream in_stream(file_path, ios::in | ios::binary);
+        Reader reader(&in_stream);
+        auto nodes = reader.GetAllNodes();
+        REQUIRE(nodes.size() == 3);
+
+        uint64_t total_bytes = 0;
+        for (const auto &node : nodes)
+            total_bytes += node.byte_size;
+
+        reader.Prefetch(nodes);
+        // Prefetching the same nodes again is a no-op
+        reader.Prefetch(nodes);
+        reader.WaitForPrefetch();
+        REQUIRE(reader.PrefetchedBytes() == total_bytes);
+        REQUIRE(reader.PrefetchesUsed() == 0);
+
+        for (const auto &node : nodes)
+        {
+            REQUIRE(reader.GetPoints(node).Size() == 10);
+            REQUIRE(reader.GetPoints(node).Get(9)->X() == 9);
+        }
+        // Only the first read of each node is served from the prefetch
+        REQUIRE(reader.PrefetchesUsed() == nodes.size());
+
+        REQUIRE_NOTHROW(reader.Prefetch({Node()}));
+        REQUIRE(reader.PrefetchedBytes() == total_bytes);
+    }
+
+    GIVEN("A bounded prefetch")
+    {
+        fstream in_stream(file_path, ios::in | ios::binary);
+        Reader reader(&in_stream);
+        REQUIRE(reader.GetMaxPrefetchBytes() == static_cast<uint64_t>(Reader::DEFAULT_MAX_PREFETCH_BYTES));
+        auto nodes = reader.GetAllNodes();
+        reader.SetMaxPrefetchBytes(nodes[0].byte_size);
+
+        reader.Prefetch(nodes);
+        reader.WaitForPrefetch();
+        REQUIRE(reader.PrefetchedBytes() <= static_cast<uint64_t>(nodes[0].byte_size));
+        // Nodes that didn't fit are read when they are needed
+        for (const auto &node : nodes)
+            REQUIRE(reader.GetPoints(node).Size() == 10);
+    }
+
+    GIVEN("Prefetches from several threads")
+    {
+        fstream in_stream(file_path, ios::in | ios::binary);
+        Reader reader(&in_stream);
+        auto nodes = reader.GetAllNodes();
+
+        vector<thread> threads;
+        for (size_t t = 0; t < 4; t++)
+        {
+            threads.emplace_back(
+                [&, t]
+                {
+                    reader.Prefetch({nodes[t % nodes.size()]});
+                    reader.WaitForPrefetch();
+                    reader.Prefetch(nodes);
+                });
+        }
+        for (auto &thread : threads)
+            thread.join();
+        reader.WaitForPrefetch();
+        for (const auto &node : nodes)
+            REQUIRE(reader.GetPoints(node).Size() == 10);
+    }
+
+    GIVEN("A file reader")
+    {
+        FileReader reader(file_path);
+        auto nodes = reader.GetAllNodes();
+
+        reader.Prefetch({nodes[0], nodes[1]});
+        reader.WaitForPrefetch();
+        REQUIRE(reader.PrefetchedBytes() == static_cast<uint64_t>(nodes[0].byte_size + nodes[1].byte_size));
+
+        REQUIRE(reader.GetPointDataCompressed(nodes[0]) == reader.GetPointDataCompressed(nodes[0].key));
+        REQUIRE(reader.GetPoints(nodes[1]).Size() == 10);
+        REQUIRE(reader.GetPoints(nodes[2]).Size() == 10);
+        REQUIRE(reader.PrefetchesUsed() == 2);
+    }
+}
+
+TEST_CASE("Reader thread safety", "[Reader]")
+{
+    string file_path = "thread_safety_test.copc.laz";
+    vector<VoxelKey> keys = {VoxelKey::RootKey(), VoxelKey(1, 0, 0, 0), VoxelKey(1, 1, 1, 1), VoxelKey(2, 0, 0, 0),
+                             VoxelKey(2, 3, 3, 3)};
+    {
+        FileWriter writer(file_path, CopcConfigWriter(6));
+        for (size_t i = 0; i < keys.size(); i++)
+        {
+            las::Points points(*writer.CopcConfig()->LasHeader());
+            for (int j = 0; j < 100; j++)
+            {
+                auto point = points.CreatePoint();
+                point->X(static_cast<double>(i));
+                points.AddPoint(point);
+            }
+            // Put each node below the root in its own page, so that the hierarchy is loaded lazily by the threads
+            auto page_key = keys[i].d == 0 ? VoxelKey::RootKey() : keys[i].GetParentAtDepth(1);
+            writer.AddNode(keys[i], points, page_key);
+        }
+        writer.Close();
+    }
+
+    FileReader reader(file_path);
+    vector<thread> threads;
+    vector<int> errors(8, 0);
+    for (size_t t = 0; t < errors.size(); t++)
+    {
+        threads.emplace_back(
+            [&, t]
+            {
+                for (int iteration = 0; iteration < 20; iteration++)
+                {
+                    for (size_t i = 0; i < keys.size(); i++)
+                    {
+                        // Visit the keys in a different order in each thread
+                        size_t k = (i + t) % keys.size();
+                        auto points = reader.GetPoints(reader.FindNode(keys[k]));
+                        if (points.Size() != 100 || points.Get(99)->X() != static_cast<double>(k))
+                            errors[t]++;
+                    }
+                    if (reader.GetAllNodes().size() != keys.size())
+                        errors[t]++;
+                }
+            });
+    }
+    for (auto &thread : threads)
+        thread.join();
+
+    for (auto error_count : errors)
+        REQUIRE(error_count == 0);
+}
+
+TEST_CASE("Reader GetPoints with an arena", "[Reader]")
+{
+    string file_path = "arena_test.copc.laz";
+    {
+        FileWriter writer(file_path, CopcConfigWriter(7));
+        las::Points points(*writer.CopcConfig()->LasHeader());
+        for (int i = 0; i < 50; i++)
+        {
+            auto point = points.CreatePoint();
+            point->X(i);
+            point->Rgb(i, 0, 0);
+            points.AddPoint(point);
+        }
+        writer.AddNode(VoxelKey::RootKey(), points);
+        writer.AddNode(VoxelKey(1, 0, 0, 0), points);
+        writer.Close();
+    }
+
+    FileReader reader(file_path);
+    Arena arena(1024);
+    vector<size_t> block_allocations;
+    for (const auto &node : reader.GetAllNodes())
+    {
+        {
+            auto points = reader.GetPoints(node, arena);
+            REQUIRE(points.Size() == 50);
+            REQUIRE(points.Get(49)->X() == 49);
+            REQUIRE(points.Get(49)->Red() == 49);
+            REQUIRE(arena.BytesUsed() >= 50 * sizeof(las::Point));
+            REQUIRE(points.Pack(reader.CopcConfig().LasHeader()) == reader.GetPointData(node));
+        }
+        // The points must be gone before the arena is released
+        arena.Release();
+        block_allocations.push_back(arena.BlockAllocations());
+    }
+    // The second node fits in the block merged by the first Release
+    REQUIRE(block_allocations[1] == block_allocations[0]);
+
+    REQUIRE_THROWS(reader.GetPoints(Node(), arena));
+}
@@ -1,9 +1,10 @@
+import os
 from sys import float_info
 
 import copclib as copc
 import pytest
 
-from .utils import get_autzen_file
+from .utils import generate_test_file, get_autzen_file
 
 
 def test_reader():
@@ -179,3 +180,80 @@ def test_spatial_query_functions():
     subset_nodes = reader.GetNodesWithinResolution(3)
     assert len(subset_nodes) == 257
     assert len(reader.GetNodesWithinResolution(0)) == len(reader.GetAllNodes())
+
+
+def test_hierarchy_cache(tmp_path):
+    file_path = generate_test_file()
+    cache_path = str(tmp_path / "hierarchy.cache")
+
+    nodes = copc.FileReader(file_path).GetAllNodes()
+
+    # The first open writes the cache
+    reader = copc.FileReader(file_path, hierarchy_cache_path=cache_path)
+    assert not reader.hierarchy_cache_hit
+    assert os.path.exists(cache_path)
+
+    # Later opens read the hierarchy from the cache
+    reader = copc.FileReader(file_path, hierarchy_cache_path=cache_path)
+    assert reader.hierarchy_cache_hit
+    assert len(reader.GetAllNodes()) == len(nodes)
+    for node in nodes:
+        cached_node = reader.FindNode(node.key)
+        assert cached_node.offset == node.offset
+        assert cached_node.byte_size == node.byte_size
+        assert cached_node.point_count == node.point_count
+        assert cached_node.page_key == node.page_key
+
+    # A corrupted cache is ignored
+    with open(cache_path, "wb") as f:
+        f.write(b"not a cache")
+    reader = copc.FileReader(file_path, hierarchy_cache_path=cache_path)
+    assert not reader.hierarchy_cache_hit
+    assert len(reader.GetAllNodes()) == len(nodes)
+
+
+def test_prefetch():
+    reader = copc.FileReader(generate_test_file())
+    nodes = reader.GetAllNodes()
+
+    reader.Prefetch(nodes)
+    reader.WaitForPrefetch()
+    assert reader.prefetched_bytes == sum(node.byte_size for node in nodes)
+
+    for node in nodes:
+        assert len(reader.GetPoints(node)) == node.point_count
+    assert reader.prefetches_used == len(nodes)
+
+
+def test_get_points_array():
+    np = pytest.importorskip("numpy")
+
+    reader = copc.FileReader(get_autzen_file())
+    node = reader.FindNode(copc.VoxelKey(5, 9, 7, 0))
+
+    arrays = reader.GetPointsArray(node, ["x", "y", "z", "classification"])
+    assert len(arrays["x"]) == node.point_count
+    # The arrays are views of a buffer owned by the library
+    assert not arrays["x"].flags.owndata
+
+    points = reader.GetPoints(node)
+    np.testing.assert_array_equal(arrays["x"], points.x)
+    np.testing.assert_array_equal(arrays["z"], points.z)
+    np.testing.assert_array_equal(arrays["classification"], points.classification)
+
+    # Dimensions can be given by keyword, for nodes and keys
+    arrays = reader.GetPointsArray(node, dims=["z"])
+    assert list(arrays.keys()) == ["z"]
+    np.testing.assert_array_equal(arrays["z"], points.z)
+    arrays = reader.GetPointsArray(node.key, dims=["x", "z"])
+    assert list(arrays.keys()) == ["x", "z"]
+
+    # The buffer outlives the dict and the reader
+    x = arrays["x"]
+    del arrays, reader
+    assert len(x) == node.point_count
+
+    # Invalid key returns empty arrays
+    reader = copc.FileReader(get_autzen_file())
+    arrays = reader.GetPointsArray(copc.VoxelKey.InvalidKey())
+    assert len(arrays["gps_time"]) == 0
@@ -0,0 +1,179 @@
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+#include <copc-lib/io/copc_reader.hpp>
+#include <copc-lib/io/copc_repack.hpp>
+#include <copc-lib/io/copc_writer.hpp>
+
+using namespace copc;
+
+namespace
+{
+las::Points MakePoints(const las::LasHeader &header, const VoxelKey &key, int count)
+{
+    Box box(key, header);
+    las::Points points(header);
+    for (int i = 0; i < count; i++)
+    {
+        auto point = points.CreatePoint();
+        point->X(box.x_min + (box.x_max - box.x_min) * (i + 0.5) / count);
+        point->Y(box.y_min);
+        point->Z(box.z_min);
+        points.AddPoint(point);
+    }
+    return points;
+}
+
+// Keys of the nodes, in the order of their data in the file
+std::vector<VoxelKey> KeysByOffset(Reader &reader)
+{
+    auto nodes = reader.GetAllNodes();
+    std::sort(nodes.begin(), nodes.end(), [](const Node &a, const Node &b) { return a.offset < b.offset; });
+    std::vector<VoxelKey> keys;
+    for (const auto &node : nodes)
+        keys.push_back(node.key);
+    return keys;
+}
+} // namespace
+
+TEST_CASE("HilbertIndex", "[Repack]")
+{
+    REQUIRE(HilbertIndex(VoxelKey::RootKey()) == 0);
+
+    // Consecutive voxels along the curve are face neighbors
+    for (int32_t d = 1; d <= 3; d++)
+    {
+        int32_t n = 1 << d;
+        std::vector<VoxelKey> keys(n * n * n);
+        for (int32_t x = 0; x < n; x++)
+            for (int32_t y = 0; y < n; y++)
+                for (int32_t z = 0; z < n; z++)
+                {
+                    VoxelKey key(d, x, y, z);
+                    auto index = HilbertIndex(key);
+                    REQUIRE(index < keys.size());
+                    keys[index] = key;
+                }
+        for (size_t i = 1; i < keys.size(); i++)
+        {
+            auto a = keys[i - 1], b = keys[i];
+            REQUIRE(std::abs(a.x - b.x) + std::abs(a.y - b.y) + std::abs(a.z - b.z) == 1);
+        }
+    }
+}
+
+TEST_CASE("RepackCopc", "[Repack]")
+{
+    // Write the nodes deepest first and in reverse key order, each depth 2 node in its own page
+    std::vector<VoxelKey> keys{VoxelKey::RootKey()};
+    for (const auto &child : VoxelKey::RootKey().GetChildren())
+    {
+        keys.push_back(child);
+        for (const auto &grandchild : child.GetChildren())
+            keys.push_back(grandchild);
+    }
+    std::stringstream in_stream;
+    {
+        CopcConfigWriter cfg(6, {0.01, 0.01, 0.01}, {0, 0, 0});
+        cfg.LasHeader()->min = Vector3(0, 0, 0);
+        cfg.LasHeader()->max = Vector3(16, 16, 16);
+        cfg.LasHeader()->points_by_return = {730};
+        Writer writer(in_stream, cfg);
+        auto header = *writer.CopcConfig()->LasHeader();
+        for (auto it = keys.rbegin(); it != keys.rend(); it++)
+            writer.AddNode(*it, MakePoints(header, *it, 10), it->d == 2 ? *it : VoxelKey::RootKey());
+        writer.Close();
+    }
+    Reader reader(&in_stream);
+
+    SECTION("Breadth first")
+    {
+        std::stringstream out_stream;
+        {
+            Writer writer(out_stream, reader.CopcConfig());
+            auto result = RepackCopc(reader, writer, RepackOrder::BreadthFirst, 0);
+            REQUIRE(result.node_count == keys.size());
+            REQUIRE(result.point_count == 730);
+            REQUIRE(result.page_count == 1);
+            writer.Close();
+        }
+
+        Reader repacked(&out_stream);
+        REQUIRE(repacked.GetPageList().size() == 1);
+        REQUIRE(repacked.CopcConfig().LasHeader().points_by_return[0] == 730);
+        auto repacked_keys = KeysByOffset(repacked);
+        REQUIRE(repacked_keys.size() == keys.size());
+        for (size_t i = 1; i < repacked_keys.size(); i++)
+            REQUIRE(repacked_keys[i - 1].d <= repacked_keys[i].d);
+        for (const auto &key : keys)
+            REQUIRE(repacked.GetPointDataCompressed(key) == reader.GetPointDataCompressed(key));
+    }
+
+    SECTION("Hilbert")
+    {
+        std::stringstream out_stream;
+        {
+            Writer writer(out_stream, reader.CopcConfig());
+            auto result = RepackCopc(reader, writer, RepackOrder::Hilbert, 16);
+            REQUIRE(result.node_count == keys.size());
+            // The root page and one page per depth 1 subtree
+            REQUIRE(result.page_count == 9);
+            writer.Close();
+        }
+
+        Reader repacked(&out_stream);
+        REQUIRE(repacked.GetPageList().size() == 9);
+        auto repacked_keys = KeysByOffset(repacked);
+        for (size_t i = 1; i < repacked_keys.size(); i++)
+        {
+            auto a = repacked_keys[i - 1], b = repacked_keys[i];
+            REQUIRE(a.d <= b.d);
+            if (a.d == b.d)
+                REQUIRE(HilbertIndex(a) < HilbertIndex(b));
+        }
+        REQUIRE(repacked.GetAllPoints().Size() == 730);
+    }
+
+    SECTION("Empty parents")
+    {
+        // (1, 0, 0, 0) is the empty parent of (2, 0, 0, 0), and (1, 1, 0, 0) is an empty leaf
+        std::stringstream parent_stream;
+        {
+            Writer writer(parent_stream, reader.CopcConfig());
+            auto header = *writer.CopcConfig()->LasHeader();
+            writer.AddNode(VoxelKey::RootKey(), MakePoints(header, VoxelKey::RootKey(), 10));
+            writer.AddEmptyNode(VoxelKey(1, 0, 0, 0));
+            writer.AddEmptyNode(VoxelKey(1, 1, 0, 0));
+            writer.AddNode(VoxelKey(2, 0, 0, 0), MakePoints(header, VoxelKey(2, 0, 0, 0), 10));
+            writer.Close();
+        }
+        Reader parent_reader(&parent_stream);
+
+        std::stringstream out_stream;
+        {
+            Writer writer(out_stream, parent_reader.CopcConfig());
+            auto result = RepackCopc(parent_reader, writer, RepackOrder::Hilbert, 0);
+            REQUIRE(result.node_count == 2);
+            REQUIRE(result.empty_node_count == 1);
+            writer.Close();
+        }
+
+        Reader repacked(&out_stream);
+        auto parent = repacked.FindNode(VoxelKey(1, 0, 0, 0));
+        REQUIRE(parent.IsValid());
+        REQUIRE(parent.point_count == 0);
+        REQUIRE(!repacked.FindNode(VoxelKey(1, 1, 0, 0)).IsValid());
+        REQUIRE(repacked.ValidateSpatialBounds());
+        REQUIRE(repacked.GetAllPoints().Size() == 20);
+    }
+
+    SECTION("Incompatible writer")
+    {
+        std::stringstream out_stream;
+        Writer writer(out_stream, CopcConfigWriter(7));
+        REQUIRE_THROWS(RepackCopc(reader, writer));
+    }
+}
@@ -0,0 +1,40 @@
+import copclib as copc
+import os
+
+from .utils import get_data_dir
+
+
+def test_repack_copc():
+    in_path = os.path.join(get_data_dir(), "repack_test_in.copc.laz")
+    out_path = os.path.join(get_data_dir(), "repack_test_out.copc.laz")
+
+    cfg = copc.CopcConfigWriter(6, [0.01, 0.01, 0.01], [0, 0, 0])
+    cfg.las_header.min = copc.Vector3(0, 0, 0)
+    cfg.las_header.max = copc.Vector3(16, 16, 16)
+    writer = copc.FileWriter(in_path, cfg)
+    header = writer.copc_config.las_header
+    keys = [copc.VoxelKey.RootKey()] + copc.VoxelKey.RootKey().GetChildren()
+    for key in reversed(keys):
+        points = copc.Points(header)
+        point = points.CreatePoint()
+        point.x = 1
+        point.y = 1
+        point.z = 1
+        points.AddPoint(point)
+        writer.AddNode(key, points)
+    writer.Close()
+
+    reader = copc.FileReader(in_path)
+    writer = copc.FileWriter(out_path, reader.copc_config)
+    result = copc.RepackCopc(reader, writer, copc.RepackOrder.BreadthFirst)
+    writer.Close()
+
+    assert result.node_count == 9
+    assert result.point_count == 9
+    assert result.page_count == 1
+
+    repacked = copc.FileReader(out_path)
+    nodes = sorted(repacked.GetAllNodes(), key=lambda node: node.offset)
+    assert nodes[0].key == copc.VoxelKey.RootKey()
+    for key in keys:
+        assert repacked.GetPointDataCompressed(key) == reader.GetPointDataCompressed(key)
@@ -0,0 +1,174 @@
+#include <sstream>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+#include <copc-lib/io/copc_reader.hpp>
+#include <copc-lib/io/copc_subset.hpp>
+#include <copc-lib/io/copc_writer.hpp>
+
+using namespace copc;
+
+namespace
+{
+las::Points MakePoints(const las::LasHeader &header, double x_min, double x_max, int count)
+{
+    las::Points points(header);
+    for (int i = 0; i < count; i++)
+    {
+        auto point = points.CreatePoint();
+        point->X(x_min + (x_max - x_min) * (i + 0.5) / count);
+        point->Y(1);
+        point->Z(1);
+        point->Intensity(i);
+        points.AddPoint(point);
+    }
+    return points;
+}
+
+// Writes a file spanning [0, 16] with a root node, two depth 1 nodes on each side of x = 8 and a depth 2 node
+void WriteTestFile(std::ostream &stream)
+{
+    CopcConfigWriter cfg(6, {0.01, 0.01, 0.01}, {0, 0, 0});
+    cfg.LasHeader()->min = Vector3(0, 0, 0);
+    cfg.LasHeader()->max = Vector3(16, 16, 16);
+    cfg.LasHeader()->points_by_return = {70};
+    cfg.CopcInfo()->center_x = 8;
+    cfg.CopcInfo()->center_y = 8;
+    cfg.CopcInfo()->center_z = 8;
+    cfg.CopcInfo()->halfsize = 8;
+    cfg.CopcInfo()->spacing = 1;
+    Writer writer(stream, cfg);
+
+    auto header = *writer.CopcConfig()->LasHeader();
+    writer.AddNode(VoxelKey::RootKey(), MakePoints(header, 0, 16, 16));
+    writer.AddNode(VoxelKey(1, 0, 0, 0), MakePoints(header, 0, 8, 20), VoxelKey(1, 0, 0, 0));
+    writer.AddNode(VoxelKey(1, 1, 0, 0), MakePoints(header, 8.5, 16, 20));
+    writer.AddNode(VoxelKey(2, 0, 0, 0), MakePoints(header, 0, 4, 14), VoxelKey(1, 0, 0, 0));
+    writer.Close();
+}
+} // namespace
+
+TEST_CASE("ExtractSubset", "[Subset]")
+{
+    std::stringstream in_stream;
+    WriteTestFile(in_stream);
+    Reader reader(&in_stream);
+    Box box(0, 0, 8.25, 16);
+
+    for (unsigned int num_threads : {1u, 4u})
+    {
+        std::stringstream out_stream;
+        SubsetResult result;
+        {
+            Writer writer(out_stream, reader.CopcConfig());
+            result = ExtractSubset(reader, writer, box, 0, num_threads);
+            writer.Close();
+        }
+        // Both depth 1 nodes cross the box, but all points of (1, 1, 0, 0) are outside of it
+        REQUIRE(result.nodes_copied == 2);
+        REQUIRE(result.nodes_filtered == 1);
+        REQUIRE(result.nodes_empty == 0);
+        REQUIRE(result.point_count == 8 + 20 + 14);
+        // The cube of the copied node (1, 0, 0, 0) and the filtered root points
+        REQUIRE(result.min == Vector3(0, 0, 0));
+        REQUIRE(result.max == Vector3(8, 8, 8));
+
+        Reader subset(&out_stream);
+        auto header = subset.CopcConfig().LasHeader();
+        REQUIRE(header.PointCount() == result.point_count);
+        REQUIRE(header.points_by_return[0] == 0);
+        REQUIRE(header.min == reader.CopcConfig().LasHeader().min);
+        REQUIRE(header.max == reader.CopcConfig().LasHeader().max);
+
+        REQUIRE(subset.GetAllNodes().size() == 3);
+        REQUIRE(!subset.FindNode(VoxelKey(1, 1, 0, 0)).IsValid());
+        REQUIRE(subset.GetPageList().size() == 2);
+        REQUIRE(subset.FindNode(VoxelKey(2, 0, 0, 0)).page_key == VoxelKey(1, 0, 0, 0));
+
+        // Copied nodes are byte for byte identical
+        REQUIRE(subset.GetPointDataCompressed(VoxelKey(1, 0, 0, 0)) ==
+                reader.GetPointDataCompressed(VoxelKey(1, 0, 0, 0)));
+        REQUIRE(subset.GetPointDataCompressed(VoxelKey(2, 0, 0, 0)) ==
+                reader.GetPointDataCompressed(VoxelKey(2, 0, 0, 0)));
+
+        auto root_points = subset.GetPoints(VoxelKey::RootKey());
+        REQUIRE(root_points.Size() == 8);
+        REQUIRE(root_points.Within(box));
+        REQUIRE(subset.GetAllPoints().Within(box));
+    }
+
+    SECTION("Resolution")
+    {
+        auto config = reader.CopcConfig();
+        auto resolution = VoxelKey::GetResolutionAtDepth(1, config.LasHeader(), config.CopcInfo());
+        std::stringstream out_stream;
+        Writer writer(out_stream, reader.CopcConfig());
+        auto result = ExtractSubset(reader, writer, box, resolution);
+        writer.Close();
+
+        REQUIRE(result.nodes_copied == 1);
+        REQUIRE(result.nodes_filtered == 1);
+        Reader subset(&out_stream);
+        REQUIRE(subset.GetMaxDepth() == 1);
+    }
+
+    SECTION("Empty parents")
+    {
+        // (1, 1, 0, 0) has no point in the box, but its child (2, 2, 0, 0) does
+        std::stringstream parent_stream;
+        {
+            Writer writer(parent_stream, reader.CopcConfig());
+            auto header = *writer.CopcConfig()->LasHeader();
+            writer.AddNode(VoxelKey::RootKey(), MakePoints(header, 0, 16, 16));
+            writer.AddNode(VoxelKey(1, 1, 0, 0), MakePoints(header, 8.5, 16, 20));
+            writer.AddNode(VoxelKey(2, 2, 0, 0), MakePoints(header, 8, 8.2, 4));
+            writer.Close();
+        }
+        Reader parent_reader(&parent_stream);
+
+        std::stringstream out_stream;
+        SubsetResult result;
+        {
+            Writer writer(out_stream, parent_reader.CopcConfig());
+            result = ExtractSubset(parent_reader, writer, box);
+            writer.Close();
+        }
+        REQUIRE(result.nodes_filtered == 2);
+        REQUIRE(result.nodes_empty == 1);
+        REQUIRE(result.point_count == 8 + 4);
+        REQUIRE(result.max.x == Catch::Approx(8.175).margin(0.01));
+
+        Reader subset(&out_stream);
+        auto parent = subset.FindNode(VoxelKey(1, 1, 0, 0));
+        REQUIRE(parent.IsValid());
+        REQUIRE(parent.point_count == 0);
+        REQUIRE(parent.byte_size == 0);
+        REQUIRE(subset.FindNode(VoxelKey(2, 2, 0, 0)).point_count == 4);
+        REQUIRE(subset.GetAllPoints().Size() == 12);
+    }
+
+    SECTION("Empty subset")
+    {
+        std::stringstream out_stream;
+        Writer writer(out_stream, reader.CopcConfig());
+        auto result = ExtractSubset(reader, writer, Box(100, 100, 200, 200));
+        writer.Close();
+
+        REQUIRE(result.point_count == 0);
+        Reader subset(&out_stream);
+        REQUIRE(subset.GetAllNodes().empty());
+    }
+
+    SECTION("Incompatible writer")
+    {
+        std::stringstream out_stream;
+        Writer writer(out_stream, CopcConfigWriter(7));
+        REQUIRE_THROWS(ExtractSubset(reader, writer, box));
+
+        std::stringstream moved_stream;
+        CopcConfigWriter cfg(reader.CopcConfig());
+        cfg.LasHeader()->max = Vector3(32, 32, 32);
+        Writer moved_writer(moved_stream, cfg);
+        REQUIRE_THROWS(ExtractSubset(reader, moved_writer, box));
+    }
+}
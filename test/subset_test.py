@@ -0,0 +1,55 @@
+import copclib as copc
+import os
+
+from .utils import get_data_dir
+
+
+def _make_points(header, x_min, x_max, count):
+    points = copc.Points(header)
+    for i in range(count):
+        point = points.CreatePoint()
+        point.x = x_min + (x_max - x_min) * (i + 0.5) / count
+        point.y = 1
+        point.z = 1
+        points.AddPoint(point)
+    return points
+
+
+def test_extract_subset():
+    in_path = os.path.join(get_data_dir(), "subset_test_in.copc.laz")
+    out_path = os.path.join(get_data_dir(), "subset_test_out.copc.laz")
+
+    cfg = copc.CopcConfigWriter(6, [0.01, 0.01, 0.01], [0, 0, 0])
+    cfg.las_header.min = copc.Vector3(0, 0, 0)
+    cfg.las_header.max = copc.Vector3(16, 16, 16)
+    cfg.copc_info.center_x = 8
+    cfg.copc_info.center_y = 8
+    cfg.copc_info.center_z = 8
+    cfg.copc_info.halfsize = 8
+    cfg.copc_info.spacing = 1
+    writer = copc.FileWriter(in_path, cfg)
+    header = writer.copc_config.las_header
+    writer.AddNode(copc.VoxelKey.RootKey(), _make_points(header, 0, 16, 16))
+    writer.AddNode(copc.VoxelKey(1, 0, 0, 0), _make_points(header, 0, 8, 20))
+    writer.AddNode(copc.VoxelKey(1, 1, 0, 0), _make_points(header, 8.5, 16, 20))
+    writer.Close()
+
+    box = copc.Box(0, 0, 8.25, 16)
+    reader = copc.FileReader(in_path)
+    writer = copc.FileWriter(out_path, reader.copc_config)
+    result = copc.ExtractSubset(reader, writer, box, num_threads=2)
+    writer.Close()
+
+    assert result.nodes_copied == 1
+    assert result.nodes_filtered == 1
+    assert result.point_count == 28
+    assert result.min == copc.Vector3(0, 0, 0)
+    assert result.max == copc.Vector3(8, 8, 8)
+
+    subset = copc.FileReader(out_path)
+    assert subset.copc_config.las_header.point_count == 28
+    key = copc.VoxelKey(1, 0, 0, 0)
+    assert subset.GetPointDataCompressed(
+        subset.FindNode(key)
+    ) == reader.GetPointDataCompressed(reader.FindNode(key))
+    assert subset.GetAllPoints().Within(box)
@@ -0,0 +1,141 @@
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+#include <copc-lib/io/copc_reader.hpp>
+#include <copc-lib/io/copc_writer.hpp>
+#include <copc-lib/io/tracing.hpp>
+
+using namespace copc;
+
+namespace
+{
+std::stringstream WriteTestFile()
+{
+    las::Points points(6);
+    for (int i = 0; i < 20; i++)
+    {
+        auto point = points.CreatePoint();
+        point->X(i);
+        points.AddPoint(point);
+    }
+
+    std::stringstream stream;
+    Writer writer(stream, CopcConfigWriter(6));
+    writer.AddNode(VoxelKey::RootKey(), points);
+    writer.AddNode(VoxelKey(1, 0, 0, 0), points, VoxelKey(1, 0, 0, 0));
+    writer.Close();
+    return stream;
+}
+} // namespace
+
+TEST_CASE("Tracing", "[Tracing]")
+{
+    SECTION("No tracer")
+    {
+        REQUIRE(GetTracer() == nullptr);
+        auto stream = WriteTestFile();
+        Reader reader(&stream);
+        REQUIRE(reader.GetPoints(VoxelKey::RootKey()).Size() == 20);
+    }
+
+    SECTION("Callback tracer")
+    {
+        std::mutex mutex;
+        std::vector<TraceEvent> events;
+        auto tracer = std::make_shared<CallbackTracer>(
+            [&](const TraceEvent &event)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                events.push_back(event);
+            });
+        SetTracer(tracer);
+        REQUIRE(GetTracer() == tracer);
+
+        auto stream = WriteTestFile();
+        Reader reader(&stream);
+        REQUIRE(reader.GetPoints(VoxelKey(1, 0, 0, 0)).Size() == 20);
+        REQUIRE(reader.GetPointData(VoxelKey::RootKey()).size() == 20 * 30);
+        SetTracer(nullptr);
+
+        // Events are nested: each end closes the last open begin of its thread
+        std::map<std::string, int> begin_counts;
+        std::vector<TraceEvent> open;
+        for (const auto &event : events)
+        {
+            if (event.type == TraceEvent::Type::Begin)
+            {
+                begin_counts[event.name]++;
+                open.push_back(event);
+                continue;
+            }
+            REQUIRE(!open.empty());
+            REQUIRE(std::string(open.back().name) == event.name);
+            REQUIRE(open.back().key == event.key);
+            REQUIRE(open.back().thread_id == event.thread_id);
+            REQUIRE(open.back().time <= event.time);
+            open.pop_back();
+        }
+        REQUIRE(open.empty());
+
+        REQUIRE(begin_counts["Writer::AddNode"] == 2);
+        REQUIRE(begin_counts["Compressor::CompressBytes"] == 2);
+        REQUIRE(begin_counts["Writer::Close"] == 1);
+        REQUIRE(begin_counts["Writer::WritePage"] == 2);
+        REQUIRE(begin_counts["Reader::ReadPage"] == 2);
+        REQUIRE(begin_counts["Reader::GetPoints"] == 1);
+        REQUIRE(begin_counts["Reader::GetPointData"] == 1);
+        REQUIRE(begin_counts["Reader::ReadNodeData"] == 2);
+        REQUIRE(begin_counts["Decompressor::DecompressBytes"] == 2);
+
+        for (const auto &event : events)
+        {
+            if (std::string(event.name) == "Reader::GetPoints")
+            {
+                REQUIRE(event.key == VoxelKey(1, 0, 0, 0));
+                REQUIRE(event.bytes > 0);
+            }
+            if (std::string(event.name) == "Decompressor::DecompressBytes")
+            {
+                REQUIRE(!event.key.IsValid());
+                REQUIRE(event.bytes == 20 * 30);
+            }
+        }
+
+        // Nothing is reported once the tracer is unregistered
+        auto count = events.size();
+        reader.GetPoints(VoxelKey::RootKey());
+        REQUIRE(events.size() == count);
+    }
+
+    SECTION("Chrome trace exporter")
+    {
+        auto exporter = std::make_shared<ChromeTraceExporter>();
+        SetTracer(exporter);
+        auto stream = WriteTestFile();
+        Reader reader(&stream);
+        reader.GetPoints(VoxelKey::RootKey());
+        SetTracer(nullptr);
+
+        REQUIRE(exporter->EventCount() > 0);
+        REQUIRE(exporter->EventCount() % 2 == 0);
+
+        std::stringstream json;
+        exporter->Write(json);
+        auto trace = json.str();
+        REQUIRE(trace.rfind("{\"traceEvents\":[", 0) == 0);
+        REQUIRE(trace.find("{\"name\":\"Reader::GetPoints\",\"ph\":\"B\",\"ts\":") != std::string::npos);
+        REQUIRE(trace.find("\"ph\":\"E\"") != std::string::npos);
+        REQUIRE(trace.find("\"args\":{\"key\":\"(0, 0, 0, 0)\",\"bytes\":") != std::string::npos);
+        REQUIRE(trace.find("\"pid\":1,\"tid\":0") != std::string::npos);
+
+        exporter->Clear();
+        REQUIRE(exporter->EventCount() == 0);
+        json.str("");
+        exporter->Write(json);
+        REQUIRE(json.str() == "{\"traceEvents\":[\n]}\n");
+    }
+}
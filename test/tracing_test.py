@@ -0,0 +1,77 @@
+import copclib as copc
+import json
+import os
+
+from .utils import get_data_dir
+
+
+def test_chrome_trace_exporter():
+    file_path = os.path.join(get_data_dir(), "tracing_test.copc.laz")
+    trace_path = os.path.join(get_data_dir(), "tracing_test.json")
+
+    exporter = copc.ChromeTraceExporter()
+    copc.SetTracer(exporter)
+    assert copc.GetTracer() is not None
+
+    writer = copc.FileWriter(file_path, copc.CopcConfigWriter(6))
+    points = copc.Points(writer.copc_config.las_header)
+    for i in range(20):
+        point = points.CreatePoint()
+        point.x = i
+        points.AddPoint(point)
+    writer.AddNode(copc.VoxelKey.RootKey(), points)
+    writer.Close()
+
+    reader = copc.FileReader(file_path)
+    assert len(reader.GetPoints(copc.VoxelKey.RootKey())) == 20
+    copc.SetTracer(None)
+    assert copc.GetTracer() is None
+
+    count = exporter.event_count
+    assert count > 0
+    reader.GetPoints(copc.VoxelKey.RootKey())
+    assert exporter.event_count == count
+
+    exporter.Save(trace_path)
+    with open(trace_path) as f:
+        events = json.load(f)["traceEvents"]
+    assert len(events) == count
+    names = {event["name"] for event in events}
+    assert "Writer::AddNode" in names
+    assert "Reader::GetPoints" in names
+    assert len([e for e in events if e["ph"] == "B"]) == count // 2
+
+    exporter.Clear()
+    assert exporter.event_count == 0
+
+
+class RecordingTracer(copc.Tracer):
+    def __init__(self):
+        super().__init__()
+        self.events = []
+
+    def OnEvent(self, event):
+        self.events.append((event.type, event.name, str(event.key)))
+
+
+def test_python_tracer():
+    file_path = os.path.join(get_data_dir(), "tracing_test.copc.laz")
+
+    writer = copc.FileWriter(file_path, copc.CopcConfigWriter(6))
+    points = copc.Points(writer.copc_config.las_header)
+    points.AddPoint(points.CreatePoint())
+    writer.AddNode(copc.VoxelKey.RootKey(), points)
+    writer.Close()
+
+    # The tracer stays registered once the caller drops its reference
+    copc.SetTracer(RecordingTracer())
+    reader = copc.FileReader(file_path)
+    assert len(reader.GetPoints(copc.VoxelKey.RootKey())) == 1
+
+    tracer = copc.GetTracer()
+    assert isinstance(tracer, RecordingTracer)
+    copc.SetTracer(None)
+
+    root = str(copc.VoxelKey.RootKey())
+    assert (copc.TraceEventType.Begin, "Reader::GetPoints", root) in tracer.events
+    assert (copc.TraceEventType.End, "Reader::GetPoints", root) in tracer.events
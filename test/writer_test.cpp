@@ -6,6 +6,7 @@
 #include <copc-lib/geometry/vector3.hpp>
 #include <copc-lib/io/copc_reader.hpp>
 #include <copc-lib/io/copc_writer.hpp>
+#include <copc-lib/io/internal/memory_stream.hpp>
 #include <copc-lib/las/vlr.hpp>
 #include <lazperf/readers.hpp>
 
@@ -599,6 +600,132 @@ TEST_CASE("Writer Pages", "[Writer]")
         auto node = reader.FindNode(VoxelKey(3, 4, 4, 4));
         REQUIRE(node.page_key == VoxelKey(1, 1, 1, 1));
     }
+
+    SECTION("Reproducible Hierarchy")
+    {
+        auto write_file = []()
+        {
+            stringstream out_stream;
+            Writer writer(out_stream, {6});
+            auto header = *writer.CopcConfig()->LasHeader();
+            las::Points points(header.PointFormatId());
+            points.AddPoint(points.CreatePoint());
+            for (const auto &child : VoxelKey::RootKey().GetChildren())
+            {
+                for (const auto &grandchild : child.GetChildren())
+                    writer.AddNode(grandchild, points, child);
+            }
+            writer.AddNode(VoxelKey::RootKey(), points);
+            writer.Close();
+            return out_stream.str();
+        };
+
+        // Pages and their entries are written in key order, regardless of where they are allocated
+        auto data = write_file();
+        REQUIRE(data == write_file());
+
+        Internal::MemoryIStream in_stream(data.data(), data.size());
+        Reader reader(&in_stream);
+        REQUIRE(reader.GetPageList().size() == 9);
+        REQUIRE(reader.GetAllNodes().size() == 65);
+    }
+
+    SECTION("Paging Policy")
+    {
+        // A root, its 8 children and their 64 children, all added to the root page
+        auto write_octree = [](Writer &writer)
+        {
+            auto header = *writer.CopcConfig()->LasHeader();
+            las::Points points(header.PointFormatId());
+            points.AddPoint(points.CreatePoint());
+            writer.AddNode(VoxelKey::RootKey(), points);
+            for (const auto &child : VoxelKey::RootKey().GetChildren())
+            {
+                writer.AddNode(child, points);
+                for (const auto &grandchild : child.GetChildren())
+                    writer.AddNode(grandchild, points);
+            }
+        };
+
+        SECTION("Default")
+        {
+            stringstream out_stream;
+            Writer writer(out_stream, {6});
+            REQUIRE(writer.GetPagingPolicy().max_page_nodes == 0);
+            REQUIRE(writer.GetPagingPolicy().depth_step == 0);
+            write_octree(writer);
+            writer.Close();
+
+            Reader reader(&out_stream);
+            REQUIRE(reader.GetPageList().size() == 1);
+        }
+
+        SECTION("Max Page Nodes")
+        {
+            stringstream out_stream;
+            Writer writer(out_stream, {6});
+            writer.SetPagingPolicy({16, 0});
+            write_octree(writer);
+            // Nodes explicitly paged keep their page
+            writer.ChangeNodePage(VoxelKey(2, 0, 0, 0), VoxelKey(2, 0, 0, 0));
+            writer.Close();
+
+            Reader reader(&out_stream);
+            REQUIRE(reader.GetPageList().size() == 10);
+            REQUIRE(reader.CopcConfig().CopcInfo().root_hier_size == 32 * 9); // root node and 8 sub pages
+            REQUIRE(reader.FindNode(VoxelKey(2, 3, 1, 0)).page_key == VoxelKey(1, 1, 0, 0));
+            REQUIRE(reader.FindNode(VoxelKey(2, 0, 0, 0)).page_key == VoxelKey(2, 0, 0, 0));
+            REQUIRE(reader.GetAllNodes().size() == 73);
+        }
+
+        SECTION("Existing pages")
+        {
+            stringstream out_stream;
+            Writer writer(out_stream, {6});
+            writer.SetPagingPolicy({16, 0});
+            write_octree(writer);
+            // The policy would page the subtree of (1, 0, 0, 0) at that key
+            writer.ChangeNodePage(VoxelKey(1, 0, 0, 0), VoxelKey(1, 0, 0, 0));
+            writer.Close();
+
+            Reader reader(&out_stream);
+            REQUIRE(reader.GetPageList().size() == 9);
+            REQUIRE(reader.FindNode(VoxelKey(1, 0, 0, 0)).page_key == VoxelKey(1, 0, 0, 0));
+            // Its children aren't mixed into the user's page
+            for (const auto &child : VoxelKey(1, 0, 0, 0).GetChildren())
+                REQUIRE(reader.FindNode(child).page_key == VoxelKey::RootKey());
+            REQUIRE(reader.FindNode(VoxelKey(2, 3, 1, 0)).page_key == VoxelKey(1, 1, 0, 0));
+            REQUIRE(reader.GetAllNodes().size() == 73);
+        }
+
+        SECTION("Depth Step")
+        {
+            stringstream out_stream;
+            Writer writer(out_stream, {6});
+            REQUIRE_THROWS(writer.SetPagingPolicy({0, -1}));
+            writer.SetPagingPolicy({0, 2});
+            write_octree(writer);
+            writer.Close();
+
+            Reader reader(&out_stream);
+            REQUIRE(reader.GetPageList().size() == 65);
+            REQUIRE(reader.FindNode(VoxelKey(1, 1, 0, 0)).page_key == VoxelKey::RootKey());
+            REQUIRE(reader.FindNode(VoxelKey(2, 3, 1, 0)).page_key == VoxelKey(2, 3, 1, 0));
+        }
+
+        SECTION("Disabled")
+        {
+            stringstream out_stream;
+            Writer writer(out_stream, {6});
+            writer.SetPagingPolicy({0, 0});
+            write_octree(writer);
+            writer.Close();
+
+            Reader reader(&out_stream);
+            REQUIRE(reader.GetPageList().size() == 1);
+            REQUIRE(reader.CopcConfig().CopcInfo().root_hier_size == 32 * 73);
+        }
+    }
 }
 
 TEST_CASE("Writer EBs", "[Writer]")
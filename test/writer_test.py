@@ -254,6 +254,23 @@ def test_writer_pages():
     node = reader.FindNode((3, 4, 4, 4))
     assert node.page_key == (1, 1, 1, 1)
 
+    # Paging policy
+    writer = copc.FileWriter(file_path, copc.CopcConfigWriter(6))
+    assert writer.paging_policy.max_page_nodes == 0
+    writer.paging_policy = copc.PagingPolicy(max_page_nodes=0, depth_step=1)
+
+    header = writer.copc_config.las_header
+    points = copc.Points(header.point_format_id)
+    points.AddPoint(points.CreatePoint())
+
+    writer.AddNode(copc.VoxelKey.RootKey(), points)
+    writer.AddNode((1, 1, 1, 1), points)
+    writer.Close()
+
+    reader = copc.FileReader(file_path)
+    assert len(reader.GetPageList()) == 2
+    assert reader.FindNode((1, 1, 1, 1)).page_key == (1, 1, 1, 1)
+
 
 def test_writer_copy():
     # Given a valid file path